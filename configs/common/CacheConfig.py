@@ -67,6 +67,9 @@ def _get_cache_opts(level, options):
     if hasattr(options, prefetcher_attr):
         opts['prefetcher'] = _get_hwp(getattr(options, prefetcher_attr))
 
+    if getattr(options, 'share_line_data', False):
+        opts['share_line_data'] = True
+
     return opts
 
 def config_cache(options, system):
@@ -121,10 +124,25 @@ def config_cache(options, system):
         system.l2 = l2_cache_class(clk_domain=system.cpu_clk_domain,
                                    **_get_cache_opts('l2', options))
 
-        system.tol2bus = L2XBar(clk_domain = system.cpu_clk_domain)
+        xbar_shards = getattr(options, 'xbar_shards', 1)
+        system.tol2bus = L2XBar(clk_domain = system.cpu_clk_domain,
+                                request_layer_shards = xbar_shards)
         system.l2.cpu_side = system.tol2bus.master
         system.l2.mem_side = system.membus.slave
 
+        # With many CPUs, group them in clusters, each with its own
+        # crossbar and snoop filter, so that neither the arbitration
+        # nor the snoops of the L2 crossbar involve every CPU
+        radix = getattr(options, 'xbar_radix', 0)
+        if radix and options.num_cpus > radix:
+            num_clusters = (options.num_cpus + radix - 1) // radix
+            system.clusterbus = [L2XBar(clk_domain = system.cpu_clk_domain,
+                                        point_of_unification = False,
+                                        request_layer_shards = xbar_shards)
+                                 for i in range(num_clusters)]
+            for bus in system.clusterbus:
+                bus.master = system.tol2bus.slave
+
     if options.memchecker:
         system.memchecker = MemChecker()
 
@@ -186,7 +204,10 @@ def config_cache(options, system):
                         ExternalCache("cpu%d.dcache" % i))
 
         system.cpu[i].createInterruptController()
-        if options.l2cache:
+        if options.l2cache and hasattr(system, 'clusterbus'):
+            system.cpu[i].connectAllPorts(system.clusterbus[i // radix],
+                                          system.membus)
+        elif options.l2cache:
             system.cpu[i].connectAllPorts(system.tol2bus, system.membus)
         elif options.external_memory_system:
             system.cpu[i].connectUncachedPorts(system.membus)
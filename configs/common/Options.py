@@ -153,6 +153,19 @@ def addNoISAOptions(parser):
     parser.add_argument("--l2_assoc", type=int, default=8)
     parser.add_argument("--l3_assoc", type=int, default=16)
     parser.add_argument("--cacheline_size", type=int, default=64)
+    parser.add_argument("--share-line-data", action="store_true",
+                        help="Share whole cache lines between the caches and "
+                        "packets using copy-on-write buffers, rather than "
+                        "copying them at every level (compare the "
+                        "lineCopies and lineShares cache stats)")
+    parser.add_argument("--xbar-radix", type=int, default=0,
+                        help="Connect the CPUs to the L2 crossbar through a "
+                        "tree of cluster crossbars with at most this many "
+                        "CPUs each, rather than a single flat crossbar "
+                        "(0 disables the tree)")
+    parser.add_argument("--xbar-shards", type=int, default=1,
+                        help="Number of address-interleaved shards of each "
+                        "request layer of the L2 crossbars")
 
     # Enable Ruby
     parser.add_argument("--ruby", action="store_true")
@@ -336,6 +349,13 @@ def addCommonOptions(parser):
                         help="restore from a simpoint checkpoint taken with " +
                         "--take-simpoint-checkpoints")
 
+    # Branch trace options
+    parser.add_argument("--branch-trace", action="store", type=str,
+                        default=None,
+                        help="Record the branches committed by an atomic "
+                        "CPU to this file in the output directory, to be "
+                        "replayed with configs/example/replay_branch_trace.py")
+
     # Checkpointing options
     # Note that performing checkpointing via python script files will override
     # checkpoint instructions built into binaries.
@@ -184,10 +184,17 @@ def build_test_system(np):
                 fatal("SimPoint generation should be done with atomic cpu")
             if np > 1:
                 fatal("SimPoint generation not supported with more than one CPUs")
+        if args.branch_trace:
+            if not ObjectList.is_noncaching_cpu(TestCPUClass):
+                fatal("Branch traces can only be recorded with an atomic cpu")
+            if np > 1:
+                fatal("Branch traces not supported with more than one CPUs")
 
         for i in range(np):
             if args.simpoint_profile:
                 test_sys.cpu[i].addSimPointProbe(args.simpoint_interval)
+            if args.branch_trace:
+                test_sys.cpu[i].addBranchTraceProbe(args.branch_trace)
             if args.checker:
                 test_sys.cpu[i].addCheckerCpu()
             if not ObjectList.is_kvm_cpu(TestCPUClass):
@@ -94,6 +94,11 @@ parser.add_argument("-r", "--random", action="store_true",
 parser.add_argument("--progress", type=int, default=100000,
                     metavar="NLOADS",
                     help="Progress message interval ")
+parser.add_argument("--share-line-data", action="store_true",
+                    help="Share whole lines between the caches and packets "
+                    "instead of copying them (compare the lineCopies and "
+                    "lineShares cache stats, and the host time, of runs with "
+                    "and without it)")
 parser.add_argument("--sys-clock", action="store", type=str,
                     default='1GHz',
                     help="""Top-level clock for blocks running at system
@@ -169,7 +174,8 @@ else:
 proto_l1 = Cache(size = '32kB', assoc = 4,
                  tag_latency = 1, data_latency = 1, response_latency = 1,
                  tgts_per_mshr = 8, clusivity = 'mostly_incl',
-                 writeback_clean = True)
+                 writeback_clean = True,
+                 share_line_data = args.share_line_data)
 
 if args.blocking:
      proto_l1.mshrs = 1
@@ -296,7 +302,8 @@ if args.noncoherent_cache:
      system.llc = NoncoherentCache(size = '16MB', assoc = 16, tag_latency = 10,
                                    data_latency = 10, sequential_access = True,
                                    response_latency = 20, tgts_per_mshr = 8,
-                                   mshrs = 64)
+                                   mshrs = 64,
+                                   share_line_data = args.share_line_data)
      last_subsys.xbar.master = system.llc.cpu_side
      system.llc.mem_side = system.physmem.port
 else:
@@ -0,0 +1,71 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Replays a branch trace, recorded with the --branch-trace option of
+# se.py or fs.py, through a branch predictor without simulating a CPU.
+# Each run evaluates a single predictor, so design space sweeps can run
+# as many independent processes in parallel.
+
+import argparse
+
+import m5
+from m5.objects import *
+from m5.util import addToPath
+
+addToPath('../')
+
+from common import ObjectList
+
+parser = argparse.ArgumentParser(
+    formatter_class=argparse.ArgumentDefaultsHelpFormatter)
+
+parser.add_argument("trace", help="Branch trace to replay")
+parser.add_argument("--bp-type", default="TAGE_SC_L_64KB",
+                    choices=ObjectList.bp_list.get_names(),
+                    help="Type of branch predictor to evaluate")
+parser.add_argument("--indirect-bp-type", default=None,
+                    choices=ObjectList.indirect_bp_list.get_names(),
+                    help="Type of indirect branch predictor to evaluate")
+parser.add_argument("--max-branches", type=int, default=0,
+                    help="Number of branches to replay, 0 for all of them")
+parser.add_argument("--commit-delay", type=int, default=0,
+                    help="Number of branches predicted before a branch "
+                    "commits and trains the predictor")
+
+args = parser.parse_args()
+
+bpred = ObjectList.bp_list.get(args.bp_type)()
+if args.indirect_bp_type:
+    bpred.indirectBranchPred = \
+        ObjectList.indirect_bp_list.get(args.indirect_bp_type)()
+
+root = Root(full_system=False)
+root.replay = BranchTraceReplay(trace_file=args.trace,
+                                branch_pred=bpred,
+                                max_branches=args.max_branches,
+                                commit_delay=args.commit_delay)
+
+m5.instantiate()
+exit_event = m5.simulate()
+
+print('Exiting @ tick', m5.curTick(), 'because', exit_event.getCause())
@@ -212,6 +212,12 @@ if args.simpoint_profile:
     if np > 1:
         fatal("SimPoint generation not supported with more than one CPUs")
 
+if args.branch_trace:
+    if not ObjectList.is_noncaching_cpu(CPUClass):
+        fatal("Branch traces can only be recorded with an atomic cpu")
+    if np > 1:
+        fatal("Branch traces not supported with more than one CPUs")
+
 for i in range(np):
     if args.smt:
         system.cpu[i].workload = multiprocesses
@@ -223,6 +229,9 @@ for i in range(np):
     if args.simpoint_profile:
         system.cpu[i].addSimPointProbe(args.simpoint_interval)
 
+    if args.branch_trace:
+        system.cpu[i].addBranchTraceProbe(args.branch_trace)
+
     if args.checker:
         system.cpu[i].addCheckerCpu()
 
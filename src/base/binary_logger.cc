@@ -0,0 +1,152 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/binary_logger.hh"
+
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+namespace Trace
+{
+
+BinaryLogger::BinaryLogger(std::ostream &_stream, size_t chunk_size,
+                           size_t num_chunks)
+    : TraceRecorder(chunk_size), stream(_stream), lineBuffer(*this),
+      lineStream(&lineBuffer), writing(false), closing(false)
+{
+    fatal_if(num_chunks == 0, "Binary debug logger needs a buffer.\n");
+
+    recorder = this;
+
+    spare.resize(num_chunks);
+    for (auto &data : spare)
+        data.reserve(chunk_size + chunk_size / 4);
+
+    binary_trace::writeHeader(stream);
+
+    writer = std::thread(&BinaryLogger::writeLoop, this);
+}
+
+BinaryLogger::~BinaryLogger()
+{
+    close();
+}
+
+void
+BinaryLogger::logMessage(Tick when, const std::string &name,
+        const std::string &flag, const std::string &message)
+{
+    if (isIgnored(name))
+        return;
+
+    recordText(when, name, flag, message);
+}
+
+void
+BinaryLogger::flush(Buffer &buf)
+{
+    if (buf.data.empty())
+        return;
+
+    std::unique_lock<std::mutex> guard(lock);
+    if (closing) {
+        // Messages logged after the logger was closed are written
+        // directly, as there is no writer anymore
+        binary_trace::writeChunk(stream, buf.thread, buf.data);
+        buf.data.clear();
+        return;
+    }
+
+    chunkWritten.wait(guard, [this]() { return !spare.empty(); });
+    pending.push_back({buf.thread, std::move(buf.data)});
+    buf.data = std::move(spare.back());
+    spare.pop_back();
+    chunkReady.notify_one();
+}
+
+void
+BinaryLogger::writeLoop()
+{
+    std::unique_lock<std::mutex> guard(lock);
+    while (true) {
+        chunkReady.wait(guard, [this]() {
+            return !pending.empty() || closing;
+        });
+        if (pending.empty())
+            break;
+
+        Chunk chunk = std::move(pending.front());
+        pending.pop_front();
+        writing = true;
+
+        guard.unlock();
+        binary_trace::writeChunk(stream, chunk.thread, chunk.data);
+        chunk.data.clear();
+        guard.lock();
+
+        spare.push_back(std::move(chunk.data));
+        writing = false;
+        chunkWritten.notify_all();
+    }
+}
+
+void
+BinaryLogger::sync()
+{
+    lineStream.flush();
+
+    {
+        std::lock_guard<std::mutex> guard(bufferLock);
+        for (auto &buf : buffers)
+            flush(*buf);
+    }
+
+    std::unique_lock<std::mutex> guard(lock);
+    chunkWritten.wait(guard, [this]() {
+        return closing || (pending.empty() && !writing);
+    });
+    stream.flush();
+}
+
+void
+BinaryLogger::close()
+{
+    if (!writer.joinable())
+        return;
+
+    sync();
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        closing = true;
+    }
+    chunkReady.notify_one();
+    writer.join();
+    stream.flush();
+}
+
+} // namespace Trace
+} // namespace gem5
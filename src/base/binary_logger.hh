@@ -0,0 +1,130 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of a debug logger recording messages in a binary format,
+ * which is written by a background thread.
+ */
+
+#ifndef __BASE_BINARY_LOGGER_HH__
+#define __BASE_BINARY_LOGGER_HH__
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "base/trace.hh"
+#include "base/trace_record.hh"
+
+namespace gem5
+{
+
+namespace Trace
+{
+
+/**
+ * Logger recording the format string and raw arguments of messages
+ * instead of formatting them, which makes debug output much cheaper.
+ * Each simulation thread appends records to its own buffer, which is
+ * handed over to a background thread writing the trace once it is full.
+ * The buffers are taken from a fixed ring, and a thread waits for the
+ * writer when they are all in use, so messages are never dropped.
+ *
+ * Traces can be decoded to the text the messages would have been logged
+ * as using the decode_debug_trace tool. @sa TraceReader
+ */
+class BinaryLogger : public Logger, public TraceRecorder
+{
+  private:
+    /** Records of a thread handed over to the writer. */
+    struct Chunk
+    {
+        uint32_t thread;
+        std::string data;
+    };
+
+    std::ostream &stream;
+
+    TextBuffer lineBuffer;
+    std::ostream lineStream;
+
+    /** Protects the state shared with the writer. */
+    std::mutex lock;
+    /** Signalled when a chunk is handed over or the logger is closed. */
+    std::condition_variable chunkReady;
+    /** Signalled when the writer is done with a chunk. */
+    std::condition_variable chunkWritten;
+
+    /** Chunks waiting to be written. */
+    std::deque<Chunk> pending;
+    /** Buffers that can be given to threads that handed one over. */
+    std::vector<std::string> spare;
+    /** Whether the writer is writing a chunk. */
+    bool writing;
+    /** Whether the writer has been asked to stop. */
+    bool closing;
+
+    std::thread writer;
+
+    void flush(Buffer &buf) override;
+
+    /** Main loop of the writer thread. */
+    void writeLoop();
+
+  public:
+    /**
+     * @param stream The stream to write the trace to.
+     * @param chunk_size Size above which the records of a thread are
+     *        handed over to the writer.
+     * @param num_chunks Number of buffers in the ring.
+     */
+    BinaryLogger(std::ostream &stream, size_t chunk_size = 1 << 20,
+                 size_t num_chunks = 16);
+    ~BinaryLogger();
+
+    void logMessage(Tick when, const std::string &name,
+            const std::string &flag, const std::string &message) override;
+
+    std::ostream &getOstream() override { return lineStream; }
+
+    /**
+     * Write all the messages recorded so far, and wait for them to be
+     * written. The threads recording messages must be stopped.
+     */
+    void sync();
+
+    /** Write all the messages and stop the writer thread. */
+    void close();
+};
+
+} // namespace Trace
+} // namespace gem5
+
+#endif // __BASE_BINARY_LOGGER_HH__
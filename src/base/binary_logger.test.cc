@@ -0,0 +1,272 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "base/binary_logger.hh"
+#include "base/gtest/cur_tick_fake.hh"
+#include "base/trace.hh"
+#include "base/trace_reader.hh"
+
+using namespace gem5;
+
+// Instantiate the mock class to have a valid curTick of 0
+GTestTickHandler tickHandler;
+
+namespace
+{
+
+enum TestEnum { TestEnumA = 3, TestEnumB = 0x7a };
+
+struct TestObject {};
+
+std::ostream &
+operator<<(std::ostream &os, const TestObject &)
+{
+    return os << "object";
+}
+
+/** Log a set of messages covering all the kinds of arguments. */
+void
+logMessages(Trace::Logger &logger)
+{
+    const int8_t i8 = -5;
+    const uint8_t u8 = 200;
+    const int16_t i16 = -1234;
+    const uint16_t u16 = 65000;
+    const int32_t i32 = -123456789;
+    const uint32_t u32 = 0xdeadbeef;
+    const int64_t i64 = -1234567890123ll;
+    const uint64_t u64 = 0xfedcba9876543210ull;
+    const char *cstr = "a C string";
+    const std::string str = "a string";
+    const void *ptr = (const void *)0x1234;
+    const int *int_ptr = nullptr;
+
+    logger.dprintf_flag(1, "obj", "Flag", "no arguments\n");
+    logger.dprintf_flag(2, "obj", "Flag", "%d %d %d %d\n", i8, i16, i32, i64);
+    logger.dprintf_flag(3, "obj", "Flag", "%d %d %d %d\n", u8, u16, u32, u64);
+    logger.dprintf_flag(4, "obj", "Flag", "%#x %#o %08x %-6d|\n",
+                        i32, u16, u32, i16);
+    logger.dprintf_flag(5, "obj", "Flag", "%c %c %c %s %d\n",
+                        'x', (signed char)'y', (unsigned char)'z', true,
+                        false);
+    logger.dprintf_flag(6, "obj", "Flag", "%f %e %g %.3f %10.2f\n",
+                        1.5f, 3.25e-10, 100000000.0, 3.14159, -2.5);
+    logger.dprintf_flag(7, "obj", "Flag", "%s|%10s|%-10s|\n",
+                        cstr, str, "literal");
+    logger.dprintf_flag(8, "obj", "Flag", "%p %#x %s\n", ptr, ptr, int_ptr);
+    logger.dprintf_flag(9, "obj", "Flag", "%d %#06x %s %s\n",
+                        TestEnumA, TestEnumB, TestObject(), TestEnumA);
+    logger.dprintf_flag(10, "obj", "Flag", "%*d|%-*s|\n", 6, 42, 8, "star");
+    logger.dprintf_flag(11, "other", "", "%d%% 100%%\n", 50);
+    logger.dprintf_flag(MaxTick, "", "Flag", "no tick %d\n", 12);
+    logger.dprintf_flag(12, "obj", "Flag", "%d %s\n", 1);
+    logger.dprintf_flag(13, "obj", "Flag", "%d\n", 1, 2);
+    const std::string dump = "A message that spans multiple dump lines";
+    logger.dump(14, "obj", dump.c_str(), dump.size(), "Flag");
+    logger.getOstream() << "a line written to the stream\n";
+}
+
+/** Decode a trace with a reader set up by a function. */
+template <typename Setup>
+std::string
+decode(const std::string &trace, Setup setup)
+{
+    std::istringstream is(trace);
+    Trace::TraceReader reader(is);
+    setup(reader);
+    std::ostringstream os;
+    reader.decode(os);
+    EXPECT_TRUE(reader.valid()) << reader.error();
+    EXPECT_FALSE(reader.truncated());
+    return os.str();
+}
+
+std::string
+decode(const std::string &trace)
+{
+    return decode(trace, [](Trace::TraceReader &) {});
+}
+
+} // anonymous namespace
+
+/** Decoding a trace gives the same text as logging to a stream. */
+TEST(BinaryLoggerTest, SameAsText)
+{
+    std::ostringstream text;
+    Trace::OstreamLogger text_logger(text);
+    logMessages(text_logger);
+
+    std::ostringstream trace;
+    {
+        Trace::BinaryLogger logger(trace);
+        logMessages(logger);
+    }
+
+    EXPECT_EQ(decode(trace.str()), text.str());
+}
+
+/** Small chunks are written while messages are being recorded. */
+TEST(BinaryLoggerTest, SmallChunks)
+{
+    std::ostringstream text;
+    Trace::OstreamLogger text_logger(text);
+    for (int i = 0; i < 1000; i++)
+        text_logger.dprintf_flag(i, "obj", "Flag", "message %d\n", i);
+
+    std::ostringstream trace;
+    {
+        Trace::BinaryLogger logger(trace, 64, 2);
+        for (int i = 0; i < 1000; i++)
+            logger.dprintf_flag(i, "obj", "Flag", "message %d\n", i);
+    }
+
+    EXPECT_EQ(decode(trace.str()), text.str());
+}
+
+/** Messages are only decoded inside a window of ticks. */
+TEST(BinaryLoggerTest, Window)
+{
+    std::ostringstream trace;
+    {
+        Trace::BinaryLogger logger(trace);
+        for (int i = 0; i < 10; i++)
+            logger.dprintf_flag(i * 10, "obj", "Flag", "message %d\n", i);
+    }
+
+    EXPECT_EQ(decode(trace.str(), [](Trace::TraceReader &reader) {
+            reader.setWindow(30, 60);
+        }),
+        "     30: obj: message 3\n"
+        "     40: obj: message 4\n"
+        "     50: obj: message 5\n");
+}
+
+/** Messages can be restricted to some objects. */
+TEST(BinaryLoggerTest, Names)
+{
+    std::ostringstream trace;
+    {
+        Trace::BinaryLogger logger(trace);
+        logger.dprintf_flag(1, "system.cpu0", "Flag", "a\n");
+        logger.dprintf_flag(2, "system.cpu1", "Flag", "b\n");
+        logger.dprintf_flag(3, "system.mem", "Flag", "c\n");
+        logger.dprintf_flag(4, "", "Flag", "d\n");
+        logger.dprintf_flag(5, "system.cpu0", "Flag", "e\n");
+    }
+
+    EXPECT_EQ(decode(trace.str(), [](Trace::TraceReader &reader) {
+            reader.setNames(ObjectMatch("system.cpu0"));
+        }),
+        "      1: system.cpu0: a\n"
+        "      5: system.cpu0: e\n");
+}
+
+/** Ticks and flags are printed as requested. */
+TEST(BinaryLoggerTest, Format)
+{
+    std::ostringstream trace;
+    {
+        Trace::BinaryLogger logger(trace);
+        logger.dprintf_flag(1, "obj", "Flag", "a %d\n", 1);
+        logger.dprintf_flag(2, "obj", "", "b %d\n", 2);
+    }
+
+    EXPECT_EQ(decode(trace.str(), [](Trace::TraceReader &reader) {
+            reader.setFormat(false, true);
+        }),
+        "Flag: obj: a 1\n"
+        "obj: b 2\n");
+}
+
+/** The messages of different threads are merged in tick order. */
+TEST(BinaryLoggerTest, Threads)
+{
+    std::ostringstream trace;
+    {
+        Trace::BinaryLogger logger(trace, 128, 4);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; t++) {
+            threads.emplace_back([&logger, t]() {
+                const std::string name = "thread" + std::to_string(t);
+                for (int i = 0; i < 100; i++) {
+                    logger.dprintf_flag(i * 4 + t, name, "Flag",
+                                        "message %d\n", i);
+                }
+            });
+        }
+        for (auto &thread : threads)
+            thread.join();
+    }
+
+    std::ostringstream expected;
+    for (int i = 0; i < 100; i++) {
+        for (int t = 0; t < 4; t++) {
+            ccprintf(expected, "%7d: thread%d: message %d\n",
+                     i * 4 + t, t, i);
+        }
+    }
+    EXPECT_EQ(decode(trace.str()), expected.str());
+}
+
+/** A truncated trace is decoded up to its last complete chunk. */
+TEST(BinaryLoggerTest, Truncated)
+{
+    std::ostringstream trace;
+    {
+        Trace::BinaryLogger logger(trace, 64, 2);
+        for (int i = 0; i < 100; i++)
+            logger.dprintf_flag(i, "obj", "Flag", "message %d\n", i);
+    }
+
+    const std::string data = trace.str();
+    std::istringstream is(data.substr(0, data.size() - 10));
+    Trace::TraceReader reader(is);
+    std::ostringstream os;
+    const uint64_t count = reader.decode(os);
+
+    EXPECT_TRUE(reader.valid());
+    EXPECT_TRUE(reader.truncated());
+    EXPECT_GT(count, 0);
+    EXPECT_LT(count, 100);
+    EXPECT_EQ(os.str().substr(0, 20), "      0: obj: messag");
+}
+
+/** Files which are not traces are rejected. */
+TEST(BinaryLoggerTest, NotATrace)
+{
+    std::istringstream is("not a binary debug trace");
+    Trace::TraceReader reader(is);
+    std::ostringstream os;
+    EXPECT_EQ(reader.decode(os), 0);
+    EXPECT_FALSE(reader.valid());
+}
@@ -0,0 +1,168 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Decoder of the binary debug traces written with --debug-binary. It
+ * prints the messages as they would have been printed by the text
+ * logger, optionally restricted to a window of ticks and to some
+ * objects.
+ */
+
+#include <getopt.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "base/match.hh"
+#include "base/trace_reader.hh"
+#include "base/types.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+void
+usage(const char *prog)
+{
+    std::cerr <<
+        "Usage: " << prog << " [options] <trace>\n"
+        "Options:\n"
+        "  --start=TICK   Skip the messages before TICK\n"
+        "  --end=TICK     Skip the messages from TICK on\n"
+        "  --name=EXPR    Only print the messages of the objects matching\n"
+        "                 EXPR, may be repeated\n"
+        "  --flags        Print the debug flag of each message\n"
+        "  --no-ticks     Do not print the tick of each message\n"
+        "  --output=FILE  Write the messages to FILE instead of stdout\n";
+}
+
+bool
+parseTick(const char *str, Tick &tick)
+{
+    char *end;
+    tick = std::strtoull(str, &end, 0);
+    return *str && !*end;
+}
+
+} // anonymous namespace
+
+int
+main(int argc, char *argv[])
+{
+    static const option options[] = {
+        { "start", required_argument, nullptr, 's' },
+        { "end", required_argument, nullptr, 'e' },
+        { "name", required_argument, nullptr, 'n' },
+        { "flags", no_argument, nullptr, 'f' },
+        { "no-ticks", no_argument, nullptr, 't' },
+        { "output", required_argument, nullptr, 'o' },
+        { "help", no_argument, nullptr, 'h' },
+        { nullptr, 0, nullptr, 0 }
+    };
+
+    Tick start = 0;
+    Tick end = MaxTick;
+    std::vector<std::string> names;
+    bool show_flags = false;
+    bool show_ticks = true;
+    std::string output;
+
+    int opt;
+    while ((opt = getopt_long(argc, argv, "", options, nullptr)) != -1) {
+        switch (opt) {
+          case 's':
+          case 'e':
+            if (!parseTick(optarg, opt == 's' ? start : end)) {
+                std::cerr << "Invalid tick: " << optarg << "\n";
+                return 1;
+            }
+            break;
+          case 'n':
+            names.push_back(optarg);
+            break;
+          case 'f':
+            show_flags = true;
+            break;
+          case 't':
+            show_ticks = false;
+            break;
+          case 'o':
+            output = optarg;
+            break;
+          case 'h':
+            usage(argv[0]);
+            return 0;
+          default:
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (optind != argc - 1) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    std::ifstream trace(argv[optind], std::ios::in | std::ios::binary);
+    if (!trace) {
+        std::cerr << "Could not open " << argv[optind] << "\n";
+        return 1;
+    }
+
+    std::ofstream file;
+    if (!output.empty()) {
+        file.open(output);
+        if (!file) {
+            std::cerr << "Could not open " << output << "\n";
+            return 1;
+        }
+    }
+    std::ostream &os = output.empty() ? std::cout : file;
+
+    Trace::TraceReader reader(trace);
+    reader.setWindow(start, end);
+    if (!names.empty()) {
+        ObjectMatch match;
+        match.setExpression(names);
+        reader.setNames(match);
+    }
+    reader.setFormat(show_ticks, show_flags);
+
+    reader.decode(os);
+
+    if (reader.truncated())
+        std::cerr << "Warning: the trace is truncated\n";
+    if (!reader.valid()) {
+        std::cerr << "Error: " << reader.error() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
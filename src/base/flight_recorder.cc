@@ -0,0 +1,163 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/flight_recorder.hh"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "base/cprintf.hh"
+#include "base/logging.hh"
+#include "base/trace_reader.hh"
+#include "debug/FmtFlag.hh"
+#include "debug/FmtTicksOff.hh"
+#include "sim/cur_tick.hh"
+
+namespace gem5
+{
+
+namespace Trace
+{
+
+FlightRecorder::FlightRecorder(const std::string &_filename,
+                               size_t _capacity, size_t chunk_size)
+    : TraceRecorder(chunk_size), filename(_filename), capacity(_capacity),
+      lineBuffer(*this), lineStream(&lineBuffer), size(0)
+{
+    fatal_if(capacity < chunk_size,
+             "Flight recorder capacity is smaller than a chunk.\n");
+
+    recorder = this;
+}
+
+void
+FlightRecorder::logMessage(Tick when, const std::string &name,
+        const std::string &flag, const std::string &message)
+{
+    if (isIgnored(name))
+        return;
+
+    recordText(when, name, flag, message);
+}
+
+void
+FlightRecorder::flush(Buffer &buf)
+{
+    std::string data;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        size += buf.data.size();
+        chunks.push_back({buf.thread, std::move(buf.data)});
+
+        // Drop the oldest chunks, keeping the storage of the last one
+        // for the next records of the thread
+        while (size > capacity && chunks.size() > 1) {
+            size -= chunks.front().data.size();
+            data = std::move(chunks.front().data);
+            chunks.pop_front();
+        }
+    }
+
+    data.clear();
+    if (data.capacity() < flushSize)
+        data.reserve(flushSize + flushSize / 4);
+    buf.data = std::move(data);
+
+    // The chunks before the next one may be dropped, so it must not
+    // use the formats and names they define
+    restart(buf);
+}
+
+void
+FlightRecorder::dumpTrace(std::ostream &os)
+{
+    lineStream.flush();
+
+    std::lock_guard<std::mutex> buffer_guard(bufferLock);
+    std::lock_guard<std::mutex> guard(lock);
+
+    binary_trace::writeHeader(os);
+
+    // The records a thread has not handed over yet come after all its
+    // chunks, which are in order
+    for (const auto &chunk : chunks)
+        binary_trace::writeChunk(os, chunk.thread, chunk.data);
+    for (const auto &buf : buffers) {
+        if (!buf->data.empty())
+            binary_trace::writeChunk(os, buf->thread, buf->data);
+    }
+
+    os.flush();
+}
+
+void
+FlightRecorder::dumpText(std::ostream &os)
+{
+    std::stringstream trace;
+    dumpTrace(trace);
+
+    TraceReader reader(trace);
+    reader.setFormat(!debug::FmtTicksOff, debug::FmtFlag);
+    reader.decode(os);
+    if (!reader.valid())
+        ccprintf(os, "Could not decode the flight recorder: %s\n",
+                 reader.error());
+}
+
+void
+FlightRecorder::dumpFile(const std::string &reason)
+{
+    std::ofstream os(filename, std::ios::out | std::ios::trunc |
+                     std::ios::binary);
+    if (!os) {
+        warn("Could not open %s to dump the flight recorder.\n", filename);
+        return;
+    }
+
+    const bool binary = filename.size() >= 4 &&
+        filename.compare(filename.size() - 4, 4, ".bin") == 0;
+    if (binary) {
+        dumpTrace(os);
+    } else {
+        ccprintf(os, "Flight recorder dumped at tick %d: %s\n",
+                 curTick(), reason);
+        dumpText(os);
+    }
+
+    ccprintf(std::cerr, "Flight recorder dumped to %s (%s)\n",
+             filename, reason);
+}
+
+void
+dumpFlightRecorder(const std::string &reason)
+{
+    auto *recorder = dynamic_cast<FlightRecorder *>(getDebugLogger());
+    if (recorder)
+        recorder->dumpFile(reason);
+}
+
+} // namespace Trace
+} // namespace gem5
@@ -0,0 +1,137 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of a debug logger keeping the most recent messages in
+ * memory until they are needed.
+ */
+
+#ifndef __BASE_FLIGHT_RECORDER_HH__
+#define __BASE_FLIGHT_RECORDER_HH__
+
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+#include "base/trace.hh"
+#include "base/trace_record.hh"
+
+namespace gem5
+{
+
+namespace Trace
+{
+
+/**
+ * Logger keeping the most recent debug messages in a bounded amount of
+ * memory, so that tracing can be left on during long runs and only be
+ * written out when something goes wrong. Messages are recorded in the
+ * binary trace format, and each thread hands its records over in chunks
+ * which are kept in a ring, the oldest chunks being dropped once the
+ * ring is full. Every chunk defines the formats and names it uses, so
+ * it can be decoded without the chunks that were dropped.
+ *
+ * The messages are dumped to a file when the simulator panics or exits
+ * with a fatal error, and at exit events, see dumpFlightRecorder(). The
+ * file is overwritten by every dump.
+ */
+class FlightRecorder : public Logger, public TraceRecorder
+{
+  private:
+    /** Records of a thread that were handed over. */
+    struct Chunk
+    {
+        uint32_t thread;
+        std::string data;
+    };
+
+    /** File the messages are dumped to. */
+    const std::string filename;
+
+    /** Maximum size of the chunks kept. */
+    const size_t capacity;
+
+    TextBuffer lineBuffer;
+    std::ostream lineStream;
+
+    /** Protects the ring of chunks. */
+    std::mutex lock;
+    /** The chunks kept, oldest first. */
+    std::deque<Chunk> chunks;
+    /** Size of the chunks kept. */
+    size_t size;
+
+    void flush(Buffer &buf) override;
+
+  public:
+    /**
+     * @param filename The file the messages are dumped to. Messages
+     *        are dumped as a binary trace if its name ends with .bin,
+     *        and as text otherwise.
+     * @param capacity Size of the records kept, in bytes.
+     * @param chunk_size Size of the records of a thread above which
+     *        they are handed over to the ring.
+     */
+    FlightRecorder(const std::string &filename, size_t capacity,
+                   size_t chunk_size = 64 * 1024);
+
+    void logMessage(Tick when, const std::string &name,
+            const std::string &flag, const std::string &message) override;
+
+    std::ostream &getOstream() override { return lineStream; }
+
+    /**
+     * Write the messages kept as a binary trace. The other threads
+     * recording messages should be stopped.
+     */
+    void dumpTrace(std::ostream &os);
+
+    /**
+     * Write the messages kept as text, as OstreamLogger would have
+     * written them.
+     */
+    void dumpText(std::ostream &os);
+
+    /**
+     * Write the messages kept to the file of the recorder.
+     *
+     * @param reason Why the messages are dumped.
+     */
+    void dumpFile(const std::string &reason);
+};
+
+/**
+ * Dump the messages of the debug logger if it is a flight recorder.
+ *
+ * @param reason Why the messages are dumped.
+ */
+void dumpFlightRecorder(const std::string &reason);
+
+} // namespace Trace
+} // namespace gem5
+
+#endif // __BASE_FLIGHT_RECORDER_HH__
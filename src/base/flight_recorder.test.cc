@@ -0,0 +1,146 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "base/cprintf.hh"
+#include "base/flight_recorder.hh"
+#include "base/gtest/cur_tick_fake.hh"
+#include "base/trace_reader.hh"
+
+using namespace gem5;
+
+// Instantiate the mock class to have a valid curTick of 0
+GTestTickHandler tickHandler;
+
+namespace
+{
+
+/** Decode the messages kept by a recorder. */
+std::string
+decode(Trace::FlightRecorder &recorder)
+{
+    std::stringstream trace;
+    recorder.dumpTrace(trace);
+
+    Trace::TraceReader reader(trace);
+    std::ostringstream os;
+    reader.decode(os);
+    EXPECT_TRUE(reader.valid()) << reader.error();
+    return os.str();
+}
+
+} // anonymous namespace
+
+/** Messages are kept until the recorder is full. */
+TEST(FlightRecorderTest, KeepAll)
+{
+    Trace::FlightRecorder recorder("unused", 4096, 256);
+    std::ostringstream expected;
+    Trace::OstreamLogger text_logger(expected);
+    for (Trace::Logger *logger : {(Trace::Logger *)&recorder,
+                                  (Trace::Logger *)&text_logger}) {
+        for (int i = 0; i < 10; i++)
+            logger->dprintf_flag(i, "obj", "Flag", "message %d\n", i);
+        logger->dump(10, "obj", "dump", 4, "Flag");
+        logger->getOstream() << "text\n";
+    }
+
+    EXPECT_EQ(decode(recorder), expected.str());
+}
+
+/**
+ * Once the recorder is full, the oldest messages are dropped and the
+ * most recent ones can still be decoded.
+ */
+TEST(FlightRecorderTest, DropOldest)
+{
+    Trace::FlightRecorder recorder("unused", 4096, 256);
+    for (int i = 0; i < 10000; i++) {
+        recorder.dprintf_flag(i, i % 2 ? "odd" : "even", "Flag",
+                              "message %d %s\n", i, "string");
+    }
+
+    const std::string text = decode(recorder);
+    std::istringstream lines(text);
+    std::vector<std::string> kept;
+    for (std::string line; std::getline(lines, line); )
+        kept.push_back(line + "\n");
+
+    // The records kept are bounded by the capacity and one chunk
+    ASSERT_GT(kept.size(), 100);
+    ASSERT_LT(kept.size(), 1000);
+
+    // The messages kept are the most recent ones, without gaps
+    const int first = 10000 - kept.size();
+    for (int i = 0; i < kept.size(); i++) {
+        const int n = first + i;
+        EXPECT_EQ(kept[i], csprintf("%7d: %s: message %d string\n", n,
+                                    n % 2 ? "odd" : "even", n));
+    }
+}
+
+/** The messages of all the threads are kept. */
+TEST(FlightRecorderTest, Threads)
+{
+    Trace::FlightRecorder recorder("unused", 1 << 20, 256);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&recorder, t]() {
+            const std::string name = "thread" + std::to_string(t);
+            for (int i = 0; i < 100; i++) {
+                recorder.dprintf_flag(i * 4 + t, name, "Flag",
+                                      "message %d\n", i);
+            }
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+
+    std::ostringstream expected;
+    for (int i = 0; i < 100; i++) {
+        for (int t = 0; t < 4; t++) {
+            ccprintf(expected, "%7d: thread%d: message %d\n",
+                     i * 4 + t, t, i);
+        }
+    }
+    EXPECT_EQ(decode(recorder), expected.str());
+}
+
+/** Messages can be dumped as text directly. */
+TEST(FlightRecorderTest, DumpText)
+{
+    Trace::FlightRecorder recorder("unused", 4096, 256);
+    recorder.dprintf_flag(1, "obj", "Flag", "message %#x\n", 10);
+
+    std::ostringstream os;
+    recorder.dumpText(os);
+    EXPECT_EQ(os.str(), "      1: obj: message 0xa\n");
+}
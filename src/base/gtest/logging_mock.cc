@@ -76,6 +76,12 @@ class GTestExitLogger : public Logger
 
 } // anonymous namespace
 
+void
+Logger::addExitHook(const std::function<void()> &hook)
+{
+    // Panics and fatal errors only throw an exception in tests
+}
+
 // We intentionally put all the loggers on the heap to prevent them from being
 // destructed at the end of the program. This make them safe to be used inside
 // destructor of other global objects. Also, we make them function static
@@ -42,6 +42,7 @@
 #define __BASE_LOGGING_HH__
 
 #include <cassert>
+#include <functional>
 #include <sstream>
 #include <utility>
 
@@ -70,6 +71,12 @@ class Logger
         NUM_LOG_LEVELS,
     };
 
+    /**
+     * Register a function called before a panic or a fatal error
+     * terminates the simulator, e.g. to save state helping to debug it.
+     */
+    static void addExitHook(const std::function<void()> &hook);
+
     static void
     setLevel(LogLevel ll)
     {
@@ -35,6 +35,8 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include "base/perf_event.hh"
+
 #include <fcntl.h>
 #include <sys/ioctl.h>
 #include <sys/mman.h>
@@ -49,12 +51,11 @@
 #include <cstring>
 
 #include "base/logging.hh"
-#include "perfevent.hh"
 
 namespace gem5
 {
 
-PerfKvmCounterConfig::PerfKvmCounterConfig(uint32_t type, uint64_t config)
+PerfCounterConfig::PerfCounterConfig(uint32_t type, uint64_t config)
 {
     memset(&attr, 0, sizeof(attr));
 
@@ -63,42 +64,42 @@ PerfKvmCounterConfig::PerfKvmCounterConfig(uint32_t type, uint64_t config)
     attr.config = config;
 }
 
-PerfKvmCounterConfig::~PerfKvmCounterConfig()
+PerfCounterConfig::~PerfCounterConfig()
 {
 }
 
 
-PerfKvmCounter::PerfKvmCounter(PerfKvmCounterConfig &config, pid_t tid)
+PerfCounter::PerfCounter(PerfCounterConfig &config, pid_t tid)
     : fd(-1), ringBuffer(NULL), pageSize(-1)
 {
     attach(config, tid, -1);
 }
 
-PerfKvmCounter::PerfKvmCounter(PerfKvmCounterConfig &config,
-                         pid_t tid, const PerfKvmCounter &parent)
+PerfCounter::PerfCounter(PerfCounterConfig &config,
+                         pid_t tid, const PerfCounter &parent)
     : fd(-1), ringBuffer(NULL), pageSize(-1)
 {
     attach(config, tid, parent);
 }
 
-PerfKvmCounter::PerfKvmCounter()
+PerfCounter::PerfCounter()
     : fd(-1), ringBuffer(NULL), pageSize(-1)
 {
 }
 
-PerfKvmCounter::~PerfKvmCounter()
+PerfCounter::~PerfCounter()
 {
     if (attached())
         detach();
 }
 
 void
-PerfKvmCounter::detach()
+PerfCounter::detach()
 {
     assert(attached());
 
     if (munmap(ringBuffer, ringNumPages * pageSize) == -1)
-        warn("PerfKvmCounter: Failed to unmap ring buffer (%i)\n",
+        warn("PerfCounter: Failed to unmap ring buffer (%i)\n",
              errno);
     close(fd);
 
@@ -107,35 +108,39 @@ PerfKvmCounter::detach()
 }
 
 void
-PerfKvmCounter::start()
+PerfCounter::start()
 {
     if (ioctl(PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP) == -1)
-        panic("KVM: Failed to enable performance counters (%i)\n", errno);
+        panic("PerfCounter: Failed to enable performance counters (%i)\n",
+              errno);
 }
 
 void
-PerfKvmCounter::stop()
+PerfCounter::stop()
 {
     if (ioctl(PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP) == -1)
-        panic("KVM: Failed to disable performance counters (%i)\n", errno);
+        panic("PerfCounter: Failed to disable performance counters (%i)\n",
+              errno);
 }
 
 void
-PerfKvmCounter::period(uint64_t period)
+PerfCounter::period(uint64_t period)
 {
     if (ioctl(PERF_EVENT_IOC_PERIOD, &period) == -1)
-        panic("KVM: Failed to set period of performance counter (%i)\n", errno);
+        panic("PerfCounter: Failed to set period of performance counter "
+              "(%i)\n", errno);
 }
 
 void
-PerfKvmCounter::refresh(int refresh)
+PerfCounter::refresh(int refresh)
 {
     if (ioctl(PERF_EVENT_IOC_REFRESH, refresh) == -1)
-        panic("KVM: Failed to refresh performance counter (%i)\n", errno);
+        panic("PerfCounter: Failed to refresh performance counter (%i)\n",
+              errno);
 }
 
 uint64_t
-PerfKvmCounter::read() const
+PerfCounter::read() const
 {
     uint64_t value;
 
@@ -144,7 +149,7 @@ PerfKvmCounter::read() const
 }
 
 void
-PerfKvmCounter::enableSignals(pid_t tid, int signal)
+PerfCounter::enableSignals(pid_t tid, int signal)
 {
     struct f_owner_ex sigowner;
 
@@ -154,46 +159,55 @@ PerfKvmCounter::enableSignals(pid_t tid, int signal)
     if (fcntl(F_SETOWN_EX, &sigowner) == -1 ||
         fcntl(F_SETSIG, signal) == -1 ||
         fcntl(F_SETFL, O_ASYNC) == -1)
-        panic("PerfKvmCounter: Failed to enable signals for counter (%i)\n",
+        panic("PerfCounter: Failed to enable signals for counter (%i)\n",
               errno);
 }
 
 void
-PerfKvmCounter::attach(PerfKvmCounterConfig &config,
+PerfCounter::attach(PerfCounterConfig &config,
                     pid_t tid, int group_fd)
 {
-    assert(!attached());
-
-    fd = syscall(__NR_perf_event_open,
-                 &config.attr, tid,
-                 -1, // CPU (-1 => Any CPU that the task happens to run on)
-                 group_fd,
-                 0); // Flags
-    if (fd == -1)
+    if (!tryAttach(config, tid, group_fd))
     {
         if (errno == EACCES)
         {
-            panic("PerfKvmCounter::attach recieved error EACCESS\n"
+            panic("PerfCounter::attach recieved error EACCESS\n"
             "  This error may be caused by a too restrictive setting\n"
             "  in the file '/proc/sys/kernel/perf_event_paranoid'\n"
             "  The default value was changed to 2 in kernel 4.6\n"
             "  A value greater than 1 prevents gem5 from making\n"
             "  the syscall to perf_event_open");
         }
-        panic("PerfKvmCounter::attach failed (%i)\n", errno);
+        panic("PerfCounter::attach failed (%i)\n", errno);
     }
+}
+
+bool
+PerfCounter::tryAttach(PerfCounterConfig &config,
+                       pid_t tid, int group_fd)
+{
+    assert(!attached());
+
+    fd = syscall(__NR_perf_event_open,
+                 &config.attr, tid,
+                 -1, // CPU (-1 => Any CPU that the task happens to run on)
+                 group_fd,
+                 0); // Flags
+    if (fd == -1)
+        return false;
 
     mmapPerf(1);
+    return true;
 }
 
 pid_t
-PerfKvmCounter::sysGettid()
+PerfCounter::sysGettid()
 {
     return syscall(__NR_gettid);
 }
 
 void
-PerfKvmCounter::mmapPerf(int pages)
+PerfCounter::mmapPerf(int pages)
 {
     assert(attached());
     assert(ringBuffer == NULL);
@@ -201,7 +215,7 @@ PerfKvmCounter::mmapPerf(int pages)
     if (pageSize == -1) {
         pageSize = sysconf(_SC_PAGE_SIZE);
         if (pageSize == -1)
-            panic("PerfKvmCounter: Failed to determine page size (%i)\n",
+            panic("PerfCounter: Failed to determine page size (%i)\n",
                   errno);
     }
 
@@ -211,26 +225,26 @@ PerfKvmCounter::mmapPerf(int pages)
         PROT_READ | PROT_WRITE, MAP_SHARED,
         fd, 0);
     if (ringBuffer == MAP_FAILED)
-        panic("PerfKvmCounter: MMAP failed (%i)\n",
+        panic("PerfCounter: MMAP failed (%i)\n",
               errno);
 }
 
 int
-PerfKvmCounter::fcntl(int cmd, long p1)
+PerfCounter::fcntl(int cmd, long p1)
 {
     assert(attached());
     return ::fcntl(fd, cmd, p1);
 }
 
 int
-PerfKvmCounter::ioctl(int request, long p1)
+PerfCounter::ioctl(int request, long p1)
 {
     assert(attached());
     return ::ioctl(fd, request, p1);
 }
 
 void
-PerfKvmCounter::read(void *buf, size_t size) const
+PerfCounter::read(void *buf, size_t size) const
 {
     char *_buf = (char *)buf;
     size_t _size = size;
@@ -243,11 +257,11 @@ PerfKvmCounter::read(void *buf, size_t size) const
         switch (ret) {
           case -1:
             if (errno != EAGAIN)
-                panic("PerfKvmCounter::read failed (%i)\n", errno);
+                panic("PerfCounter::read failed (%i)\n", errno);
             break;
 
           case 0:
-            panic("PerfKvmCounter::read unexpected EOF.\n");
+            panic("PerfCounter::read unexpected EOF.\n");
 
           default:
             _size -= ret;
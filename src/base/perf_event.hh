@@ -35,8 +35,8 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
-#ifndef __CPU_KVM_PERFEVENT_HH__
-#define __CPU_KVM_PERFEVENT_HH__
+#ifndef __BASE_PERF_EVENT_HH__
+#define __BASE_PERF_EVENT_HH__
 
 #include <linux/perf_event.h>
 #include <sys/types.h>
@@ -51,7 +51,7 @@ namespace gem5
 /**
  * PerfEvent counter configuration.
  */
-class PerfKvmCounterConfig
+class PerfCounterConfig
 {
   public:
     /**
@@ -74,8 +74,8 @@ class PerfKvmCounterConfig
      * @param type Counter type.
      * @param config Counter configuration
      */
-    PerfKvmCounterConfig(uint32_t type, uint64_t config);
-    ~PerfKvmCounterConfig();
+    PerfCounterConfig(uint32_t type, uint64_t config);
+    ~PerfCounterConfig();
 
     /**
      * Set the initial sample period (overflow count) of an event. If
@@ -85,7 +85,7 @@ class PerfKvmCounterConfig
      * @param period Number of counter events before the counter
      * overflows
      */
-    PerfKvmCounterConfig &samplePeriod(uint64_t period) {
+    PerfCounterConfig &samplePeriod(uint64_t period) {
         attr.freq = 0;
         attr.sample_period = period;
         return *this;
@@ -98,7 +98,7 @@ class PerfKvmCounterConfig
      *
      * @param events Number of overflows before signaling a wake up
      */
-    PerfKvmCounterConfig &wakeupEvents(uint32_t events) {
+    PerfCounterConfig &wakeupEvents(uint32_t events) {
         attr.watermark = 0;
         attr.wakeup_events = events;
         return *this;
@@ -110,7 +110,7 @@ class PerfKvmCounterConfig
      *
      * @param val true to disable, false to enable the counter
      */
-    PerfKvmCounterConfig &disabled(bool val) {
+    PerfCounterConfig &disabled(bool val) {
         attr.disabled = val;
         return *this;
     }
@@ -123,7 +123,7 @@ class PerfKvmCounterConfig
      *
      * @param val true to pin the counter
      */
-    PerfKvmCounterConfig &pinned(bool val) {
+    PerfCounterConfig &pinned(bool val) {
         attr.pinned = val;
         return *this;
     }
@@ -141,7 +141,7 @@ class PerfKvmCounterConfig
      *
      * @param val true to exclude host events
      */
-    PerfKvmCounterConfig &exclude_host(bool val) {
+    PerfCounterConfig &exclude_host(bool val) {
 #if HAVE_PERF_ATTR_EXCLUDE_HOST == 1
         attr.exclude_host = val;
 #endif
@@ -156,11 +156,22 @@ class PerfKvmCounterConfig
      *
      * @param val true to exclude host events
      */
-    PerfKvmCounterConfig &exclude_hv(bool val) {
+    PerfCounterConfig &exclude_hv(bool val) {
         attr.exclude_hv = val;
         return *this;
     }
 
+    /**
+     * Exclude the events from the kernel, which unprivileged users
+     * are often not allowed to count.
+     *
+     * @param val true to exclude kernel events
+     */
+    PerfCounterConfig &exclude_kernel(bool val) {
+        attr.exclude_kernel = val;
+        return *this;
+    }
+
     /** Underlying perf_event_attr structure describing the counter */
     struct perf_event_attr attr;
 };
@@ -168,7 +179,7 @@ class PerfKvmCounterConfig
 /**
  * An instance of a performance counter.
  */
-class PerfKvmCounter
+class PerfCounter
 {
 public:
     /**
@@ -177,7 +188,7 @@ public:
      * @param config Counter configuration
      * @param tid Thread to sample (0 indicates current thread)
      */
-    PerfKvmCounter(PerfKvmCounterConfig &config, pid_t tid);
+    PerfCounter(PerfCounterConfig &config, pid_t tid);
     /**
      * Create and attach a new counter and make it a member of an
      * exist counter group.
@@ -186,13 +197,13 @@ public:
      * @param tid Thread to sample (0 indicates current thread)
      * @param parent Group leader
      */
-    PerfKvmCounter(PerfKvmCounterConfig &config,
-                pid_t tid, const PerfKvmCounter &parent);
+    PerfCounter(PerfCounterConfig &config,
+                pid_t tid, const PerfCounter &parent);
     /**
      * Create a new counter, but don't attach it.
      */
-    PerfKvmCounter();
-    ~PerfKvmCounter();
+    PerfCounter();
+    ~PerfCounter();
 
 
     /**
@@ -204,7 +215,7 @@ public:
      * @param config Counter configuration
      * @param tid Thread to sample (0 indicates current thread)
      */
-    void attach(PerfKvmCounterConfig &config, pid_t tid) {
+    void attach(PerfCounterConfig &config, pid_t tid) {
         attach(config, tid, -1);
     }
 
@@ -219,11 +230,28 @@ public:
      * @param tid Thread to sample (0 indicates current thread)
      * @param parent Group leader
      */
-    void attach(PerfKvmCounterConfig &config,
-                pid_t tid, const PerfKvmCounter &parent) {
+    void attach(PerfCounterConfig &config,
+                pid_t tid, const PerfCounter &parent) {
         attach(config, tid, parent.fd);
     }
 
+    /**
+     * Try to attach a counter, which may be refused by the host, e.g.,
+     * when the kernel restricts the use of PerfEvent or the host CPU
+     * lacks the requested event.
+     *
+     * @note This operation is only supported if the counter isn't
+     * already attached.
+     *
+     * @param config Counter configuration
+     * @param tid Thread to sample (0 indicates current thread)
+     * @return True if the counter was attached, false otherwise, with
+     * the error number in errno.
+     */
+    bool tryAttach(PerfCounterConfig &config, pid_t tid) {
+        return tryAttach(config, tid, -1);
+    }
+
     /** Detach a counter from PerfEvent. */
     void detach();
 
@@ -302,11 +330,12 @@ public:
 
 private:
     // Disallow copying
-    PerfKvmCounter(const PerfKvmCounter &that);
+    PerfCounter(const PerfCounter &that);
     // Disallow assignment
-    PerfKvmCounter &operator=(const PerfKvmCounter &that);
+    PerfCounter &operator=(const PerfCounter &that);
 
-    void attach(PerfKvmCounterConfig &config, pid_t tid, int group_fd);
+    void attach(PerfCounterConfig &config, pid_t tid, int group_fd);
+    bool tryAttach(PerfCounterConfig &config, pid_t tid, int group_fd);
 
     /**
      * Get the TID of the current thread.
@@ -383,4 +412,4 @@ private:
 
 } // namespace gem5
 
-#endif
+#endif // __BASE_PERF_EVENT_HH__
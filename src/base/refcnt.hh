@@ -97,6 +97,9 @@ class RefCounted
     /// Increment the reference count
     void incref() const { ++count; }
 
+    /// Get the number of references currently held to the object
+    int getCount() const { return count; }
+
     /// Decrement the reference count and destroy the object if all
     /// references are gone.
     void
@@ -564,6 +564,8 @@ class ScalarBase : public DataWrap<Derived, ScalarInfoProxy>
         this->doInit();
     }
 
+    ~ScalarBase() { data()->~Storage(); }
+
   public:
     // Common operators for stats
     /**
@@ -1315,6 +1317,12 @@ class DistBase : public DataWrap<Derived, DistInfoProxy>
     {
     }
 
+    ~DistBase()
+    {
+        if (this->info()->flags.isSet(init))
+            data()->~Storage();
+    }
+
     /**
      * Add a value to the distribtion n times. Calls sample on the storage
      * class.
@@ -2116,6 +2124,142 @@ class Distribution : public DistBase<Distribution, DistStor>
     }
 };
 
+/**
+ * A scalar stat that can be updated by several event queues running in
+ * parallel. Each simulation thread updates its own shard of the stat,
+ * and the shards are summed when the stat is read.
+ * @sa Stat, ScalarBase, ShardedStatStor
+ */
+class ShardedScalar : public ScalarBase<ShardedScalar, ShardedStatStor>
+{
+  public:
+    using ScalarBase<ShardedScalar, ShardedStatStor>::operator=;
+
+    ShardedScalar(Group *parent = nullptr)
+        : ScalarBase<ShardedScalar, ShardedStatStor>(
+                parent, nullptr, units::Unspecified::get(), nullptr)
+    {
+    }
+
+    ShardedScalar(Group *parent, const char *name,
+                  const char *desc = nullptr)
+        : ScalarBase<ShardedScalar, ShardedStatStor>(
+                parent, name, units::Unspecified::get(), desc)
+    {
+    }
+
+    ShardedScalar(Group *parent, const char *name, const units::Base *unit,
+                  const char *desc = nullptr)
+        : ScalarBase<ShardedScalar, ShardedStatStor>(parent, name, unit, desc)
+    {
+    }
+};
+
+/**
+ * A vector of scalar stats that can be updated by several event queues
+ * running in parallel.
+ * @sa Stat, VectorBase, ShardedStatStor
+ */
+class ShardedVector : public VectorBase<ShardedVector, ShardedStatStor>
+{
+  public:
+    ShardedVector(Group *parent = nullptr)
+        : VectorBase<ShardedVector, ShardedStatStor>(
+                parent, nullptr, units::Unspecified::get(), nullptr)
+    {
+    }
+
+    ShardedVector(Group *parent, const char *name,
+                  const char *desc = nullptr)
+        : VectorBase<ShardedVector, ShardedStatStor>(
+                parent, name, units::Unspecified::get(), desc)
+    {
+    }
+
+    ShardedVector(Group *parent, const char *name, const units::Base *unit,
+                  const char *desc = nullptr)
+        : VectorBase<ShardedVector, ShardedStatStor>(parent, name, unit, desc)
+    {
+    }
+};
+
+/**
+ * A 2-Dimensional vector of scalar stats that can be updated by several
+ * event queues running in parallel.
+ * @sa Stat, Vector2dBase, ShardedStatStor
+ */
+class ShardedVector2d : public Vector2dBase<ShardedVector2d, ShardedStatStor>
+{
+  public:
+    ShardedVector2d(Group *parent = nullptr)
+        : Vector2dBase<ShardedVector2d, ShardedStatStor>(
+                parent, nullptr, units::Unspecified::get(), nullptr)
+    {
+    }
+
+    ShardedVector2d(Group *parent, const char *name,
+                    const char *desc = nullptr)
+        : Vector2dBase<ShardedVector2d, ShardedStatStor>(
+                parent, name, units::Unspecified::get(), desc)
+    {
+    }
+
+    ShardedVector2d(Group *parent, const char *name,
+                    const units::Base *unit, const char *desc = nullptr)
+        : Vector2dBase<ShardedVector2d, ShardedStatStor>(
+                parent, name, unit, desc)
+    {
+    }
+};
+
+/**
+ * A simple distribution stat that can be sampled by several event
+ * queues running in parallel. Each simulation thread samples its own
+ * copy of the distribution, and the copies are merged when the stat is
+ * dumped.
+ * @sa Stat, DistBase, ShardedDistStor
+ */
+class ShardedDistribution
+    : public DistBase<ShardedDistribution, ShardedDistStor>
+{
+  public:
+    ShardedDistribution(Group *parent = nullptr)
+        : DistBase<ShardedDistribution, ShardedDistStor>(
+                parent, nullptr, units::Unspecified::get(), nullptr)
+    {
+    }
+
+    ShardedDistribution(Group *parent, const char *name,
+                        const char *desc = nullptr)
+        : DistBase<ShardedDistribution, ShardedDistStor>(
+                parent, name, units::Unspecified::get(), desc)
+    {
+    }
+
+    ShardedDistribution(Group *parent, const char *name,
+                        const units::Base *unit, const char *desc = nullptr)
+        : DistBase<ShardedDistribution, ShardedDistStor>(
+                parent, name, unit, desc)
+    {
+    }
+
+    /**
+     * Set the parameters of this distribution. @sa DistStor::Params
+     * @param min The minimum value of the distribution.
+     * @param max The maximum value of the distribution.
+     * @param bkt The number of values in each bucket.
+     * @return A reference to this distribution.
+     */
+    ShardedDistribution &
+    init(Counter min, Counter max, Counter bkt)
+    {
+        DistStor::Params *params = new DistStor::Params(min, max, bkt);
+        this->setParams(params);
+        this->doInit();
+        return this->self();
+    }
+};
+
 /**
  * A simple histogram stat.
  * @sa Stat, DistBase, HistStor
@@ -2697,6 +2841,14 @@ class Temp
         : node(new ScalarStatNode(s.info()))
     { }
 
+    /**
+     * Create a new ScalarStatNode.
+     * @param s The ScalarStat to place in a node.
+     */
+    Temp(const ShardedScalar &s)
+        : node(new ScalarStatNode(s.info()))
+    { }
+
     /**
      * Create a new VectorStatNode.
      * @param s The VectorStat to place in a node.
@@ -2709,6 +2861,10 @@ class Temp
         : node(new VectorStatNode(s.info()))
     { }
 
+    Temp(const ShardedVector &s)
+        : node(new VectorStatNode(s.info()))
+    { }
+
     /**
      *
      */
@@ -0,0 +1,363 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/stats/binary.hh"
+
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+#include "base/logging.hh"
+#include "base/output.hh"
+#include "base/stats/info.hh"
+#include "sim/cur_tick.hh"
+
+namespace gem5
+{
+
+GEM5_DEPRECATED_NAMESPACE(Stats, statistics);
+namespace statistics
+{
+
+namespace
+{
+
+/**
+ * Check if a value can be encoded as an integer delta without losing
+ * any information.
+ */
+bool
+isExactInteger(double value)
+{
+    return std::trunc(value) == value && std::fabs(value) < 0x1p53 &&
+        !(value == 0 && std::signbit(value));
+}
+
+std::vector<std::string>
+labels(const std::vector<std::string> &names, size_t size)
+{
+    std::vector<std::string> result(size);
+    for (size_t i = 0; i < size; i++) {
+        if (i < names.size() && !names[i].empty())
+            result[i] = names[i];
+        else
+            result[i] = std::to_string(i);
+    }
+    return result;
+}
+
+} // anonymous namespace
+
+constexpr char Binary::magic[8];
+
+Binary::Binary(std::ostream &_stream)
+    : stream(_stream), collecting(true)
+{
+    char header_version[4];
+    for (int i = 0; i < 4; i++)
+        header_version[i] = (char)(version >> (8 * i));
+    stream.write(magic, sizeof(magic));
+    stream.write(header_version, sizeof(header_version));
+}
+
+void
+Binary::begin()
+{
+    values.clear();
+}
+
+void
+Binary::end()
+{
+    assert(path.empty());
+
+    if (collecting) {
+        record.clear();
+        putVarint(schema.size());
+        for (const auto &column : schema) {
+            putString(column.name);
+            putString(column.unit);
+            putString(column.desc);
+            record.push_back(column.kind);
+            putVarint(column.rows);
+            putVarint(column.cols);
+            putVarint(column.rowLabels.size());
+            for (const auto &label : column.rowLabels)
+                putString(label);
+            putVarint(column.colLabels.size());
+            for (const auto &label : column.colLabels)
+                putString(label);
+        }
+        writeRecord(SCHEMA);
+
+        // The first dump is encoded against zeros
+        previous.assign(values.size(), 0.0);
+        collecting = false;
+    }
+
+    panic_if(values.size() != previous.size(),
+             "Binary stats dump has %d values rather than %d.\n",
+             values.size(), previous.size());
+
+    // Encode the changed values first, as their number precedes them
+    record.clear();
+    uint64_t num_changes = 0;
+    size_t next = 0;
+    for (size_t i = 0; i < values.size(); i++) {
+        const double value = values[i];
+        const double old = previous[i];
+        if (std::memcmp(&value, &old, sizeof(value)) == 0)
+            continue;
+
+        const uint64_t gap = i - next;
+        next = i + 1;
+        num_changes++;
+        if (isExactInteger(value) && isExactInteger(old)) {
+            const int64_t delta = (int64_t)value - (int64_t)old;
+            putVarint(gap << 1);
+            putVarint(((uint64_t)delta << 1) ^ (uint64_t)(delta >> 63));
+        } else {
+            putVarint((gap << 1) | 1);
+            putDouble(value);
+        }
+    }
+
+    std::string changes;
+    changes.swap(record);
+    putU64(curTick());
+    putVarint(num_changes);
+    record.append(changes);
+    writeRecord(DUMP);
+    stream.flush();
+
+    previous.swap(values);
+}
+
+bool
+Binary::valid() const
+{
+    return stream.good();
+}
+
+void
+Binary::beginGroup(const char *name)
+{
+    if (path.empty())
+        path.push(name);
+    else
+        path.push(path.top() + "." + name);
+}
+
+void
+Binary::endGroup()
+{
+    assert(!path.empty());
+    path.pop();
+}
+
+std::string
+Binary::statName(const std::string &name) const
+{
+    if (path.empty())
+        return name;
+    else
+        return path.top() + "." + name;
+}
+
+bool
+Binary::addColumn(const Info &info, Kind kind, uint64_t rows, uint64_t cols,
+                  const std::vector<std::string> &row_labels,
+                  const std::vector<std::string> &col_labels)
+{
+    if (!info.flags.isSet(display))
+        return false;
+
+    if (collecting) {
+        schema.push_back({statName(info.name), info.unit->getUnitString(),
+                          info.desc, kind, rows, cols, row_labels,
+                          col_labels});
+    }
+    return true;
+}
+
+void
+Binary::visit(const ScalarInfo &info)
+{
+    if (!addColumn(info, SCALAR, 1, 1, {}, {}))
+        return;
+
+    values.push_back(info.result());
+}
+
+void
+Binary::visit(const VectorInfo &info)
+{
+    const auto &result = info.result();
+    if (!addColumn(info, VECTOR, 1, result.size(), {},
+                   labels(info.subnames, result.size()))) {
+        return;
+    }
+
+    values.insert(values.end(), result.begin(), result.end());
+}
+
+std::vector<std::string>
+Binary::distLabels(const DistData &data)
+{
+    std::vector<std::string> result = {
+        "samples", "sum", "squares", "min_value", "max_value",
+        "underflows", "overflows", "bucket_min", "bucket_size"
+    };
+    for (size_t i = 0; i < data.cvec.size(); i++)
+        result.push_back(std::to_string(i));
+    return result;
+}
+
+void
+Binary::appendDist(const DistData &data)
+{
+    values.push_back(data.samples);
+    values.push_back(data.sum);
+    values.push_back(data.squares);
+    values.push_back(data.min_val);
+    values.push_back(data.max_val);
+    values.push_back(data.underflow);
+    values.push_back(data.overflow);
+    values.push_back(data.min);
+    values.push_back(data.bucket_size);
+    values.insert(values.end(), data.cvec.begin(), data.cvec.end());
+}
+
+void
+Binary::visit(const DistInfo &info)
+{
+    const auto col_labels = distLabels(info.data);
+    if (!addColumn(info, DIST, 1, col_labels.size(), {}, col_labels))
+        return;
+
+    appendDist(info.data);
+}
+
+void
+Binary::visit(const VectorDistInfo &info)
+{
+    const size_t size = info.size();
+    const auto col_labels = size ? distLabels(info.data[0]) :
+        std::vector<std::string>();
+    if (!addColumn(info, VECTOR_DIST, size, col_labels.size(),
+                   labels(info.subnames, size), col_labels)) {
+        return;
+    }
+
+    for (size_t i = 0; i < size; i++)
+        appendDist(info.data[i]);
+}
+
+void
+Binary::visit(const Vector2dInfo &info)
+{
+    if (!addColumn(info, VECTOR_2D, info.x, info.y,
+                   labels(info.subnames, info.x),
+                   labels(info.y_subnames, info.y))) {
+        return;
+    }
+
+    values.insert(values.end(), info.cvec.begin(), info.cvec.end());
+}
+
+void
+Binary::visit(const FormulaInfo &info)
+{
+    const auto &result = info.result();
+    if (!addColumn(info, FORMULA, 1, result.size(), {},
+                   labels(info.subnames, result.size()))) {
+        return;
+    }
+
+    values.insert(values.end(), result.begin(), result.end());
+}
+
+void
+Binary::visit(const SparseHistInfo &info)
+{
+    // The buckets of sparse histograms change from dump to dump, which
+    // does not fit a fixed schema
+}
+
+void
+Binary::writeRecord(Tag tag)
+{
+    char header[9];
+    header[0] = tag;
+    const uint64_t length = record.size();
+    for (int i = 0; i < 8; i++)
+        header[1 + i] = (char)(length >> (8 * i));
+    stream.write(header, sizeof(header));
+    stream.write(record.data(), record.size());
+}
+
+void
+Binary::putVarint(uint64_t value)
+{
+    while (value >= 0x80) {
+        record.push_back((char)(value | 0x80));
+        value >>= 7;
+    }
+    record.push_back((char)value);
+}
+
+void
+Binary::putString(const std::string &str)
+{
+    putVarint(str.size());
+    record.append(str);
+}
+
+void
+Binary::putU64(uint64_t value)
+{
+    for (int i = 0; i < 8; i++)
+        record.push_back((char)(value >> (8 * i)));
+}
+
+void
+Binary::putDouble(double value)
+{
+    uint64_t bits;
+    static_assert(sizeof(bits) == sizeof(value), "Unexpected double size");
+    std::memcpy(&bits, &value, sizeof(bits));
+    putU64(bits);
+}
+
+std::unique_ptr<Output>
+initBinary(const std::string &filename)
+{
+    // The stream is owned by the output directory and closed on exit
+    OutputStream *os = simout.create(filename, true);
+    return std::unique_ptr<Output>(new Binary(*os->stream()));
+}
+
+} // namespace statistics
+} // namespace gem5
@@ -0,0 +1,208 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * A statistics output writing a compact, append-only binary time series.
+ *
+ * The file starts with a header made of the magic number "gem5STB\0" and
+ * a 32-bit version, followed by records. Each record is made of an 8-bit
+ * tag and a 64-bit payload length, so that readers can skip records
+ * they are not interested in, followed by the payload. All fixed size
+ * integers are little endian, and variable length integers use the
+ * LEB128 encoding.
+ *
+ * The first record describes the schema of the dumps: for each stat its
+ * name, unit, description, kind, number of rows and columns, and the
+ * labels of its rows and columns. The values of all the stats, flattened
+ * in row major order, form a single array of doubles.
+ *
+ * The buckets of a distribution are labelled by their index, as their
+ * range may change between dumps, e.g., when a histogram grows. Every
+ * dump holds the lower bound of the first bucket and the size of the
+ * buckets as values of the distribution, from which the range of each
+ * bucket is computed.
+ *
+ * Every dump then appends a record holding its tick and the elements of
+ * the array that changed since the previous dump. Each change starts
+ * with a varint holding the distance from the previous change shifted
+ * left by one, with the low bit set if the value is stored as a raw
+ * double rather than as a zigzag-encoded integer delta. The first dump
+ * is encoded against an array of zeros.
+ */
+
+#ifndef __BASE_STATS_BINARY_HH__
+#define __BASE_STATS_BINARY_HH__
+
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <stack>
+#include <string>
+#include <vector>
+
+#include "base/compiler.hh"
+#include "base/stats/output.hh"
+#include "base/stats/types.hh"
+#include "base/types.hh"
+
+namespace gem5
+{
+
+GEM5_DEPRECATED_NAMESPACE(Stats, statistics);
+namespace statistics
+{
+
+class Binary : public Output
+{
+  public:
+    /** Magic number at the start of a binary stats file. */
+    static constexpr char magic[8] =
+        { 'g', 'e', 'm', '5', 'S', 'T', 'B', '\0' };
+
+    /** Version of the format. */
+    static constexpr uint32_t version = 2;
+
+    /** Record tags. */
+    enum Tag : uint8_t
+    {
+        SCHEMA = 1,
+        DUMP = 2
+    };
+
+    /** Kinds of stats, as recorded in the schema. */
+    enum Kind : uint8_t
+    {
+        SCALAR = 0,
+        VECTOR = 1,
+        DIST = 2,
+        VECTOR_DIST = 3,
+        VECTOR_2D = 4,
+        FORMULA = 5
+    };
+
+    /**
+     * @param stream Stream to write to, which must outlive the output.
+     */
+    Binary(std::ostream &stream);
+
+    Binary() = delete;
+    Binary(const Binary &other) = delete;
+
+  public: // Output interface
+    void begin() override;
+    void end() override;
+    bool valid() const override;
+
+    void beginGroup(const char *name) override;
+    void endGroup() override;
+
+    void visit(const ScalarInfo &info) override;
+    void visit(const VectorInfo &info) override;
+    void visit(const DistInfo &info) override;
+    void visit(const VectorDistInfo &info) override;
+    void visit(const Vector2dInfo &info) override;
+    void visit(const FormulaInfo &info) override;
+    void visit(const SparseHistInfo &info) override;
+
+  protected:
+    /** Description of a stat in the schema. */
+    struct Column
+    {
+        std::string name;
+        std::string unit;
+        std::string desc;
+        Kind kind;
+        uint64_t rows;
+        uint64_t cols;
+        std::vector<std::string> rowLabels;
+        std::vector<std::string> colLabels;
+    };
+
+    std::ostream &stream;
+
+    /** Names of the groups being visited. */
+    std::stack<std::string> path;
+
+    /** Is the schema being collected, i.e., is this the first dump? */
+    bool collecting;
+
+    /** Schema collected during the first dump. */
+    std::vector<Column> schema;
+
+    /** Values of the current dump. */
+    std::vector<double> values;
+
+    /** Values of the previous dump. */
+    std::vector<double> previous;
+
+    /** Buffer used to build a record before writing it. */
+    std::string record;
+
+    /** @return The name of a stat, including the path of its group. */
+    std::string statName(const std::string &name) const;
+
+    /**
+     * Add a stat to the schema, if it is being collected.
+     *
+     * @return True if the stat is dumped.
+     */
+    bool addColumn(const Info &info, Kind kind, uint64_t rows, uint64_t cols,
+                   const std::vector<std::string> &row_labels,
+                   const std::vector<std::string> &col_labels);
+
+    /**
+     * @return The labels of the columns used for a distribution. Only
+     * the number of buckets is taken from the data, as it is the same in
+     * every dump.
+     */
+    static std::vector<std::string> distLabels(const DistData &data);
+
+    /** Append the flattened values of a distribution. */
+    void appendDist(const DistData &data);
+
+    /** Write a record made of a tag and the contents of the buffer. */
+    void writeRecord(Tag tag);
+
+    /** @{ */
+    /** Append an encoded value to the record buffer. */
+    void putVarint(uint64_t value);
+    void putString(const std::string &str);
+    void putU64(uint64_t value);
+    void putDouble(double value);
+    /** @} */
+};
+
+/**
+ * Create a binary stats output.
+ *
+ * @param filename Name of the file, in the output directory.
+ */
+std::unique_ptr<Output> initBinary(const std::string &filename);
+
+} // namespace statistics
+} // namespace gem5
+
+#endif // __BASE_STATS_BINARY_HH__
@@ -0,0 +1,367 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "base/gtest/cur_tick_fake.hh"
+#include "base/stats/binary.hh"
+#include "base/stats/info.hh"
+#include "base/stats/storage.hh"
+#include "base/stats/units.hh"
+
+using namespace gem5;
+
+// Instantiate the fake class to have a valid curTick of 0
+GTestTickHandler tickHandler;
+
+namespace
+{
+
+class DummyScalarInfo : public statistics::ScalarInfo
+{
+  public:
+    double val = 0;
+
+    bool check() const override { return true; }
+    void prepare() override {}
+    void reset() override { val = 0; }
+    bool zero() const override { return val == 0; }
+    void visit(statistics::Output &visitor) override { visitor.visit(*this); }
+
+    statistics::Counter value() const override { return val; }
+    statistics::Result result() const override { return val; }
+    statistics::Result total() const override { return val; }
+};
+
+class DummyVectorInfo : public statistics::VectorInfo
+{
+  public:
+    statistics::VCounter vals;
+    statistics::VResult results;
+
+    bool check() const override { return true; }
+    void prepare() override {}
+    void reset() override {}
+    bool zero() const override { return false; }
+    void visit(statistics::Output &visitor) override { visitor.visit(*this); }
+
+    statistics::size_type size() const override { return vals.size(); }
+    const statistics::VCounter &value() const override { return vals; }
+
+    const statistics::VResult &
+    result() const override
+    {
+        return results;
+    }
+
+    statistics::Result total() const override { return 0; }
+};
+
+class DummyDistInfo : public statistics::DistInfo
+{
+  public:
+    bool check() const override { return true; }
+    void prepare() override {}
+    void reset() override {}
+    bool zero() const override { return false; }
+    void visit(statistics::Output &visitor) override { visitor.visit(*this); }
+};
+
+/** A minimal decoder of the records of a binary stats file. */
+class Decoder
+{
+  public:
+    std::string data;
+    size_t pos = 0;
+
+    uint64_t
+    varint()
+    {
+        uint64_t value = 0;
+        for (int shift = 0; ; shift += 7) {
+            uint8_t byte = data.at(pos++);
+            value |= uint64_t(byte & 0x7f) << shift;
+            if (byte < 0x80)
+                return value;
+        }
+    }
+
+    uint64_t
+    u64()
+    {
+        uint64_t value = 0;
+        for (int i = 0; i < 8; i++)
+            value |= uint64_t((uint8_t)data.at(pos++)) << (8 * i);
+        return value;
+    }
+
+    std::string
+    string()
+    {
+        size_t length = varint();
+        std::string str = data.substr(pos, length);
+        pos += length;
+        return str;
+    }
+
+    double
+    rawDouble()
+    {
+        uint64_t bits = u64();
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    /**
+     * Decode the changes of a dump record into the values of the
+     * previous dump.
+     */
+    void
+    dump(std::vector<double> &values)
+    {
+        u64();
+        const uint64_t num_changes = varint();
+        size_t index = 0;
+        for (uint64_t i = 0; i < num_changes; i++) {
+            const uint64_t code = varint();
+            index += code >> 1;
+            ASSERT_LT(index, values.size());
+            if (code & 1) {
+                values[index] = rawDouble();
+            } else {
+                const uint64_t zigzag = varint();
+                const int64_t delta =
+                    (int64_t)(zigzag >> 1) ^ -(int64_t)(zigzag & 1);
+                values[index] = (int64_t)values[index] + delta;
+            }
+            index++;
+        }
+    }
+
+    /** Read a record header and check its tag and length. */
+    void
+    record(uint8_t tag)
+    {
+        ASSERT_EQ((uint8_t)data.at(pos++), tag);
+        uint64_t length = u64();
+        ASSERT_LE(pos + length, data.size());
+    }
+};
+
+void
+dump(statistics::Output &output, DummyScalarInfo &scalar,
+     DummyVectorInfo &vector, DummyScalarInfo &hidden)
+{
+    output.begin();
+    output.beginGroup("system");
+    scalar.visit(output);
+    hidden.visit(output);
+    output.beginGroup("cpu");
+    vector.visit(output);
+    output.endGroup();
+    output.endGroup();
+    output.end();
+}
+
+} // anonymous namespace
+
+TEST(StatsBinaryTest, SchemaAndDeltas)
+{
+    DummyScalarInfo scalar;
+    scalar.setName("scalar");
+    scalar.desc = "A scalar";
+    scalar.unit = statistics::units::Count::get();
+    scalar.flags.set(statistics::display);
+
+    DummyVectorInfo vector;
+    vector.setName("vector");
+    vector.flags.set(statistics::display);
+    vector.subnames = {"first", ""};
+    vector.vals = {0, 0};
+
+    // Stats without the display flag are not dumped
+    DummyScalarInfo hidden;
+    hidden.setName("hidden");
+
+    std::ostringstream stream;
+    statistics::Binary output(stream);
+
+    scalar.val = 5;
+    vector.results = {1, 2};
+    dump(output, scalar, vector, hidden);
+
+    tickHandler.setCurTick(1000);
+    scalar.val = 5;
+    vector.results = {1, 2.5};
+    dump(output, scalar, vector, hidden);
+
+    tickHandler.setCurTick(2000);
+    scalar.val = 3;
+    vector.results = {1, 2.5};
+    dump(output, scalar, vector, hidden);
+
+    Decoder dec;
+    dec.data = stream.str();
+    ASSERT_EQ(dec.data.substr(0, 8), std::string("gem5STB\0", 8));
+    dec.pos = 8;
+    ASSERT_EQ(dec.u64() & 0xffffffff, statistics::Binary::version);
+    dec.pos = 12;
+
+    dec.record(statistics::Binary::SCHEMA);
+    ASSERT_EQ(dec.varint(), 2);
+    EXPECT_EQ(dec.string(), "system.scalar");
+    EXPECT_EQ(dec.string(), "Count");
+    EXPECT_EQ(dec.string(), "A scalar");
+    EXPECT_EQ((uint8_t)dec.data.at(dec.pos++), statistics::Binary::SCALAR);
+    EXPECT_EQ(dec.varint(), 1);
+    EXPECT_EQ(dec.varint(), 1);
+    EXPECT_EQ(dec.varint(), 0);
+    EXPECT_EQ(dec.varint(), 0);
+
+    EXPECT_EQ(dec.string(), "system.cpu.vector");
+    dec.string();
+    dec.string();
+    EXPECT_EQ((uint8_t)dec.data.at(dec.pos++), statistics::Binary::VECTOR);
+    EXPECT_EQ(dec.varint(), 1);
+    EXPECT_EQ(dec.varint(), 2);
+    EXPECT_EQ(dec.varint(), 0);
+    ASSERT_EQ(dec.varint(), 2);
+    EXPECT_EQ(dec.string(), "first");
+    EXPECT_EQ(dec.string(), "1");
+
+    // The first dump holds all the non-zero values as integer deltas
+    dec.record(statistics::Binary::DUMP);
+    EXPECT_EQ(dec.u64(), 0);
+    ASSERT_EQ(dec.varint(), 3);
+    EXPECT_EQ(dec.varint(), 0 << 1);
+    EXPECT_EQ(dec.varint(), 5 << 1);
+    EXPECT_EQ(dec.varint(), 0 << 1);
+    EXPECT_EQ(dec.varint(), 1 << 1);
+    EXPECT_EQ(dec.varint(), 0 << 1);
+    EXPECT_EQ(dec.varint(), 2 << 1);
+
+    // The second dump only holds the last value, as a raw double
+    dec.record(statistics::Binary::DUMP);
+    EXPECT_EQ(dec.u64(), 1000);
+    ASSERT_EQ(dec.varint(), 1);
+    EXPECT_EQ(dec.varint(), (2 << 1) | 1);
+    uint64_t bits = dec.u64();
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    EXPECT_EQ(value, 2.5);
+
+    // The third dump holds a negative delta of the first value
+    dec.record(statistics::Binary::DUMP);
+    EXPECT_EQ(dec.u64(), 2000);
+    ASSERT_EQ(dec.varint(), 1);
+    EXPECT_EQ(dec.varint(), 0 << 1);
+    EXPECT_EQ(dec.varint(), (2 << 1) - 1);
+
+    EXPECT_EQ(dec.pos, dec.data.size());
+}
+
+/**
+ * The range of the buckets of a histogram is dumped with its values, so
+ * that the buckets can still be interpreted after the histogram grows.
+ */
+TEST(StatsBinaryTest, HistogramGrows)
+{
+    statistics::HistStor::Params params(4);
+    statistics::HistStor hist(&params);
+
+    DummyDistInfo dist;
+    dist.setName("hist");
+    dist.flags.set(statistics::display);
+
+    std::ostringstream stream;
+    statistics::Binary output(stream);
+    auto dump = [&]() {
+        hist.prepare(&params, dist.data);
+        output.begin();
+        dist.visit(output);
+        output.end();
+    };
+
+    // Buckets [0, 1), [1, 2), [2, 3) and [3, 4)
+    hist.sample(1, 1);
+    hist.sample(3, 2);
+    dump();
+
+    // The buckets grow to [0, 4), [4, 8), [8, 12) and [12, 16)
+    hist.sample(13, 1);
+    dump();
+
+    Decoder dec;
+    dec.data = stream.str();
+    dec.pos = 12;
+
+    dec.record(statistics::Binary::SCHEMA);
+    ASSERT_EQ(dec.varint(), 1);
+    EXPECT_EQ(dec.string(), "hist");
+    dec.string();
+    dec.string();
+    EXPECT_EQ((uint8_t)dec.data.at(dec.pos++), statistics::Binary::DIST);
+    EXPECT_EQ(dec.varint(), 1);
+    ASSERT_EQ(dec.varint(), 13);
+    EXPECT_EQ(dec.varint(), 0);
+    ASSERT_EQ(dec.varint(), 13);
+    const std::vector<std::string> expected_labels = {
+        "samples", "sum", "squares", "min_value", "max_value",
+        "underflows", "overflows", "bucket_min", "bucket_size",
+        "0", "1", "2", "3"
+    };
+    for (const auto &label : expected_labels)
+        EXPECT_EQ(dec.string(), label);
+
+    const int bucket_min = 7;
+    const int bucket_size = 8;
+    const int buckets = 9;
+    std::vector<double> values(13, 0.0);
+
+    dec.record(statistics::Binary::DUMP);
+    dec.dump(values);
+    EXPECT_EQ(values[0], 3);
+    EXPECT_EQ(values[bucket_min], 0);
+    EXPECT_EQ(values[bucket_size], 1);
+    EXPECT_EQ(values[buckets + 1], 1);
+    EXPECT_EQ(values[buckets + 3], 2);
+
+    dec.record(statistics::Binary::DUMP);
+    dec.dump(values);
+    EXPECT_EQ(values[0], 4);
+    EXPECT_EQ(values[bucket_min], 0);
+    EXPECT_EQ(values[bucket_size], 4);
+    EXPECT_EQ(values[buckets + 0], 3);
+    EXPECT_EQ(values[buckets + 1], 0);
+    EXPECT_EQ(values[buckets + 3], 1);
+
+    EXPECT_EQ(dec.pos, dec.data.size());
+}
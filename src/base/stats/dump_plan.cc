@@ -0,0 +1,101 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/stats/dump_plan.hh"
+
+#include "base/stats/group.hh"
+#include "base/stats/info.hh"
+#include "base/stats/output.hh"
+
+namespace gem5
+{
+
+GEM5_DEPRECATED_NAMESPACE(Stats, statistics);
+namespace statistics
+{
+
+void
+DumpPlan::addGroup(const Group &group)
+{
+    for (auto *info : group.getStats()) {
+        steps.push_back({Action::Visit, 0, info});
+        stats.push_back(info);
+    }
+
+    for (const auto &g : group.getStatGroups()) {
+        steps.push_back({Action::BeginGroup, (uint32_t)names.size(),
+                         nullptr});
+        names.push_back(g.first);
+        addGroup(*g.second);
+        steps.push_back({Action::EndGroup, 0, nullptr});
+    }
+}
+
+void
+DumpPlan::build(const Group &root, const std::vector<Info *> &extra)
+{
+    clear();
+    addGroup(root);
+    for (auto *info : extra) {
+        steps.push_back({Action::Visit, 0, info});
+        stats.push_back(info);
+    }
+}
+
+void
+DumpPlan::clear()
+{
+    steps.clear();
+    names.clear();
+    stats.clear();
+}
+
+void
+DumpPlan::prepare() const
+{
+    for (auto *info : stats)
+        info->prepare();
+}
+
+void
+DumpPlan::visit(Output &output) const
+{
+    for (const auto &step : steps) {
+        switch (step.action) {
+          case Action::Visit:
+            step.info->visit(output);
+            break;
+          case Action::BeginGroup:
+            output.beginGroup(names[step.name].c_str());
+            break;
+          case Action::EndGroup:
+            output.endGroup();
+            break;
+        }
+    }
+}
+
+} // namespace statistics
+} // namespace gem5
@@ -0,0 +1,118 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_STATS_DUMP_PLAN_HH__
+#define __BASE_STATS_DUMP_PLAN_HH__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "base/compiler.hh"
+
+namespace gem5
+{
+
+GEM5_DEPRECATED_NAMESPACE(Stats, statistics);
+namespace statistics
+{
+
+class Group;
+class Info;
+struct Output;
+
+/**
+ * A flattened view of a tree of statistics groups, used to dump the
+ * statistics without walking the tree every time.
+ *
+ * The plan holds the sequence of actions that a recursive walk of the
+ * tree performs on an output: entering a group, visiting a stat and
+ * leaving a group. Statistics and groups may not be added once the
+ * plan is built, which is the case once statistics are enabled.
+ */
+class DumpPlan
+{
+  private:
+    enum class Action : uint8_t
+    {
+        BeginGroup,
+        EndGroup,
+        Visit
+    };
+
+    struct Step
+    {
+        Action action;
+        /** Index of the group name when entering a group. */
+        uint32_t name;
+        /** Stat to visit, if any. */
+        Info *info;
+    };
+
+    std::vector<Step> steps;
+
+    /** Names of the groups entered by the plan. */
+    std::vector<std::string> names;
+
+    /** All the stats visited by the plan, in order. */
+    std::vector<Info *> stats;
+
+    void addGroup(const Group &group);
+
+  public:
+    /**
+     * Flatten the tree of groups rooted at a group. The stats of a group
+     * are visited before its subgroups, in the order of their names.
+     *
+     * @param root Root of the tree.
+     * @param extra Stats that do not belong to a group, which are
+     * visited after the tree.
+     */
+    void build(const Group &root, const std::vector<Info *> &extra={});
+
+    /** Forget the flattened tree. */
+    void clear();
+
+    /** @return True if the plan has not been built. */
+    bool empty() const { return steps.empty(); }
+
+    /** @return The number of stats visited by the plan. */
+    size_t numStats() const { return stats.size(); }
+
+    /** Prepare all the stats of the plan for data access. */
+    void prepare() const;
+
+    /**
+     * Pass the groups and stats of the plan to an output.
+     *
+     * @param output The output to visit the stats with.
+     */
+    void visit(Output &output) const;
+};
+
+} // namespace statistics
+} // namespace gem5
+
+#endif // __BASE_STATS_DUMP_PLAN_HH__
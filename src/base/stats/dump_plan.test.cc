@@ -0,0 +1,160 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "base/stats/dump_plan.hh"
+#include "base/stats/group.hh"
+#include "base/stats/info.hh"
+#include "base/stats/output.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** An output that records the sequence of calls it receives. */
+class RecordingOutput : public statistics::Output
+{
+  public:
+    std::vector<std::string> calls;
+
+    void begin() override {}
+    void end() override {}
+    bool valid() const override { return true; }
+
+    void
+    beginGroup(const char *name) override
+    {
+        calls.push_back(std::string("begin ") + name);
+    }
+
+    void endGroup() override { calls.push_back("end"); }
+
+    void visit(const statistics::ScalarInfo &info) override {}
+    void visit(const statistics::VectorInfo &info) override {}
+    void visit(const statistics::DistInfo &info) override {}
+    void visit(const statistics::VectorDistInfo &info) override {}
+    void visit(const statistics::Vector2dInfo &info) override {}
+    void visit(const statistics::FormulaInfo &info) override {}
+    void visit(const statistics::SparseHistInfo &info) override {}
+};
+
+class DummyInfo : public statistics::Info
+{
+  public:
+    using statistics::Info::Info;
+
+    int prepared = 0;
+
+    bool check() const override { return true; }
+    void prepare() override { prepared++; }
+    void reset() override {}
+    bool zero() const override { return false; }
+
+    void
+    visit(statistics::Output &visitor) override
+    {
+        static_cast<RecordingOutput &>(visitor).calls.push_back(
+            "visit " + name);
+    }
+};
+
+} // anonymous namespace
+
+/** Test that an unbuilt plan does not visit anything. */
+TEST(StatsDumpPlanTest, Empty)
+{
+    statistics::DumpPlan plan;
+    ASSERT_TRUE(plan.empty());
+    ASSERT_EQ(plan.numStats(), 0);
+
+    RecordingOutput output;
+    plan.visit(output);
+    ASSERT_TRUE(output.calls.empty());
+}
+
+/**
+ * Test that the plan visits the stats of a group before its subgroups,
+ * with the subgroups in the order of their names, and the extra stats
+ * last.
+ */
+TEST(StatsDumpPlanTest, Order)
+{
+    statistics::Group root(nullptr);
+    statistics::Group node_b(nullptr);
+    statistics::Group node_a(nullptr);
+    statistics::Group node_a_1(nullptr);
+    root.addStatGroup("b", &node_b);
+    root.addStatGroup("a", &node_a);
+    node_a.addStatGroup("a1", &node_a_1);
+
+    DummyInfo root_info, b_info, a1_info, extra_info;
+    root_info.setName("root_stat");
+    b_info.setName("b_stat");
+    a1_info.setName("a1_stat");
+    extra_info.setName("extra_stat");
+    root.addStat(&root_info);
+    node_b.addStat(&b_info);
+    node_a_1.addStat(&a1_info);
+
+    statistics::DumpPlan plan;
+    plan.build(root, {&extra_info});
+    ASSERT_FALSE(plan.empty());
+    ASSERT_EQ(plan.numStats(), 4);
+
+    RecordingOutput output;
+    plan.visit(output);
+    const std::vector<std::string> expected = {
+        "visit root_stat",
+        "begin a",
+        "begin a1",
+        "visit a1_stat",
+        "end",
+        "end",
+        "begin b",
+        "visit b_stat",
+        "end",
+        "visit extra_stat",
+    };
+    ASSERT_EQ(output.calls, expected);
+
+    // Visiting the plan again produces the same sequence
+    output.calls.clear();
+    plan.visit(output);
+    ASSERT_EQ(output.calls, expected);
+
+    plan.prepare();
+    ASSERT_EQ(root_info.prepared, 1);
+    ASSERT_EQ(b_info.prepared, 1);
+    ASSERT_EQ(a1_info.prepared, 1);
+    ASSERT_EQ(extra_info.prepared, 1);
+
+    plan.clear();
+    ASSERT_TRUE(plan.empty());
+}
@@ -41,7 +41,9 @@
 
 #include "base/stats/storage.hh"
 
+#include <algorithm>
 #include <cmath>
+#include <mutex>
 
 namespace gem5
 {
@@ -73,6 +75,26 @@ DistStor::sample(Counter val, int number)
     samples += number;
 }
 
+void
+DistStor::add(const DistStor *other)
+{
+    assert(size() == other->size());
+    assert(min_track == other->min_track);
+    assert(bucket_size == other->bucket_size);
+
+    min_val = std::min(min_val, other->min_val);
+    max_val = std::max(max_val, other->max_val);
+    underflow += other->underflow;
+    overflow += other->overflow;
+
+    for (off_type i = 0; i < size(); ++i)
+        cvec[i] += other->cvec[i];
+
+    sum += other->sum;
+    squares += other->squares;
+    samples += other->samples;
+}
+
 void
 HistStor::growOut()
 {
@@ -227,5 +249,199 @@ HistStor::add(HistStor *hs)
         cvec[i] += hs->cvec[i];
 }
 
+namespace
+{
+
+/**
+ * Slot allocation state of the sharded stats. A shard is only modified
+ * by its own thread, and slots are allocated when stats are created, so
+ * the lock is kept off the update path.
+ */
+struct ShardState
+{
+    std::mutex lock;
+    /** The shards of all the threads, which live until exit. */
+    std::vector<StatShard *> shards;
+    /** Number of counter slots allocated so far. */
+    size_type numCounters = 0;
+    /** Counter slots released by destroyed stats. */
+    std::vector<size_type> freeCounters;
+    /** Number of distribution slots allocated so far. */
+    size_type numDists = 0;
+    /** Distribution slots released by destroyed stats. */
+    std::vector<size_type> freeDists;
+};
+
+ShardState &
+shardState()
+{
+    static ShardState state;
+    return state;
+}
+
+/** Create the shard of the calling thread. Called with the lock held. */
+StatShard *
+newShard(ShardState &state)
+{
+    StatShard *shard = new StatShard;
+    state.shards.push_back(shard);
+    return shard;
+}
+
+} // anonymous namespace
+
+__thread StatShard *StatShards::localShard = nullptr;
+
+size_type
+StatShards::allocCounter()
+{
+    ShardState &state = shardState();
+    std::lock_guard<std::mutex> guard(state.lock);
+    if (state.freeCounters.empty())
+        return state.numCounters++;
+
+    const size_type slot = state.freeCounters.back();
+    state.freeCounters.pop_back();
+    return slot;
+}
+
+void
+StatShards::freeCounter(size_type slot)
+{
+    ShardState &state = shardState();
+    std::lock_guard<std::mutex> guard(state.lock);
+    for (auto *shard : state.shards) {
+        if (slot < shard->counters.size())
+            shard->counters[slot] = Counter();
+    }
+    state.freeCounters.push_back(slot);
+}
+
+size_type
+StatShards::allocDist()
+{
+    ShardState &state = shardState();
+    std::lock_guard<std::mutex> guard(state.lock);
+    if (state.freeDists.empty())
+        return state.numDists++;
+
+    const size_type slot = state.freeDists.back();
+    state.freeDists.pop_back();
+    return slot;
+}
+
+void
+StatShards::freeDist(size_type slot)
+{
+    ShardState &state = shardState();
+    std::lock_guard<std::mutex> guard(state.lock);
+    for (auto *shard : state.shards) {
+        if (slot < shard->dists.size())
+            shard->dists[slot].reset();
+    }
+    state.freeDists.push_back(slot);
+}
+
+const std::vector<StatShard *> &
+StatShards::shards()
+{
+    return shardState().shards;
+}
+
+StatShard *
+StatShards::growCounters(size_type slot)
+{
+    ShardState &state = shardState();
+    std::lock_guard<std::mutex> guard(state.lock);
+    if (!localShard)
+        localShard = newShard(state);
+
+    // Make room for all the stats created so far at once
+    assert(slot < state.numCounters);
+    localShard->counters.resize(state.numCounters, Counter());
+    return localShard;
+}
+
+DistStor *
+StatShards::growDists(size_type slot, const StorageParams *params)
+{
+    ShardState &state = shardState();
+    std::lock_guard<std::mutex> guard(state.lock);
+    if (!localShard)
+        localShard = newShard(state);
+
+    assert(slot < state.numDists);
+    if (slot >= localShard->dists.size())
+        localShard->dists.resize(state.numDists);
+
+    auto &dist = localShard->dists[slot];
+    if (!dist)
+        dist.reset(new DistStor(params));
+    return dist.get();
+}
+
+void
+ShardedStatStor::set(Counter val)
+{
+    for (auto *shard : StatShards::shards()) {
+        if (slot < shard->counters.size())
+            shard->counters[slot] = Counter();
+    }
+    StatShards::counter(slot) = val;
+}
+
+Counter
+ShardedStatStor::value() const
+{
+    Counter total = Counter();
+    for (const auto *shard : StatShards::shards()) {
+        if (slot < shard->counters.size())
+            total += shard->counters[slot];
+    }
+    return total;
+}
+
+void
+ShardedStatStor::reset(const StorageParams* const storage_params)
+{
+    for (auto *shard : StatShards::shards()) {
+        if (slot < shard->counters.size())
+            shard->counters[slot] = Counter();
+    }
+}
+
+bool
+ShardedDistStor::zero() const
+{
+    for (const auto *shard : StatShards::shards()) {
+        if (slot < shard->dists.size() && shard->dists[slot] &&
+            !shard->dists[slot]->zero()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+ShardedDistStor::prepare(const StorageParams* const storage_params,
+                         DistData &data)
+{
+    DistStor merged(storage_params);
+    for (const auto *shard : StatShards::shards()) {
+        if (slot < shard->dists.size() && shard->dists[slot])
+            merged.add(shard->dists[slot].get());
+    }
+    merged.prepare(storage_params, data);
+}
+
+void
+ShardedDistStor::reset(const StorageParams* const storage_params)
+{
+    for (auto *shard : StatShards::shards()) {
+        if (slot < shard->dists.size() && shard->dists[slot])
+            shard->dists[slot]->reset(storage_params);
+    }
+}
+
 } // namespace statistics
 } // namespace gem5
@@ -32,6 +32,8 @@
 
 #include <cassert>
 #include <cmath>
+#include <memory>
+#include <vector>
 
 #include "base/cast.hh"
 #include "base/compiler.hh"
@@ -291,6 +293,12 @@ class DistStor
         reset(storage_params);
     }
 
+    /**
+     * Adds the contents of the given storage to this storage.
+     * @param other The other storage to be added.
+     */
+    void add(const DistStor *other);
+
     /**
      * Add a value to the distribution for the given number of times.
      * @param val The value to add.
@@ -782,6 +790,215 @@ class SparseHistStor
     }
 };
 
+/**
+ * The values of the sharded stats updated by one simulation thread.
+ */
+struct StatShard
+{
+    /** Counters of the sharded scalar stats, indexed by slot. */
+    std::vector<Counter> counters;
+    /** Distributions of the sharded distribution stats, by slot. */
+    std::vector<std::unique_ptr<DistStor>> dists;
+};
+
+/**
+ * Per-thread shards of the sharded stats.
+ *
+ * Stats that are updated from several event queues running in parallel
+ * keep one copy of their value per simulation thread, so that updates
+ * neither race with each other nor need atomic operations. Each stat is
+ * given a slot, and each thread a shard holding the values of the slots
+ * it updated. The shards are merged when a stat is read, which must only
+ * happen while the simulation threads are synchronized, as is the case
+ * when stats are dumped or reset.
+ */
+class StatShards
+{
+  public:
+    /** @return A free counter slot, zero in every shard. */
+    static size_type allocCounter();
+
+    /** Release a counter slot, so that it can be reused. */
+    static void freeCounter(size_type slot);
+
+    /** @return A free distribution slot, empty in every shard. */
+    static size_type allocDist();
+
+    /** Release a distribution slot, so that it can be reused. */
+    static void freeDist(size_type slot);
+
+    /** @return The shards of all the threads that updated a stat. */
+    static const std::vector<StatShard *> &shards();
+
+    /**
+     * Get the counter of a slot for the calling thread.
+     * @param slot The slot of the stat.
+     * @return The counter of the calling thread.
+     */
+    static Counter &
+    counter(size_type slot)
+    {
+        StatShard *shard = localShard;
+        if (GEM5_UNLIKELY(!shard || slot >= shard->counters.size()))
+            shard = growCounters(slot);
+        return shard->counters[slot];
+    }
+
+    /**
+     * Get the distribution of a slot for the calling thread, creating
+     * it the first time the thread samples it.
+     * @param slot The slot of the stat.
+     * @param params The parameters of the distribution.
+     * @return The distribution of the calling thread.
+     */
+    static DistStor &
+    dist(size_type slot, const StorageParams *params)
+    {
+        StatShard *shard = localShard;
+        if (GEM5_UNLIKELY(!shard || slot >= shard->dists.size() ||
+                          !shard->dists[slot])) {
+            return *growDists(slot, params);
+        }
+        return *shard->dists[slot];
+    }
+
+  private:
+    /** The shard of the calling thread, if it has updated a stat. */
+    static __thread StatShard *localShard;
+
+    static StatShard *growCounters(size_type slot);
+    static DistStor *growDists(size_type slot, const StorageParams *params);
+};
+
+/**
+ * Storage for a scalar stat that is updated by several simulation
+ * threads. Each thread increments its own shard of the counter, and the
+ * shards are summed when the value is read. @sa StatShards
+ */
+class ShardedStatStor
+{
+  private:
+    /** The slot of this stat in the shards. */
+    const size_type slot;
+
+  public:
+    struct Params : public StorageParams {};
+
+    ShardedStatStor(const StorageParams* const storage_params)
+        : slot(StatShards::allocCounter())
+    { }
+
+    ~ShardedStatStor() { StatShards::freeCounter(slot); }
+
+    ShardedStatStor(const ShardedStatStor &) = delete;
+    ShardedStatStor &operator=(const ShardedStatStor &) = delete;
+
+    /**
+     * Set the stat to the given value. The shards of the other threads
+     * are cleared, so this must not race with their updates.
+     * @param val The new value.
+     */
+    void set(Counter val);
+
+    /**
+     * Increment the stat by the given value.
+     * @param val The new value.
+     */
+    void inc(Counter val) { StatShards::counter(slot) += val; }
+
+    /**
+     * Decrement the stat by the given value.
+     * @param val The new value.
+     */
+    void dec(Counter val) { StatShards::counter(slot) -= val; }
+
+    /**
+     * Return the value of this stat, summed over all the shards.
+     * @return The value of this stat.
+     */
+    Counter value() const;
+
+    /**
+     * Return the value of this stat as a result type.
+     * @return The value of this stat.
+     */
+    Result result() const { return (Result)value(); }
+
+    /**
+     * Prepare stat data for dumping or serialization
+     */
+    void prepare(const StorageParams* const storage_params) { }
+
+    /**
+     * Reset stat value to default
+     */
+    void reset(const StorageParams* const storage_params);
+
+    /**
+     * @return true if zero value
+     */
+    bool zero() const { return value() == Counter(); }
+};
+
+/**
+ * Storage for a distribution stat that is sampled by several simulation
+ * threads. Each thread samples its own copy of the distribution, and the
+ * copies are merged when the stat is prepared for dumping.
+ * @sa StatShards
+ */
+class ShardedDistStor
+{
+  public:
+    typedef DistStor::Params Params;
+
+  private:
+    /** The parameters of the distribution. */
+    const Params *params;
+    /** The slot of this stat in the shards. */
+    const size_type slot;
+
+  public:
+    ShardedDistStor(const StorageParams* const storage_params)
+        : params(safe_cast<const Params *>(storage_params)),
+          slot(StatShards::allocDist())
+    { }
+
+    ~ShardedDistStor() { StatShards::freeDist(slot); }
+
+    ShardedDistStor(const ShardedDistStor &) = delete;
+    ShardedDistStor &operator=(const ShardedDistStor &) = delete;
+
+    /**
+     * Add a value to the distribution for the given number of times.
+     * @param val The value to add.
+     * @param number The number of times to add the value.
+     */
+    void
+    sample(Counter val, int number)
+    {
+        StatShards::dist(slot, params).sample(val, number);
+    }
+
+    /**
+     * Return the number of buckets in this distribution.
+     * @return the number of buckets.
+     */
+    size_type size() const { return params->buckets; }
+
+    /**
+     * Returns true if any calls to sample have been made.
+     * @return True if any values have been sampled.
+     */
+    bool zero() const;
+
+    void prepare(const StorageParams* const storage_params, DistData &data);
+
+    /**
+     * Reset stat value to default
+     */
+    void reset(const StorageParams* const storage_params);
+};
+
 } // namespace statistics
 } // namespace gem5
 
@@ -30,6 +30,8 @@
 #include <gtest/gtest.h>
 
 #include <cmath>
+#include <thread>
+#include <vector>
 
 #include "base/gtest/cur_tick_fake.hh"
 #include "base/gtest/logging.hh"
@@ -1214,3 +1216,108 @@ TEST(StatsSparseHistStorTest, SamplePrepare)
     }
     ASSERT_EQ(data.samples, total_samples);
 }
+
+/** Test setting and getting a value to a sharded storage. */
+TEST(StatsShardedStatStorTest, SetValueResult)
+{
+    statistics::ShardedStatStor stor(nullptr);
+    statistics::Counter val;
+
+    val = 10;
+    stor.set(val);
+    ASSERT_EQ(stor.value(), val);
+    ASSERT_EQ(stor.result(), statistics::Result(val));
+
+    val = 1234;
+    stor.set(val);
+    ASSERT_EQ(stor.value(), val);
+    ASSERT_EQ(stor.result(), statistics::Result(val));
+}
+
+/**
+ * Test that the updates of several threads to a sharded storage are all
+ * accounted for, and that resetting and setting the storage clear the
+ * shards of all threads.
+ */
+TEST(StatsShardedStatStorTest, IncDecThreads)
+{
+    statistics::ShardedStatStor stor(nullptr);
+    const int num_threads = 4;
+    const int num_incs = 10000;
+
+    auto update = [&stor]() {
+        for (int i = 0; i < num_incs; i++) {
+            stor.inc(3);
+            stor.dec(1);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_threads; i++)
+        threads.emplace_back(update);
+    for (auto &thread : threads)
+        thread.join();
+    update();
+
+    ASSERT_EQ(stor.value(), (num_threads + 1) * num_incs * 2);
+    ASSERT_FALSE(stor.zero());
+
+    stor.set(5);
+    ASSERT_EQ(stor.value(), 5);
+
+    stor.reset(nullptr);
+    ASSERT_TRUE(stor.zero());
+}
+
+/** Test that the slots of destroyed storages are reused zeroed. */
+TEST(StatsShardedStatStorTest, SlotReuse)
+{
+    auto *stor = new statistics::ShardedStatStor(nullptr);
+    stor->inc(10);
+    std::thread([stor]() { stor->inc(10); }).join();
+    ASSERT_EQ(stor->value(), 20);
+    delete stor;
+
+    statistics::ShardedStatStor new_stor(nullptr);
+    ASSERT_TRUE(new_stor.zero());
+}
+
+/**
+ * Test that sampling a sharded distribution from several threads gives
+ * the same data as sampling a distribution from a single thread.
+ */
+TEST(StatsShardedDistStorTest, SamplePrepareThreads)
+{
+    statistics::DistStor::Params params(0, 99, 5);
+    statistics::ShardedDistStor stor(&params);
+    statistics::DistStor expected_stor(&params);
+
+    ValueSamples values[] = {{10, 5}, {1234, 2}, {12345678, 99}, {-10, 4},
+        {17, 17}, {52, 63}, {18, 11}, {0, 1}, {99, 15}, {-1, 200}, {100, 50}};
+    int num_values = sizeof(values) / sizeof(ValueSamples);
+
+    ASSERT_TRUE(stor.zero());
+    ASSERT_EQ(stor.size(), params.buckets);
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_values; i++) {
+        expected_stor.sample(values[i].value, values[i].numSamples);
+        threads.emplace_back([&stor, &values, i]() {
+            stor.sample(values[i].value, values[i].numSamples);
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+    ASSERT_FALSE(stor.zero());
+
+    statistics::DistData data;
+    statistics::DistData expected_data;
+    stor.prepare(&params, data);
+    expected_stor.prepare(&params, expected_data);
+    ASSERT_EQ(data.underflow, expected_data.underflow);
+    ASSERT_EQ(data.overflow, expected_data.overflow);
+    checkExpectedDistData(data, expected_data, true);
+
+    stor.reset(&params);
+    ASSERT_TRUE(stor.zero());
+}
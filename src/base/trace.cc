@@ -31,10 +31,12 @@
 
 #include "base/trace.hh"
 
+#include <atomic>
 #include <cctype>
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <unordered_map>
 
 #include "base/atomicio.hh"
 #include "base/logging.hh"
@@ -104,12 +106,53 @@ disable()
 
 ObjectMatch ignore;
 
+namespace
+{
+
+std::atomic<uint64_t> lastIgnoreVersion(0);
+
+/**
+ * Whether the objects logging messages are ignored, for the version of
+ * the ignored objects it was filled for. Each thread has its own cache,
+ * as objects of a thread mostly log messages from that thread.
+ */
+struct IgnoreCache
+{
+    uint64_t version = 0;
+    std::unordered_map<std::string, bool> ignored;
+};
+
+thread_local IgnoreCache ignoreCache;
+
+} // anonymous namespace
+
+uint64_t
+Logger::nextIgnoreVersion()
+{
+    return ++lastIgnoreVersion;
+}
+
+bool
+Logger::isIgnoredCached(const std::string &name)
+{
+    IgnoreCache &cache = ignoreCache;
+    if (cache.version != ignoreVersion) {
+        cache.ignored.clear();
+        cache.version = ignoreVersion;
+    }
+
+    auto it = cache.ignored.find(name);
+    if (it == cache.ignored.end())
+        it = cache.ignored.emplace(name, ignore.match(name)).first;
+    return it->second;
+}
+
 
 void
 Logger::dump(Tick when, const std::string &name,
          const void *d, int len, const std::string &flag)
 {
-    if (!name.empty() && ignore.match(name))
+    if (isIgnored(name))
         return;
 
     const char *data = static_cast<const char *>(d);
@@ -149,7 +192,7 @@ void
 OstreamLogger::logMessage(Tick when, const std::string &name,
         const std::string &flag, const std::string &message)
 {
-    if (!name.empty() && ignore.match(name))
+    if (isIgnored(name))
         return;
 
     if (!debug::FmtTicksOff && (when != MaxTick))
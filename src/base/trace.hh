@@ -32,6 +32,7 @@
 #ifndef __BASE_TRACE_HH__
 #define __BASE_TRACE_HH__
 
+#include <cstdint>
 #include <ostream>
 #include <string>
 #include <sstream>
@@ -40,6 +41,7 @@
 #include "base/cprintf.hh"
 #include "base/debug.hh"
 #include "base/match.hh"
+#include "base/trace_record.hh"
 #include "base/types.hh"
 #include "sim/cur_tick.hh"
 
@@ -61,6 +63,21 @@ class Logger
     /** Name match for objects to ignore */
     ObjectMatch ignore;
 
+    /** Whether any object is ignored. */
+    bool ignoring = false;
+
+    /**
+     * Version of the ignored objects, unique among all loggers, which
+     * changes along with them.
+     */
+    uint64_t ignoreVersion = nextIgnoreVersion();
+
+    /**
+     * Recorder storing the raw arguments of messages instead of having
+     * them formatted, for loggers that support it.
+     */
+    TraceRecorder *recorder = nullptr;
+
   public:
     /** Log a single message */
     template <typename ...Args>
@@ -76,8 +93,12 @@ class Logger
             const std::string &flag,
             const char *fmt, const Args &...args)
     {
-        if (!name.empty() && ignore.match(name))
+        if (isIgnored(name))
+            return;
+        if (recorder) {
+            recorder->record(when, name, flag, fmt, args...);
             return;
+        }
         std::ostringstream line;
         ccprintf(line, fmt, args...);
         logMessage(when, name, flag, line.str());
@@ -99,12 +120,46 @@ class Logger
     virtual std::ostream &getOstream() = 0;
 
     /** Set objects to ignore */
-    void setIgnore(ObjectMatch &ignore_) { ignore = ignore_; }
+    void
+    setIgnore(ObjectMatch &ignore_)
+    {
+        ignore = ignore_;
+        ignoring = true;
+        ignoreVersion = nextIgnoreVersion();
+    }
 
     /** Add objects to ignore */
-    void addIgnore(const ObjectMatch &ignore_) { ignore.add(ignore_); }
+    void
+    addIgnore(const ObjectMatch &ignore_)
+    {
+        ignore.add(ignore_);
+        ignoring = true;
+        ignoreVersion = nextIgnoreVersion();
+    }
+
+    /**
+     * Check if the messages of an object are ignored. Whether a name is
+     * ignored is cached until the ignored objects change, so that the
+     * messages of an object which is ignored do not match its name
+     * again, and messages cost a single branch when no object is.
+     *
+     * @param name The name of the object.
+     * @return True if the messages of the object must be dropped.
+     */
+    bool
+    isIgnored(const std::string &name)
+    {
+        return GEM5_UNLIKELY(ignoring) && !name.empty() &&
+            isIgnoredCached(name);
+    }
 
     virtual ~Logger() { }
+
+  private:
+    static uint64_t nextIgnoreVersion();
+
+    /** Look the name of an object up in the cache of the thread. */
+    bool isIgnoredCached(const std::string &name);
 };
 
 /** Logging wrapper for ostreams with the format:
@@ -221,6 +221,39 @@ TEST(TraceTest, LogMessageIgnoreMultiple)
     ASSERT_EQ(getString(&logger), "");
 }
 
+/**
+ * Test that the cached decisions of whether objects are ignored follow
+ * the changes of the ignored objects, and are not shared between loggers.
+ */
+TEST(TraceTest, IsIgnoredCached)
+{
+    std::stringstream ss;
+    Trace::OstreamLogger logger(ss);
+    Trace::OstreamLogger other_logger(ss);
+
+    ObjectMatch ignore_foo("Foo");
+    ObjectMatch ignore_bar("Bar.*");
+
+    ASSERT_FALSE(logger.isIgnored("Foo"));
+
+    logger.setIgnore(ignore_foo);
+    for (int i = 0; i < 2; i++) {
+        ASSERT_TRUE(logger.isIgnored("Foo"));
+        ASSERT_TRUE(logger.isIgnored("Foo.child"));
+        ASSERT_FALSE(logger.isIgnored("Bar.child"));
+        ASSERT_FALSE(logger.isIgnored(""));
+        ASSERT_FALSE(other_logger.isIgnored("Foo"));
+    }
+
+    logger.addIgnore(ignore_bar);
+    ASSERT_TRUE(logger.isIgnored("Foo"));
+    ASSERT_TRUE(logger.isIgnored("Bar.child"));
+
+    logger.setIgnore(ignore_bar);
+    ASSERT_FALSE(logger.isIgnored("Foo"));
+    ASSERT_TRUE(logger.isIgnored("Bar.child"));
+}
+
 /** Test that dumping for an ignored name does not log anything. */
 TEST(TraceTest, DumpIgnored)
 {
@@ -0,0 +1,448 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/trace_reader.hh"
+
+#include <cstring>
+#include <sstream>
+
+#include "base/cprintf.hh"
+
+namespace gem5
+{
+
+namespace Trace
+{
+
+using namespace binary_trace;
+
+TraceReader::TraceReader(std::istream &_stream)
+    : stream(_stream), _truncated(false), start(0), end(MaxTick),
+      filterNames(false), ticks(true), flags(false)
+{
+    index();
+}
+
+bool
+TraceReader::fail(const std::string &reason)
+{
+    if (_error.empty())
+        _error = reason;
+    return false;
+}
+
+void
+TraceReader::index()
+{
+    char header[sizeof(magic) + 4];
+    if (!stream.read(header, sizeof(header)) ||
+        std::memcmp(header, magic, sizeof(magic)) != 0) {
+        fail("Not a binary debug trace");
+        return;
+    }
+
+    uint32_t trace_version = 0;
+    for (int i = 0; i < 4; i++) {
+        trace_version |=
+            (uint32_t)(uint8_t)header[sizeof(magic) + i] << (8 * i);
+    }
+    if (trace_version != version) {
+        fail(csprintf("Unsupported binary debug trace version %d",
+                      trace_version));
+        return;
+    }
+
+    stream.seekg(0, std::ios::end);
+    const uint64_t size = stream.tellg();
+    uint64_t offset = sizeof(header);
+
+    // Only the chunk headers are read, the records are read lazily
+    while (offset < size) {
+        char chunk_header[8];
+        stream.seekg(offset);
+        if (size - offset < sizeof(chunk_header) ||
+            !stream.read(chunk_header, sizeof(chunk_header))) {
+            _truncated = true;
+            break;
+        }
+
+        uint32_t thread = 0;
+        uint32_t length = 0;
+        for (int i = 0; i < 4; i++) {
+            thread |= (uint32_t)(uint8_t)chunk_header[i] << (8 * i);
+            length |= (uint32_t)(uint8_t)chunk_header[4 + i] << (8 * i);
+        }
+
+        offset += sizeof(chunk_header);
+        if (size - offset < length) {
+            _truncated = true;
+            break;
+        }
+
+        if (thread >= threads.size())
+            threads.resize(thread + 1);
+        threads[thread].chunks.emplace_back(offset, length);
+        offset += length;
+    }
+    stream.clear();
+}
+
+bool
+TraceReader::readChunk(Thread &thread)
+{
+    if (thread.nextChunk == thread.chunks.size())
+        return false;
+
+    const auto &chunk = thread.chunks[thread.nextChunk++];
+    thread.data.resize(chunk.second);
+    thread.pos = 0;
+    stream.seekg(chunk.first);
+    if (!stream.read(&thread.data[0], chunk.second))
+        return fail("Could not read a chunk of the trace");
+    return true;
+}
+
+bool
+TraceReader::getVarint(Thread &thread, uint64_t &value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (thread.pos == thread.data.size())
+            break;
+        const uint8_t byte = thread.data[thread.pos++];
+        value |= (uint64_t)(byte & 0x7f) << shift;
+        if (byte < 0x80)
+            return true;
+    }
+    return fail("Malformed varint in the trace");
+}
+
+bool
+TraceReader::getString(Thread &thread, std::string &str)
+{
+    uint64_t length;
+    if (!getVarint(thread, length))
+        return false;
+    if (thread.data.size() - thread.pos < length)
+        return fail("Malformed string in the trace");
+    str.assign(thread.data, thread.pos, length);
+    thread.pos += length;
+    return true;
+}
+
+bool
+TraceReader::getArg(Thread &thread, Arg &arg)
+{
+    if (thread.pos == thread.data.size())
+        return fail("Missing argument in the trace");
+    arg.type = (ArgType)(uint8_t)thread.data[thread.pos++];
+
+    switch (arg.type) {
+      case BOOL:
+      case CHAR:
+      case SCHAR:
+      case UCHAR:
+        if (thread.pos == thread.data.size())
+            return fail("Missing argument in the trace");
+        arg.bits = (uint8_t)thread.data[thread.pos++];
+        return true;
+
+      case INT16:
+      case INT32:
+      case INT64:
+      case UINT16:
+      case UINT32:
+      case UINT64:
+      case POINTER:
+        return getVarint(thread, arg.bits);
+
+      case FLOAT:
+      case DOUBLE:
+        {
+            const size_t size = arg.type == FLOAT ? 4 : 8;
+            if (thread.data.size() - thread.pos < size)
+                return fail("Missing argument in the trace");
+            arg.bits = 0;
+            std::memcpy(&arg.bits, &thread.data[thread.pos], size);
+            thread.pos += size;
+            return true;
+        }
+
+      case STRING:
+      case OBJECT:
+        return getString(thread, arg.str);
+
+      default:
+        return fail(csprintf("Unknown argument type %d in the trace",
+                             (int)arg.type));
+    }
+}
+
+std::string
+TraceReader::format(const Format &format, const std::vector<Arg> &args)
+{
+    // Objects were formatted with the spec of their argument when they
+    // were recorded, so they are only printed as strings
+    std::string fmt;
+    size_t copied = 0;
+    for (size_t i = 0; i < args.size() && i < format.specs.size(); i++) {
+        if (args[i].type != OBJECT)
+            continue;
+        const Spec &spec = format.specs[i];
+        fmt.append(format.fmt, copied, spec.pos - copied);
+        fmt.append("%s");
+        copied = spec.pos + spec.len;
+    }
+    fmt.append(format.fmt, copied, std::string::npos);
+
+    std::ostringstream line;
+    cp::Print print(line, fmt);
+    for (const auto &arg : args) {
+        switch (arg.type) {
+          case BOOL:
+            print.addArg((bool)arg.bits);
+            break;
+          case CHAR:
+            print.addArg((char)arg.bits);
+            break;
+          case SCHAR:
+            print.addArg((signed char)arg.bits);
+            break;
+          case UCHAR:
+            print.addArg((unsigned char)arg.bits);
+            break;
+          case INT16:
+          case INT32:
+          case INT64:
+            {
+                const int64_t value =
+                    (int64_t)(arg.bits >> 1) ^ -(int64_t)(arg.bits & 1);
+                if (arg.type == INT16)
+                    print.addArg((short)value);
+                else if (arg.type == INT32)
+                    print.addArg((int)value);
+                else
+                    print.addArg((long)value);
+            }
+            break;
+          case UINT16:
+            print.addArg((unsigned short)arg.bits);
+            break;
+          case UINT32:
+            print.addArg((unsigned int)arg.bits);
+            break;
+          case UINT64:
+            print.addArg((unsigned long)arg.bits);
+            break;
+          case FLOAT:
+            {
+                float value;
+                std::memcpy(&value, &arg.bits, sizeof(value));
+                print.addArg(value);
+            }
+            break;
+          case DOUBLE:
+            {
+                double value;
+                std::memcpy(&value, &arg.bits, sizeof(value));
+                print.addArg(value);
+            }
+            break;
+          case STRING:
+          case OBJECT:
+            print.addArg(arg.str);
+            break;
+          case POINTER:
+            print.addArg((const void *)(uintptr_t)arg.bits);
+            break;
+        }
+    }
+    print.endArgs();
+
+    return line.str();
+}
+
+void
+TraceReader::formatLine(Thread &thread, Tick when, const std::string &name,
+                        const std::string &flag, const std::string &message)
+{
+    std::ostringstream line;
+
+    if (ticks && when != MaxTick)
+        ccprintf(line, "%7d: ", when);
+
+    if (flags && !flag.empty())
+        line << flag << ": ";
+
+    if (!name.empty())
+        line << name << ": ";
+
+    line << message;
+    thread.text = line.str();
+}
+
+bool
+TraceReader::next(Thread &thread)
+{
+    std::vector<Arg> args;
+    std::string flag;
+    std::string text;
+
+    while (valid()) {
+        if (thread.pos == thread.data.size() && !readChunk(thread))
+            return false;
+
+        const RecordType type = (RecordType)(uint8_t)thread.data[thread.pos++];
+        uint64_t id;
+        switch (type) {
+          case FORMAT:
+            {
+                Format format;
+                if (!getVarint(thread, id) ||
+                    !getString(thread, format.flag) ||
+                    !getString(thread, format.fmt)) {
+                    return false;
+                }
+                // Formats that cannot be recorded raw are not defined,
+                // but still use an id
+                if (id <= thread.formats.size())
+                    return fail("Unexpected format id in the trace");
+                thread.formats.resize(id - 1);
+                parseFormat(format.fmt.c_str(), format.specs);
+                thread.formats.push_back(std::move(format));
+            }
+            continue;
+
+          case NAME:
+            {
+                std::string name;
+                if (!getVarint(thread, id) || !getString(thread, name))
+                    return false;
+                if (id != thread.names.size() + 1)
+                    return fail("Unexpected name id in the trace");
+                thread.selected.push_back(!filterNames || names.match(name));
+                thread.names.push_back(std::move(name));
+            }
+            continue;
+
+          case RESET:
+            thread.formats.clear();
+            thread.names.clear();
+            thread.selected.clear();
+            continue;
+
+          case MESSAGE:
+          case TEXT:
+            break;
+
+          default:
+            return fail(csprintf("Unknown record type %d in the trace",
+                                 (int)type));
+        }
+
+        uint64_t when;
+        uint64_t name_id;
+        uint64_t format_id = 0;
+        if (!getVarint(thread, when))
+            return false;
+        if (type == MESSAGE && !getVarint(thread, format_id))
+            return false;
+        if (!getVarint(thread, name_id))
+            return false;
+        if (name_id > thread.names.size() ||
+            format_id > thread.formats.size() ||
+            (type == MESSAGE &&
+             (format_id == 0 || thread.formats[format_id - 1].fmt.empty()))) {
+            return fail("Undefined name or format in the trace");
+        }
+
+        // Ticks are stored off by one so that MaxTick is stored as 0
+        when -= 1;
+        if (when != MaxTick)
+            thread.lastTick = when;
+        const Tick tick = thread.lastTick;
+        const bool selected = tick >= start && tick < end &&
+            (name_id ? thread.selected[name_id - 1] : !filterNames);
+
+        if (type == MESSAGE) {
+            uint64_t num_args;
+            if (!getVarint(thread, num_args))
+                return false;
+            args.resize(num_args);
+            for (auto &arg : args) {
+                if (!getArg(thread, arg))
+                    return false;
+            }
+            if (!selected)
+                continue;
+
+            const Format &format = thread.formats[format_id - 1];
+            flag = format.flag;
+            text = this->format(format, args);
+        } else {
+            if (!getString(thread, flag) || !getString(thread, text))
+                return false;
+            if (!selected)
+                continue;
+        }
+
+        static const std::string no_name;
+        formatLine(thread, when,
+                   name_id ? thread.names[name_id - 1] : no_name, flag, text);
+        thread.tick = tick;
+        return true;
+    }
+
+    return false;
+}
+
+uint64_t
+TraceReader::decode(std::ostream &os)
+{
+    for (auto &thread : threads)
+        thread.ready = next(thread);
+
+    uint64_t count = 0;
+    while (valid()) {
+        // Merge the threads by picking the earliest message
+        Thread *first = nullptr;
+        for (auto &thread : threads) {
+            if (thread.ready && (!first || thread.tick < first->tick))
+                first = &thread;
+        }
+        if (!first)
+            break;
+
+        os << first->text;
+        count++;
+        first->ready = next(*first);
+    }
+
+    os.flush();
+    return count;
+}
+
+} // namespace Trace
+} // namespace gem5
@@ -0,0 +1,194 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of a decoder of binary debug traces.
+ */
+
+#ifndef __BASE_TRACE_READER_HH__
+#define __BASE_TRACE_READER_HH__
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/match.hh"
+#include "base/trace_record.hh"
+#include "base/types.hh"
+
+namespace gem5
+{
+
+namespace Trace
+{
+
+/**
+ * Decoder of the binary traces recorded by BinaryLogger, producing the
+ * text the messages would have been logged as by OstreamLogger. The
+ * arguments of the messages are formatted by cprintf with their original
+ * types, so the output is the same. The messages of the different
+ * simulation threads are merged in tick order, and can be restricted to
+ * a window of ticks and to some objects.
+ */
+class TraceReader
+{
+  private:
+    /** A format defined by a thread. */
+    struct Format
+    {
+        std::string flag;
+        std::string fmt;
+        std::vector<binary_trace::Spec> specs;
+    };
+
+    /** An argument of a message. */
+    struct Arg
+    {
+        binary_trace::ArgType type;
+        uint64_t bits;
+        std::string str;
+    };
+
+    /** The decoding state of the records of one thread. */
+    struct Thread
+    {
+        /** Offsets and sizes of the chunks of the thread, in order. */
+        std::vector<std::pair<uint64_t, uint32_t>> chunks;
+        size_t nextChunk = 0;
+
+        /** The chunk being decoded, and the position in it. */
+        std::string data;
+        size_t pos = 0;
+
+        /** Formats and names defined by the thread, by id - 1. */
+        std::vector<Format> formats;
+        std::vector<std::string> names;
+        /** Whether each name is selected by the name filter. */
+        std::vector<bool> selected;
+
+        /** Tick of the last message with a tick. */
+        Tick lastTick = 0;
+
+        /** Whether the next message of the thread has been decoded. */
+        bool ready = false;
+        /** Tick used to order the next message. */
+        Tick tick = 0;
+        /** The next message of the thread, formatted. */
+        std::string text;
+    };
+
+    std::istream &stream;
+    std::string _error;
+    bool _truncated;
+
+    std::vector<Thread> threads;
+
+    Tick start;
+    Tick end;
+    ObjectMatch names;
+    bool filterNames;
+    bool ticks;
+    bool flags;
+
+    /** Find the chunks of each thread. */
+    void index();
+
+    /** Read the next chunk of a thread. @return False if none is left. */
+    bool readChunk(Thread &thread);
+
+    /**
+     * Decode the records of a thread up to its next message selected by
+     * the filters, and format it.
+     * @return False if the thread has no message left.
+     */
+    bool next(Thread &thread);
+
+    bool getVarint(Thread &thread, uint64_t &value);
+    bool getString(Thread &thread, std::string &str);
+    bool getArg(Thread &thread, Arg &arg);
+
+    /** Format a message with its arguments. */
+    std::string format(const Format &format, const std::vector<Arg> &args);
+
+    /** Format the line of a message as OstreamLogger would. */
+    void formatLine(Thread &thread, Tick when, const std::string &name,
+                    const std::string &flag, const std::string &message);
+
+    bool fail(const std::string &reason);
+
+  public:
+    /** @param stream The trace, which must be seekable. */
+    TraceReader(std::istream &stream);
+
+    /** @return True unless the trace could not be decoded. */
+    bool valid() const { return _error.empty(); }
+
+    /** @return Why the trace could not be decoded. */
+    const std::string &error() const { return _error; }
+
+    /** @return True if the end of the trace was cut off. */
+    bool truncated() const { return _truncated; }
+
+    /** Only decode the messages in [start, end). */
+    void
+    setWindow(Tick _start, Tick _end)
+    {
+        start = _start;
+        end = _end;
+    }
+
+    /** Only decode the messages of the objects matching an expression. */
+    void
+    setNames(const ObjectMatch &_names)
+    {
+        names = _names;
+        filterNames = true;
+    }
+
+    /** Set whether ticks and flags are printed, as FmtTicksOff/FmtFlag. */
+    void
+    setFormat(bool show_ticks, bool show_flags)
+    {
+        ticks = show_ticks;
+        flags = show_flags;
+    }
+
+    /**
+     * Decode the trace.
+     *
+     * @param os The stream to write the messages to.
+     * @return The number of messages written.
+     */
+    uint64_t decode(std::ostream &os);
+};
+
+} // namespace Trace
+} // namespace gem5
+
+#endif // __BASE_TRACE_READER_HH__
@@ -0,0 +1,250 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/trace_record.hh"
+
+#include <atomic>
+#include <cassert>
+
+namespace gem5
+{
+
+namespace Trace
+{
+
+namespace binary_trace
+{
+
+bool
+parseFormat(const char *fmt, std::vector<Spec> &specs)
+{
+    bool valid = true;
+    specs.clear();
+
+    // This follows cp::Print::process() and cp::Print::processFlag()
+    for (const char *ptr = fmt; *ptr; ) {
+        if (*ptr != '%') {
+            ++ptr;
+            continue;
+        }
+        if (ptr[1] == '%') {
+            ptr += 2;
+            continue;
+        }
+
+        const char *start = ptr;
+        bool done = false;
+        while (!done) {
+            ++ptr;
+            switch (*ptr) {
+              case 'l': case '#': case '-': case '+': case ' ': case '.':
+              case '0': case '1': case '2': case '3': case '4':
+              case '5': case '6': case '7': case '8': case '9':
+                break;
+              case '*':
+                valid = false;
+                break;
+              default:
+                done = true;
+                break;
+            }
+        }
+        if (*ptr)
+            ++ptr;
+        specs.push_back({(size_t)(start - fmt), (size_t)(ptr - start)});
+    }
+
+    return valid;
+}
+
+void
+writeHeader(std::ostream &os)
+{
+    char trace_version[4];
+    for (int i = 0; i < 4; i++)
+        trace_version[i] = (char)(version >> (8 * i));
+    os.write(magic, sizeof(magic));
+    os.write(trace_version, sizeof(trace_version));
+}
+
+void
+writeChunk(std::ostream &os, uint32_t thread, const std::string &data)
+{
+    char header[8];
+    const uint32_t size = data.size();
+    for (int i = 0; i < 4; i++) {
+        header[i] = (char)(thread >> (8 * i));
+        header[4 + i] = (char)(size >> (8 * i));
+    }
+    os.write(header, sizeof(header));
+    os.write(data.data(), data.size());
+}
+
+} // namespace binary_trace
+
+namespace
+{
+
+std::atomic<uint64_t> nextSerial(1);
+
+} // anonymous namespace
+
+__thread uint64_t TraceRecorder::localSerial = 0;
+__thread TraceRecorder::Buffer *TraceRecorder::localBuffer = nullptr;
+
+TraceRecorder::TraceRecorder(size_t flush_size)
+    : flushSize(flush_size), serial(nextSerial++)
+{
+}
+
+TraceRecorder::Buffer &
+TraceRecorder::threadBuffer()
+{
+    const std::thread::id owner = std::this_thread::get_id();
+
+    std::lock_guard<std::mutex> guard(bufferLock);
+    Buffer *buf = nullptr;
+    for (auto &other : buffers) {
+        if (other->owner == owner)
+            buf = other.get();
+    }
+    if (!buf) {
+        buffers.emplace_back(new Buffer(owner, buffers.size()));
+        buf = buffers.back().get();
+        buf->data.reserve(flushSize + flushSize / 4);
+    }
+
+    localSerial = serial;
+    localBuffer = buf;
+    return *buf;
+}
+
+const TraceRecorder::Format &
+TraceRecorder::internFormat(Buffer &buf, const char *fmt,
+                            const std::string &flag)
+{
+    // Format strings are almost always literals, but their contents are
+    // still compared in case a buffer is reused for another format
+    auto &formats = buf.formats[fmt];
+    for (const auto &format : formats) {
+        if (format.flag == flag && std::strcmp(format.text.c_str(), fmt) == 0)
+            return format;
+    }
+
+    std::vector<binary_trace::Spec> specs;
+    Format format;
+    format.id = ++buf.numFormats;
+    format.text = fmt;
+    format.flag = flag;
+    format.raw = binary_trace::parseFormat(fmt, specs);
+    for (const auto &spec : specs)
+        format.specs.push_back(format.text.substr(spec.pos, spec.len));
+
+    if (format.raw) {
+        buf.data.push_back(binary_trace::FORMAT);
+        binary_trace::putVarint(buf.data, format.id);
+        binary_trace::putString(buf.data, format.flag);
+        binary_trace::putString(buf.data, format.text);
+    }
+
+    formats.push_back(std::move(format));
+    return formats.back();
+}
+
+uint32_t
+TraceRecorder::internName(Buffer &buf, const std::string &name)
+{
+    if (name.empty())
+        return 0;
+    if (name == buf.lastName)
+        return buf.lastNameId;
+
+    auto it = buf.names.find(name);
+    if (it == buf.names.end()) {
+        it = buf.names.emplace(name, ++buf.numNames).first;
+        buf.data.push_back(binary_trace::NAME);
+        binary_trace::putVarint(buf.data, it->second);
+        binary_trace::putString(buf.data, name);
+    }
+
+    buf.lastName = name;
+    buf.lastNameId = it->second;
+    return it->second;
+}
+
+void
+TraceRecorder::restart(Buffer &buf)
+{
+    assert(buf.data.empty());
+
+    buf.formats.clear();
+    buf.numFormats = 0;
+    buf.names.clear();
+    buf.numNames = 0;
+    buf.lastName.clear();
+    buf.lastNameId = 0;
+
+    buf.data.push_back(binary_trace::RESET);
+}
+
+void
+TraceRecorder::recordText(Buffer &buf, Tick when, const std::string &name,
+                          const std::string &flag, const std::string &message)
+{
+    const uint32_t name_id = internName(buf, name);
+    buf.data.push_back(binary_trace::TEXT);
+    binary_trace::putVarint(buf.data, when + 1);
+    binary_trace::putVarint(buf.data, name_id);
+    binary_trace::putString(buf.data, flag);
+    binary_trace::putString(buf.data, message);
+
+    if (buf.data.size() >= flushSize)
+        flush(buf);
+}
+
+TraceRecorder::TextBuffer::int_type
+TraceRecorder::TextBuffer::overflow(int_type c)
+{
+    if (traits_type::eq_int_type(c, traits_type::eof()))
+        return traits_type::not_eof(c);
+
+    line.push_back(traits_type::to_char_type(c));
+    if (c == '\n')
+        sync();
+    return c;
+}
+
+int
+TraceRecorder::TextBuffer::sync()
+{
+    if (!line.empty()) {
+        recorder.recordText(MaxTick, "", "", line);
+        line.clear();
+    }
+    return 0;
+}
+
+} // namespace Trace
+} // namespace gem5
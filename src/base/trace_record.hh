@@ -0,0 +1,415 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Recording of debug messages in a binary format, which stores the
+ * format string and the raw arguments of each message rather than
+ * formatting it.
+ */
+
+#ifndef __BASE_TRACE_RECORD_HH__
+#define __BASE_TRACE_RECORD_HH__
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "base/compiler.hh"
+#include "base/cprintf.hh"
+#include "base/types.hh"
+
+namespace gem5
+{
+
+namespace Trace
+{
+
+/**
+ * Layout of binary debug traces.
+ *
+ * A trace starts with a magic string and a 32-bit version, followed by
+ * chunks of records. Each chunk starts with the index of the thread that
+ * recorded it and the size of its records, both 32-bit, and only holds
+ * complete records. Format strings and object names are defined once
+ * per thread, by FORMAT and NAME records, and messages refer to them by
+ * id, until a RESET record makes the thread start defining them again.
+ * Integers are little-endian, and varints unless stated otherwise.
+ */
+namespace binary_trace
+{
+
+constexpr char magic[8] = {'g', 'e', 'm', '5', 'D', 'B', 'T', '\0'};
+constexpr uint32_t version = 1;
+
+enum RecordType : uint8_t
+{
+    /** Id, flag and format string of messages. */
+    FORMAT = 1,
+    /** Id and name of an object. */
+    NAME = 2,
+    /** Tick + 1, format id, name id and arguments of a message. */
+    MESSAGE = 3,
+    /** Tick + 1, name id, flag and text of a formatted message. */
+    TEXT = 4,
+    /** Forget the formats and names defined by the thread. */
+    RESET = 5,
+};
+
+/**
+ * Types of the arguments of messages. Arguments are recorded with their
+ * exact type so that they are formatted as they would have been when
+ * the message was logged. Objects are formatted when they are recorded.
+ */
+enum ArgType : uint8_t
+{
+    BOOL, CHAR, SCHAR, UCHAR,
+    /** Signed integers, as zigzag varints. */
+    INT16, INT32, INT64,
+    UINT16, UINT32, UINT64,
+    /** Floating point values, as raw 32 and 64-bit values. */
+    FLOAT, DOUBLE,
+    STRING, POINTER,
+    /** An object formatted with the conversion spec of its argument. */
+    OBJECT,
+};
+
+/** Position of a conversion spec in a format string. */
+struct Spec
+{
+    size_t pos;
+    size_t len;
+};
+
+/**
+ * Find the conversion specs of a format string, in the way cprintf
+ * parses them.
+ *
+ * @param fmt The format string.
+ * @param specs The specs, one for each argument.
+ * @return False if a width or precision is taken from the arguments,
+ *         in which case specs do not map to arguments.
+ */
+bool parseFormat(const char *fmt, std::vector<Spec> &specs);
+
+inline void
+putVarint(std::string &data, uint64_t value)
+{
+    while (value >= 0x80) {
+        data.push_back((char)(value | 0x80));
+        value >>= 7;
+    }
+    data.push_back((char)value);
+}
+
+inline void
+putString(std::string &data, const char *str, size_t len)
+{
+    putVarint(data, len);
+    data.append(str, len);
+}
+
+inline void
+putString(std::string &data, const std::string &str)
+{
+    putString(data, str.data(), str.size());
+}
+
+/** Write the magic string and version starting a trace. */
+void writeHeader(std::ostream &os);
+
+/** Write a chunk of records of a thread. */
+void writeChunk(std::ostream &os, uint32_t thread, const std::string &data);
+
+} // namespace binary_trace
+
+/**
+ * Recorder of debug messages in the binary trace format. Messages are
+ * appended to a buffer owned by the calling thread, so recording needs
+ * no locking, and each buffer is handed over to the subclass once it is
+ * large enough. A thread defines each format string and object name the
+ * first time it uses them, and then refers to them by id.
+ */
+class TraceRecorder
+{
+  protected:
+    /** A message format interned by a thread. */
+    struct Format
+    {
+        /** Id of the format in its thread. */
+        uint32_t id;
+        /** Copy of the format string, which may not be a literal. */
+        std::string text;
+        std::string flag;
+        /** Conversion specs of the arguments. */
+        std::vector<std::string> specs;
+        /** Whether the arguments can be recorded unformatted. */
+        bool raw;
+    };
+
+    /** The records of one thread. */
+    struct Buffer
+    {
+        Buffer(std::thread::id _owner, uint32_t _thread)
+            : owner(_owner), thread(_thread)
+        {}
+
+        const std::thread::id owner;
+        /** Index of the thread in the trace. */
+        const uint32_t thread;
+        /** Records not handed over yet. */
+        std::string data;
+
+        std::unordered_map<const char *, std::vector<Format>> formats;
+        uint32_t numFormats = 0;
+        std::unordered_map<std::string, uint32_t> names;
+        uint32_t numNames = 0;
+        /** The last name recorded, which is usually the next one. */
+        std::string lastName;
+        uint32_t lastNameId = 0;
+    };
+
+  public:
+    /**
+     * Record a message.
+     *
+     * @param when The tick of the message, or MaxTick to omit it.
+     * @param name The name of the object logging the message.
+     * @param flag The debug flag of the message.
+     * @param fmt The cprintf format string of the message.
+     * @param args The arguments of the format string.
+     */
+    template <typename ...Args>
+    void
+    record(Tick when, const std::string &name, const std::string &flag,
+           const char *fmt, const Args &...args)
+    {
+        Buffer &buf = buffer();
+        const Format &format = internFormat(buf, fmt, flag);
+        if (!format.raw) {
+            std::ostringstream message;
+            ccprintf(message, fmt, args...);
+            recordText(buf, when, name, flag, message.str());
+            return;
+        }
+
+        const uint32_t name_id = internName(buf, name);
+        buf.data.push_back(binary_trace::MESSAGE);
+        binary_trace::putVarint(buf.data, when + 1);
+        binary_trace::putVarint(buf.data, format.id);
+        binary_trace::putVarint(buf.data, name_id);
+        binary_trace::putVarint(buf.data, sizeof...(Args));
+        GEM5_VAR_USED unsigned index = 0;
+        (putArg(buf.data, format, index++, args), ...);
+
+        if (buf.data.size() >= flushSize)
+            flush(buf);
+    }
+
+    /**
+     * Record a message that is already formatted.
+     *
+     * @param when The tick of the message, or MaxTick to omit it.
+     * @param name The name of the object logging the message.
+     * @param flag The debug flag of the message.
+     * @param message The text of the message.
+     */
+    void
+    recordText(Tick when, const std::string &name, const std::string &flag,
+               const std::string &message)
+    {
+        recordText(buffer(), when, name, flag, message);
+    }
+
+    /**
+     * Stream buffer recording each line written to it as a message
+     * without tick, name or flag, for loggers to implement getOstream().
+     */
+    class TextBuffer : public std::streambuf
+    {
+      private:
+        TraceRecorder &recorder;
+        std::string line;
+
+      public:
+        TextBuffer(TraceRecorder &_recorder) : recorder(_recorder) {}
+
+      protected:
+        int_type overflow(int_type c) override;
+        int sync() override;
+    };
+
+  protected:
+    /**
+     * @param flush_size Size of the records of a thread above which they
+     *        are handed over.
+     */
+    TraceRecorder(size_t flush_size);
+    virtual ~TraceRecorder() = default;
+
+    /**
+     * Hand the records of a buffer over, leaving the buffer empty. This
+     * is called by the thread owning the buffer, or when all the threads
+     * recording messages are stopped.
+     */
+    virtual void flush(Buffer &buf) = 0;
+
+    /**
+     * Make a thread define its formats and names again, so that the
+     * records that follow can be decoded without the previous ones.
+     * This must be called with an empty buffer.
+     */
+    void restart(Buffer &buf);
+
+    /** Size of the records above which they are handed over. */
+    const size_t flushSize;
+
+    /** Protects the list of buffers. */
+    std::mutex bufferLock;
+    /** The buffers of all the threads that recorded a message. */
+    std::vector<std::unique_ptr<Buffer>> buffers;
+
+  private:
+    /** Unique id of this recorder, as addresses may be reused. */
+    const uint64_t serial;
+
+    /** Id of the recorder owning the buffer cached by the thread. */
+    static __thread uint64_t localSerial;
+    /** The buffer cached by the thread. */
+    static __thread Buffer *localBuffer;
+
+    Buffer &
+    buffer()
+    {
+        if (GEM5_UNLIKELY(localSerial != serial))
+            return threadBuffer();
+        return *localBuffer;
+    }
+
+    /** Find or create the buffer of the calling thread. */
+    Buffer &threadBuffer();
+
+    const Format &internFormat(Buffer &buf, const char *fmt,
+                               const std::string &flag);
+    uint32_t internName(Buffer &buf, const std::string &name);
+
+    void recordText(Buffer &buf, Tick when, const std::string &name,
+                    const std::string &flag, const std::string &message);
+
+    template <typename T>
+    static void
+    putArg(std::string &data, const Format &format, unsigned index,
+           const T &arg)
+    {
+        using namespace binary_trace;
+        using Decayed = std::decay_t<T>;
+        using Pointee = std::remove_cv_t<std::remove_pointer_t<Decayed>>;
+
+        if constexpr (std::is_same_v<T, bool>) {
+            data.push_back(BOOL);
+            data.push_back(arg);
+        } else if constexpr (std::is_same_v<T, char>) {
+            data.push_back(CHAR);
+            data.push_back(arg);
+        } else if constexpr (std::is_same_v<T, signed char>) {
+            data.push_back(SCHAR);
+            data.push_back(arg);
+        } else if constexpr (std::is_same_v<T, unsigned char>) {
+            data.push_back(UCHAR);
+            data.push_back(arg);
+        } else if constexpr (std::is_same_v<T, short> ||
+                             std::is_same_v<T, int> ||
+                             std::is_same_v<T, long> ||
+                             std::is_same_v<T, long long>) {
+            static_assert(sizeof(T) <= sizeof(int64_t));
+            data.push_back(sizeof(T) == 2 ? INT16 :
+                           sizeof(T) == 4 ? INT32 : INT64);
+            const int64_t value = arg;
+            putVarint(data, ((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+        } else if constexpr (std::is_same_v<T, unsigned short> ||
+                             std::is_same_v<T, unsigned int> ||
+                             std::is_same_v<T, unsigned long> ||
+                             std::is_same_v<T, unsigned long long>) {
+            static_assert(sizeof(T) <= sizeof(uint64_t));
+            data.push_back(sizeof(T) == 2 ? UINT16 :
+                           sizeof(T) == 4 ? UINT32 : UINT64);
+            putVarint(data, arg);
+        } else if constexpr (std::is_same_v<T, float> ||
+                             std::is_same_v<T, double>) {
+            data.push_back(sizeof(T) == 4 ? FLOAT : DOUBLE);
+            char raw[sizeof(T)];
+            std::memcpy(raw, &arg, sizeof(T));
+            data.append(raw, sizeof(T));
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            data.push_back(STRING);
+            putString(data, arg);
+        } else if constexpr (std::is_same_v<Decayed, const char *> ||
+                             std::is_same_v<Decayed, char *>) {
+            const char *str = arg;
+            if (str) {
+                data.push_back(STRING);
+                putString(data, str, std::strlen(str));
+            } else {
+                putObject(data, format, index, arg);
+            }
+        } else if constexpr (std::is_pointer_v<Decayed> &&
+                !std::is_function_v<Pointee> &&
+                !std::is_volatile_v<std::remove_pointer_t<Decayed>> &&
+                !std::is_same_v<Pointee, signed char> &&
+                !std::is_same_v<Pointee, unsigned char>) {
+            // Other pointers are not printed as addresses by cprintf
+            data.push_back(POINTER);
+            putVarint(data, (uintptr_t)arg);
+        } else {
+            putObject(data, format, index, arg);
+        }
+    }
+
+    template <typename T>
+    static void
+    putObject(std::string &data, const Format &format, unsigned index,
+              const T &arg)
+    {
+        std::ostringstream text;
+        ccprintf(text, index < format.specs.size() ?
+                 format.specs[index].c_str() : "%s", arg);
+        data.push_back(binary_trace::OBJECT);
+        binary_trace::putString(data, text.str());
+    }
+};
+
+} // namespace Trace
+} // namespace gem5
+
+#endif // __BASE_TRACE_RECORD_HH__
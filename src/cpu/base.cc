@@ -139,7 +139,9 @@ BaseCPU::BaseCPU(const Params &p, bool is_checker)
       syscallRetryLatency(p.syscallRetryLatency),
       pwrGatingLatency(p.pwr_gating_latency),
       powerGatingOnIdle(p.power_gating_on_idle),
-      enterPwrGatingEvent([this]{ enterPwrGating(); }, name())
+      enterPwrGatingEvent([this]{ enterPwrGating(); }, name()),
+      statRegionEvent([this]{ processStatRegionEvent(); },
+                      name() + ".statRegionEvent")
 {
     // if Python did not provide a valid ID, do it here
     if (_cpuId == -1 ) {
@@ -378,7 +380,9 @@ BaseCPUStats::BaseCPUStats(statistics::Group *parent)
       ADD_STAT(numWorkItemsStarted, statistics::units::Count::get(),
                "Number of work items this cpu started"),
       ADD_STAT(numWorkItemsCompleted, statistics::units::Count::get(),
-               "Number of work items this cpu completed")
+               "Number of work items this cpu completed"),
+      ADD_STAT(statRegion, statistics::units::Count::get(),
+               "Number of the profiled region the stats were collected over")
 {
 }
 
@@ -395,6 +399,10 @@ BaseCPU::regStats()
 
     using namespace statistics;
 
+    baseStats.statRegion
+        .functor([this]() { return statRegion; })
+        .flags(nozero);
+
     int size = threadContexts.size();
     if (size > 1) {
         for (int i = 0; i < size; ++i) {
@@ -679,6 +687,61 @@ BaseCPU::getCurrentInstCount(ThreadID tid)
     return threadContexts[tid]->getCurrentInstCount();
 }
 
+void
+BaseCPU::scheduleStatRegions(ThreadID tid,
+    const std::vector<std::pair<Counter, Counter>> &regions)
+{
+    fatal_if(tid >= numThreads, "%s: No thread %i.", name(), tid);
+    fatal_if(statRegionEvent.scheduled(),
+             "%s: Statistics regions are already scheduled.", name());
+
+    const Counter now = getCurrentInstCount(tid);
+    Counter last_end = 0;
+    statRegionBoundaries.clear();
+    for (unsigned i = 0; i < regions.size(); i++) {
+        const Counter start = regions[i].first;
+        const Counter end = regions[i].second;
+        fatal_if(start >= end, "%s: Statistics region %i is empty.",
+                 name(), i + 1);
+        fatal_if(i && start < last_end,
+                 "%s: Statistics region %i overlaps the previous one.",
+                 name(), i + 1);
+
+        // A region starting where the previous one ends shares its
+        // boundary, where the statistics are dumped and then reset
+        if (i && start == last_end)
+            statRegionBoundaries.back().next = i + 1;
+        else
+            statRegionBoundaries.push_back({now + start, false, i + 1});
+        statRegionBoundaries.push_back({now + end, true, 0});
+        last_end = end;
+    }
+
+    statRegionThread = tid;
+    if (!statRegionBoundaries.empty()) {
+        threadContexts[tid]->scheduleInstCountEvent(&statRegionEvent,
+            statRegionBoundaries.front().insts);
+    }
+}
+
+void
+BaseCPU::processStatRegionEvent()
+{
+    const StatRegionBoundary boundary = statRegionBoundaries.front();
+    statRegionBoundaries.pop_front();
+
+    // The statistics are dumped and reset once all the event queues
+    // have reached this point, and the region number must still be
+    // that of the dumped region then
+    statistics::schedStatEventOnce(boundary.dump, boundary.next != 0,
+        [this, next = boundary.next]() { statRegion = next; });
+
+    if (!statRegionBoundaries.empty()) {
+        threadContexts[statRegionThread]->scheduleInstCountEvent(
+            &statRegionEvent, statRegionBoundaries.front().insts);
+    }
+}
+
 AddressMonitor::AddressMonitor() {
     armed = false;
     waiting = false;
@@ -740,7 +803,17 @@ BaseCPU::GlobalStats::GlobalStats(statistics::Group *parent)
              "Simulator instruction rate (inst/s)"),
     ADD_STAT(hostOpRate, statistics::units::Rate<
                 statistics::units::Count, statistics::units::Second>::get(),
-             "Simulator op (including micro ops) rate (op/s)")
+             "Simulator op (including micro ops) rate (op/s)"),
+    ADD_STAT(hostCyclesPerSimInst, statistics::units::Rate<
+                statistics::units::Cycle, statistics::units::Count>::get(),
+             "Host cycles spent per simulated instruction"),
+    ADD_STAT(hostInstructionsPerSimInst, statistics::units::Ratio::get(),
+             "Host instructions executed per simulated instruction"),
+    ADD_STAT(hostCacheMissesPerSimInst, statistics::units::Ratio::get(),
+             "Host cache misses per simulated instruction"),
+    ADD_STAT(hostBranchMissesPerSimInst, statistics::units::Ratio::get(),
+             "Host branch mispredictions per simulated instruction"),
+    startInsts(0)
 {
     simInsts
         .functor(BaseCPU::numSimulatedInsts)
@@ -766,6 +839,35 @@ BaseCPU::GlobalStats::GlobalStats(statistics::Group *parent)
 
     hostInstRate = simInsts / hostSeconds;
     hostOpRate = simOps / hostSeconds;
+
+    // Unlike simInsts, the host events are counted since the last reset
+    statistics::Value *per_sim_inst[] = {
+        &hostCyclesPerSimInst, &hostInstructionsPerSimInst,
+        &hostCacheMissesPerSimInst, &hostBranchMissesPerSimInst
+    };
+    for (int c = 0; c < HostCounters::NumCounters; c++) {
+        const auto counter = (HostCounters::Counter)c;
+        per_sim_inst[c]
+            ->functor([this, counter]() { return perSimInst(counter); })
+            .precision(4)
+            .prereq(rootStats.hostCycles)
+            ;
+    }
+}
+
+void
+BaseCPU::GlobalStats::resetStats()
+{
+    startInsts = BaseCPU::numSimulatedInsts();
+
+    statistics::Group::resetStats();
+}
+
+double
+BaseCPU::GlobalStats::perSimInst(HostCounters::Counter counter) const
+{
+    const Counter insts = BaseCPU::numSimulatedInsts() - startInsts;
+    return insts ? (double)rootStats.hostEvents(counter) / insts : 0.0;
 }
 
 } // namespace gem5
@@ -42,6 +42,8 @@
 #ifndef __CPU_BASE_HH__
 #define __CPU_BASE_HH__
 
+#include <deque>
+#include <utility>
 #include <vector>
 
 // Before we do anything else, check if this build is the NULL ISA,
@@ -56,6 +58,7 @@
 #include "sim/clocked_object.hh"
 #include "sim/eventq.hh"
 #include "sim/full_system.hh"
+#include "sim/host_counters.hh"
 #include "sim/insttracer.hh"
 #include "sim/probe/pmu.hh"
 #include "sim/probe/probe.hh"
@@ -158,6 +161,20 @@ class BaseCPU : public ClockedObject
 
         statistics::Formula hostInstRate;
         statistics::Formula hostOpRate;
+
+        statistics::Value hostCyclesPerSimInst;
+        statistics::Value hostInstructionsPerSimInst;
+        statistics::Value hostCacheMissesPerSimInst;
+        statistics::Value hostBranchMissesPerSimInst;
+
+        void resetStats() override;
+
+      private:
+        /** Instructions simulated when the stats were last reset. */
+        Counter startInsts;
+
+        /** Host events counted per simulated instruction since then. */
+        double perSimInst(HostCounters::Counter counter) const;
     };
 
     /**
@@ -448,6 +465,23 @@ class BaseCPU : public ClockedObject
      */
     uint64_t getCurrentInstCount(ThreadID tid);
 
+    /**
+     * Collect the statistics over a list of regions of the execution
+     * of a thread, e.g., the simulation points of a workload. The
+     * statistics are reset when a region starts and dumped when it
+     * ends, from C++, so a run can profile any number of regions
+     * without returning to the configuration script. Each dump is
+     * tagged with the number of its region, counting from 1, in the
+     * statRegion statistic of this CPU.
+     *
+     * @param tid Thread monitor.
+     * @param regions Start and end of each region, in instructions
+     * into the future. The regions must be sorted and must not
+     * overlap.
+     */
+    void scheduleStatRegions(ThreadID tid,
+        const std::vector<std::pair<Counter, Counter>> &regions);
+
   public:
     /**
      * @{
@@ -597,6 +631,8 @@ class BaseCPU : public ClockedObject
         statistics::Scalar numCycles;
         statistics::Scalar numWorkItemsStarted;
         statistics::Scalar numWorkItemsCompleted;
+        // Region of scheduleStatRegions() the stats were collected over
+        statistics::Value statRegion;
     } baseStats;
 
   private:
@@ -621,6 +657,31 @@ class BaseCPU : public ClockedObject
     const Cycles pwrGatingLatency;
     const bool powerGatingOnIdle;
     EventFunctionWrapper enterPwrGatingEvent;
+
+  private:
+    /** A point where the statistics are dumped and/or reset. */
+    struct StatRegionBoundary
+    {
+        /** Instruction count of the thread at the boundary. */
+        Counter insts;
+        /** Is this the end of a region? */
+        bool dump;
+        /** Number of the region starting here, or 0 if none. */
+        unsigned next;
+    };
+
+    /** Boundaries of the regions that were not reached yet. */
+    std::deque<StatRegionBoundary> statRegionBoundaries;
+
+    /** Thread whose instructions delimit the regions. */
+    ThreadID statRegionThread = 0;
+
+    /** Number of the current region, or 0 outside the regions. */
+    unsigned statRegion = 0;
+
+    /** Dump and/or reset the statistics at the next boundary. */
+    void processStatRegionEvent();
+    EventFunctionWrapper statRegionEvent;
 };
 
 } // namespace gem5
@@ -1258,7 +1258,7 @@ void
 BaseKvmCPU::setupCounters()
 {
     DPRINTF(Kvm, "Attaching cycle counter...\n");
-    PerfKvmCounterConfig cfgCycles(PERF_TYPE_HARDWARE,
+    PerfCounterConfig cfgCycles(PERF_TYPE_HARDWARE,
                                 PERF_COUNT_HW_CPU_CYCLES);
     cfgCycles.disabled(true)
         .pinned(true);
@@ -1337,8 +1337,8 @@ BaseKvmCPU::setupInstCounter(uint64_t period)
     if (period == activeInstPeriod && hwInstructions.attached())
         return;
 
-    PerfKvmCounterConfig cfgInstructions(PERF_TYPE_HARDWARE,
-                                         PERF_COUNT_HW_INSTRUCTIONS);
+    PerfCounterConfig cfgInstructions(PERF_TYPE_HARDWARE,
+                                      PERF_COUNT_HW_INSTRUCTIONS);
 
     // Try to exclude the host. We set both exclude_hv and
     // exclude_host since different architectures use slightly
@@ -1353,7 +1353,7 @@ BaseKvmCPU::setupInstCounter(uint64_t period)
     }
 
     // We need to detach and re-attach the counter to reliably change
-    // sampling settings. See PerfKvmCounter::period() for details.
+    // sampling settings. See PerfCounter::period() for details.
     if (hwInstructions.attached())
         hwInstructions.detach();
     assert(hwCycles.attached());
@@ -45,7 +45,7 @@
 #include <queue>
 
 #include "base/statistics.hh"
-#include "cpu/kvm/perfevent.hh"
+#include "base/perf_event.hh"
 #include "cpu/kvm/timer.hh"
 #include "cpu/kvm/vm.hh"
 #include "cpu/base.hh"
@@ -753,7 +753,7 @@ class BaseKvmCPU : public BaseCPU
      * PerfKvmTimer (see perfControlledByTimer) to trigger exits from
      * KVM.
      */
-    PerfKvmCounter hwCycles;
+    PerfCounter hwCycles;
 
     /**
      * Guest instruction counter.
@@ -766,7 +766,7 @@ class BaseKvmCPU : public BaseCPU
      * @see setupInstBreak
      * @see scheduleInstStop
      */
-    PerfKvmCounter hwInstructions;
+    PerfCounter hwInstructions;
 
     /**
      * Does the runTimer control the performance counters?
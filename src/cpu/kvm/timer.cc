@@ -168,7 +168,7 @@ PosixKvmTimer::calcResolution()
 }
 
 
-PerfKvmTimer::PerfKvmTimer(PerfKvmCounter &ctr,
+PerfKvmTimer::PerfKvmTimer(PerfCounter &ctr,
                            int signo, float hostFactor, Tick hostFreq)
     : BaseKvmTimer(signo, hostFactor, hostFreq),
       hwOverflow(ctr)
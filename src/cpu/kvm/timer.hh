@@ -40,7 +40,7 @@
 
 #include <ctime>
 
-#include "cpu/kvm/perfevent.hh"
+#include "base/perf_event.hh"
 #include "sim/core.hh"
 
 namespace gem5
@@ -215,7 +215,7 @@ class PosixKvmTimer : public BaseKvmTimer
  *
  * @warning There is a known problem in some versions of the PerfEvent
  * API that prevents the counter overflow period from being updated
- * reliably, which might break this timer. See PerfKvmCounter::period()
+ * reliably, which might break this timer. See PerfCounter::period()
  * for details.
  */
 class PerfKvmTimer : public BaseKvmTimer
@@ -235,7 +235,7 @@ class PerfKvmTimer : public BaseKvmTimer
      * @param hostFactor Performance scaling factor
      * @param hostFreq Clock frequency of the host
      */
-    PerfKvmTimer(PerfKvmCounter &ctr,
+    PerfKvmTimer(PerfCounter &ctr,
                  int signo,
                  float hostFactor, Tick hostFreq);
     ~PerfKvmTimer();
@@ -247,7 +247,7 @@ class PerfKvmTimer : public BaseKvmTimer
     Tick calcResolution();
 
   private:
-    PerfKvmCounter &hwOverflow;
+    PerfCounter &hwOverflow;
 };
 
 } // namespace gem5
@@ -284,6 +284,15 @@ class MinorCPU(BaseCPU):
     enableIdling = Param.Bool(True,
         "Enable cycle skipping when the processor is idle\n");
 
+    # When only Execute keeps the pipeline ticking, waiting for
+    # instructions to move through the FUs, for commit delays to expire
+    # or for memory responses, the pipeline can stop until the earliest
+    # cycle at which Execute can change state.  This doesn't change the
+    # timing of the model and needs enableIdling and a single thread.
+    enableSleeping = Param.Bool(False,
+        "Enable cycle skipping while Execute waits for a later cycle or for"
+        " an event");
+
     branchPred = Param.BranchPredictor(TournamentBP(
         numThreads = Parent.numThreads), "Branch Predictor")
 
@@ -349,6 +349,24 @@ class SelfStallingPipeline : public MinorBuffer<ElemType, ReportTraits>
     /** There's data (not a bubble) at the end of the pipe */
     bool isPopable() { return !BubbleTraits::isBubble(front()); }
 
+    /** How many times must the pipeline be advanced (without stalling)
+     *  for the oldest non-bubble element to reach the end of the pipe.
+     *  Returns 0 if it's already there and the depth if the pipe holds
+     *  only bubbles */
+    unsigned int
+    advancesBeforePopable()
+    {
+        /* The size of a pipeline includes its input slot */
+        int depth = this->getSize() - 1;
+
+        for (int i = 0; i < depth; i++) {
+            if (!BubbleTraits::isBubble((*this)[i - depth]))
+                return i;
+        }
+
+        return depth;
+    }
+
     /** Try to advance the pipeline.  If we're stalled, don't advance.  If
      *  we're not stalled, advance then check to see if we become stalled
      *  (a non-bubble at the end of the pipe) */
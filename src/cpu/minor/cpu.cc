@@ -156,6 +156,10 @@ MinorCPU::wakeup(ThreadID tid)
     DPRINTF(Drain, "[tid:%d] MinorCPU wakeup\n", tid);
     assert(tid < numThreads);
 
+    /* Interrupts are only noticed by a ticking Execute */
+    if (pipeline->isSleeping())
+        wakeupOnEvent(minor::Pipeline::CPUStageId);
+
     if (threads[tid]->status() == ThreadContext::Suspended) {
         threads[tid]->activate();
     }
@@ -37,6 +37,7 @@
 
 #include "cpu/minor/execute.hh"
 
+#include <algorithm>
 #include <functional>
 
 #include "arch/locked_mem.hh"
@@ -1421,6 +1422,144 @@ Execute::commit(ThreadID thread_id, bool only_commit_microops, bool discard,
     }
 }
 
+Cycles
+Execute::earliestIssueCycle(ThreadID thread_id, MinorDynInstPtr inst)
+{
+    Cycles ret = noEventCycle;
+
+    /* Look for the FU which will allow the instruction to be issued
+     *  first.  Stalled FUs can only take an instruction once the one at
+     *  their end has been committed */
+    for (unsigned int i = 0; i < numFuncUnits; i++) {
+        FUPipeline *fu = funcUnits[i];
+
+        if (fu->stalled || !fu->provides(inst->staticInst->opClass()))
+            continue;
+
+        MinorFUTiming *timing = fu->findTiming(inst->staticInst);
+
+        if (timing && timing->suppress)
+            continue;
+
+        Cycles issue_cycle = scoreboard[thread_id].earliestIssueCycle(inst,
+            (timing ? &(timing->srcRegsRelativeLats) : NULL),
+            &(fu->cantForwardFromFUIndices), cpu.getContext(thread_id));
+
+        ret = std::min(ret, std::max(issue_cycle, fu->nextInsertCycle));
+    }
+
+    return ret;
+}
+
+Cycles
+Execute::nextEventCycle()
+{
+    Cycles next_cycle = cpu.curCycle() + Cycles(1);
+
+    /* The LSQ has requests to pass to the memory system */
+    if (lsq.needsToTick())
+        return next_cycle;
+
+    Cycles ret = noEventCycle;
+
+    /* Moving FU pipelines matter when their next instruction reaches the
+     *  end of the pipeline and can be considered for commit */
+    for (unsigned int i = 0; i < numFuncUnits; i++) {
+        FUPipeline *fu = funcUnits[i];
+
+        if (fu->occupancy != 0 && !fu->stalled) {
+            ret = std::min(ret,
+                next_cycle + Cycles(fu->advancesBeforePopable()));
+        }
+    }
+
+    for (ThreadID tid = 0; tid < cpu.numThreads; tid++) {
+        ExecuteThreadInfo &ex_info = executeInfo[tid];
+
+        if (ex_info.drainState != NotDraining || isInterrupted(tid))
+            return next_cycle;
+
+        /* Could the head in flight inst be committed? */
+        if (!ex_info.inFlightInsts->empty()) {
+            const MinorDynInstPtr &head_inst =
+                ex_info.inFlightInsts->front().inst;
+
+            if (head_inst->isNoCostInst() || lsq.findResponse(head_inst))
+                return next_cycle;
+
+            FUPipeline *fu = (head_inst->inLSQ ? NULL :
+                funcUnits[head_inst->fuIndex]);
+
+            if (fu && fu->stalled && fu->front().inst->id == head_inst->id) {
+                if (head_inst->extraCommitDelay == Cycles(0) &&
+                    !head_inst->extraCommitDelayExpr &&
+                    head_inst->minimumCommitCycle > next_cycle)
+                {
+                    /* Held back by an extra commit delay */
+                    ret = std::min(ret, head_inst->minimumCommitCycle);
+                } else if (!head_inst->isMemRef() || lsq.canRequest()) {
+                    return next_cycle;
+                }
+                /* Otherwise, this mem ref waits for space in the LSQ */
+            }
+        }
+
+        /* Could a mem ref be issued early to the LSQ? */
+        if (!ex_info.inFUMemInsts->empty() && lsq.canRequest()) {
+            const MinorDynInstPtr &head_mem_ref_inst =
+                ex_info.inFUMemInsts->front().inst;
+            const MinorDynInstPtr &fu_inst =
+                funcUnits[head_mem_ref_inst->fuIndex]->front().inst;
+
+            if (!fu_inst->isBubble() &&
+                !fu_inst->inLSQ &&
+                fu_inst->canEarlyIssue &&
+                ex_info.streamSeqNum == fu_inst->id.streamSeqNum &&
+                ex_info.inFlightInsts->front().inst->id.execSeqNum >
+                    fu_inst->instToWaitFor)
+            {
+                return next_cycle;
+            }
+        }
+
+        /* When could the next instruction be issued? */
+        const ForwardInstData *insts_in = getInput(tid);
+
+        if (insts_in) {
+            MinorDynInstPtr inst = insts_in->insts[ex_info.inputIndex];
+
+            /* Bubbles are skipped, faults, free instructions and
+             *  instructions to discard are issued straightaway */
+            if (inst->isBubble() || inst->isFault() ||
+                inst->isNoCostInst() ||
+                inst->id.streamSeqNum != ex_info.streamSeqNum ||
+                cpu.getContext(tid)->status() == ThreadContext::Suspended)
+            {
+                return next_cycle;
+            }
+
+            ret = std::min(ret, earliestIssueCycle(tid, inst));
+        }
+    }
+
+    return std::max(ret, next_cycle);
+}
+
+void
+Execute::skipCycles(Cycles num_cycles)
+{
+    for (unsigned int i = 0; i < numFuncUnits; i++) {
+        FUPipeline *fu = funcUnits[i];
+
+        /* Advancing an empty pipeline changes nothing */
+        if (fu->occupancy == 0)
+            continue;
+
+        for (Cycles cycle(0); cycle < num_cycles; ++cycle)
+            fu->advance();
+    }
+}
+
 bool
 Execute::isInbetweenInsts(ThreadID thread_id) const
 {
@@ -324,6 +324,12 @@ class Execute : public Named
     ThreadID getCommittingThread();
     ThreadID getIssuingThread();
 
+    /** The first cycle at which the given instruction, which is next to
+     *  be issued by its thread, could be issued into any of the FUs
+     *  which aren't stalled.  Returns noEventCycle if that depends on
+     *  the completion of another instruction */
+    Cycles earliestIssueCycle(ThreadID thread_id, MinorDynInstPtr inst);
+
   public:
     Execute(const std::string &name_,
         MinorCPU &cpu_,
@@ -361,6 +367,23 @@ class Execute : public Named
     /** Like the drain interface on SimObject */
     unsigned int drain();
     void drainResume();
+
+    /** Returned by nextEventCycle when only an event can change the state
+     *  of Execute */
+    static constexpr Cycles noEventCycle = Scoreboard::unknownIssueCycle;
+
+    /** The earliest cycle at which evaluate could next change the state
+     *  of Execute, assuming it isn't woken by an event (a memory response,
+     *  an interrupt or a drain request) before then.  This is the next
+     *  cycle if Execute may have work to do then and noEventCycle if
+     *  it's only waiting for events */
+    Cycles nextEventCycle();
+
+    /** Catch up with cycles which the pipeline didn't evaluate while
+     *  sleeping until the cycle returned by nextEventCycle.  The only
+     *  state which changes in those cycles is the FU pipelines advancing
+     *  towards their next instruction */
+    void skipCycles(Cycles num_cycles);
 };
 
 } // namespace minor
@@ -828,7 +828,8 @@ LSQ::StoreBuffer::forwardStoreData(LSQRequestPtr load,
         store_addr, addr_offset);
 
     void *load_packet_data = load->packet->getPtr<void>();
-    void *store_packet_data = store->packet->getPtr<uint8_t>() + addr_offset;
+    const uint8_t *store_packet_data =
+        store->packet->getConstPtr<uint8_t>() + addr_offset;
 
     std::memcpy(load_packet_data, store_packet_data, load_size);
 }
@@ -59,6 +59,10 @@ Pipeline::Pipeline(MinorCPU &cpu_, const MinorCPUParams &params) :
     Ticked(cpu_, &(cpu_.BaseCPU::baseStats.numCycles)),
     cpu(cpu_),
     allow_idling(params.enableIdling),
+    allow_sleeping(params.enableSleeping),
+    sleeping(false),
+    sleepEvent([this]{ cpu.wakeupOnEvent(ExecuteStageId); },
+        cpu_.name() + ".sleepEvent"),
     f1ToF2(cpu.name() + ".f1ToF2", "lines",
         params.fetch1ToFetch2ForwardDelay),
     f2ToF1(cpu.name() + ".f2ToF1", "prediction",
@@ -105,6 +109,14 @@ Pipeline::Pipeline(MinorCPU &cpu_, const MinorCPUParams &params) :
         fatal("%s: executeBranchDelay must be >= 1\n",
             cpu.name(), params.executeBranchDelay);
     }
+
+    /* Thread scheduling policies can pick different threads on every
+     *  cycle, so skipping cycles is only exact with one thread */
+    if (allow_sleeping && params.numThreads != 1) {
+        warn("%s: enableSleeping is only supported with one thread\n",
+            cpu.name());
+        allow_sleeping = false;
+    }
 }
 
 void
@@ -122,9 +134,61 @@ Pipeline::minorTrace() const
     activityRecorder.minorTrace();
 }
 
+bool
+Pipeline::sleepUntilNextEvent()
+{
+    Cycles next_cycle = cpu.curCycle() + Cycles(1);
+    Cycles wakeup_cycle = execute.nextEventCycle();
+
+    if (wakeup_cycle <= next_cycle)
+        return false;
+
+    if (wakeup_cycle == Execute::noEventCycle) {
+        DPRINTF(Quiesce, "Sleeping until Execute is woken by an event\n");
+    } else {
+        DPRINTF(Quiesce, "Sleeping until cycle %d\n", wakeup_cycle);
+
+        /* Restarting the pipeline at the end of the previous cycle ticks
+         *  it at wakeup_cycle */
+        cpu.schedule(sleepEvent,
+            cpu.clockEdge(Cycles(wakeup_cycle - next_cycle)));
+    }
+
+    stop();
+    sleeping = true;
+
+    return true;
+}
+
+void
+Pipeline::endSleep()
+{
+    sleeping = false;
+
+    /* The pipeline may have been woken by an event before the end of
+     *  the sleep */
+    if (sleepEvent.scheduled())
+        cpu.deschedule(sleepEvent);
+
+    /* The cycles skipped are already part of numCycles as start accounts
+     *  for the time since the pipeline was stopped.  The current cycle
+     *  is evaluated as usual */
+    assert(cpu.curCycle() > lastStopped);
+    Cycles skipped_cycles = Cycles(cpu.curCycle() - lastStopped - 1);
+
+    DPRINTF(Quiesce, "Woken up after sleeping for %d cycles\n",
+        skipped_cycles);
+
+    execute.skipCycles(skipped_cycles);
+    cpu.stats.sleepCycles += skipped_cycles;
+}
+
 void
 Pipeline::evaluate()
 {
+    if (sleeping)
+        endSleep();
+
     /** We tick the CPU to update the BaseCPU cycle counters */
     cpu.tick();
 
@@ -155,6 +219,13 @@ Pipeline::evaluate()
         if (!activityRecorder.active() && !needToSignalDrained) {
             DPRINTF(Quiesce, "Suspending as the processor is idle\n");
             stop();
+        } else if (allow_sleeping && !needToSignalDrained &&
+            /* Only Execute is active and nothing is in flight between
+             *  the stages */
+            activityRecorder.getActivityCount() == 1 &&
+            activityRecorder.getStageActive(Pipeline::ExecuteStageId))
+        {
+            sleepUntilNextEvent();
         }
 
         /* Deactivate all stages.  Note that the stages *could*
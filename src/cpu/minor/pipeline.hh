@@ -52,6 +52,7 @@
 #include "cpu/minor/fetch1.hh"
 #include "cpu/minor/fetch2.hh"
 #include "params/MinorCPU.hh"
+#include "sim/eventq.hh"
 #include "sim/ticked_object.hh"
 
 namespace gem5
@@ -78,6 +79,16 @@ class Pipeline : public Ticked
     /** Allow cycles to be skipped when the pipeline is idle */
     bool allow_idling;
 
+    /** Allow cycles to be skipped when only Execute is active and it
+     *  can't change state before a later cycle */
+    bool allow_sleeping;
+
+    /** True while the pipeline is stopped by sleep rather than idling */
+    bool sleeping;
+
+    /** Restarts the pipeline at the end of a sleep */
+    EventFunctionWrapper sleepEvent;
+
     Latch<ForwardLineData> f1ToF2;
     Latch<BranchData> f2ToF1;
     Latch<ForwardInstData> f2ToD;
@@ -108,9 +119,21 @@ class Pipeline : public Ticked
     /** True after drain is called but draining isn't complete */
     bool needToSignalDrained;
 
+  protected:
+    /** Stop ticking until the next cycle at which Execute can change
+     *  state, or until it's woken by an event if there's no such cycle.
+     *  Returns false if the pipeline must tick on the next cycle */
+    bool sleepUntilNextEvent();
+
+    /** Account for the cycles skipped by a sleep which has just ended */
+    void endSleep();
+
   public:
     Pipeline(MinorCPU &cpu_, const MinorCPUParams &params);
 
+    /** Is the pipeline stopped until Execute can change state? */
+    bool isSleeping() const { return sleeping; }
+
   public:
     /** Wake up the Fetch unit.  This is needed on thread activation esp.
      *  after quiesce wakeup */
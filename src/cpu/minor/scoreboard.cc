@@ -37,6 +37,8 @@
 
 #include "cpu/minor/scoreboard.hh"
 
+#include <algorithm>
+
 #include "cpu/reg_class.hh"
 #include "debug/MinorScoreboard.hh"
 #include "debug/MinorTiming.hh"
@@ -215,11 +217,42 @@ Scoreboard::canInstIssue(MinorDynInstPtr inst,
     if (inst->isFault())
         return true;
 
+    bool ret = earliestIssueCycle(inst, src_reg_relative_latencies,
+        cant_forward_from_fu_indices, thread_context) <= now;
+
+    if (debug::MinorTiming) {
+        unsigned int num_srcs = inst->staticInst->numSrcRegs();
+        unsigned int num_relative_latencies =
+            (src_reg_relative_latencies ?
+                src_reg_relative_latencies->size() : 0);
+
+        if (ret && num_srcs > num_relative_latencies &&
+            num_relative_latencies != 0)
+        {
+            DPRINTF(MinorTiming, "Warning, inst: %s timing extra decode has"
+                " more src. regs: %d than relative latencies: %d\n",
+                inst->staticInst->disassemble(0), num_srcs,
+                num_relative_latencies);
+        }
+    }
+
+    return ret;
+}
+
+Cycles
+Scoreboard::earliestIssueCycle(MinorDynInstPtr inst,
+    const std::vector<Cycles> *src_reg_relative_latencies,
+    const std::vector<bool> *cant_forward_from_fu_indices,
+    ThreadContext *thread_context)
+{
+    if (inst->isFault())
+        return Cycles(0);
+
     StaticInstPtr staticInst = inst->staticInst;
     unsigned int num_srcs = staticInst->numSrcRegs();
 
-    /* Default to saying you can issue */
-    bool ret = true;
+    /* The latest cycle at which a source result can be forwarded */
+    Cycles ret = Cycles(0);
 
     unsigned int num_relative_latencies = 0;
     Cycles default_relative_latency = Cycles(0);
@@ -236,10 +269,7 @@ Scoreboard::canInstIssue(MinorDynInstPtr inst,
     }
 
     /* For each source register, find the latest result */
-    unsigned int src_index = 0;
-    while (src_index < num_srcs && /* More registers */
-        ret /* Still possible */)
-    {
+    for (unsigned int src_index = 0; src_index < num_srcs; src_index++) {
         RegId reg = flattenRegIndex(staticInst->srcRegIdx(src_index),
             thread_context);
         unsigned short int index;
@@ -255,22 +285,15 @@ Scoreboard::canInstIssue(MinorDynInstPtr inst,
                     default_relative_latency :
                     (*src_reg_relative_latencies)[src_index]));
 
-            if (returnCycle[index] > (now + relative_latency) ||
-                numUnpredictableResults[index] != 0)
-            {
-                ret = false;
-            }
-        }
-        src_index++;
-    }
+            if (numUnpredictableResults[index] != 0)
+                return unknownIssueCycle;
 
-    if (debug::MinorTiming) {
-        if (ret && num_srcs > num_relative_latencies &&
-            num_relative_latencies != 0)
-        {
-            DPRINTF(MinorTiming, "Warning, inst: %s timing extra decode has"
-                " more src. regs: %d than relative latencies: %d\n",
-                staticInst->disassemble(0), num_srcs, num_relative_latencies);
+            /* The result can be used relative_latency cycles before it
+             *  is presented */
+            if (returnCycle[index] > relative_latency) {
+                ret = std::max(ret,
+                    Cycles(returnCycle[index] - relative_latency));
+            }
         }
     }
 
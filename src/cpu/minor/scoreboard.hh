@@ -44,6 +44,7 @@
 #ifndef __CPU_MINOR_SCOREBOARD_HH__
 #define __CPU_MINOR_SCOREBOARD_HH__
 
+#include <limits>
 #include <vector>
 
 #include "base/named.hh"
@@ -157,6 +158,20 @@ class Scoreboard : public Named
         const std::vector<bool> *cant_forward_from_fu_indices,
         Cycles now, ThreadContext *thread_context);
 
+    /** Returned by earliestIssueCycle for insts which must wait for an
+     *  unpredictable result to be committed */
+    static constexpr Cycles unknownIssueCycle =
+        Cycles(std::numeric_limits<uint64_t>::max());
+
+    /** The first cycle at which canInstIssue could return true for this
+     *  instruction, assuming no more results are marked up or cleared
+     *  before then.  Returns unknownIssueCycle if the instruction depends
+     *  on an unpredictable result */
+    Cycles earliestIssueCycle(MinorDynInstPtr inst,
+        const std::vector<Cycles> *src_reg_relative_latencies,
+        const std::vector<bool> *cant_forward_from_fu_indices,
+        ThreadContext *thread_context);
+
     /** MinorTraceIF interface */
     void minorTrace() const;
 };
@@ -58,6 +58,9 @@ MinorStats::MinorStats(BaseCPU *base_cpu)
     ADD_STAT(quiesceCycles, statistics::units::Cycle::get(),
              "Total number of cycles that CPU has spent quiesced or waiting "
              "for an interrupt"),
+    ADD_STAT(sleepCycles, statistics::units::Cycle::get(),
+             "Total number of cycles that the pipeline has skipped while "
+             "waiting for Execute to change state"),
     ADD_STAT(cpi, statistics::units::Rate<
                 statistics::units::Cycle, statistics::units::Count>::get(),
              "CPI: cycles per instruction"),
@@ -68,6 +71,7 @@ MinorStats::MinorStats(BaseCPU *base_cpu)
              "Class of committed instruction")
 {
     quiesceCycles.prereq(quiesceCycles);
+    sleepCycles.prereq(sleepCycles);
 
     cpi.precision(6);
     cpi = base_cpu->baseStats.numCycles / numInsts;
@@ -75,6 +75,10 @@ struct MinorStats : public statistics::Group
     /** Number of cycles in quiescent state */
     statistics::Scalar quiesceCycles;
 
+    /** Number of cycles skipped while the pipeline was asleep waiting for
+     *  Execute to change state */
+    statistics::Scalar sleepCycles;
+
     /** CPI/IPC for total cycle counts and macro insts */
     statistics::Formula cpi;
     statistics::Formula ipc;
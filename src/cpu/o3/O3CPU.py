@@ -126,6 +126,9 @@ class O3CPU(BaseCPU):
     LQEntries = Param.Unsigned(32, "Number of load queue entries")
     SQEntries = Param.Unsigned(32, "Number of store queue entries")
     LSQDepCheckShift = Param.Unsigned(4, "Number of places to shift addr before check")
+    lsq_addr_index = Param.Bool(True, "Index the loads and stores of the "
+                                "LSQ by address for forwarding and "
+                                "memory order violation checks")
     LSQCheckLoads = Param.Bool(True,
         "Should dependency violations be checked for loads & stores or just stores")
     store_set_clear_period = Param.Unsigned(250000,
@@ -157,6 +160,26 @@ class O3CPU(BaseCPU):
     numIQEntries = Param.Unsigned(64, "Number of instruction queue entries")
     numROBEntries = Param.Unsigned(192, "Number of reorder buffer entries")
 
+    inst_arena = Param.Bool(True, "Allocate the dynamic instructions from "
+                            "a per-CPU arena rather than the heap")
+
+    # While the ROB is full and every stage is blocked behind a long
+    # latency miss, fetch keeps the CPU ticking without any change to
+    # its state. Suspending the tick event until the next completion
+    # event, and accounting the skipped cycles in bulk, does not change
+    # the reported timing nor the stats.
+    skip_stall_cycles = Param.Bool(False, "Stop ticking while the pipeline "
+                                   "is stalled until a completion event")
+
+    # The instruction queue can model a matrix scheduler, which keeps the
+    # register dependencies in a wakeup matrix and selects the oldest
+    # ready instructions using an age ordered mask, instead of using
+    # linked lists and priority queues. The instructions issued are the
+    # same.
+    iq_matrix_scheduler = Param.Bool(False, "Use a wakeup matrix and an "
+                                     "age ordered ready mask in the "
+                                     "instruction queue")
+
     smtNumFetchingThreads = Param.Unsigned(1, "SMT Number of Fetching Threads")
     smtFetchPolicy = Param.SMTFetchPolicy('RoundRobin', "SMT Fetch policy")
     smtLSQPolicy    = Param.SMTQueuePolicy('Partitioned',
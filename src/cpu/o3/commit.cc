@@ -703,6 +703,32 @@ Commit::tick()
     updateStatus();
 }
 
+bool
+Commit::canSkipCycles() const
+{
+    // Interrupts are checked and the stall probe is notified every
+    // cycle
+    if (interrupt != NoFault || ppCommitStall->hasListeners())
+        return false;
+
+    // Squashes and traps change the state on the next tick
+    for (ThreadID tid : *activeThreads) {
+        if ((commitStatus[tid] != Running && commitStatus[tid] != Idle) ||
+            trapSquash[tid] || tcSquash[tid]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void
+Commit::recordStalledCycles(Cycles cycles)
+{
+    // see commitInsts(), nothing can be committed
+    stats.numCommittedDist.sample(0, cycles);
+}
+
 void
 Commit::handleInterrupt()
 {
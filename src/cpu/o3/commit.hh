@@ -205,6 +205,18 @@ class Commit
     /** Ticks the commit stage, which tries to commit instructions. */
     void tick();
 
+    /** Checks if ticking commit would only update its per cycle stats,
+     * i.e., nothing can be committed and no squash or interrupt is
+     * pending, so that the CPU may skip ticking it.
+     */
+    bool canSkipCycles() const;
+
+    /** Accounts the cycles commit was not ticked while the CPU skipped
+     * them, as if it had been.
+     * @param cycles Number of skipped cycles.
+     */
+    void recordStalledCycles(Cycles cycles);
+
     /** Handles any squashes that are sent from IEW, and adds instructions
      * to the ROB and tries to commit instructions.
      */
@@ -329,23 +341,23 @@ class Commit
     TimeBuffer<TimeStruct>::wire toIEW;
 
     /** Wire to read information from IEW (for ROB). */
-    TimeBuffer<TimeStruct>::wire robInfoFromIEW;
+    TimeBuffer<TimeStruct>::const_wire robInfoFromIEW;
 
     TimeBuffer<FetchStruct> *fetchQueue;
 
-    TimeBuffer<FetchStruct>::wire fromFetch;
+    TimeBuffer<FetchStruct>::const_wire fromFetch;
 
     /** IEW instruction queue interface. */
     TimeBuffer<IEWStruct> *iewQueue;
 
     /** Wire to read information from IEW queue. */
-    TimeBuffer<IEWStruct>::wire fromIEW;
+    TimeBuffer<IEWStruct>::const_wire fromIEW;
 
     /** Rename instruction queue interface, for ROB. */
     TimeBuffer<RenameStruct> *renameQueue;
 
     /** Wire to read information from rename queue. */
-    TimeBuffer<RenameStruct>::wire fromRename;
+    TimeBuffer<RenameStruct>::const_wire fromRename;
 
   public:
     /** ROB interface. */
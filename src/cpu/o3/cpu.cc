@@ -77,6 +77,14 @@ CPU::CPU(const O3CPUParams &params)
                 false, Event::CPU_Tick_Pri),
       threadExitEvent([this]{ exitThreads(); }, "O3CPU exit threads",
                 false, Event::CPU_Exit_Pri),
+      // Size the arena for the instructions that can be in flight,
+      // which are held by the ROB, or by the fetch queues before
+      // being dispatched
+      instArena(params.inst_arena ?
+                new InstArena(sizeof(DynInst),
+                              params.numROBEntries +
+                              params.fetchQueueSize * params.numThreads) :
+                nullptr),
 #ifndef NDEBUG
       instcount(0),
 #endif
@@ -115,6 +123,8 @@ CPU::CPU(const O3CPUParams &params)
       activityRec(name(), NumStages,
                   params.backComSize + params.forwardComSize,
                   params.activity),
+      skipStallCycles(params.skip_stall_cycles),
+      stallSkipped(false),
 
       globalSeqNum(1),
       system(params.system),
@@ -382,6 +392,9 @@ CPU::CPUStats::CPUStats(CPU *cpu)
       ADD_STAT(quiesceCycles, statistics::units::Cycle::get(),
                "Total number of cycles that CPU has spent quiesced or waiting "
                "for an interrupt"),
+      ADD_STAT(stallSkippedCycles, statistics::units::Cycle::get(),
+               "Total number of cycles that the CPU has skipped while its "
+               "pipeline was stalled"),
       ADD_STAT(committedInsts, statistics::units::Count::get(),
                "Number of Instructions Simulated"),
       ADD_STAT(committedOps, statistics::units::Count::get(),
@@ -433,6 +446,9 @@ CPU::CPUStats::CPUStats(CPU *cpu)
     quiesceCycles
         .prereq(quiesceCycles);
 
+    stallSkippedCycles
+        .prereq(stallSkippedCycles);
+
     // Number of Instructions simulated
     // --------------------------------
     // Should probably be in Base CPU but need templated
@@ -505,6 +521,10 @@ CPU::tick()
     assert(!switchedOut());
     assert(drainState() != DrainState::Drained);
 
+    // The tick may have been scheduled by something else than a wake up
+    if (stallSkipped)
+        endStallSkip();
+
     ++baseStats.numCycles;
     updateCycleCounters(BaseCPU::CPU_STATE_ON);
 
@@ -544,6 +564,10 @@ CPU::tick()
             DPRINTF(O3CPU, "Idle!\n");
             lastRunningCycle = curCycle();
             cpuStats.timesIdled++;
+        } else if (skipStallCycles && pipelineStalled()) {
+            DPRINTF(O3CPU, "Pipeline stalled, waiting for a wake up!\n");
+            lastRunningCycle = curCycle();
+            stallSkipped = true;
         } else {
             schedule(tickEvent, clockEdge(Cycles(1)));
             DPRINTF(O3CPU, "Scheduling next tick!\n");
@@ -1144,105 +1168,6 @@ CPU::setMiscReg(int misc_reg, RegVal val, ThreadID tid)
     isa[tid]->setMiscReg(misc_reg, val);
 }
 
-RegVal
-CPU::readIntReg(PhysRegIdPtr phys_reg)
-{
-    cpuStats.intRegfileReads++;
-    return regFile.readIntReg(phys_reg);
-}
-
-RegVal
-CPU::readFloatReg(PhysRegIdPtr phys_reg)
-{
-    cpuStats.fpRegfileReads++;
-    return regFile.readFloatReg(phys_reg);
-}
-
-const TheISA::VecRegContainer&
-CPU::readVecReg(PhysRegIdPtr phys_reg) const
-{
-    cpuStats.vecRegfileReads++;
-    return regFile.readVecReg(phys_reg);
-}
-
-TheISA::VecRegContainer&
-CPU::getWritableVecReg(PhysRegIdPtr phys_reg)
-{
-    cpuStats.vecRegfileWrites++;
-    return regFile.getWritableVecReg(phys_reg);
-}
-
-const TheISA::VecElem&
-CPU::readVecElem(PhysRegIdPtr phys_reg) const
-{
-    cpuStats.vecRegfileReads++;
-    return regFile.readVecElem(phys_reg);
-}
-
-const TheISA::VecPredRegContainer&
-CPU::readVecPredReg(PhysRegIdPtr phys_reg) const
-{
-    cpuStats.vecPredRegfileReads++;
-    return regFile.readVecPredReg(phys_reg);
-}
-
-TheISA::VecPredRegContainer&
-CPU::getWritableVecPredReg(PhysRegIdPtr phys_reg)
-{
-    cpuStats.vecPredRegfileWrites++;
-    return regFile.getWritableVecPredReg(phys_reg);
-}
-
-RegVal
-CPU::readCCReg(PhysRegIdPtr phys_reg)
-{
-    cpuStats.ccRegfileReads++;
-    return regFile.readCCReg(phys_reg);
-}
-
-void
-CPU::setIntReg(PhysRegIdPtr phys_reg, RegVal val)
-{
-    cpuStats.intRegfileWrites++;
-    regFile.setIntReg(phys_reg, val);
-}
-
-void
-CPU::setFloatReg(PhysRegIdPtr phys_reg, RegVal val)
-{
-    cpuStats.fpRegfileWrites++;
-    regFile.setFloatReg(phys_reg, val);
-}
-
-void
-CPU::setVecReg(PhysRegIdPtr phys_reg, const TheISA::VecRegContainer& val)
-{
-    cpuStats.vecRegfileWrites++;
-    regFile.setVecReg(phys_reg, val);
-}
-
-void
-CPU::setVecElem(PhysRegIdPtr phys_reg, const TheISA::VecElem& val)
-{
-    cpuStats.vecRegfileWrites++;
-    regFile.setVecElem(phys_reg, val);
-}
-
-void
-CPU::setVecPredReg(PhysRegIdPtr phys_reg,
-                               const TheISA::VecPredRegContainer& val)
-{
-    cpuStats.vecPredRegfileWrites++;
-    regFile.setVecPredReg(phys_reg, val);
-}
-
-void
-CPU::setCCReg(PhysRegIdPtr phys_reg, RegVal val)
-{
-    cpuStats.ccRegfileWrites++;
-    regFile.setCCReg(phys_reg, val);
-}
-
 RegVal
 CPU::readArchIntReg(int reg_idx, ThreadID tid)
 {
@@ -1408,12 +1333,16 @@ CPU::squashFromTC(ThreadID tid)
     commit.generateTCEvent(tid);
 }
 
+InstListHook<DynInst> &
+CPU::InstListHookOf::get(DynInst *inst)
+{
+    return inst->cpuHook;
+}
+
 CPU::ListIt
 CPU::addInst(const DynInstPtr &inst)
 {
-    instList.push_back(inst);
-
-    return --(instList.end());
+    return instList.push_back(inst);
 }
 
 void
@@ -1445,7 +1374,7 @@ CPU::removeFrontInst(const DynInstPtr &inst)
     removeInstsThisCycle = true;
 
     // Remove the front instruction.
-    removeList.push(inst->getInstListIt());
+    removeList.push(instList.iteratorTo(inst.get()));
 }
 
 void
@@ -1465,7 +1394,7 @@ CPU::removeInstsNotInROB(ThreadID tid)
         end_it = instList.begin();
         rob_empty = true;
     } else {
-        end_it = (rob.readTailInst(tid))->getInstListIt();
+        end_it = instList.iteratorTo(rob.readTailInst(tid).get());
         DPRINTF(O3CPU, "ROB is not empty, squashing insts not in ROB.\n");
     }
 
@@ -1590,16 +1519,61 @@ CPU::wakeDependents(const DynInstPtr &inst)
     iew.wakeDependents(inst);
 }
 */
+bool
+CPU::pipelineStalled()
+{
+    // Only fetch may be active, and nothing may be left in the time
+    // buffers, as the activity recorder counts both.
+    if (activityRec.getActivityCount() != 1 ||
+        !activityRec.getStageActive(FetchIdx)) {
+        return false;
+    }
+
+    // Ticking any of the stages must not change its state, so that
+    // only their per cycle stats have to be accounted on wake up.
+    return !isDraining() && fetch.stalledOnDecode() &&
+        decode.canSkipCycles() && rename.canSkipCycles() &&
+        iew.canSkipCycles() && commit.canSkipCycles();
+}
+
+void
+CPU::endStallSkip()
+{
+    assert(stallSkipped);
+    stallSkipped = false;
+
+    // The cycle the CPU is woken up in is ticked as usual, so only
+    // the cycles in between are accounted here.
+    Cycles cycles(curCycle() - lastRunningCycle);
+    if (cycles > 1) {
+        --cycles;
+        DPRINTF(O3CPU, "Skipped %llu stalled cycles.\n", uint64_t(cycles));
+        cpuStats.stallSkippedCycles += cycles;
+        baseStats.numCycles += cycles;
+        fetch.recordStalledCycles(cycles);
+        decode.recordStalledCycles(cycles);
+        rename.recordStalledCycles(cycles);
+        iew.recordStalledCycles(cycles);
+        commit.recordStalledCycles(cycles);
+    }
+}
+
 void
 CPU::wakeCPU()
 {
-    if (activityRec.active() || tickEvent.scheduled()) {
+    if (tickEvent.scheduled() || (activityRec.active() && !stallSkipped)) {
         DPRINTF(Activity, "CPU already running.\n");
         return;
     }
 
     DPRINTF(Activity, "Waking up CPU\n");
 
+    if (stallSkipped) {
+        endStallSkip();
+        schedule(tickEvent, clockEdge());
+        return;
+    }
+
     Cycles cycles(curCycle() - lastRunningCycle);
     // @todo: This is an oddity that is only here to match the stats
     if (cycles > 1) {
@@ -1614,6 +1588,10 @@ CPU::wakeCPU()
 void
 CPU::wakeup(ThreadID tid)
 {
+    // Interrupts are noticed by commit, which has to tick again
+    if (stallSkipped)
+        wakeCPU();
+
     if (thread[tid]->status() != gem5::ThreadContext::Suspended)
         return;
 
@@ -45,6 +45,7 @@
 
 #include <iostream>
 #include <list>
+#include <memory>
 #include <queue>
 #include <set>
 #include <vector>
@@ -60,6 +61,8 @@
 #include "cpu/o3/fetch.hh"
 #include "cpu/o3/free_list.hh"
 #include "cpu/o3/iew.hh"
+#include "cpu/o3/inst_arena.hh"
+#include "cpu/o3/inst_list.hh"
 #include "cpu/o3/limits.hh"
 #include "cpu/o3/rename.hh"
 #include "cpu/o3/rob.hh"
@@ -95,7 +98,13 @@ class ThreadContext;
 class CPU : public BaseCPU
 {
   public:
-    typedef std::list<DynInstPtr>::iterator ListIt;
+    /** Accessor of the hook linking instructions in instList. */
+    struct InstListHookOf
+    {
+        static InstListHook<DynInst> &get(DynInst *inst);
+    };
+
+    typedef InstList<DynInst, InstListHookOf>::iterator ListIt;
 
     friend class ThreadContext;
 
@@ -322,16 +331,42 @@ class CPU : public BaseCPU
      */
     void setMiscReg(int misc_reg, RegVal val, ThreadID tid);
 
-    RegVal readIntReg(PhysRegIdPtr phys_reg);
+    /**
+     * @{
+     * Physical register accessors. These are defined here so that the
+     * operand accessors of the dynamic instructions, which know the
+     * class of each register, reach the register file arrays directly.
+     */
+    RegVal
+    readIntReg(PhysRegIdPtr phys_reg)
+    {
+        cpuStats.intRegfileReads++;
+        return regFile.readIntReg(phys_reg);
+    }
 
-    RegVal readFloatReg(PhysRegIdPtr phys_reg);
+    RegVal
+    readFloatReg(PhysRegIdPtr phys_reg)
+    {
+        cpuStats.fpRegfileReads++;
+        return regFile.readFloatReg(phys_reg);
+    }
 
-    const TheISA::VecRegContainer& readVecReg(PhysRegIdPtr reg_idx) const;
+    const TheISA::VecRegContainer&
+    readVecReg(PhysRegIdPtr phys_reg) const
+    {
+        cpuStats.vecRegfileReads++;
+        return regFile.readVecReg(phys_reg);
+    }
 
     /**
      * Read physical vector register for modification.
      */
-    TheISA::VecRegContainer& getWritableVecReg(PhysRegIdPtr reg_idx);
+    TheISA::VecRegContainer&
+    getWritableVecReg(PhysRegIdPtr phys_reg)
+    {
+        cpuStats.vecRegfileWrites++;
+        return regFile.getWritableVecReg(phys_reg);
+    }
 
     /** Returns current vector renaming mode */
     enums::VecRegRenameMode vecRenameMode() const { return vecMode; }
@@ -340,27 +375,77 @@ class CPU : public BaseCPU
     void vecRenameMode(enums::VecRegRenameMode vec_mode)
     { vecMode = vec_mode; }
 
-    const TheISA::VecElem& readVecElem(PhysRegIdPtr reg_idx) const;
+    const TheISA::VecElem&
+    readVecElem(PhysRegIdPtr phys_reg) const
+    {
+        cpuStats.vecRegfileReads++;
+        return regFile.readVecElem(phys_reg);
+    }
 
     const TheISA::VecPredRegContainer&
-        readVecPredReg(PhysRegIdPtr reg_idx) const;
+    readVecPredReg(PhysRegIdPtr phys_reg) const
+    {
+        cpuStats.vecPredRegfileReads++;
+        return regFile.readVecPredReg(phys_reg);
+    }
 
-    TheISA::VecPredRegContainer& getWritableVecPredReg(PhysRegIdPtr reg_idx);
+    TheISA::VecPredRegContainer&
+    getWritableVecPredReg(PhysRegIdPtr phys_reg)
+    {
+        cpuStats.vecPredRegfileWrites++;
+        return regFile.getWritableVecPredReg(phys_reg);
+    }
 
-    RegVal readCCReg(PhysRegIdPtr phys_reg);
+    RegVal
+    readCCReg(PhysRegIdPtr phys_reg)
+    {
+        cpuStats.ccRegfileReads++;
+        return regFile.readCCReg(phys_reg);
+    }
 
-    void setIntReg(PhysRegIdPtr phys_reg, RegVal val);
+    void
+    setIntReg(PhysRegIdPtr phys_reg, RegVal val)
+    {
+        cpuStats.intRegfileWrites++;
+        regFile.setIntReg(phys_reg, val);
+    }
 
-    void setFloatReg(PhysRegIdPtr phys_reg, RegVal val);
+    void
+    setFloatReg(PhysRegIdPtr phys_reg, RegVal val)
+    {
+        cpuStats.fpRegfileWrites++;
+        regFile.setFloatReg(phys_reg, val);
+    }
 
-    void setVecReg(PhysRegIdPtr reg_idx, const TheISA::VecRegContainer& val);
+    void
+    setVecReg(PhysRegIdPtr phys_reg, const TheISA::VecRegContainer& val)
+    {
+        cpuStats.vecRegfileWrites++;
+        regFile.setVecReg(phys_reg, val);
+    }
 
-    void setVecElem(PhysRegIdPtr reg_idx, const TheISA::VecElem& val);
+    void
+    setVecElem(PhysRegIdPtr phys_reg, const TheISA::VecElem& val)
+    {
+        cpuStats.vecRegfileWrites++;
+        regFile.setVecElem(phys_reg, val);
+    }
 
-    void setVecPredReg(PhysRegIdPtr reg_idx,
-            const TheISA::VecPredRegContainer& val);
+    void
+    setVecPredReg(PhysRegIdPtr phys_reg,
+            const TheISA::VecPredRegContainer& val)
+    {
+        cpuStats.vecPredRegfileWrites++;
+        regFile.setVecPredReg(phys_reg, val);
+    }
 
-    void setCCReg(PhysRegIdPtr phys_reg, RegVal val);
+    void
+    setCCReg(PhysRegIdPtr phys_reg, RegVal val)
+    {
+        cpuStats.ccRegfileWrites++;
+        regFile.setCCReg(phys_reg, val);
+    }
+    /** @} */
 
     RegVal readArchIntReg(int reg_idx, ThreadID tid);
 
@@ -453,13 +538,20 @@ class CPU : public BaseCPU
     void dumpInsts();
 
   public:
+    /**
+     * Arena the dynamic instructions are allocated from, if enabled. It
+     * is declared before anything that may hold instructions, so that
+     * it is destroyed after them.
+     */
+    std::unique_ptr<InstArena> instArena;
+
 #ifndef NDEBUG
     /** Count of total number of dynamic instructions in flight. */
     int instcount;
 #endif
 
     /** List of all the instructions in flight. */
-    std::list<DynInstPtr> instList;
+    InstList<DynInst, InstListHookOf> instList;
 
     /** List of all the instructions that will be removed at the end of this
      *  cycle.
@@ -564,6 +656,33 @@ class CPU : public BaseCPU
      */
     ActivityRecorder activityRec;
 
+    /** Stop ticking while the pipeline is stalled. */
+    const bool skipStallCycles;
+
+    /**
+     * Is the tick event suspended because the pipeline is stalled? The
+     * stages are still active, so the CPU has to be woken up even
+     * though the activity recorder says that it is running.
+     */
+    bool stallSkipped;
+
+    /**
+     * Check if ticking the CPU again would not change any of its state,
+     * i.e., no communication is in flight between the stages, all the
+     * stages but fetch are inactive, fetch is only waiting for decode
+     * to unblock, and none of the stages would change its status.
+     *
+     * @return True if the CPU can stop ticking until it is woken up.
+     */
+    bool pipelineStalled();
+
+    /**
+     * Account the cycles skipped while the pipeline was stalled, as if
+     * the CPU had been ticking, including the per cycle stats of all
+     * the stages.
+     */
+    void endStallSkip();
+
   public:
     /** Records that there was time buffer activity this cycle. */
     void activityThisCycle() { activityRec.activity(); }
@@ -671,6 +790,9 @@ class CPU : public BaseCPU
         /** Stat for total number of cycles the CPU spends descheduled due to a
          * quiesce operation or waiting for an interrupt. */
         statistics::Scalar quiesceCycles;
+        /** Stat for total number of cycles skipped while the pipeline was
+         * stalled. */
+        statistics::Scalar stallSkippedCycles;
         /** Stat for the number of committed instructions per thread. */
         statistics::Vector committedInsts;
         /** Stat for the number of committed ops (including micro ops) per
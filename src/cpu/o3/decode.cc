@@ -575,6 +575,39 @@ Decode::tick()
     }
 }
 
+bool
+Decode::canSkipCycles() const
+{
+    for (ThreadID tid : *activeThreads) {
+        // Blocked stays blocked as long as rename stalls it, running
+        // and idle stay so as long as there is nothing to decode, and
+        // the other states change on the next tick
+        if (decodeStatus[tid] == Blocked) {
+            if (!checkStall(tid))
+                return false;
+        } else if (decodeStatus[tid] != Running &&
+                   decodeStatus[tid] != Idle) {
+            return false;
+        } else if (checkStall(tid) || !insts[tid].empty()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void
+Decode::recordStalledCycles(Cycles cycles)
+{
+    // see decode() and decodeInsts()
+    for (ThreadID tid : *activeThreads) {
+        if (decodeStatus[tid] == Blocked)
+            stats.blockedCycles += cycles;
+        else
+            stats.idleCycles += cycles;
+    }
+}
+
 void
 Decode::decode(bool &status_change, ThreadID tid)
 {
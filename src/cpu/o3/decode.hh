@@ -136,6 +136,18 @@ class Decode
      */
     void tick();
 
+    /** Checks if ticking decode would only update its per cycle stats,
+     * i.e., it stays blocked or has no instructions to decode, so that
+     * the CPU may skip ticking it.
+     */
+    bool canSkipCycles() const;
+
+    /** Accounts the cycles decode was not ticked while the CPU skipped
+     * them, as if it had been.
+     * @param cycles Number of skipped cycles.
+     */
+    void recordStalledCycles(Cycles cycles);
+
     /** Determines what to do based on decode's current status.
      * @param status_change decode() sets this variable if there was a status
      * change (ie switching from from blocking to unblocking).
@@ -211,13 +223,13 @@ class Decode
     TimeBuffer<TimeStruct> *timeBuffer;
 
     /** Wire to get rename's output from backwards time buffer. */
-    TimeBuffer<TimeStruct>::wire fromRename;
+    TimeBuffer<TimeStruct>::const_wire fromRename;
 
     /** Wire to get iew's information from backwards time buffer. */
-    TimeBuffer<TimeStruct>::wire fromIEW;
+    TimeBuffer<TimeStruct>::const_wire fromIEW;
 
     /** Wire to get commit's information from backwards time buffer. */
-    TimeBuffer<TimeStruct>::wire fromCommit;
+    TimeBuffer<TimeStruct>::const_wire fromCommit;
 
     /** Wire to write information heading to previous stages. */
     // Might not be the best name as not only fetch will read it.
@@ -233,7 +245,7 @@ class Decode
     TimeBuffer<FetchStruct> *fetchQueue;
 
     /** Wire to get fetch's output from fetch queue. */
-    TimeBuffer<FetchStruct>::wire fromFetch;
+    TimeBuffer<FetchStruct>::const_wire fromFetch;
 
     /** Queue of all instructions coming from fetch this cycle. */
     std::queue<DynInstPtr> insts[MaxThreads];
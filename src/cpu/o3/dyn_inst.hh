@@ -58,6 +58,9 @@
 #include "cpu/inst_seq.hh"
 #include "cpu/o3/cpu.hh"
 #include "cpu/o3/dyn_inst_ptr.hh"
+#include "cpu/o3/inst_arena.hh"
+#include "cpu/o3/inst_fifo.hh"
+#include "cpu/o3/inst_list.hh"
 #include "cpu/o3/lsq_unit.hh"
 #include "cpu/op_class.hh"
 #include "cpu/reg_class.hh"
@@ -76,9 +79,6 @@ namespace o3
 class DynInst : public ExecContext, public RefCounted
 {
   public:
-    // The list of instructions iterator type.
-    typedef typename std::list<DynInstPtr>::iterator ListIt;
-
     /** BaseDynInst constructor given a binary instruction. */
     DynInst(const StaticInstPtr &staticInst, const StaticInstPtr
             &macroop, TheISA::PCState pc, TheISA::PCState predPC,
@@ -89,6 +89,20 @@ class DynInst : public ExecContext, public RefCounted
 
     ~DynInst();
 
+    /**
+     * Dynamic instructions are either allocated from the arena of their
+     * CPU, using new (arena) DynInst(...), or on the heap. Both can be
+     * deleted the usual way, which returns the storage where it came
+     * from.
+     */
+    static void *operator new(size_t size)
+    { return InstArena::allocateHeap(size); }
+    static void *operator new(size_t size, InstArena &arena)
+    { return arena.allocate(size); }
+    static void operator delete(void *ptr) { InstArena::release(ptr); }
+    static void operator delete(void *ptr, InstArena &arena)
+    { InstArena::release(ptr); }
+
     /** Executes the instruction.*/
     Fault execute();
 
@@ -356,8 +370,20 @@ class DynInst : public ExecContext, public RefCounted
     /** The thread this instruction is from. */
     ThreadID threadNumber = 0;
 
-    /** Iterator pointing to this BaseDynInst in the list of all insts. */
-    ListIt instListIt;
+    /** Link in the CPU's list of all insts. */
+    InstListHook<DynInst> cpuHook;
+
+    /** Link in the ROB's list of instructions of this thread. */
+    InstListHook<DynInst> robHook;
+
+    /** Link in the IQ's list of instructions of this thread. */
+    InstListHook<DynInst> iqHook;
+
+    /** Link in the memory dependence unit's list of instructions. */
+    InstListHook<DynInst> memDepHook;
+
+    /** Link in the IQ's list of instructions ready to execute. */
+    InstFifoHook<DynInst> executeHook;
 
     ////////////////////// Branch Data ///////////////
     /** Predicted PC state after this instruction. */
@@ -1033,12 +1059,6 @@ class DynInst : public ExecContext, public RefCounted
     /** Assert this instruction has generated a memory request. */
     void setRequest() { instFlags[ReqMade] = true; }
 
-    /** Returns iterator to this instruction in the list of all insts. */
-    ListIt &getInstListIt() { return instListIt; }
-
-    /** Sets iterator for this instruction in the list of all insts. */
-    void setInstListIt(ListIt _instListIt) { instListIt = _instListIt; }
-
   public:
     /** Returns the number of consecutive store conditional failures. */
     unsigned int
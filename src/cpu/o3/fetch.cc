@@ -938,6 +938,52 @@ Fetch::tick()
     numInst = 0;
 }
 
+bool
+Fetch::stalledOnDecode() const
+{
+    if (numThreads != 1 || activeThreads->size() != 1)
+        return false;
+
+    ThreadID tid = activeThreads->front();
+
+    // Nothing can be added to the fetch queue nor sent to decode
+    if (fetchStatus[tid] != Running || !stalls[tid].decode ||
+        stalls[tid].drain || fetchQueue[tid].size() < fetchQueueSize ||
+        issuePipelinedIfetch[tid]) {
+        return false;
+    }
+
+    // Fetch must not go to the instruction cache either, see fetch()
+    const TheISA::PCState &this_pc = pc[tid];
+    Addr fetch_addr = (this_pc.instAddr() + fetchOffset[tid]) &
+        decoder[tid]->pcMask();
+
+    return (fetchBufferValid[tid] &&
+            fetchBufferAlignPC(fetch_addr) == fetchBufferPC[tid]) ||
+        isRomMicroPC(this_pc.microPC()) || macroop[tid];
+}
+
+void
+Fetch::recordStalledCycles(Cycles cycles)
+{
+    ThreadID tid = activeThreads->front();
+
+    if (checkInterrupt(pc[tid].instAddr()) && !delayedCommit[tid])
+        fetchStats.miscStallCycles += cycles;
+    else
+        fetchStats.cycles += cycles;
+
+    fetchStats.nisnDist.sample(0, cycles);
+
+    // Draw the random numbers tick() would have drawn to pick a thread
+    // to send instructions to decode from, so that the random numbers
+    // seen by the rest of the system are the same as if fetch had been
+    // ticked. The skip needs a single active thread, see
+    // stalledOnDecode(), which each of the picks would have returned.
+    for (Cycles i(0); i < cycles; ++i)
+        random_mt.random<uint8_t>(0, 0);
+}
+
 bool
 Fetch::checkSignalsAndUpdate(ThreadID tid)
 {
@@ -1051,7 +1097,9 @@ Fetch::buildInst(ThreadID tid, StaticInstPtr staticInst,
     InstSeqNum seq = cpu->getAndIncrementInstSeq();
 
     // Create a new DynInst from the instruction fetched.
-    DynInstPtr instruction =
+    DynInstPtr instruction = cpu->instArena ?
+        new (*cpu->instArena) DynInst(staticInst, curMacroop, thisPC, nextPC,
+                                      seq, cpu) :
         new DynInst(staticInst, curMacroop, thisPC, nextPC, seq, cpu);
     instruction->setTid(tid);
 
@@ -1076,7 +1124,7 @@ Fetch::buildInst(ThreadID tid, StaticInstPtr staticInst,
 #endif
 
     // Add instruction to the CPU's list of instructions.
-    instruction->setInstListIt(cpu->addInst(instruction));
+    cpu->addInst(instruction);
 
     // Write the instruction to the first slot in the queue
     // that heads to decode.
@@ -337,6 +337,24 @@ class Fetch
      */
     void tick();
 
+    /**
+     * Check if fetch is only waiting for decode to unblock, in which
+     * case ticking it does not change its state. Only a single thread
+     * is handled, as the SMT fetch policies keep changing threads.
+     *
+     * @return True if fetch is stalled behind decode.
+     */
+    bool stalledOnDecode() const;
+
+    /**
+     * Account the cycles that fetch was not ticked while it was stalled
+     * behind decode, as if it had been. This includes drawing the random
+     * numbers of the skipped cycles.
+     *
+     * @param cycles Number of skipped cycles.
+     */
+    void recordStalledCycles(Cycles cycles);
+
     /** Checks all input signals and updates the status as necessary.
      *  @return: Returns if the status has changed due to input signals.
      */
@@ -350,7 +368,7 @@ class Fetch
     void fetch(bool &status_change);
 
     /** Align a PC to the start of a fetch buffer block. */
-    Addr fetchBufferAlignPC(Addr addr)
+    Addr fetchBufferAlignPC(Addr addr) const
     {
         return (addr & ~(fetchBufferMask));
     }
@@ -395,16 +413,16 @@ class Fetch
     TimeBuffer<TimeStruct> *timeBuffer;
 
     /** Wire to get decode's information from backwards time buffer. */
-    TimeBuffer<TimeStruct>::wire fromDecode;
+    TimeBuffer<TimeStruct>::const_wire fromDecode;
 
     /** Wire to get rename's information from backwards time buffer. */
-    TimeBuffer<TimeStruct>::wire fromRename;
+    TimeBuffer<TimeStruct>::const_wire fromRename;
 
     /** Wire to get iew's information from backwards time buffer. */
-    TimeBuffer<TimeStruct>::wire fromIEW;
+    TimeBuffer<TimeStruct>::const_wire fromIEW;
 
     /** Wire to get commit's information from backwards time buffer. */
-    TimeBuffer<TimeStruct>::wire fromCommit;
+    TimeBuffer<TimeStruct>::const_wire fromCommit;
 
     //Might be annoying how this name is different than the queue.
     /** Wire used to write any information heading to decode. */
@@ -1558,6 +1558,48 @@ IEW::tick()
     }
 }
 
+bool
+IEW::canSkipCycles()
+{
+    // Anything to execute, write back or broadcast to the other stages
+    // changes the state on the next tick
+    if (exeStatus != Idle || updateLSQNextCycle ||
+        instQueue.hasReadyInsts() || ldstQueue.willWB()) {
+        return false;
+    }
+
+    for (ThreadID tid : *activeThreads) {
+        // Blocked stays blocked as long as it is stalled, running and
+        // idle stay so as long as there is nothing to dispatch, and the
+        // other states change on the next tick
+        if (dispatchStatus[tid] == Blocked) {
+            if (!checkStall(tid))
+                return false;
+        } else if (dispatchStatus[tid] != Running &&
+                   dispatchStatus[tid] != Idle) {
+            return false;
+        } else if (checkStall(tid) || !insts[tid].empty()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void
+IEW::recordStalledCycles(Cycles cycles)
+{
+    // see dispatch()
+    for (ThreadID tid : *activeThreads) {
+        if (dispatchStatus[tid] == Blocked)
+            iewStats.blockCycles += cycles;
+    }
+
+    // see tick() and updateStatus()
+    instQueue.recordStalledCycles(cycles);
+    instQueue.iqIOStats.intInstQueueReads += cycles;
+}
+
 void
 IEW::updateExeInstStats(const DynInstPtr& inst)
 {
@@ -292,6 +292,19 @@ class IEW
      */
     void tick();
 
+    /** Checks if ticking IEW would only update its per cycle stats,
+     * i.e., dispatch stays blocked or has nothing to dispatch, and
+     * nothing can be issued or executed, so that the CPU may skip
+     * ticking it.
+     */
+    bool canSkipCycles();
+
+    /** Accounts the cycles IEW was not ticked while the CPU skipped
+     * them, as if it had been.
+     * @param cycles Number of skipped cycles.
+     */
+    void recordStalledCycles(Cycles cycles);
+
   private:
     /** Updates execution stats based on the instruction. */
     void updateExeInstStats(const DynInstPtr &inst);
@@ -303,7 +316,7 @@ class IEW
     TimeBuffer<TimeStruct>::wire toFetch;
 
     /** Wire to get commit's output from backwards time buffer. */
-    TimeBuffer<TimeStruct>::wire fromCommit;
+    TimeBuffer<TimeStruct>::const_wire fromCommit;
 
     /** Wire to write information heading to previous stages. */
     TimeBuffer<TimeStruct>::wire toRename;
@@ -312,13 +325,13 @@ class IEW
     TimeBuffer<RenameStruct> *renameQueue;
 
     /** Wire to get rename's output from rename queue. */
-    TimeBuffer<RenameStruct>::wire fromRename;
+    TimeBuffer<RenameStruct>::const_wire fromRename;
 
     /** Issue stage queue. */
     TimeBuffer<IssueStruct> issueToExecQueue;
 
     /** Wire to read information from the issue stage time queue. */
-    TimeBuffer<IssueStruct>::wire fromIssue;
+    TimeBuffer<IssueStruct>::const_wire fromIssue;
 
     /**
      * IEW stage time buffer.  Holds ROB indices of instructions that
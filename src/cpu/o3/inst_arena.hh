@@ -0,0 +1,189 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_INST_ARENA_HH__
+#define __CPU_O3_INST_ARENA_HH__
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace gem5
+{
+
+namespace o3
+{
+
+/**
+ * A pool of fixed-size slots for the dynamic instructions of a CPU.
+ * Instructions are created and destroyed at a high rate, but the number
+ * in flight is bounded by the sizes of the pipeline structures, so the
+ * arena keeps the released slots on a free list and reuses them rather
+ * than going through the heap for every instruction. Slots are carved
+ * out of large chunks, and more chunks are allocated if the initial
+ * estimate turns out to be too small.
+ *
+ * Every slot starts with a header pointing to its arena, so that a slot
+ * can be released without knowing where it came from. Objects that do
+ * not come from an arena (e.g., if the arena is disabled) are allocated
+ * on the heap with a null header, and are released back to the heap.
+ *
+ * The arena must outlive all of its slots.
+ */
+class InstArena
+{
+  private:
+    /** Header at the beginning of every slot. */
+    union Header
+    {
+        InstArena *arena;
+        Header *nextFree;
+        std::max_align_t align;
+    };
+
+    /** Size of the objects held by the slots, in bytes. */
+    const std::size_t objSize;
+
+    /** Number of slots allocated in each chunk. */
+    const std::size_t slotsPerChunk;
+
+    /** The chunks the slots are carved out of. */
+    std::vector<std::unique_ptr<Header[]>> chunks;
+
+    /** The first free slot, if any. */
+    Header *freeList = nullptr;
+
+    /** Number of slots currently in use. */
+    std::size_t _inUse = 0;
+
+    /** Number of headers that a slot is made of. */
+    std::size_t
+    headersPerSlot() const
+    {
+        return 1 + (objSize + sizeof(Header) - 1) / sizeof(Header);
+    }
+
+    void
+    grow()
+    {
+        const std::size_t stride = headersPerSlot();
+        chunks.emplace_back(new Header[stride * slotsPerChunk]);
+        Header *chunk = chunks.back().get();
+        for (std::size_t i = slotsPerChunk; i-- > 0;) {
+            chunk[i * stride].nextFree = freeList;
+            freeList = &chunk[i * stride];
+        }
+    }
+
+  public:
+    /**
+     * @param obj_size Size of the objects held by the slots, in bytes.
+     * @param slots_per_chunk Number of slots allocated at once, which
+     *        should cover the instructions usually in flight.
+     */
+    InstArena(std::size_t obj_size, std::size_t slots_per_chunk)
+        : objSize(obj_size), slotsPerChunk(slots_per_chunk)
+    {
+        assert(slotsPerChunk > 0);
+    }
+
+    InstArena(const InstArena &) = delete;
+    InstArena &operator=(const InstArena &) = delete;
+
+    /**
+     * Get a slot for an object.
+     *
+     * @param size Size of the object, which must fit in a slot.
+     * @return Storage for the object.
+     */
+    void *
+    allocate(std::size_t size)
+    {
+        assert(size <= objSize);
+        if (!freeList)
+            grow();
+
+        Header *slot = freeList;
+        freeList = slot->nextFree;
+        slot->arena = this;
+        ++_inUse;
+        return slot + 1;
+    }
+
+    /**
+     * Allocate storage for an object on the heap, with a header showing
+     * that it does not belong to any arena.
+     *
+     * @param size Size of the object.
+     * @return Storage for the object.
+     */
+    static void *
+    allocateHeap(std::size_t size)
+    {
+        Header *slot = static_cast<Header *>(
+            ::operator new(sizeof(Header) + size));
+        slot->arena = nullptr;
+        return slot + 1;
+    }
+
+    /**
+     * Release the storage of an object allocated by allocate() or
+     * allocateHeap(), returning it to where it came from.
+     *
+     * @param ptr Storage of the object.
+     */
+    static void
+    release(void *ptr)
+    {
+        if (!ptr)
+            return;
+
+        Header *slot = static_cast<Header *>(ptr) - 1;
+        InstArena *arena = slot->arena;
+        if (!arena) {
+            ::operator delete(slot);
+            return;
+        }
+
+        assert(arena->_inUse > 0);
+        --arena->_inUse;
+        slot->nextFree = arena->freeList;
+        arena->freeList = slot;
+    }
+
+    /** @return The number of slots currently in use. */
+    std::size_t inUse() const { return _inUse; }
+
+    /** @return The total number of slots, free or in use. */
+    std::size_t capacity() const { return chunks.size() * slotsPerChunk; }
+};
+
+} // namespace o3
+} // namespace gem5
+
+#endif // __CPU_O3_INST_ARENA_HH__
@@ -0,0 +1,108 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <set>
+#include <vector>
+
+#include "cpu/o3/inst_arena.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+struct Obj
+{
+    uint64_t payload[5];
+
+    static void *operator new(size_t size, o3::InstArena &arena)
+    { return arena.allocate(size); }
+    static void *operator new(size_t size)
+    { return o3::InstArena::allocateHeap(size); }
+    static void operator delete(void *ptr) { o3::InstArena::release(ptr); }
+    static void operator delete(void *ptr, o3::InstArena &)
+    { o3::InstArena::release(ptr); }
+};
+
+} // anonymous namespace
+
+/** Released slots are reused before growing the arena. */
+TEST(InstArenaTest, ReuseSlots)
+{
+    o3::InstArena arena(sizeof(Obj), 4);
+
+    std::vector<Obj *> objs;
+    for (int i = 0; i < 4; i++)
+        objs.push_back(new (arena) Obj);
+    EXPECT_EQ(arena.inUse(), 4);
+    EXPECT_EQ(arena.capacity(), 4);
+
+    std::set<Obj *> released(objs.begin(), objs.end());
+    for (auto obj : objs)
+        delete obj;
+    EXPECT_EQ(arena.inUse(), 0);
+
+    for (int i = 0; i < 4; i++)
+        EXPECT_EQ(released.count(new (arena) Obj), 1);
+    EXPECT_EQ(arena.capacity(), 4);
+}
+
+/** The arena grows when all of its slots are in use. */
+TEST(InstArenaTest, Grow)
+{
+    o3::InstArena arena(sizeof(Obj), 2);
+
+    std::set<Obj *> objs;
+    for (int i = 0; i < 5; i++) {
+        Obj *obj = new (arena) Obj;
+        for (auto &word : obj->payload)
+            word = i;
+        objs.insert(obj);
+    }
+    EXPECT_EQ(objs.size(), 5);
+    EXPECT_EQ(arena.inUse(), 5);
+    EXPECT_EQ(arena.capacity(), 6);
+
+    for (auto obj : objs)
+        delete obj;
+    EXPECT_EQ(arena.inUse(), 0);
+}
+
+/** Objects not allocated from an arena go back to the heap. */
+TEST(InstArenaTest, Heap)
+{
+    o3::InstArena arena(sizeof(Obj), 2);
+
+    Obj *heap_obj = new Obj;
+    Obj *arena_obj = new (arena) Obj;
+    EXPECT_EQ(arena.inUse(), 1);
+
+    delete heap_obj;
+    EXPECT_EQ(arena.inUse(), 1);
+    delete arena_obj;
+    EXPECT_EQ(arena.inUse(), 0);
+}
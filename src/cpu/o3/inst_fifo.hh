@@ -0,0 +1,185 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_INST_FIFO_HH__
+#define __CPU_O3_INST_FIFO_HH__
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+
+#include "base/refcnt.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+/**
+ * The links of an instruction in an InstFifo. An instruction has one
+ * hook for each of the queues it can be in, so that queueing it does
+ * not allocate a list node.
+ */
+template <class Inst>
+struct InstFifoHook
+{
+    Inst *next = nullptr;
+    bool linked = false;
+};
+
+/**
+ * A FIFO of reference counted instructions linked through a hook inside
+ * the instructions themselves. The queue holds a reference to each of
+ * its instructions, as a list of reference counting pointers would, but
+ * pushing and popping do not touch the heap. An instruction can only be
+ * in one queue per hook at a time.
+ *
+ * The hook is found by HookOf::get(inst), which allows declaring a queue
+ * where the instruction class is still incomplete.
+ */
+template <class Inst, class HookOf>
+class InstFifo
+{
+  private:
+    Inst *head = nullptr;
+    Inst *tail = nullptr;
+    std::size_t _size = 0;
+
+  public:
+    using Ptr = RefCountingPtr<Inst>;
+
+    /** Iterator over the instructions, from the oldest one. */
+    class const_iterator
+    {
+      private:
+        Inst *inst;
+
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Ptr;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Inst *;
+        using reference = Ptr;
+
+        explicit const_iterator(Inst *_inst) : inst(_inst) {}
+
+        Inst *operator->() const { return inst; }
+        Ptr operator*() const { return Ptr(inst); }
+
+        const_iterator &
+        operator++()
+        {
+            inst = HookOf::get(inst).next;
+            return *this;
+        }
+
+        const_iterator
+        operator++(int)
+        {
+            const_iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator==(const const_iterator &o) const
+        { return inst == o.inst; }
+        bool operator!=(const const_iterator &o) const
+        { return inst != o.inst; }
+    };
+
+    InstFifo() = default;
+    InstFifo(const InstFifo &) = delete;
+    InstFifo &operator=(const InstFifo &) = delete;
+
+    ~InstFifo() { clear(); }
+
+    bool empty() const { return !head; }
+    std::size_t size() const { return _size; }
+
+    const_iterator begin() const { return const_iterator(head); }
+    const_iterator end() const { return const_iterator(nullptr); }
+
+    /** Append an instruction, taking a reference to it. */
+    void
+    push_back(const Ptr &inst)
+    {
+        auto &hook = HookOf::get(inst.get());
+        assert(!hook.linked);
+        hook.linked = true;
+        hook.next = nullptr;
+        inst->incref();
+
+        if (tail)
+            HookOf::get(tail).next = inst.get();
+        else
+            head = inst.get();
+        tail = inst.get();
+        ++_size;
+    }
+
+    /** @return The oldest instruction. */
+    Ptr
+    front() const
+    {
+        assert(head);
+        return Ptr(head);
+    }
+
+    /**
+     * Remove the oldest instruction, and hand over the queue's
+     * reference to it.
+     *
+     * @return The instruction removed.
+     */
+    Ptr
+    pop_front()
+    {
+        assert(head);
+        Ptr inst(head);
+        auto &hook = HookOf::get(head);
+        head = hook.next;
+        if (!head)
+            tail = nullptr;
+        hook.next = nullptr;
+        hook.linked = false;
+        --_size;
+        inst->decref();
+        return inst;
+    }
+
+    /** Remove all the instructions. */
+    void
+    clear()
+    {
+        while (!empty())
+            pop_front();
+    }
+};
+
+} // namespace o3
+} // namespace gem5
+
+#endif // __CPU_O3_INST_FIFO_HH__
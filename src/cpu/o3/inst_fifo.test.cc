@@ -0,0 +1,102 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "base/refcnt.hh"
+#include "cpu/o3/inst_fifo.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+struct Inst : public RefCounted
+{
+    int id;
+    o3::InstFifoHook<Inst> hook;
+
+    static int live;
+
+    Inst(int _id) : id(_id) { live++; }
+    ~Inst() { live--; }
+};
+
+int Inst::live = 0;
+
+struct HookOf
+{
+    static o3::InstFifoHook<Inst> &get(Inst *inst) { return inst->hook; }
+};
+
+typedef RefCountingPtr<Inst> InstPtr;
+typedef o3::InstFifo<Inst, HookOf> Fifo;
+
+} // anonymous namespace
+
+/** Instructions come out in the order they were pushed. */
+TEST(InstFifoTest, FifoOrder)
+{
+    Fifo fifo;
+    for (int i = 0; i < 4; i++)
+        fifo.push_back(new Inst(i));
+    EXPECT_EQ(fifo.size(), 4);
+
+    std::vector<int> ids;
+    for (auto it = fifo.begin(); it != fifo.end(); it++)
+        ids.push_back(it->id);
+    EXPECT_EQ(ids, std::vector<int>({0, 1, 2, 3}));
+
+    for (int i = 0; i < 4; i++) {
+        EXPECT_EQ(fifo.front()->id, i);
+        EXPECT_EQ(fifo.pop_front()->id, i);
+    }
+    EXPECT_TRUE(fifo.empty());
+    EXPECT_EQ(Inst::live, 0);
+}
+
+/** The queue holds a reference to each of its instructions. */
+TEST(InstFifoTest, References)
+{
+    {
+        Fifo fifo;
+        InstPtr inst = new Inst(0);
+        fifo.push_back(inst);
+        EXPECT_EQ(inst->getCount(), 2);
+
+        inst = nullptr;
+        EXPECT_EQ(Inst::live, 1);
+
+        InstPtr popped = fifo.pop_front();
+        EXPECT_EQ(popped->getCount(), 1);
+
+        // Once out of the queue, the instruction can be queued again
+        fifo.push_back(popped);
+        fifo.push_back(new Inst(1));
+    }
+    EXPECT_EQ(Inst::live, 0);
+}
@@ -0,0 +1,254 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_INST_LIST_HH__
+#define __CPU_O3_INST_LIST_HH__
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+
+#include "base/refcnt.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+/**
+ * The links of an instruction in an InstList. As with an InstFifoHook,
+ * an instruction has one hook for each of the lists it can be in.
+ */
+template <class Inst>
+struct InstListHook
+{
+    Inst *prev = nullptr;
+    Inst *next = nullptr;
+    bool linked = false;
+};
+
+/**
+ * A doubly linked list of reference counted instructions, linked through
+ * a hook inside the instructions themselves. It is a drop in replacement
+ * for the std::list<DynInstPtr> the pipeline structures used to keep
+ * their instructions in, without a heap allocated node per instruction.
+ * Removing an instruction from the middle of the list only needs the
+ * instruction, as its links are found through its hook.
+ *
+ * Iterators stay valid until the instruction they point to is erased.
+ * Decrementing the iterator to the first instruction gives end(), and
+ * decrementing end() gives the last instruction, as with std::list.
+ */
+template <class Inst, class HookOf>
+class InstList
+{
+  private:
+    Inst *head = nullptr;
+    Inst *tail = nullptr;
+    std::size_t _size = 0;
+
+  public:
+    using Ptr = RefCountingPtr<Inst>;
+
+    /** Bidirectional iterator over the instructions. */
+    class iterator
+    {
+      private:
+        friend class InstList;
+
+        const InstList *list = nullptr;
+        Inst *inst = nullptr;
+
+        iterator(const InstList *_list, Inst *_inst)
+            : list(_list), inst(_inst)
+        {}
+
+      public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = Ptr;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Inst *;
+        using reference = Ptr;
+
+        iterator() = default;
+
+        Inst *operator->() const { return inst; }
+        Ptr operator*() const { return Ptr(inst); }
+
+        iterator &
+        operator++()
+        {
+            inst = inst ? HookOf::get(inst).next : list->head;
+            return *this;
+        }
+
+        iterator
+        operator++(int)
+        {
+            iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        iterator &
+        operator--()
+        {
+            inst = inst ? HookOf::get(inst).prev : list->tail;
+            return *this;
+        }
+
+        iterator
+        operator--(int)
+        {
+            iterator old = *this;
+            --*this;
+            return old;
+        }
+
+        bool operator==(const iterator &o) const
+        { return list == o.list && inst == o.inst; }
+        bool operator!=(const iterator &o) const
+        { return !(*this == o); }
+    };
+
+    using const_iterator = iterator;
+
+    InstList() = default;
+    InstList(const InstList &) = delete;
+    InstList &operator=(const InstList &) = delete;
+
+    ~InstList() { clear(); }
+
+    bool empty() const { return !head; }
+    std::size_t size() const { return _size; }
+
+    iterator begin() const { return iterator(this, head); }
+    iterator end() const { return iterator(this, nullptr); }
+
+    /** @return An iterator to an instruction of this list. */
+    iterator
+    iteratorTo(Inst *inst) const
+    {
+        assert(HookOf::get(inst).linked);
+        return iterator(this, inst);
+    }
+
+    Ptr
+    front() const
+    {
+        assert(head);
+        return Ptr(head);
+    }
+
+    Ptr
+    back() const
+    {
+        assert(tail);
+        return Ptr(tail);
+    }
+
+    /**
+     * Append an instruction, taking a reference to it.
+     *
+     * @return An iterator to the instruction.
+     */
+    iterator
+    push_back(const Ptr &inst)
+    {
+        auto &hook = HookOf::get(inst.get());
+        assert(!hook.linked);
+        hook.linked = true;
+        hook.prev = tail;
+        hook.next = nullptr;
+        inst->incref();
+
+        if (tail)
+            HookOf::get(tail).next = inst.get();
+        else
+            head = inst.get();
+        tail = inst.get();
+        ++_size;
+        return iterator(this, tail);
+    }
+
+    /**
+     * Remove an instruction, and drop the list's reference to it.
+     *
+     * @return An iterator to the instruction that followed it.
+     */
+    iterator
+    erase(iterator it)
+    {
+        assert(it.list == this && it.inst);
+        Inst *inst = it.inst;
+        auto &hook = HookOf::get(inst);
+        assert(hook.linked);
+        Inst *next = hook.next;
+
+        if (hook.prev)
+            HookOf::get(hook.prev).next = next;
+        else
+            head = next;
+        if (next)
+            HookOf::get(next).prev = hook.prev;
+        else
+            tail = hook.prev;
+
+        hook.prev = nullptr;
+        hook.next = nullptr;
+        hook.linked = false;
+        --_size;
+        inst->decref();
+        return iterator(this, next);
+    }
+
+    /**
+     * Remove the first instruction, and hand over the list's reference
+     * to it.
+     *
+     * @return The instruction removed.
+     */
+    Ptr
+    pop_front()
+    {
+        Ptr inst = front();
+        erase(begin());
+        return inst;
+    }
+
+    /** Remove all the instructions. */
+    void
+    clear()
+    {
+        while (!empty())
+            erase(begin());
+    }
+};
+
+} // namespace o3
+} // namespace gem5
+
+#endif // __CPU_O3_INST_LIST_HH__
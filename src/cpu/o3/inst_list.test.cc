@@ -0,0 +1,149 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "base/refcnt.hh"
+#include "cpu/o3/inst_list.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+struct Inst : public RefCounted
+{
+    int id;
+    o3::InstListHook<Inst> hook;
+
+    static int live;
+
+    Inst(int _id) : id(_id) { live++; }
+    ~Inst() { live--; }
+};
+
+int Inst::live = 0;
+
+struct HookOf
+{
+    static o3::InstListHook<Inst> &get(Inst *inst) { return inst->hook; }
+};
+
+typedef RefCountingPtr<Inst> InstPtr;
+typedef o3::InstList<Inst, HookOf> List;
+
+std::vector<int>
+ids(const List &list)
+{
+    std::vector<int> ids;
+    for (auto it = list.begin(); it != list.end(); it++)
+        ids.push_back(it->id);
+    return ids;
+}
+
+} // anonymous namespace
+
+/** Instructions are kept in the order they were appended. */
+TEST(InstListTest, Order)
+{
+    List list;
+    for (int i = 0; i < 4; i++)
+        list.push_back(new Inst(i));
+    EXPECT_EQ(list.size(), 4);
+    EXPECT_EQ(ids(list), std::vector<int>({0, 1, 2, 3}));
+    EXPECT_EQ(list.front()->id, 0);
+    EXPECT_EQ(list.back()->id, 3);
+
+    std::vector<int> reversed;
+    auto it = list.end();
+    while (--it != list.end())
+        reversed.push_back(it->id);
+    EXPECT_EQ(reversed, std::vector<int>({3, 2, 1, 0}));
+
+    EXPECT_EQ(list.pop_front()->id, 0);
+    EXPECT_EQ(ids(list), std::vector<int>({1, 2, 3}));
+    list.clear();
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(Inst::live, 0);
+}
+
+/** Instructions can be erased from anywhere, walking backwards. */
+TEST(InstListTest, EraseBackwards)
+{
+    List list;
+    InstPtr insts[4];
+    for (int i = 0; i < 4; i++) {
+        insts[i] = new Inst(i);
+        list.push_back(insts[i]);
+    }
+
+    EXPECT_EQ(list.erase(list.iteratorTo(insts[1].get()))->id, 2);
+    EXPECT_EQ(ids(list), std::vector<int>({0, 2, 3}));
+
+    // The way the squash loops remove the youngest instructions
+    auto it = list.end();
+    it--;
+    while (it != list.end() && it->id > 0)
+        list.erase(it--);
+    EXPECT_EQ(ids(list), std::vector<int>({0}));
+
+    list.erase(list.begin());
+    EXPECT_TRUE(list.empty());
+    EXPECT_TRUE(list.begin() == list.end());
+
+    // Once out of the list, an instruction can be appended again
+    list.push_back(insts[3]);
+    EXPECT_EQ(ids(list), std::vector<int>({3}));
+}
+
+/** The list holds a reference to each of its instructions. */
+TEST(InstListTest, References)
+{
+    {
+        List list;
+        InstPtr inst = new Inst(0);
+        auto it = list.push_back(inst);
+        EXPECT_EQ(inst->getCount(), 2);
+
+        inst = nullptr;
+        EXPECT_EQ(Inst::live, 1);
+        EXPECT_EQ(it->getCount(), 1);
+
+        list.push_back(new Inst(1));
+        list.erase(it);
+        EXPECT_EQ(Inst::live, 1);
+    }
+    EXPECT_EQ(Inst::live, 0);
+}
+
+/** Iterators of different lists never compare equal. */
+TEST(InstListTest, DistinctEnds)
+{
+    List a, b;
+    EXPECT_TRUE(a.end() != b.end());
+    EXPECT_TRUE(a.end() == a.begin());
+}
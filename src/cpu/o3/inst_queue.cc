@@ -41,6 +41,7 @@
 
 #include "cpu/o3/inst_queue.hh"
 
+#include <iterator>
 #include <limits>
 #include <vector>
 
@@ -111,6 +112,15 @@ InstructionQueue::InstructionQueue(CPU *cpu_ptr, IEW *iew_ptr,
     //dependency graph.
     dependGraph.resize(numPhysRegs);
 
+    if (params.iq_matrix_scheduler) {
+        // The ready instructions are all in flight, so their ages are
+        // mostly within a few ROBs of each other.
+        readyMatrix = std::make_unique<ReadyMatrix<DynInstPtr>>(
+            Num_OpClasses, 4 * params.numROBEntries);
+        wakeupMatrix = std::make_unique<WakeupMatrix<DynInstPtr>>(
+            numPhysRegs, numEntries);
+    }
+
     // Resize the register scoreboard.
     regScoreboard.resize(numPhysRegs);
 
@@ -158,6 +168,18 @@ InstructionQueue::InstructionQueue(CPU *cpu_ptr, IEW *iew_ptr,
     }
 }
 
+InstListHook<DynInst> &
+InstructionQueue::InstListHookOf::get(DynInst *inst)
+{
+    return inst->iqHook;
+}
+
+InstFifoHook<DynInst> &
+InstructionQueue::ExecuteHook::get(DynInst *inst)
+{
+    return inst->executeHook;
+}
+
 InstructionQueue::~InstructionQueue()
 {
     dependGraph.reset();
@@ -417,8 +439,12 @@ InstructionQueue::resetState()
         queueOnList[i] = false;
         readyIt[i] = listOrder.end();
     }
+    if (readyMatrix) {
+        readyMatrix->clear();
+        wakeupMatrix->reset();
+    }
     nonSpecInsts.clear();
-    listOrder.clear();
+    spareListOrder.splice(spareListOrder.end(), listOrder);
     deferredMemInsts.clear();
     blockedMemInsts.clear();
     retryMemInsts.clear();
@@ -449,6 +475,7 @@ bool
 InstructionQueue::isDrained() const
 {
     bool drained = dependGraph.empty() &&
+                   (!wakeupMatrix || wakeupMatrix->empty()) &&
                    instsToExecute.empty() &&
                    wbOutstanding == 0;
     for (ThreadID tid = 0; tid < numThreads; ++tid)
@@ -461,6 +488,7 @@ void
 InstructionQueue::drainSanityCheck() const
 {
     assert(dependGraph.empty());
+    assert(!wakeupMatrix || wakeupMatrix->empty());
     assert(instsToExecute.empty());
     for (ThreadID tid = 0; tid < numThreads; ++tid)
         memDepUnit[tid].drainSanityCheck();
@@ -542,6 +570,9 @@ InstructionQueue::isFull(ThreadID tid)
 bool
 InstructionQueue::hasReadyInsts()
 {
+    if (readyMatrix)
+        return !readyMatrix->empty();
+
     if (!listOrder.empty()) {
         return true;
     }
@@ -658,8 +689,7 @@ DynInstPtr
 InstructionQueue::getInstToExecute()
 {
     assert(!instsToExecute.empty());
-    DynInstPtr inst = std::move(instsToExecute.front());
-    instsToExecute.pop_front();
+    DynInstPtr inst = instsToExecute.pop_front();
     if (inst->isFloating()) {
         iqIOStats.fpInstQueueReads++;
     } else if (inst->isVector()) {
@@ -692,7 +722,7 @@ InstructionQueue::addToOrderList(OpClass op_class)
         list_it++;
     }
 
-    readyIt[op_class] = listOrder.insert(list_it, queue_entry);
+    readyIt[op_class] = insertListOrder(list_it, queue_entry);
     queueOnList[op_class] = true;
 }
 
@@ -718,7 +748,28 @@ InstructionQueue::moveToYoungerInst(ListOrderIt list_order_it)
         ++next_it;
     }
 
-    readyIt[op_class] = listOrder.insert(next_it, queue_entry);
+    readyIt[op_class] = insertListOrder(next_it, queue_entry);
+}
+
+InstructionQueue::ListOrderIt
+InstructionQueue::insertListOrder(ListOrderIt pos,
+                                  const ListOrderEntry &entry)
+{
+    if (spareListOrder.empty())
+        return listOrder.insert(pos, entry);
+
+    ListOrderIt it = spareListOrder.begin();
+    *it = entry;
+    listOrder.splice(pos, spareListOrder, it);
+    return it;
+}
+
+InstructionQueue::ListOrderIt
+InstructionQueue::eraseListOrder(ListOrderIt it)
+{
+    ListOrderIt next_it = std::next(it);
+    spareListOrder.splice(spareListOrder.begin(), listOrder, it);
+    return next_it;
 }
 
 void
@@ -770,16 +821,37 @@ InstructionQueue::scheduleReadyInsts()
     // Increment the iterator.
     // This will avoid trying to schedule a certain op class if there are no
     // FUs that handle it.
+    // The matrix scheduler selects the instructions in the same order,
+    // using the age ordered mask instead of the list, and excludes the op
+    // classes that have no free FU in this cycle.
     int total_issued = 0;
     ListOrderIt order_it = listOrder.begin();
     ListOrderIt order_end_it = listOrder.end();
+    int ready_slot = -1;
 
-    while (total_issued < totalWidth && order_it != order_end_it) {
-        OpClass op_class = (*order_it).queueType;
+    while (total_issued < totalWidth) {
+        OpClass op_class;
+        DynInstPtr issuing_inst;
 
-        assert(!readyInsts[op_class].empty());
+        if (readyMatrix) {
+            ready_slot = readyMatrix->selectOldest();
+            if (ready_slot < 0)
+                break;
 
-        DynInstPtr issuing_inst = readyInsts[op_class].top();
+            op_class = OpClass(readyMatrix->opClass(ready_slot));
+            issuing_inst = readyMatrix->inst(ready_slot);
+        } else {
+            if (order_it == order_end_it)
+                break;
+
+            op_class = (*order_it).queueType;
+
+            assert(!readyInsts[op_class].empty());
+
+            issuing_inst = readyInsts[op_class].top();
+
+            assert(issuing_inst->seqNum == (*order_it).oldestInst);
+        }
 
         if (issuing_inst->isFloating()) {
             iqIOStats.fpInstQueueReads++;
@@ -789,19 +861,21 @@ InstructionQueue::scheduleReadyInsts()
             iqIOStats.intInstQueueReads++;
         }
 
-        assert(issuing_inst->seqNum == (*order_it).oldestInst);
-
         if (issuing_inst->isSquashed()) {
-            readyInsts[op_class].pop();
-
-            if (!readyInsts[op_class].empty()) {
-                moveToYoungerInst(order_it);
+            if (readyMatrix) {
+                readyMatrix->pop(ready_slot);
             } else {
-                readyIt[op_class] = listOrder.end();
-                queueOnList[op_class] = false;
-            }
+                readyInsts[op_class].pop();
 
-            listOrder.erase(order_it++);
+                if (!readyInsts[op_class].empty()) {
+                    moveToYoungerInst(order_it);
+                } else {
+                    readyIt[op_class] = listOrder.end();
+                    queueOnList[op_class] = false;
+                }
+
+                order_it = eraseListOrder(order_it);
+            }
 
             ++iqStats.squashedInstsIssued;
 
@@ -862,13 +936,19 @@ InstructionQueue::scheduleReadyInsts()
                     tid, issuing_inst->pcState(),
                     issuing_inst->seqNum);
 
-            readyInsts[op_class].pop();
-
-            if (!readyInsts[op_class].empty()) {
-                moveToYoungerInst(order_it);
+            if (readyMatrix) {
+                readyMatrix->pop(ready_slot);
             } else {
-                readyIt[op_class] = listOrder.end();
-                queueOnList[op_class] = false;
+                readyInsts[op_class].pop();
+
+                if (!readyInsts[op_class].empty()) {
+                    moveToYoungerInst(order_it);
+                } else {
+                    readyIt[op_class] = listOrder.end();
+                    queueOnList[op_class] = false;
+                }
+
+                order_it = eraseListOrder(order_it);
             }
 
             issuing_inst->setIssued();
@@ -891,15 +971,20 @@ InstructionQueue::scheduleReadyInsts()
                 memDepUnit[tid].issue(issuing_inst);
             }
 
-            listOrder.erase(order_it++);
             iqStats.statIssuedInstType[tid][op_class]++;
         } else {
             iqStats.statFuBusy[op_class]++;
             iqStats.fuBusy[tid]++;
-            ++order_it;
+            if (readyMatrix)
+                readyMatrix->exclude(op_class);
+            else
+                ++order_it;
         }
     }
 
+    if (readyMatrix)
+        readyMatrix->clearExcluded();
+
     iqStats.numIssuedDist.sample(total_issued);
     iqStats.instsIssued+= total_issued;
 
@@ -914,6 +999,12 @@ InstructionQueue::scheduleReadyInsts()
     }
 }
 
+void
+InstructionQueue::recordStalledCycles(Cycles cycles)
+{
+    iqStats.numIssuedDist.sample(0, cycles);
+}
+
 void
 InstructionQueue::scheduleNonSpec(const InstSeqNum &inst)
 {
@@ -947,7 +1038,7 @@ InstructionQueue::commit(const InstSeqNum &inst, ThreadID tid)
     DPRINTF(IQ, "[tid:%i] Committing instructions older than [sn:%llu]\n",
             tid,inst);
 
-    ListIt iq_it = instList[tid].begin();
+    InstIt iq_it = instList[tid].begin();
 
     while (iq_it != instList[tid].end() &&
            (*iq_it)->seqNum <= inst) {
@@ -1027,11 +1118,7 @@ InstructionQueue::wakeDependents(const DynInstPtr &completed_inst)
                 dest_reg->index(),
                 dest_reg->className());
 
-        //Go through the dependency chain, marking the registers as
-        //ready within the waiting instructions.
-        DynInstPtr dep_inst = dependGraph.pop(dest_reg->flatIndex());
-
-        while (dep_inst) {
+        auto wake_inst = [this](const DynInstPtr &dep_inst) {
             DPRINTF(IQ, "Waking up a dependent instruction, [sn:%llu] "
                     "PC %s.\n", dep_inst->seqNum, dep_inst->pcState());
 
@@ -1042,15 +1129,29 @@ InstructionQueue::wakeDependents(const DynInstPtr &completed_inst)
             dep_inst->markSrcRegReady();
 
             addIfReady(dep_inst);
+        };
+
+        if (wakeupMatrix) {
+            // All of the dependents are in the register's row.
+            dependents += wakeupMatrix->wake(dest_reg->flatIndex(),
+                                             wake_inst);
+        } else {
+            //Go through the dependency chain, marking the registers as
+            //ready within the waiting instructions.
+            DynInstPtr dep_inst = dependGraph.pop(dest_reg->flatIndex());
 
-            dep_inst = dependGraph.pop(dest_reg->flatIndex());
+            while (dep_inst) {
+                wake_inst(dep_inst);
 
-            ++dependents;
+                dep_inst = dependGraph.pop(dest_reg->flatIndex());
+
+                ++dependents;
+            }
         }
 
         // Reset the head node now that all of its dependents have
         // been woken up.
-        assert(dependGraph.empty(dest_reg->flatIndex()));
+        assert(noDependents(dest_reg->flatIndex()));
         dependGraph.clearInst(dest_reg->flatIndex());
 
         // Mark the scoreboard as having that register ready.
@@ -1064,6 +1165,23 @@ InstructionQueue::addReadyMemInst(const DynInstPtr &ready_inst)
 {
     OpClass op_class = ready_inst->opClass();
 
+    addToReadyInsts(ready_inst);
+
+    DPRINTF(IQ, "Instruction is ready to issue, putting it onto "
+            "the ready list, PC %s opclass:%i [sn:%llu].\n",
+            ready_inst->pcState(), op_class, ready_inst->seqNum);
+}
+
+void
+InstructionQueue::addToReadyInsts(const DynInstPtr &ready_inst)
+{
+    OpClass op_class = ready_inst->opClass();
+
+    if (readyMatrix) {
+        readyMatrix->push(ready_inst, ready_inst->seqNum, op_class);
+        return;
+    }
+
     readyInsts[op_class].push(ready_inst);
 
     // Will need to reorder the list if either a queue is not on the list,
@@ -1072,13 +1190,17 @@ InstructionQueue::addReadyMemInst(const DynInstPtr &ready_inst)
         addToOrderList(op_class);
     } else if (readyInsts[op_class].top()->seqNum  <
                (*readyIt[op_class]).oldestInst) {
-        listOrder.erase(readyIt[op_class]);
+        eraseListOrder(readyIt[op_class]);
         addToOrderList(op_class);
     }
+}
 
-    DPRINTF(IQ, "Instruction is ready to issue, putting it onto "
-            "the ready list, PC %s opclass:%i [sn:%llu].\n",
-            ready_inst->pcState(), op_class, ready_inst->seqNum);
+bool
+InstructionQueue::noDependents(RegIndex idx) const
+{
+    if (wakeupMatrix)
+        return wakeupMatrix->empty(idx);
+    return dependGraph.empty(idx);
 }
 
 void
@@ -1181,7 +1303,7 @@ void
 InstructionQueue::doSquash(ThreadID tid)
 {
     // Start at the tail.
-    ListIt squash_it = instList[tid].end();
+    InstIt squash_it = instList[tid].end();
     --squash_it;
 
     DPRINTF(IQ, "[tid:%i] Squashing until sequence number %i!\n",
@@ -1247,8 +1369,13 @@ InstructionQueue::doSquash(ThreadID tid)
 
                     if (!squashed_inst->regs.readySrcIdx(src_reg_idx) &&
                         !src_reg->isFixedMapping()) {
-                        dependGraph.remove(src_reg->flatIndex(),
-                                           squashed_inst);
+                        if (wakeupMatrix) {
+                            wakeupMatrix->remove(src_reg->flatIndex(),
+                                                 squashed_inst);
+                        } else {
+                            dependGraph.remove(src_reg->flatIndex(),
+                                               squashed_inst);
+                        }
                     }
 
                     ++iqStats.squashedOperandsExamined;
@@ -1311,7 +1438,7 @@ InstructionQueue::doSquash(ThreadID tid)
             if (dest_reg->isFixedMapping()){
                 continue;
             }
-            assert(dependGraph.empty(dest_reg->flatIndex()));
+            assert(noDependents(dest_reg->flatIndex()));
             dependGraph.clearInst(dest_reg->flatIndex());
         }
         instList[tid].erase(squash_it--);
@@ -1354,7 +1481,11 @@ InstructionQueue::addToDependents(const DynInstPtr &new_inst)
                         new_inst->pcState(), src_reg->index(),
                         src_reg->className());
 
-                dependGraph.insert(src_reg->flatIndex(), new_inst);
+                if (wakeupMatrix) {
+                    wakeupMatrix->insert(src_reg->flatIndex(), new_inst);
+                } else {
+                    dependGraph.insert(src_reg->flatIndex(), new_inst);
+                }
 
                 // Change the return value to indicate that something
                 // was added to the dependency graph.
@@ -1394,7 +1525,7 @@ InstructionQueue::addToProducers(const DynInstPtr &new_inst)
             continue;
         }
 
-        if (!dependGraph.empty(dest_reg->flatIndex())) {
+        if (!noDependents(dest_reg->flatIndex())) {
             dependGraph.dump();
             panic("Dependency graph %i (%s) (flat: %i) not empty!",
                   dest_reg->index(), dest_reg->className(),
@@ -1433,17 +1564,7 @@ InstructionQueue::addIfReady(const DynInstPtr &inst)
                 "the ready list, PC %s opclass:%i [sn:%llu].\n",
                 inst->pcState(), op_class, inst->seqNum);
 
-        readyInsts[op_class].push(inst);
-
-        // Will need to reorder the list if either a queue is not on the list,
-        // or it has an older instruction than last time.
-        if (!queueOnList[op_class]) {
-            addToOrderList(op_class);
-        } else if (readyInsts[op_class].top()->seqNum  <
-                   (*readyIt[op_class]).oldestInst) {
-            listOrder.erase(readyIt[op_class]);
-            addToOrderList(op_class);
-        }
+        addToReadyInsts(inst);
     }
 }
 
@@ -1457,7 +1578,8 @@ void
 InstructionQueue::dumpLists()
 {
     for (int i = 0; i < Num_OpClasses; ++i) {
-        cprintf("Ready list %i size: %i\n", i, readyInsts[i].size());
+        cprintf("Ready list %i size: %i\n", i,
+                readyMatrix ? readyMatrix->size(i) : readyInsts[i].size());
 
         cprintf("\n");
     }
@@ -1501,7 +1623,7 @@ InstructionQueue::dumpInsts()
     for (ThreadID tid = 0; tid < numThreads; ++tid) {
         int num = 0;
         int valid_num = 0;
-        ListIt inst_list_it = instList[tid].begin();
+        InstIt inst_list_it = instList[tid].begin();
 
         while (inst_list_it != instList[tid].end()) {
             cprintf("Instruction:%i\n", num);
@@ -1541,7 +1663,7 @@ InstructionQueue::dumpInsts()
 
     int num = 0;
     int valid_num = 0;
-    ListIt inst_list_it = instsToExecute.begin();
+    auto inst_list_it = instsToExecute.begin();
 
     while (inst_list_it != instsToExecute.end())
     {
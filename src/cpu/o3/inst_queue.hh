@@ -44,6 +44,7 @@
 
 #include <list>
 #include <map>
+#include <memory>
 #include <queue>
 #include <vector>
 
@@ -53,6 +54,9 @@
 #include "cpu/o3/comm.hh"
 #include "cpu/o3/dep_graph.hh"
 #include "cpu/o3/dyn_inst_ptr.hh"
+#include "cpu/o3/inst_fifo.hh"
+#include "cpu/o3/inst_list.hh"
+#include "cpu/o3/issue_matrix.hh"
 #include "cpu/o3/limits.hh"
 #include "cpu/o3/mem_dep_unit.hh"
 #include "cpu/o3/store_set.hh"
@@ -98,7 +102,16 @@ class IEW;
 class InstructionQueue
 {
   public:
+    /** Accessor of the hook linking instructions in instList. */
+    struct InstListHookOf
+    {
+        static InstListHook<DynInst> &get(DynInst *inst);
+    };
+
     // Typedef of iterator through the list of instructions.
+    typedef InstList<DynInst, InstListHookOf>::iterator InstIt;
+
+    // Typedef of iterator through the lists of memory instructions.
     typedef typename std::list<DynInstPtr>::iterator ListIt;
 
     /** FU completion event class. */
@@ -225,6 +238,14 @@ class InstructionQueue
      */
     void scheduleReadyInsts();
 
+    /**
+     * Accounts the cycles in which scheduleReadyInsts() was not called
+     * while the CPU skipped them, and nothing was ready to schedule.
+     *
+     * @param cycles Number of skipped cycles.
+     */
+    void recordStalledCycles(Cycles cycles);
+
     /** Schedules a single specific non-speculative instruction. */
     void scheduleNonSpec(const InstSeqNum &inst);
 
@@ -307,7 +328,7 @@ class InstructionQueue
     TimeBuffer<TimeStruct> *timeBuffer;
 
     /** Wire to read information from timebuffer. */
-    typename TimeBuffer<TimeStruct>::wire fromCommit;
+    typename TimeBuffer<TimeStruct>::const_wire fromCommit;
 
     /** Function unit pool. */
     FUPool *fuPool;
@@ -317,10 +338,19 @@ class InstructionQueue
     //////////////////////////////////////
 
     /** List of all the instructions in the IQ (some of which may be issued). */
-    std::list<DynInstPtr> instList[MaxThreads];
+    InstList<DynInst, InstListHookOf> instList[MaxThreads];
 
-    /** List of instructions that are ready to be executed. */
-    std::list<DynInstPtr> instsToExecute;
+    /** Accessor of the hook linking instructions in instsToExecute. */
+    struct ExecuteHook
+    {
+        static InstFifoHook<DynInst> &get(DynInst *inst);
+    };
+
+    /**
+     * List of instructions that are ready to be executed. Instructions
+     * are linked through a hook of their own rather than list nodes.
+     */
+    InstFifo<DynInst, ExecuteHook> instsToExecute;
 
     /** List of instructions waiting for their DTB translation to
      *  complete (hw page table walk in progress).
@@ -375,15 +405,28 @@ class InstructionQueue
 
     /** List that contains the age order of the oldest instruction of each
      *  ready queue.  Used to select the oldest instruction available
-     *  among op classes.
-     *  @todo: Might be better to just move these entries around instead
-     *  of creating new ones every time the position changes due to an
-     *  instruction issuing.  Not sure std::list supports this.
+     *  among op classes.  Its entries are spliced in from and out to
+     *  spareListOrder, rather than allocated every time the position of
+     *  a ready queue changes due to an instruction issuing.
      */
     std::list<ListOrderEntry> listOrder;
 
+    /** Entries of listOrder not currently in use. */
+    std::list<ListOrderEntry> spareListOrder;
+
     typedef typename std::list<ListOrderEntry>::iterator ListOrderIt;
 
+    /** Insert an entry into the age order list, reusing a spare one. */
+    ListOrderIt insertListOrder(ListOrderIt pos,
+                                const ListOrderEntry &entry);
+
+    /**
+     * Remove an entry from the age order list, keeping it as a spare.
+     *
+     * @return Iterator to the entry that followed it.
+     */
+    ListOrderIt eraseListOrder(ListOrderIt it);
+
     /** Tracks if each ready queue is on the age order list. */
     bool queueOnList[Num_OpClasses];
 
@@ -403,6 +446,25 @@ class InstructionQueue
 
     DependencyGraph<DynInstPtr> dependGraph;
 
+    /**
+     * Ready instructions in an age ordered mask, used instead of the ready
+     * queues and their age order list when the IQ models a matrix
+     * scheduler.
+     */
+    std::unique_ptr<ReadyMatrix<DynInstPtr>> readyMatrix;
+
+    /**
+     * Register dependencies in a wakeup matrix, used instead of the
+     * dependency graph when the IQ models a matrix scheduler.
+     */
+    std::unique_ptr<WakeupMatrix<DynInstPtr>> wakeupMatrix;
+
+    /** Adds an instruction to the ready instructions. */
+    void addToReadyInsts(const DynInstPtr &ready_inst);
+
+    /** Checks if no instruction is waiting on a register. */
+    bool noDependents(RegIndex idx) const;
+
     //////////////////////////////////////
     // Various parameters
     //////////////////////////////////////
@@ -0,0 +1,520 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_ISSUE_MATRIX_HH__
+#define __CPU_O3_ISSUE_MATRIX_HH__
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "base/bitfield.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+/**
+ * Dense bit matrix, each row being a bit vector of whole 64-bit words.
+ * The number of words of the rows can be grown while preserving the
+ * contents.
+ */
+class SlotBits
+{
+  public:
+    SlotBits() : rows(0), words(0) { }
+
+    /** Resize to the given shape, keeping the existing bits. */
+    void
+    resize(unsigned num_rows, unsigned num_words)
+    {
+        std::vector<uint64_t> new_bits(num_rows * num_words, 0);
+        for (unsigned r = 0; r < std::min(rows, num_rows); r++) {
+            for (unsigned w = 0; w < std::min(words, num_words); w++)
+                new_bits[r * num_words + w] = bits[r * words + w];
+        }
+        bits.swap(new_bits);
+        rows = num_rows;
+        words = num_words;
+    }
+
+    /** Clears all of the bits. */
+    void clear() { std::fill(bits.begin(), bits.end(), 0); }
+
+    uint64_t *row(unsigned r) { return &bits[r * words]; }
+    const uint64_t *row(unsigned r) const { return &bits[r * words]; }
+
+    bool
+    test(unsigned r, unsigned slot) const
+    {
+        return row(r)[slot / 64] & (1ULL << (slot % 64));
+    }
+
+    void set(unsigned r, unsigned slot)
+    { row(r)[slot / 64] |= 1ULL << (slot % 64); }
+
+    void reset(unsigned r, unsigned slot)
+    { row(r)[slot / 64] &= ~(1ULL << (slot % 64)); }
+
+    /** Checks if a row has no bits set. */
+    bool
+    rowEmpty(unsigned r) const
+    {
+        const uint64_t *bits_row = row(r);
+        for (unsigned w = 0; w < words; w++) {
+            if (bits_row[w])
+                return false;
+        }
+        return true;
+    }
+
+    /** Number of 64-bit words in a row. */
+    unsigned numWords() const { return words; }
+
+  private:
+    std::vector<uint64_t> bits;
+    unsigned rows;
+    unsigned words;
+};
+
+/**
+ * Ready instructions of an instruction queue held in an age ordered
+ * ready mask, as a hardware select circuit does, rather than in per op
+ * class priority queues. The slot of an instruction is given by its
+ * age, i.e., its sequence number, in a window of the most recent ages.
+ * The oldest ready instruction is therefore the first ready slot after
+ * the youngest age, and the select logic only needs bitwise operations
+ * on the words of the mask. The rare instructions that are still ready
+ * when their age leaves the window are set aside in age order, and are
+ * selected first.
+ *
+ * The selection order is the same as the one of the age ordered list of
+ * ready queues: the oldest instruction first, skipping the op classes
+ * that have been excluded in this cycle because they had no free
+ * functional unit. An instruction made ready more than once is also
+ * selected more than once.
+ */
+template <class DynInstPtr>
+class ReadyMatrix
+{
+  public:
+    /**
+     * @param num_classes Number of op classes.
+     * @param window Number of most recent ages that have a slot, rounded
+     *        up to a power of two of at least 64.
+     */
+    ReadyMatrix(unsigned num_classes, unsigned window)
+        : numClasses(num_classes), numSlots(64), youngest(0), numReady(0)
+    {
+        while (numSlots < window)
+            numSlots *= 2;
+        numWords = numSlots / 64;
+        slots.resize(numSlots);
+        ready.resize(1, numWords);
+        excluded.resize(1, numWords);
+        classes.resize(numClasses, numWords);
+        excludedClasses.resize(numClasses, false);
+    }
+
+    /** Makes an instruction ready. */
+    void
+    push(const DynInstPtr &inst, uint64_t age, unsigned op_class)
+    {
+        assert(op_class < numClasses);
+
+        if (age + numSlots <= youngest) {
+            pushAside(Slot{inst, age, op_class, 1});
+            return;
+        }
+        if (age > youngest)
+            advance(age);
+
+        const unsigned slot = age & (numSlots - 1);
+        numReady++;
+        if (ready.test(0, slot)) {
+            assert(slots[slot].age == age);
+            slots[slot].copies++;
+            return;
+        }
+        slots[slot] = Slot{inst, age, op_class, 1};
+        ready.set(0, slot);
+        classes.set(op_class, slot);
+        if (excludedClasses[op_class])
+            excluded.set(0, slot);
+    }
+
+    /**
+     * Selects the oldest ready instruction whose op class has not been
+     * excluded.
+     *
+     * @return The slot of the instruction, or -1 if there is none.
+     */
+    int
+    selectOldest() const
+    {
+        for (unsigned i = 0; i < aside.size(); i++) {
+            if (!excludedClasses[aside[i].opClass])
+                return numSlots + i;
+        }
+
+        // The oldest age of the window is the one after the youngest
+        const unsigned start = (youngest + 1) & (numSlots - 1);
+        const unsigned start_word = start / 64;
+        const uint64_t *ready_row = ready.row(0);
+        const uint64_t *skipped = excluded.row(0);
+
+        for (unsigned i = 0; i <= numWords; i++) {
+            const unsigned w = (start_word + i) % numWords;
+            uint64_t candidates = ready_row[w] & ~skipped[w];
+            // The first word is visited twice, for the ages after the
+            // start and, once wrapped around, for the ones before it.
+            if (i == 0)
+                candidates &= ~mask(start % 64);
+            else if (i == numWords)
+                candidates &= mask(start % 64);
+            if (candidates)
+                return w * 64 + findLsbSet(candidates);
+        }
+        return -1;
+    }
+
+    /** @return The instruction in a slot. */
+    const DynInstPtr &inst(int slot) const { return get(slot).inst; }
+
+    /** @return The op class of the instruction in a slot. */
+    unsigned opClass(int slot) const { return get(slot).opClass; }
+
+    /** Removes the instruction in a slot, once it issued or squashed. */
+    void
+    pop(int slot)
+    {
+        if (slot >= (int)numSlots) {
+            aside.erase(aside.begin() + (slot - numSlots));
+        } else if (--slots[slot].copies == 0) {
+            assert(ready.test(0, slot));
+            ready.reset(0, slot);
+            excluded.reset(0, slot);
+            classes.reset(slots[slot].opClass, slot);
+            slots[slot].inst = nullptr;
+        }
+        numReady--;
+    }
+
+    /**
+     * Excludes the instructions of an op class from being selected for
+     * the rest of the cycle, as they have no free functional unit.
+     */
+    void
+    exclude(unsigned op_class)
+    {
+        excludedClasses[op_class] = true;
+        const uint64_t *class_row = classes.row(op_class);
+        uint64_t *skipped = excluded.row(0);
+        for (unsigned w = 0; w < numWords; w++)
+            skipped[w] |= class_row[w];
+    }
+
+    /** Allows every op class to be selected again, at the end of a cycle. */
+    void
+    clearExcluded()
+    {
+        excluded.clear();
+        std::fill(excludedClasses.begin(), excludedClasses.end(), false);
+    }
+
+    /** Removes all of the instructions. */
+    void
+    clear()
+    {
+        for (auto &slot : slots)
+            slot.inst = nullptr;
+        aside.clear();
+        ready.clear();
+        classes.clear();
+        clearExcluded();
+        numReady = 0;
+    }
+
+    /** @return The number of ready instructions. */
+    unsigned size() const { return numReady; }
+
+    bool empty() const { return numReady == 0; }
+
+    /** @return The number of ready instructions of an op class. */
+    unsigned
+    size(unsigned op_class) const
+    {
+        unsigned count = 0;
+        const uint64_t *class_row = classes.row(op_class);
+        for (unsigned w = 0; w < numWords; w++) {
+            for (uint64_t bits = class_row[w]; bits; bits &= bits - 1)
+                count += slots[w * 64 + findLsbSet(bits)].copies;
+        }
+        for (const auto &slot : aside)
+            count += slot.opClass == op_class;
+        return count;
+    }
+
+  private:
+    struct Slot
+    {
+        DynInstPtr inst;
+        uint64_t age;
+        unsigned opClass;
+        /** Number of times the instruction was made ready. */
+        unsigned copies;
+    };
+
+    const Slot &
+    get(int slot) const
+    {
+        return slot >= (int)numSlots ? aside[slot - numSlots] : slots[slot];
+    }
+
+    /**
+     * Moves the window to end at a younger age. The instructions still
+     * ready in the slots of the ages that enter the window are older
+     * than the window, and are set aside.
+     */
+    void
+    advance(uint64_t age)
+    {
+        const uint64_t entering = std::min<uint64_t>(age - youngest,
+                                                     numSlots);
+        youngest = age;
+        if (numReady == aside.size())
+            return;
+
+        for (uint64_t a = age - entering + 1; a <= age; a++) {
+            const unsigned slot = a & (numSlots - 1);
+            // Skip the words without a ready instruction at once
+            if (slot % 64 == 0 && !ready.row(0)[slot / 64] &&
+                a + 63 <= age) {
+                a += 63;
+                continue;
+            }
+            if (!ready.test(0, slot))
+                continue;
+            Slot old = slots[slot];
+            ready.reset(0, slot);
+            excluded.reset(0, slot);
+            classes.reset(old.opClass, slot);
+            slots[slot].inst = nullptr;
+            const unsigned copies = old.copies;
+            old.copies = 1;
+            numReady -= copies;
+            for (unsigned c = 0; c < copies; c++)
+                pushAside(old);
+        }
+    }
+
+    /** Sets aside an instruction older than the window, in age order. */
+    void
+    pushAside(const Slot &slot)
+    {
+        auto it = std::upper_bound(aside.begin(), aside.end(), slot.age,
+            [](uint64_t age, const Slot &s) { return age < s.age; });
+        aside.insert(it, slot);
+        numReady++;
+    }
+
+    const unsigned numClasses;
+
+    /** Number of slots, i.e., of ages in the window. */
+    unsigned numSlots;
+
+    unsigned numWords;
+
+    std::vector<Slot> slots;
+
+    /** Instructions older than the window, in age order. */
+    std::vector<Slot> aside;
+
+    /** Youngest age pushed, i.e., the end of the window. */
+    uint64_t youngest;
+
+    /** Age ordered mask of the ready slots. */
+    SlotBits ready;
+
+    /** Slots of each op class, one row per op class. */
+    SlotBits classes;
+
+    /** Slots of the op classes excluded in this cycle. */
+    SlotBits excluded;
+
+    /** Op classes excluded in this cycle. */
+    std::vector<bool> excludedClasses;
+
+    unsigned numReady;
+};
+
+/**
+ * Register dependencies of the instructions of an instruction queue held
+ * in a dense wakeup matrix, rather than in a linked list per physical
+ * register. Each read of a register by a waiting instruction occupies a
+ * slot, and the row of a register has the bits of the slots that are
+ * waiting on it set. A register write wakes its dependents by reading
+ * its row. As in the dependency graph, an instruction reading a register
+ * more than once is woken up once per read.
+ */
+template <class DynInstPtr>
+class WakeupMatrix
+{
+  public:
+    /**
+     * @param num_regs Number of physical registers.
+     * @param num_slots Initial number of slots, grown on demand.
+     */
+    WakeupMatrix(unsigned num_regs, unsigned num_slots)
+        : numRegs(num_regs), numUsed(0)
+    {
+        grow((num_slots + 63) / 64);
+    }
+
+    /** Makes an instruction wait on a register. */
+    void
+    insert(unsigned reg, const DynInstPtr &inst)
+    {
+        if (numUsed == slots.size())
+            grow(used.numWords() + 1);
+
+        const uint64_t *used_row = used.row(0);
+        unsigned slot = 0;
+        for (unsigned w = 0; w < used.numWords(); w++) {
+            if (~used_row[w]) {
+                slot = w * 64 + findLsbSet(~used_row[w]);
+                break;
+            }
+        }
+
+        used.set(0, slot);
+        waiting.set(reg, slot);
+        slots[slot] = inst;
+        numUsed++;
+    }
+
+    /**
+     * Stops an instruction from waiting on a register once, when it is
+     * squashed.
+     */
+    void
+    remove(unsigned reg, const DynInstPtr &inst)
+    {
+        const uint64_t *reg_row = waiting.row(reg);
+        for (unsigned w = 0; w < waiting.numWords(); w++) {
+            for (uint64_t bits = reg_row[w]; bits; bits &= bits - 1) {
+                const unsigned slot = w * 64 + findLsbSet(bits);
+                if (slots[slot] == inst) {
+                    waiting.reset(reg, slot);
+                    release(slot);
+                    return;
+                }
+            }
+        }
+    }
+
+    /**
+     * Wakes all of the instructions waiting on a register, calling a
+     * function for each of their reads of it, in slot order.
+     *
+     * @return The number of reads woken up.
+     */
+    template <class Func>
+    int
+    wake(unsigned reg, Func func)
+    {
+        int woken = 0;
+        uint64_t *reg_row = waiting.row(reg);
+        for (unsigned w = 0; w < waiting.numWords(); w++) {
+            while (reg_row[w]) {
+                const unsigned slot = w * 64 + findLsbSet(reg_row[w]);
+                reg_row[w] &= reg_row[w] - 1;
+
+                DynInstPtr inst = std::move(slots[slot]);
+                release(slot);
+                func(inst);
+                woken++;
+            }
+        }
+        return woken;
+    }
+
+    /** Checks if no instruction is waiting on a register. */
+    bool empty(unsigned reg) const { return waiting.rowEmpty(reg); }
+
+    /** Checks if no instruction is waiting on any register. */
+    bool empty() const { return numUsed == 0; }
+
+    /** Removes all of the instructions. */
+    void
+    reset()
+    {
+        for (auto &slot : slots)
+            slot = nullptr;
+        waiting.clear();
+        used.clear();
+        numUsed = 0;
+    }
+
+  private:
+    /** Frees the slot of a read. */
+    void
+    release(unsigned slot)
+    {
+        slots[slot] = nullptr;
+        used.reset(0, slot);
+        numUsed--;
+    }
+
+    /** Makes room for a number of words of slots. */
+    void
+    grow(unsigned words)
+    {
+        slots.resize(words * 64);
+        waiting.resize(numRegs, words);
+        used.resize(1, words);
+    }
+
+    const unsigned numRegs;
+
+    /** Instruction of each read. */
+    std::vector<DynInstPtr> slots;
+
+    /** Wakeup matrix, a register's row has its dependents' slots set. */
+    SlotBits waiting;
+
+    /** Slots holding a read. */
+    SlotBits used;
+
+    unsigned numUsed;
+};
+
+} // namespace o3
+} // namespace gem5
+
+#endif //__CPU_O3_ISSUE_MATRIX_HH__
@@ -0,0 +1,216 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "cpu/o3/issue_matrix.hh"
+
+using namespace gem5;
+using namespace gem5::o3;
+
+namespace
+{
+
+struct TestInst
+{
+    uint64_t seqNum;
+    unsigned opClass;
+};
+
+typedef TestInst *TestInstPtr;
+
+const unsigned NumClasses = 8;
+
+/** Pops all of the selectable instructions, returning their ages. */
+std::vector<uint64_t>
+drain(ReadyMatrix<TestInstPtr> &matrix)
+{
+    std::vector<uint64_t> order;
+    for (int slot; (slot = matrix.selectOldest()) >= 0; matrix.pop(slot))
+        order.push_back(matrix.inst(slot)->seqNum);
+    return order;
+}
+
+} // anonymous namespace
+
+/** Instructions are selected oldest first. */
+TEST(ReadyMatrixTest, OldestFirst)
+{
+    ReadyMatrix<TestInstPtr> matrix(NumClasses, 64);
+    TestInst insts[] = {{5, 0}, {2, 1}, {9, 0}, {70, 2}, {64, 3}};
+    for (auto &inst : insts)
+        matrix.push(&inst, inst.seqNum, inst.opClass);
+
+    EXPECT_EQ(matrix.size(), 5);
+    EXPECT_EQ(drain(matrix), std::vector<uint64_t>({2, 5, 9, 64, 70}));
+    EXPECT_TRUE(matrix.empty());
+}
+
+/** Excluded op classes are skipped until the end of the cycle. */
+TEST(ReadyMatrixTest, Exclude)
+{
+    ReadyMatrix<TestInstPtr> matrix(NumClasses, 64);
+    TestInst insts[] = {{1, 3}, {2, 3}, {3, 4}};
+    for (auto &inst : insts)
+        matrix.push(&inst, inst.seqNum, inst.opClass);
+
+    matrix.exclude(3);
+    EXPECT_EQ(matrix.inst(matrix.selectOldest())->seqNum, 3);
+    EXPECT_EQ(matrix.size(3), 2);
+
+    // Instructions made ready during the cycle are excluded as well
+    TestInst late{4, 3};
+    matrix.push(&late, late.seqNum, late.opClass);
+    EXPECT_EQ(drain(matrix), std::vector<uint64_t>({3}));
+
+    matrix.clearExcluded();
+    EXPECT_EQ(drain(matrix), std::vector<uint64_t>({1, 2, 4}));
+}
+
+/** An instruction made ready twice is selected twice. */
+TEST(ReadyMatrixTest, ReadyTwice)
+{
+    ReadyMatrix<TestInstPtr> matrix(NumClasses, 64);
+    TestInst a{7, 1}, b{8, 1};
+    matrix.push(&a, a.seqNum, a.opClass);
+    matrix.push(&b, b.seqNum, b.opClass);
+    matrix.push(&a, a.seqNum, a.opClass);
+
+    EXPECT_EQ(matrix.size(1), 3);
+    EXPECT_EQ(drain(matrix), std::vector<uint64_t>({7, 7, 8}));
+}
+
+/**
+ * Instructions still ready when their age leaves the window are kept,
+ * and selected before the younger ones.
+ */
+TEST(ReadyMatrixTest, OlderThanWindow)
+{
+    ReadyMatrix<TestInstPtr> matrix(NumClasses, 64);
+    TestInst insts[] = {{10, 0}, {20, 1}, {100, 0}, {30, 2}, {300, 1}};
+    for (auto &inst : insts)
+        matrix.push(&inst, inst.seqNum, inst.opClass);
+
+    EXPECT_EQ(matrix.size(), 5);
+    EXPECT_EQ(matrix.size(0), 2);
+
+    matrix.exclude(0);
+    EXPECT_EQ(drain(matrix), std::vector<uint64_t>({20, 30, 300}));
+    matrix.clearExcluded();
+    EXPECT_EQ(drain(matrix), std::vector<uint64_t>({10, 100}));
+}
+
+/** Ages wrap around the window as they grow. */
+TEST(ReadyMatrixTest, WrapAround)
+{
+    ReadyMatrix<TestInstPtr> matrix(NumClasses, 128);
+    std::vector<TestInst> insts;
+    for (uint64_t seq_num = 1; seq_num < 1000; seq_num++)
+        insts.push_back(TestInst{seq_num, unsigned(seq_num % NumClasses)});
+
+    // Keep up to 100 instructions of the window ready, selecting the
+    // oldest every other cycle.
+    uint64_t next_issue = 1;
+    for (auto &inst : insts) {
+        matrix.push(&inst, inst.seqNum, inst.opClass);
+        if (inst.seqNum % 2 || inst.seqNum - next_issue >= 100) {
+            int slot = matrix.selectOldest();
+            ASSERT_GE(slot, 0);
+            ASSERT_EQ(matrix.inst(slot)->seqNum, next_issue++);
+            matrix.pop(slot);
+        }
+    }
+    for (int slot; (slot = matrix.selectOldest()) >= 0; matrix.pop(slot))
+        ASSERT_EQ(matrix.inst(slot)->seqNum, next_issue++);
+    EXPECT_EQ(next_issue, 1000);
+}
+
+/** Waking a register wakes all of its dependents once per read. */
+TEST(WakeupMatrixTest, Wake)
+{
+    WakeupMatrix<TestInstPtr> matrix(16, 4);
+    TestInst a{1, 0}, b{2, 0};
+
+    matrix.insert(3, &a);
+    matrix.insert(3, &a);
+    matrix.insert(5, &a);
+    matrix.insert(5, &b);
+
+    std::vector<TestInstPtr> woken;
+    auto record = [&woken](TestInstPtr inst) { woken.push_back(inst); };
+
+    EXPECT_EQ(matrix.wake(3, record), 2);
+    EXPECT_EQ(woken, std::vector<TestInstPtr>({&a, &a}));
+    EXPECT_TRUE(matrix.empty(3));
+    EXPECT_FALSE(matrix.empty());
+
+    woken.clear();
+    EXPECT_EQ(matrix.wake(5, record), 2);
+    EXPECT_EQ(woken.size(), 2);
+    EXPECT_TRUE(matrix.empty());
+}
+
+/** Removing a squashed instruction removes one of its reads. */
+TEST(WakeupMatrixTest, Remove)
+{
+    WakeupMatrix<TestInstPtr> matrix(16, 4);
+    TestInst a{1, 0}, b{2, 0};
+
+    matrix.insert(3, &a);
+    matrix.insert(3, &b);
+    matrix.insert(3, &a);
+
+    matrix.remove(3, &a);
+    std::vector<TestInstPtr> woken;
+    auto record = [&woken](TestInstPtr inst) { woken.push_back(inst); };
+    EXPECT_EQ(matrix.wake(3, record), 2);
+    EXPECT_EQ(woken, std::vector<TestInstPtr>({&b, &a}));
+
+    matrix.insert(4, &a);
+    matrix.remove(4, &a);
+    EXPECT_TRUE(matrix.empty(4));
+    EXPECT_TRUE(matrix.empty());
+}
+
+/** The matrix grows when more reads are waiting than it has slots. */
+TEST(WakeupMatrixTest, Grow)
+{
+    WakeupMatrix<TestInstPtr> matrix(4, 64);
+    std::vector<TestInst> insts(200, TestInst{0, 0});
+    for (unsigned i = 0; i < insts.size(); i++)
+        matrix.insert(i % 4, &insts[i]);
+
+    unsigned woken = 0;
+    for (unsigned reg = 0; reg < 4; reg++) {
+        woken += matrix.wake(reg, [&](TestInstPtr inst) {
+            EXPECT_EQ((inst - &insts[0]) % 4, reg);
+        });
+    }
+    EXPECT_EQ(woken, insts.size());
+    EXPECT_TRUE(matrix.empty());
+}
@@ -258,13 +258,13 @@ LSQ::executeStore(const DynInstPtr &inst)
 }
 
 void
-LSQ::commitLoads(InstSeqNum &youngest_inst, ThreadID tid)
+LSQ::commitLoads(const InstSeqNum &youngest_inst, ThreadID tid)
 {
     thread.at(tid).commitLoads(youngest_inst);
 }
 
 void
-LSQ::commitStores(InstSeqNum &youngest_inst, ThreadID tid)
+LSQ::commitStores(const InstSeqNum &youngest_inst, ThreadID tid)
 {
     thread.at(tid).commitStores(youngest_inst);
 }
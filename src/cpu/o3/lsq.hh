@@ -819,12 +819,12 @@ class LSQ
     /**
      * Commits loads up until the given sequence number for a specific thread.
      */
-    void commitLoads(InstSeqNum &youngest_inst, ThreadID tid);
+    void commitLoads(const InstSeqNum &youngest_inst, ThreadID tid);
 
     /**
      * Commits stores up until the given sequence number for a specific thread.
      */
-    void commitStores(InstSeqNum &youngest_inst, ThreadID tid);
+    void commitStores(const InstSeqNum &youngest_inst, ThreadID tid);
 
     /**
      * Attempts to write back stores until all cache ports are used or the
@@ -0,0 +1,189 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/o3/lsq_addr_index.hh"
+
+#include <algorithm>
+#include <cassert>
+
+#include "base/intmath.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+LSQAddrIndex::LSQAddrIndex(size_t num_entries, unsigned granule_shift)
+    : granuleShift(granule_shift), entries(num_entries),
+      heads(size_t(2) << ceilLog2(num_entries), NoPos),
+      tails(heads.size(), NoPos), bucketMask(heads.size() - 1)
+{
+    assert(num_entries > 0);
+    cursors.reserve(heads.size());
+}
+
+void
+LSQAddrIndex::granules(Addr addr, unsigned size, Addr &first,
+                       Addr &last) const
+{
+    // An empty access is compared as ending on the byte before its
+    // address, so it covers the granules on both sides of it.
+    if (size) {
+        first = addr >> granuleShift;
+        last = (addr + size - 1) >> granuleShift;
+    } else {
+        first = (addr ? addr - 1 : addr) >> granuleShift;
+        last = addr >> granuleShift;
+    }
+}
+
+void
+LSQAddrIndex::insert(size_t idx, Addr addr, unsigned size)
+{
+    // This replaces the previous access of the entry, or the access of
+    // an older entry at the same position that was never removed.
+    const Pos pos = idx % entries.size();
+    release(pos);
+
+    Entry &entry = entries[pos];
+    entry.valid = true;
+    entry.idx = idx;
+    granules(addr, size, entry.first, entry.last);
+    if (entry.last - entry.first > maxSpan)
+        maxSpan = entry.last - entry.first;
+
+    // Entries mostly come in age order, so look for the place of the
+    // entry from the youngest one.
+    const size_t bucket = bucketOf(entry.first);
+    Pos prev = tails[bucket];
+    while (prev != NoPos && entries[prev].idx > idx)
+        prev = entries[prev].prev;
+
+    entry.prev = prev;
+    entry.next = prev == NoPos ? heads[bucket] : entries[prev].next;
+    if (entry.prev == NoPos)
+        heads[bucket] = pos;
+    else
+        entries[entry.prev].next = pos;
+    if (entry.next == NoPos)
+        tails[bucket] = pos;
+    else
+        entries[entry.next].prev = pos;
+}
+
+void
+LSQAddrIndex::remove(size_t idx)
+{
+    const Pos pos = idx % entries.size();
+    if (entries[pos].idx == idx)
+        release(pos);
+}
+
+void
+LSQAddrIndex::release(Pos pos)
+{
+    Entry &entry = entries[pos];
+    if (!entry.valid)
+        return;
+
+    const size_t bucket = bucketOf(entry.first);
+    if (entry.prev == NoPos)
+        heads[bucket] = entry.next;
+    else
+        entries[entry.prev].next = entry.next;
+    if (entry.next == NoPos)
+        tails[bucket] = entry.prev;
+    else
+        entries[entry.next].prev = entry.prev;
+
+    entry.prev = NoPos;
+    entry.next = NoPos;
+    entry.valid = false;
+}
+
+void
+LSQAddrIndex::find(Addr addr, unsigned size,
+                   std::vector<size_t> &matches) const
+{
+    matches.clear();
+
+    Addr first, last;
+    granules(addr, size, first, last);
+
+    // Entries touching the access start at most maxSpan granules
+    // before it. Consecutive granules are in distinct buckets, unless
+    // there are more of them than buckets.
+    const Addr lowest = first > maxSpan ? first - maxSpan : 0;
+    cursors.clear();
+    if (last - lowest < heads.size()) {
+        for (Addr granule = lowest; granule <= last; granule++) {
+            if (heads[bucketOf(granule)] != NoPos)
+                cursors.push_back(heads[bucketOf(granule)]);
+        }
+    } else {
+        for (Pos head : heads) {
+            if (head != NoPos)
+                cursors.push_back(head);
+        }
+    }
+
+    // Merge the buckets, each of which is in age order, keeping the
+    // entries that touch the granules of the access.
+    while (!cursors.empty()) {
+        auto oldest = cursors.begin();
+        for (auto it = cursors.begin() + 1; it != cursors.end(); ++it) {
+            if (entries[*it].idx < entries[*oldest].idx)
+                oldest = it;
+        }
+
+        const Entry &entry = entries[*oldest];
+        if (entry.first <= last && entry.last >= first)
+            matches.push_back(entry.idx);
+
+        if (entry.next == NoPos) {
+            *oldest = cursors.back();
+            cursors.pop_back();
+        } else {
+            *oldest = entry.next;
+        }
+    }
+}
+
+void
+LSQAddrIndex::clear()
+{
+    for (auto &entry : entries) {
+        entry.valid = false;
+        entry.prev = NoPos;
+        entry.next = NoPos;
+    }
+    std::fill(heads.begin(), heads.end(), NoPos);
+    std::fill(tails.begin(), tails.end(), NoPos);
+    maxSpan = 0;
+}
+
+} // namespace o3
+} // namespace gem5
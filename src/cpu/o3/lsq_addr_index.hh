@@ -0,0 +1,148 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_LSQ_ADDR_INDEX_HH__
+#define __CPU_O3_LSQ_ADDR_INDEX_HH__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+/**
+ * Index of the entries of a load or store queue by address. The address
+ * space is split into aligned granules, and the entries whose accesses
+ * touch the granules of an access are found without searching the
+ * whole queue. The granules must be at least as large as the blocks
+ * used to compare the addresses, so that no overlapping entry is
+ * missed; entries that do not overlap can be returned too, and must be
+ * filtered out by the caller.
+ *
+ * The index is a fixed size hash table, which does not allocate after
+ * its construction. Each entry is linked in the bucket of the first
+ * granule of its access, through links kept in the entry itself, and
+ * the buckets are kept in the order of the queue indices. The queue
+ * indices are the ones of the circular queues of the LSQ, which
+ * increase monotonically, so this is the age order of the entries, and
+ * the buckets found are merged rather than sorted.
+ *
+ * An entry is replaced when another entry with the same position in the
+ * queue is inserted, so entries do not have to be removed when the
+ * queue is squashed, as long as the caller checks that the entries
+ * returned are valid.
+ */
+class LSQAddrIndex
+{
+  public:
+    /**
+     * @param num_entries Number of entries in the indexed queue.
+     * @param granule_shift Log2 of the size of the granules.
+     */
+    LSQAddrIndex(size_t num_entries, unsigned granule_shift);
+
+    /**
+     * Indexes an access, replacing any previous access of the entry.
+     *
+     * @param idx Queue index of the entry.
+     * @param addr Address of the access.
+     * @param size Size of the access, in bytes.
+     */
+    void insert(size_t idx, Addr addr, unsigned size);
+
+    /** Removes an entry from the index. */
+    void remove(size_t idx);
+
+    /**
+     * Finds the entries whose accesses touch the granules of a given
+     * access.
+     *
+     * @param addr Address of the access.
+     * @param size Size of the access, in bytes.
+     * @param matches Queue indices of the entries, oldest first.
+     */
+    void find(Addr addr, unsigned size, std::vector<size_t> &matches) const;
+
+    /** Removes all of the entries. */
+    void clear();
+
+  private:
+    /** Position of an entry, or end of a list. */
+    typedef int32_t Pos;
+    static constexpr Pos NoPos = -1;
+
+    struct Entry
+    {
+        bool valid = false;
+        size_t idx = 0;
+        /** First and last granules touched by the access. */
+        Addr first = 0;
+        Addr last = 0;
+        /** Neighbours in the bucket, in age order. */
+        Pos prev = NoPos;
+        Pos next = NoPos;
+    };
+
+    /** First and last granules touched by an access. */
+    void granules(Addr addr, unsigned size, Addr &first, Addr &last) const;
+
+    size_t bucketOf(Addr granule) const { return granule & bucketMask; }
+
+    /** Removes an entry from its bucket. */
+    void release(Pos pos);
+
+    const unsigned granuleShift;
+
+    /** Indexed accesses, by position of their entry in the queue. */
+    std::vector<Entry> entries;
+
+    /** Oldest and youngest entries of each bucket. */
+    std::vector<Pos> heads;
+    std::vector<Pos> tails;
+
+    const Addr bucketMask;
+
+    /**
+     * Largest number of granules an indexed access spans beyond its
+     * first one, since the index was last cleared. An access can only
+     * be touched by the entries whose first granule is at most this
+     * many granules before its own.
+     */
+    Addr maxSpan = 0;
+
+    /** Next entry of each bucket being merged by find(). */
+    mutable std::vector<Pos> cursors;
+};
+
+} // namespace o3
+} // namespace gem5
+
+#endif //__CPU_O3_LSQ_ADDR_INDEX_HH__
@@ -0,0 +1,211 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "cpu/o3/lsq_addr_index.hh"
+
+using namespace gem5;
+
+TEST(LSQAddrIndexTest, FindOldestFirst)
+{
+    o3::LSQAddrIndex index(8, 6);
+    std::vector<size_t> matches;
+
+    index.insert(3, 0x1000, 8);
+    index.insert(1, 0x1010, 4);
+    index.insert(2, 0x2000, 8);
+    // Spans two granules, but is returned once
+    index.insert(0, 0x103c, 8);
+
+    index.find(0x1000, 64, matches);
+    EXPECT_EQ(matches, std::vector<size_t>({0, 1, 3}));
+
+    index.find(0x1040, 64, matches);
+    EXPECT_EQ(matches, std::vector<size_t>({0}));
+
+    index.find(0x3000, 8, matches);
+    EXPECT_TRUE(matches.empty());
+}
+
+TEST(LSQAddrIndexTest, ReplaceEntry)
+{
+    o3::LSQAddrIndex index(4, 6);
+    std::vector<size_t> matches;
+
+    index.insert(1, 0x1000, 8);
+    index.insert(1, 0x2000, 8);
+    index.find(0x1000, 8, matches);
+    EXPECT_TRUE(matches.empty());
+    index.find(0x2000, 8, matches);
+    EXPECT_EQ(matches, std::vector<size_t>({1}));
+
+    // A newer entry at the same position replaces a stale one
+    index.insert(5, 0x3000, 8);
+    index.find(0x2000, 8, matches);
+    EXPECT_TRUE(matches.empty());
+    index.find(0x3000, 8, matches);
+    EXPECT_EQ(matches, std::vector<size_t>({5}));
+}
+
+TEST(LSQAddrIndexTest, Remove)
+{
+    o3::LSQAddrIndex index(4, 6);
+    std::vector<size_t> matches;
+
+    index.insert(6, 0x1000, 8);
+    // The entry at this position is no longer the one being removed
+    index.remove(2);
+    index.find(0x1000, 8, matches);
+    EXPECT_EQ(matches, std::vector<size_t>({6}));
+
+    index.remove(6);
+    index.find(0x1000, 8, matches);
+    EXPECT_TRUE(matches.empty());
+
+    index.insert(7, 0x1000, 8);
+    index.clear();
+    index.find(0x1000, 8, matches);
+    EXPECT_TRUE(matches.empty());
+}
+
+TEST(LSQAddrIndexTest, EmptyAccess)
+{
+    o3::LSQAddrIndex index(4, 6);
+    std::vector<size_t> matches;
+
+    // An empty access at the start of a granule also matches the
+    // accesses of the previous granule
+    index.insert(0, 0x1038, 8);
+    index.insert(1, 0x1040, 8);
+    index.find(0x1040, 0, matches);
+    EXPECT_EQ(matches, std::vector<size_t>({0, 1}));
+
+    index.insert(2, 0x1040, 0);
+    index.find(0x1000, 8, matches);
+    EXPECT_EQ(matches, std::vector<size_t>({0, 2}));
+}
+
+TEST(LSQAddrIndexTest, OutOfOrderInsert)
+{
+    o3::LSQAddrIndex index(8, 6);
+    std::vector<size_t> matches;
+
+    // Loads execute out of order, but are found in age order
+    index.insert(5, 0x1000, 8);
+    index.insert(2, 0x1008, 8);
+    index.insert(7, 0x1010, 8);
+    index.insert(3, 0x1040, 8);
+    index.find(0x1000, 128, matches);
+    EXPECT_EQ(matches, std::vector<size_t>({2, 3, 5, 7}));
+}
+
+TEST(LSQAddrIndexTest, WideAccess)
+{
+    // Accesses spanning more granules than there are buckets
+    o3::LSQAddrIndex index(2, 4);
+    std::vector<size_t> matches;
+
+    index.insert(0, 0x1000, 128);
+    index.insert(1, 0x1100, 8);
+    index.find(0x1078, 8, matches);
+    EXPECT_EQ(matches, std::vector<size_t>({0}));
+
+    index.find(0x1000, 512, matches);
+    EXPECT_EQ(matches, std::vector<size_t>({0, 1}));
+
+    index.find(0x1080, 8, matches);
+    EXPECT_TRUE(matches.empty());
+}
+
+TEST(LSQAddrIndexTest, MatchesLinearSearch)
+{
+    const size_t num_entries = 16;
+    const unsigned shift = 4;
+    o3::LSQAddrIndex index(num_entries, shift);
+
+    struct Access
+    {
+        bool valid = false;
+        size_t idx = 0;
+        Addr addr = 0;
+        unsigned size = 0;
+    };
+    std::vector<Access> queue(num_entries);
+    for (size_t i = 0; i < num_entries; i++)
+        queue[i].idx = i;
+
+    auto touches = [shift](const Access &a, Addr granule) {
+        Addr first = (a.size || !a.addr ? a.addr : a.addr - 1) >> shift;
+        Addr last = (a.addr + (a.size ? a.size - 1 : 0)) >> shift;
+        return first <= granule && granule <= last;
+    };
+
+    std::mt19937 rng(1);
+    std::vector<size_t> matches;
+    size_t next_idx = 0;
+    for (int i = 0; i < 20000; i++) {
+        Addr addr = rng() % 512;
+        unsigned size = rng() % 24;
+        switch (rng() % 4) {
+          case 0:
+          case 1: {
+            size_t idx = rng() % 3 ? next_idx++ : rng() % (next_idx + 1);
+            Access &a = queue[idx % num_entries];
+            a = {true, idx, addr, size};
+            index.insert(idx, addr, size);
+            break;
+          }
+          case 2: {
+            Access &a = queue[rng() % num_entries];
+            index.remove(a.idx);
+            a.valid = false;
+            break;
+          }
+          default: {
+            index.find(addr, size, matches);
+
+            Access probe{true, 0, addr, size};
+            std::vector<size_t> expected;
+            for (const auto &a : queue) {
+                if (!a.valid)
+                    continue;
+                for (Addr g = 0; g <= 1024 >> shift; g++) {
+                    if (touches(a, g) && touches(probe, g)) {
+                        expected.push_back(a.idx);
+                        break;
+                    }
+                }
+            }
+            std::sort(expected.begin(), expected.end());
+            ASSERT_EQ(matches, expected);
+          }
+        }
+    }
+}
@@ -43,6 +43,7 @@
 
 #include "arch/generic/debugfaults.hh"
 #include "arch/locked_mem.hh"
+#include "base/intmath.hh"
 #include "base/str.hh"
 #include "config/the_isa.hh"
 #include "cpu/checker/cpu.hh"
@@ -229,6 +230,17 @@ LSQUnit::init(CPU *cpu_ptr, IEW *iew_ptr, const O3CPUParams &params,
     checkLoads = params.LSQCheckLoads;
     needsTSO = params.needsTSO;
 
+    if (params.lsq_addr_index) {
+        // The granules have to be at least as large as the blocks that
+        // are compared when checking for violations.
+        unsigned granule_shift = std::max(depCheckShift,
+            (unsigned)floorLog2(cpu->cacheLineSize()));
+        loadIndex = std::make_unique<LSQAddrIndex>(loadQueue.capacity(),
+                                                   granule_shift);
+        storeIndex = std::make_unique<LSQAddrIndex>(storeQueue.capacity(),
+                                                    granule_shift);
+    }
+
     resetState();
 }
 
@@ -249,6 +261,11 @@ LSQUnit::resetState()
 
     stalled = false;
 
+    if (loadIndex) {
+        loadIndex->clear();
+        storeIndex->clear();
+    }
+
     cacheBlockMask = ~(cpu->cacheLineSize() - 1);
 }
 
@@ -527,12 +544,30 @@ LSQUnit::checkViolations(typename LoadQueue::iterator& loadIt,
     Addr inst_eff_addr1 = inst->effAddr >> depCheckShift;
     Addr inst_eff_addr2 = (inst->effAddr + inst->effSize - 1) >> depCheckShift;
 
+    // With the address index, only the loads that may overlap the access
+    // are visited, in the order of the queue.
+    auto match = addrMatches.cbegin();
+    if (loadIndex) {
+        loadIndex->find(inst->effAddr, inst->effSize, addrMatches);
+        match = addrMatches.cbegin();
+    }
+
     /** @todo in theory you only need to check an instruction that has executed
      * however, there isn't a good way in the pipeline at the moment to check
      * all instructions that will execute before the store writes back. Thus,
      * like the implementation that came before it, we're overly conservative.
      */
     while (loadIt != loadQueue.end()) {
+        if (loadIndex) {
+            while (match != addrMatches.cend() && *match < loadIt.idx())
+                ++match;
+            if (match == addrMatches.cend() ||
+                *match >= loadQueue.end().idx()) {
+                break;
+            }
+            loadIt = loadQueue.getIterator(*match++);
+        }
+
         DynInstPtr ld_inst = loadIt->instruction();
         if (!ld_inst->effAddrValid() || ld_inst->strictlyOrdered()) {
             ++loadIt;
@@ -743,7 +778,7 @@ LSQUnit::commitLoad()
 }
 
 void
-LSQUnit::commitLoads(InstSeqNum &youngest_inst)
+LSQUnit::commitLoads(const InstSeqNum &youngest_inst)
 {
     assert(loads == 0 || loadQueue.front().valid());
 
@@ -754,7 +789,7 @@ LSQUnit::commitLoads(InstSeqNum &youngest_inst)
 }
 
 void
-LSQUnit::commitStores(InstSeqNum &youngest_inst)
+LSQUnit::commitStores(const InstSeqNum &youngest_inst)
 {
     assert(stores == 0 || storeQueue.front().valid());
 
@@ -1312,6 +1347,9 @@ LSQUnit::read(LSQRequest *req, int load_idx)
 
     assert(!load_inst->isExecuted());
 
+    if (loadIndex)
+        loadIndex->insert(load_idx, load_inst->effAddr, load_inst->effSize);
+
     // Make sure this isn't a strictly ordered load
     // A bit of a hackish way to get strictly ordered accesses to work
     // only if they're at the head of the LSQ and are ready to commit
@@ -1403,10 +1441,28 @@ LSQUnit::read(LSQRequest *req, int load_idx)
     // Check the SQ for any previous stores that might lead to forwarding
     auto store_it = load_inst->sqIt;
     assert (store_it >= storeWBIt);
+
+    // With the address index, only the stores that may overlap the load
+    // are visited, youngest first.
+    auto match = addrMatches.crbegin();
+    if (storeIndex) {
+        storeIndex->find(req->mainRequest()->getVaddr(),
+                         req->mainRequest()->getSize(), addrMatches);
+        match = addrMatches.crbegin();
+    }
+
     // End once we've reached the top of the LSQ
     while (store_it != storeWBIt && !load_inst->isDataPrefetch()) {
-        // Move the index to one younger
-        store_it--;
+        if (storeIndex) {
+            while (match != addrMatches.crend() && *match >= store_it.idx())
+                ++match;
+            if (match == addrMatches.crend() || *match < storeWBIt.idx())
+                break;
+            store_it = storeQueue.getIterator(*match++);
+        } else {
+            // Move the index to one younger
+            store_it--;
+        }
         assert(store_it->valid());
         assert(store_it->instruction()->seqNum < load_inst->seqNum);
         int store_size = store_it->size();
@@ -1637,6 +1693,11 @@ LSQUnit::write(LSQRequest *req, uint8_t *data, int store_idx)
     storeQueue[store_idx].setRequest(req);
     unsigned size = req->_size;
     storeQueue[store_idx].size() = size;
+    if (storeIndex) {
+        storeIndex->insert(store_idx,
+                           storeQueue[store_idx].instruction()->effAddr,
+                           size);
+    }
     bool store_no_data =
         req->mainRequest()->getFlags() & Request::STORE_NO_DATA;
     storeQueue[store_idx].isAllZeros() = store_no_data;
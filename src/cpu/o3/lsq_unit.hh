@@ -47,6 +47,7 @@
 #include <map>
 #include <memory>
 #include <queue>
+#include <vector>
 
 #include "arch/generic/debugfaults.hh"
 #include "arch/generic/vec_reg.hh"
@@ -59,6 +60,7 @@
 #include "cpu/o3/cpu.hh"
 #include "cpu/o3/dyn_inst_ptr.hh"
 #include "cpu/o3/lsq.hh"
+#include "cpu/o3/lsq_addr_index.hh"
 #include "cpu/timebuf.hh"
 #include "debug/HtmCpu.hh"
 #include "debug/LSQUnit.hh"
@@ -272,10 +274,10 @@ class LSQUnit
     /** Commits the head load. */
     void commitLoad();
     /** Commits loads older than a specific sequence number. */
-    void commitLoads(InstSeqNum &youngest_inst);
+    void commitLoads(const InstSeqNum &youngest_inst);
 
     /** Commits stores older than a specific sequence number. */
-    void commitStores(InstSeqNum &youngest_inst);
+    void commitStores(const InstSeqNum &youngest_inst);
 
     /** Writes back stores. */
     void writebackStores();
@@ -496,6 +498,23 @@ class LSQUnit
     /** Should loads be checked for dependency issues */
     bool checkLoads;
 
+    /**
+     * The loads of the load queue indexed by address, used to find the
+     * loads violating memory ordering without searching the whole
+     * queue. Null if the queues are searched linearly.
+     */
+    std::unique_ptr<LSQAddrIndex> loadIndex;
+
+    /**
+     * The stores of the store queue indexed by address, used to find
+     * the stores that may forward data to a load. Null if the queues
+     * are searched linearly.
+     */
+    std::unique_ptr<LSQAddrIndex> storeIndex;
+
+    /** Entries found in an address index, kept to avoid allocations. */
+    std::vector<size_t> addrMatches;
+
     /** The number of load instructions in the LQ. */
     int loads;
     /** The number of store instructions in the SQ. */
@@ -519,7 +538,7 @@ class LSQUnit
     Addr cacheBlockMask;
 
     /** Wire to read information from the issue stage time queue. */
-    typename TimeBuffer<IssueStruct>::wire fromIssue;
+    typename TimeBuffer<IssueStruct>::const_wire fromIssue;
 
     /** Whether or not the LSQ is stalled. */
     bool stalled;
@@ -52,6 +52,12 @@ int MemDepUnit::MemDepEntry::memdep_insert = 0;
 int MemDepUnit::MemDepEntry::memdep_erase = 0;
 #endif
 
+InstListHook<DynInst> &
+MemDepUnit::InstListHookOf::get(DynInst *inst)
+{
+    return inst->memDepHook;
+}
+
 MemDepUnit::MemDepUnit() : iqPtr(NULL), stats(nullptr) {}
 
 MemDepUnit::MemDepUnit(const O3CPUParams &params)
@@ -68,7 +74,7 @@ MemDepUnit::~MemDepUnit()
 {
     for (ThreadID tid = 0; tid < MaxThreads; tid++) {
 
-        ListIt inst_list_it = instList[tid].begin();
+        InstIt inst_list_it = instList[tid].begin();
 
         MemDepHashIt hash_it;
 
@@ -202,8 +208,6 @@ MemDepUnit::insert(const DynInstPtr &inst)
 
     instList[tid].push_back(inst);
 
-    inst_entry->listIt = --(instList[tid].end());
-
     // Check any barriers and the dependence predictor for any
     // producing memrefs/stores.
     std::vector<InstSeqNum>  producing_stores;
@@ -336,8 +340,6 @@ MemDepUnit::insertBarrier(const DynInstPtr &barr_inst)
     // Add the instruction to the instruction list.
     instList[tid].push_back(barr_inst);
 
-    inst_entry->listIt = --(instList[tid].end());
-
     insertBarrierSN(barr_inst);
 }
 
@@ -414,7 +416,8 @@ MemDepUnit::completed(const DynInstPtr &inst)
 
     assert(hash_it != memDepHash.end());
 
-    instList[tid].erase((*hash_it).second->listIt);
+    instList[tid].erase(
+        instList[tid].iteratorTo((*hash_it).second->inst.get()));
 
     (*hash_it).second = NULL;
 
@@ -532,7 +535,7 @@ MemDepUnit::squash(const InstSeqNum &squashed_num, ThreadID tid)
         }
     }
 
-    ListIt squash_it = instList[tid].end();
+    InstIt squash_it = instList[tid].end();
     --squash_it;
 
     MemDepHashIt hash_it;
@@ -616,7 +619,7 @@ MemDepUnit::dumpLists()
         cprintf("Instruction list %i size: %i\n",
                 tid, instList[tid].size());
 
-        ListIt inst_list_it = instList[tid].begin();
+        InstIt inst_list_it = instList[tid].begin();
         int num = 0;
 
         while (inst_list_it != instList[tid].end()) {
@@ -59,3 +59,8 @@ class ElasticTrace(ProbeListenerObject):
     # Whether to trace virtual addresses for memory accesses
     traceVirtAddr = Param.Bool(False, "Set to true if virtual addresses are " \
                                 "to be traced.")
+    # Whether to write the data dependency trace in the columnar format,
+    # which the TraceCPU replays considerably faster than protobuf traces
+    columnarDataDepTrace = Param.Bool(False, "Set to true to write the data " \
+                                      "dependency trace in the columnar " \
+                                      "binary format instead of protobuf.")
@@ -58,6 +58,7 @@ ElasticTrace::ElasticTrace(const ElasticTraceParams &params)
        lastClearedSeqNum(0),
        depWindowSize(params.depWindowSize),
        dataTraceStream(nullptr),
+       columnarTraceStream(nullptr),
        instTraceStream(nullptr),
        startTraceInst(params.startTraceInst),
        allProbesReg(false),
@@ -86,7 +87,12 @@ ElasticTrace::ElasticTrace(const ElasticTraceParams &params)
                                             params.instFetchTraceFile);
     instTraceStream = new ProtoOutputStream(filename);
     filename = simout.resolve(name() + "." + params.dataDepTraceFile);
-    dataTraceStream = new ProtoOutputStream(filename);
+    if (params.columnarDataDepTrace) {
+        columnarTraceStream = new ElasticTraceWriter(filename, depWindowSize,
+                                                     sim_clock::Frequency);
+    } else {
+        dataTraceStream = new ProtoOutputStream(filename);
+    }
     // Create a protobuf message for the header and write it to the stream
     ProtoMessage::PacketHeader inst_pkt_header;
     inst_pkt_header.set_obj_id(name());
@@ -94,11 +100,13 @@ ElasticTrace::ElasticTrace(const ElasticTraceParams &params)
     instTraceStream->write(inst_pkt_header);
     // Create a protobuf message for the header and write it to
     // the stream
-    ProtoMessage::InstDepRecordHeader data_rec_header;
-    data_rec_header.set_obj_id(name());
-    data_rec_header.set_tick_freq(sim_clock::Frequency);
-    data_rec_header.set_window_size(depWindowSize);
-    dataTraceStream->write(data_rec_header);
+    if (dataTraceStream) {
+        ProtoMessage::InstDepRecordHeader data_rec_header;
+        data_rec_header.set_obj_id(name());
+        data_rec_header.set_tick_freq(sim_clock::Frequency);
+        data_rec_header.set_window_size(depWindowSize);
+        dataTraceStream->write(data_rec_header);
+    }
     // Register a callback to flush trace records and close the output streams.
     registerExitCallback([this]() {  flushTraces(); });
 }
@@ -871,8 +879,26 @@ ElasticTrace::writeDepTrace(uint32_t num_to_write)
                 dep_pkt.set_weight(num_filtered_nodes);
                 num_filtered_nodes = 0;
             }
-            // Write the message to the protobuf output stream
-            dataTraceStream->write(dep_pkt);
+            // Write the message to the protobuf output stream, or convert
+            // it for the columnar stream
+            if (columnarTraceStream) {
+                columnarRecord.seqNum = dep_pkt.seq_num();
+                columnarRecord.type = (ElasticTraceRecord::Type)dep_pkt.type();
+                columnarRecord.compDelay = dep_pkt.comp_delay();
+                columnarRecord.physAddr = dep_pkt.p_addr();
+                columnarRecord.virtAddr = dep_pkt.v_addr();
+                columnarRecord.pc = dep_pkt.pc();
+                columnarRecord.size = dep_pkt.size();
+                columnarRecord.flags = dep_pkt.flags();
+                columnarRecord.weight = dep_pkt.weight();
+                columnarRecord.robDep.assign(dep_pkt.rob_dep().begin(),
+                                             dep_pkt.rob_dep().end());
+                columnarRecord.regDep.assign(dep_pkt.reg_dep().begin(),
+                                             dep_pkt.reg_dep().end());
+                columnarTraceStream->write(columnarRecord);
+            } else {
+                dataTraceStream->write(dep_pkt);
+            }
         } else {
             // Don't write the node to the trace but note that we have filtered
             // out a node.
@@ -927,6 +953,7 @@ ElasticTrace::flushTraces()
     writeDepTrace(depTrace.size());
     // Delete the stream objects
     delete dataTraceStream;
+    delete columnarTraceStream;
     delete instTraceStream;
 }
 
@@ -53,6 +53,7 @@
 #include "base/statistics.hh"
 #include "cpu/o3/dyn_inst_ptr.hh"
 #include "cpu/reg_class.hh"
+#include "cpu/trace/elastic_trace_file.hh"
 #include "mem/request.hh"
 #include "params/ElasticTrace.hh"
 #include "proto/inst_dep_record.pb.h"
@@ -353,6 +354,15 @@ class ElasticTrace : public ProbeListenerObject
     /** Protobuf output stream for data dependency trace */
     ProtoOutputStream* dataTraceStream;
 
+    /**
+     * Columnar output stream for the data dependency trace, used instead
+     * of the protobuf stream if requested.
+     */
+    ElasticTraceWriter* columnarTraceStream;
+
+    /** Record reused to write to the columnar stream. */
+    ElasticTraceRecord columnarRecord;
+
     /** Protobuf output stream for instruction fetch trace. */
     ProtoOutputStream* instTraceStream;
 
@@ -0,0 +1,117 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "arch/generic/isa.hh"
+#include "base/compiler.hh"
+#include "cpu/o3/free_list.hh"
+#include "cpu/o3/regfile.hh"
+#include "cpu/reg_class.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** Number of registers an instruction stream reads in a row. */
+const int numRegs = 32;
+
+/**
+ * A register file sized like that of a default O3 CPU, and a few of
+ * its integer registers.
+ */
+struct RegFileFixture
+{
+    BaseISA::RegClasses regClasses;
+    o3::PhysRegFile regFile;
+    o3::UnifiedFreeList freeList;
+    PhysRegIdPtr regs[numRegs];
+
+    RegFileFixture() :
+        regClasses(makeRegClasses()),
+        regFile(256, 256, 256, 32, 128, regClasses, enums::Full),
+        freeList("freelist", &regFile)
+    {
+        for (int i = 0; i < numRegs; i++) {
+            regs[i] = freeList.getIntReg();
+            regFile.setIntReg(regs[i], i);
+        }
+    }
+
+    static BaseISA::RegClasses
+    makeRegClasses()
+    {
+        BaseISA::RegClasses classes;
+        for (int cls = IntRegClass; cls <= MiscRegClass; cls++)
+            classes.emplace_back(numRegs);
+        return classes;
+    }
+};
+
+/**
+ * How the CPU used to read a physical register for an instruction:
+ * through an accessor that couldn't be inlined into the operand
+ * accessors of the instructions.
+ */
+GEM5_NO_INLINE RegVal
+readIntRegOutOfLine(o3::PhysRegFile &reg_file, PhysRegIdPtr phys_reg)
+{
+    return reg_file.readIntReg(phys_reg);
+}
+
+/** Read registers through an out of line accessor. */
+void
+BM_ReadOutOfLine(benchmark::State &state)
+{
+    RegFileFixture f;
+    for (auto _ : state) {
+        RegVal sum = 0;
+        for (int i = 0; i < numRegs; i++)
+            sum += readIntRegOutOfLine(f.regFile, f.regs[i]);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * numRegs);
+}
+BENCHMARK(BM_ReadOutOfLine);
+
+/** Read registers through the inline accessors the CPU now has. */
+void
+BM_ReadInline(benchmark::State &state)
+{
+    RegFileFixture f;
+    for (auto _ : state) {
+        RegVal sum = 0;
+        for (int i = 0; i < numRegs; i++)
+            sum += f.regFile.readIntReg(f.regs[i]);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * numRegs);
+}
+BENCHMARK(BM_ReadInline);
+
+} // anonymous namespace
+
+BENCHMARK_MAIN();
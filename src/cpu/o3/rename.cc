@@ -448,6 +448,40 @@ Rename::tick()
 
 }
 
+bool
+Rename::canSkipCycles()
+{
+    for (ThreadID tid : *activeThreads) {
+        // Blocked stays blocked as long as it is stalled, running and
+        // idle stay so as long as there is nothing to rename, and the
+        // other states change on the next tick
+        if (renameStatus[tid] == Blocked) {
+            if (!checkStall(tid))
+                return false;
+        } else if (renameStatus[tid] != Running &&
+                   renameStatus[tid] != Idle) {
+            return false;
+        } else if (checkStall(tid) || !insts[tid].empty()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void
+Rename::recordStalledCycles(Cycles cycles)
+{
+    // see rename() and renameInsts(), no instruction can be renamed so
+    // none of the full events is counted
+    for (ThreadID tid : *activeThreads) {
+        if (renameStatus[tid] == Blocked)
+            stats.blockCycles += cycles;
+        else
+            stats.idleCycles += cycles;
+    }
+}
+
 void
 Rename::rename(bool &status_change, ThreadID tid)
 {
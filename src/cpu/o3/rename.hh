@@ -195,6 +195,18 @@ class Rename
      */
     void tick();
 
+    /** Checks if ticking rename would only update its per cycle stats,
+     * i.e., it stays blocked or has no instructions to rename, so that
+     * the CPU may skip ticking it.
+     */
+    bool canSkipCycles();
+
+    /** Accounts the cycles rename was not ticked while the CPU skipped
+     * them, as if it had been.
+     * @param cycles Number of skipped cycles.
+     */
+    void recordStalledCycles(Cycles cycles);
+
     /** Debugging function used to dump history buffer of renamings. */
     void dumpHistory();
 
@@ -327,10 +339,10 @@ class Rename
     TimeBuffer<TimeStruct> *timeBuffer;
 
     /** Wire to get IEW's output from backwards time buffer. */
-    TimeBuffer<TimeStruct>::wire fromIEW;
+    TimeBuffer<TimeStruct>::const_wire fromIEW;
 
     /** Wire to get commit's output from backwards time buffer. */
-    TimeBuffer<TimeStruct>::wire fromCommit;
+    TimeBuffer<TimeStruct>::const_wire fromCommit;
 
     /** Wire to write infromation heading to previous stages. */
     TimeBuffer<TimeStruct>::wire toDecode;
@@ -345,7 +357,7 @@ class Rename
     TimeBuffer<DecodeStruct> *decodeQueue;
 
     /** Wire to get decode's output from decode queue. */
-    TimeBuffer<DecodeStruct>::wire fromDecode;
+    TimeBuffer<DecodeStruct>::const_wire fromDecode;
 
     /** Queue of all instructions coming from decode this cycle. */
     InstQueue insts[MaxThreads];
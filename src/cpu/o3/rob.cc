@@ -55,6 +55,12 @@ namespace gem5
 namespace o3
 {
 
+InstListHook<DynInst> &
+ROB::InstListHookOf::get(DynInst *inst)
+{
+    return inst->robHook;
+}
+
 ROB::ROB(CPU *_cpu, const O3CPUParams &params)
     : robPolicy(params.smtROBPolicy),
       cpu(_cpu),
@@ -237,11 +243,8 @@ ROB::retireHead(ThreadID tid)
 
     assert(numInstsInROB > 0);
 
-    // Get the head ROB instruction by copying it and remove it from the list
-    InstIt head_it = instList[tid].begin();
-
-    DynInstPtr head_inst = std::move(*head_it);
-    instList[tid].erase(head_it);
+    // Get the head ROB instruction and remove it from the list
+    DynInstPtr head_inst = instList[tid].pop_front();
 
     assert(head_inst->readyToCommit());
 
@@ -498,7 +501,7 @@ ROB::squash(InstSeqNum squash_num, ThreadID tid)
     }
 }
 
-const DynInstPtr&
+DynInstPtr
 ROB::readHeadInst(ThreadID tid)
 {
     if (threadEntries[tid] != 0) {
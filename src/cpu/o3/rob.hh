@@ -50,6 +50,7 @@
 #include "config/the_isa.hh"
 #include "cpu/inst_seq.hh"
 #include "cpu/o3/dyn_inst_ptr.hh"
+#include "cpu/o3/inst_list.hh"
 #include "cpu/o3/limits.hh"
 #include "cpu/reg_class.hh"
 #include "enums/SMTQueuePolicy.hh"
@@ -73,7 +74,14 @@ class ROB
 {
   public:
     typedef std::pair<RegIndex, RegIndex> UnmapInfo;
-    typedef typename std::list<DynInstPtr>::iterator InstIt;
+
+    /** Accessor of the hook linking instructions in instList. */
+    struct InstListHookOf
+    {
+        static InstListHook<DynInst> &get(DynInst *inst);
+    };
+
+    typedef InstList<DynInst, InstListHookOf>::iterator InstIt;
 
     /** Possible ROB statuses. */
     enum Status
@@ -127,7 +135,7 @@ class ROB
      *  the ROB.
      *  @return Pointer to the DynInst that is at the head of the ROB.
      */
-    const DynInstPtr &readHeadInst(ThreadID tid);
+    DynInstPtr readHeadInst(ThreadID tid);
 
     /** Returns a pointer to the instruction with the given sequence if it is
      *  in the ROB.
@@ -287,7 +295,7 @@ class ROB
     unsigned maxEntries[MaxThreads];
 
     /** ROB List of Instructions */
-    std::list<DynInstPtr> instList[MaxThreads];
+    InstList<DynInst, InstListHookOf> instList[MaxThreads];
 
     /** Number of instructions that can be squashed in a single cycle. */
     unsigned squashWidth;
@@ -0,0 +1,43 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.params import *
+from m5.SimObject import SimObject
+
+class BranchTraceReplay(SimObject):
+    """Replays a trace of committed branches through a branch predictor,
+    without a CPU model, and exits when the whole trace is replayed."""
+
+    type = 'BranchTraceReplay'
+    cxx_class = 'gem5::branch_prediction::BranchTraceReplay'
+    cxx_header = "cpu/pred/trace_replay.hh"
+
+    trace_file = Param.String("Branch trace to replay")
+    branch_pred = Param.BranchPredictor("Branch predictor to evaluate")
+    max_branches = Param.UInt64(0,
+        "Number of branches to replay, 0 for the whole trace")
+    commit_delay = Param.Unsigned(0,
+        "Number of younger branches predicted before a branch commits")
+
+    # Resolves the number of threads of the branch predictor
+    numThreads = Param.Unsigned(1, "Number of threads")
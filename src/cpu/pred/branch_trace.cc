@@ -0,0 +1,169 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/pred/branch_trace.hh"
+
+#include <algorithm>
+#include <cassert>
+
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+namespace branch_prediction
+{
+
+namespace
+{
+
+/** Identifies branch trace files, followed by the format version. */
+const char traceMagic[8] = {'g', 'e', 'm', '5', 'B', 'T', 'R', 'C'};
+const uint8_t traceVersion = 1;
+
+/** Maps signed distances to unsigned values close to zero. */
+uint64_t
+zigzag(int64_t value)
+{
+    return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+}
+
+int64_t
+unzigzag(uint64_t value)
+{
+    return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+}
+
+} // anonymous namespace
+
+BranchTraceWriter::BranchTraceWriter(const std::string &path)
+{
+    fatal_if(!file.open(path, std::ios::out | std::ios::binary |
+                                  std::ios::trunc),
+             "Unable to create branch trace %s.", path);
+    file.sputn(traceMagic, sizeof(traceMagic));
+    file.sputc(traceVersion);
+}
+
+BranchTraceWriter::~BranchTraceWriter()
+{
+    close();
+}
+
+void
+BranchTraceWriter::writeVarint(uint64_t value)
+{
+    while (value >= 0x80) {
+        file.sputc((char)(value | 0x80));
+        value >>= 7;
+    }
+    file.sputc((char)value);
+}
+
+void
+BranchTraceWriter::write(const BranchRecord &record)
+{
+    assert(file.is_open());
+
+    // the outcome is implied by the target, keep the flags consistent
+    const bool taken = record.target != record.fallThrough;
+    uint8_t flags = record.flags & BranchRecord::TypeMask;
+    if (taken)
+        flags |= BranchRecord::Taken;
+
+    file.sputc(flags);
+    writeVarint(record.insts);
+    writeVarint(zigzag(record.pc - nextPC));
+    writeVarint(record.fallThrough - record.pc);
+    if (taken)
+        writeVarint(zigzag(record.target - record.pc));
+
+    nextPC = record.target;
+    count++;
+}
+
+void
+BranchTraceWriter::close()
+{
+    if (file.is_open())
+        file.close();
+}
+
+BranchTraceReader::BranchTraceReader(const std::string &path)
+    : path(path)
+{
+    fatal_if(!file.open(path, std::ios::in | std::ios::binary),
+             "Unable to open branch trace %s.", path);
+
+    char magic[sizeof(traceMagic)];
+    fatal_if(file.sgetn(magic, sizeof(magic)) != sizeof(magic) ||
+             !std::equal(magic, magic + sizeof(magic), traceMagic),
+             "%s is not a branch trace.", path);
+    const int version = file.sbumpc();
+    fatal_if(version != traceVersion,
+             "Unsupported version %d of branch trace %s.", version, path);
+}
+
+bool
+BranchTraceReader::readVarint(uint64_t &value)
+{
+    value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        const int byte = file.sbumpc();
+        if (byte == std::filebuf::traits_type::eof())
+            return false;
+        value |= (uint64_t)(byte & 0x7f) << shift;
+        if (!(byte & 0x80))
+            return true;
+    }
+    return false;
+}
+
+bool
+BranchTraceReader::read(BranchRecord &record)
+{
+    const int flags = file.sbumpc();
+    if (flags == std::filebuf::traits_type::eof())
+        return false;
+
+    uint64_t insts, pc_delta, size, target_delta = 0;
+    const bool taken = flags & BranchRecord::Taken;
+    fatal_if(!readVarint(insts) || !readVarint(pc_delta) ||
+             !readVarint(size) || (taken && !readVarint(target_delta)),
+             "Truncated branch trace %s.", path);
+
+    record.flags = flags;
+    record.insts = insts;
+    record.pc = nextPC + unzigzag(pc_delta);
+    record.fallThrough = record.pc + size;
+    record.target = taken ? record.pc + unzigzag(target_delta)
+                          : record.fallThrough;
+
+    nextPC = record.target;
+    return true;
+}
+
+} // namespace branch_prediction
+} // namespace gem5
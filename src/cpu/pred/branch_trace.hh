@@ -0,0 +1,230 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * A compact binary format for traces of committed branches, used to
+ * evaluate branch predictors without a CPU model.
+ */
+
+#ifndef __CPU_PRED_BRANCH_TRACE_HH__
+#define __CPU_PRED_BRANCH_TRACE_HH__
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+#include "base/types.hh"
+#include "cpu/inst_seq.hh"
+
+namespace gem5
+{
+
+namespace branch_prediction
+{
+
+/** A committed branch, in program order. */
+struct BranchRecord
+{
+    enum Flags : uint8_t
+    {
+        /** The branch was taken. */
+        Taken = 0x01,
+        /** The branch is conditional, otherwise it is unconditional. */
+        Conditional = 0x02,
+        /** The target comes from a register rather than the PC. */
+        Indirect = 0x04,
+        /** The branch is a subroutine call. */
+        Call = 0x08,
+        /** The branch is a subroutine return. */
+        Return = 0x10,
+        /** Mask of the flags describing the type of the branch. */
+        TypeMask = Conditional | Indirect | Call | Return
+    };
+
+    /** Address of the branch. */
+    Addr pc = 0;
+    /** Address of the instruction following the branch in memory. */
+    Addr fallThrough = 0;
+    /** Address of the next instruction committed after the branch. */
+    Addr target = 0;
+    /** Flags describing the branch and its outcome. */
+    uint8_t flags = 0;
+    /**
+     * Number of instructions committed since the previous branch,
+     * including this one.
+     */
+    uint64_t insts = 0;
+
+    bool taken() const { return flags & Taken; }
+    bool conditional() const { return flags & Conditional; }
+    bool indirect() const { return flags & Indirect; }
+    bool call() const { return flags & Call; }
+    bool isReturn() const { return flags & Return; }
+};
+
+/**
+ * Writes a branch trace. Every record starts with a byte of flags
+ * followed by variable length integers: the number of instructions
+ * since the previous branch, the distance from the address following
+ * the previous branch to this one, the size of the branch and, if it
+ * was taken, the distance to its target. Code runs in straight lines
+ * between branches, so most branches fit in a handful of bytes.
+ */
+class BranchTraceWriter
+{
+  public:
+    /**
+     * Creates a trace, replacing any existing file.
+     * @param path Path of the trace file.
+     */
+    BranchTraceWriter(const std::string &path);
+    ~BranchTraceWriter();
+
+    /** Appends a branch to the trace. */
+    void write(const BranchRecord &record);
+
+    /** Flushes the trace and closes the file. */
+    void close();
+
+    /** @return The number of branches written so far. */
+    uint64_t size() const { return count; }
+
+  private:
+    void writeVarint(uint64_t value);
+
+    std::filebuf file;
+
+    /** Address following the previous branch. */
+    Addr nextPC = 0;
+
+    uint64_t count = 0;
+};
+
+/** Reads the branches of a trace written by a BranchTraceWriter. */
+class BranchTraceReader
+{
+  public:
+    /**
+     * Opens a trace and checks its header.
+     * @param path Path of the trace file.
+     */
+    BranchTraceReader(const std::string &path);
+
+    /**
+     * Reads the next branch of the trace.
+     * @param record Record to fill.
+     * @return False at the end of the trace.
+     */
+    bool read(BranchRecord &record);
+
+  private:
+    bool readVarint(uint64_t &value);
+
+    std::filebuf file;
+
+    const std::string path;
+
+    /** Address following the previous branch. */
+    Addr nextPC = 0;
+};
+
+/** Counts of the branches replayed from a trace. */
+struct BranchReplayCounts
+{
+    /** Number of instructions committed by the traced program. */
+    uint64_t insts = 0;
+    /** Number of branches replayed. */
+    uint64_t branches = 0;
+    /** Number of conditional branches replayed. */
+    uint64_t condBranches = 0;
+    /** Number of branches whose next PC was mispredicted. */
+    uint64_t mispredicts = 0;
+    /** Number of conditional branches mispredicted. */
+    uint64_t condMispredicts = 0;
+};
+
+/**
+ * Replays the branches of a trace through a predictor. There is no
+ * wrong path in a trace, so every branch is resolved right after being
+ * predicted, and committed once a number of younger branches have been
+ * predicted. The predictor has to provide:
+ *
+ * - Addr predict(const BranchRecord &record, InstSeqNum seq_num), which
+ *   predicts the next PC of a branch;
+ * - void squash(const BranchRecord &record, InstSeqNum seq_num), which
+ *   repairs its state after the branch was mispredicted;
+ * - void update(InstSeqNum seq_num), which commits all the branches up
+ *   to and including seq_num.
+ *
+ * Branches are numbered from one in trace order.
+ *
+ * @param reader The trace to replay.
+ * @param pred The predictor.
+ * @param max_branches Number of branches to replay, zero for all.
+ * @param commit_delay Number of younger branches predicted before a
+ *        branch commits.
+ * @return The counts of the replayed branches.
+ */
+template <class Predictor>
+BranchReplayCounts
+replayBranchTrace(BranchTraceReader &reader, Predictor &pred,
+                  uint64_t max_branches, unsigned commit_delay)
+{
+    BranchReplayCounts counts;
+    BranchRecord record;
+    InstSeqNum seq_num = 0;
+
+    while ((!max_branches || seq_num < max_branches) && reader.read(record)) {
+        ++seq_num;
+
+        const Addr predicted = pred.predict(record, seq_num);
+
+        counts.insts += record.insts;
+        counts.branches++;
+        if (record.conditional())
+            counts.condBranches++;
+
+        if (predicted != record.target) {
+            counts.mispredicts++;
+            if (record.conditional())
+                counts.condMispredicts++;
+            pred.squash(record, seq_num);
+        }
+
+        if (seq_num > commit_delay)
+            pred.update(seq_num - commit_delay);
+    }
+    // commit the branches still in flight at the end of the trace
+    if (seq_num && commit_delay)
+        pred.update(seq_num);
+
+    return counts;
+}
+
+} // namespace branch_prediction
+} // namespace gem5
+
+#endif // __CPU_PRED_BRANCH_TRACE_HH__
@@ -0,0 +1,181 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <vector>
+
+#include "cpu/pred/branch_trace.hh"
+
+using namespace gem5;
+using namespace gem5::branch_prediction;
+
+namespace
+{
+
+std::string
+tracePath(const std::string &name)
+{
+    return testing::TempDir() + name;
+}
+
+BranchRecord
+makeRecord(Addr pc, unsigned size, Addr target, uint8_t type,
+           uint64_t insts)
+{
+    BranchRecord record;
+    record.pc = pc;
+    record.fallThrough = pc + size;
+    record.target = target;
+    record.flags = type;
+    if (target != record.fallThrough)
+        record.flags |= BranchRecord::Taken;
+    record.insts = insts;
+    return record;
+}
+
+void
+expectEqual(const BranchRecord &a, const BranchRecord &b)
+{
+    EXPECT_EQ(a.pc, b.pc);
+    EXPECT_EQ(a.fallThrough, b.fallThrough);
+    EXPECT_EQ(a.target, b.target);
+    EXPECT_EQ(a.flags, b.flags);
+    EXPECT_EQ(a.insts, b.insts);
+}
+
+} // anonymous namespace
+
+TEST(BranchTraceTest, Empty)
+{
+    const std::string path = tracePath("branch_trace_empty");
+    {
+        BranchTraceWriter writer(path);
+        EXPECT_EQ(writer.size(), 0);
+    }
+
+    BranchTraceReader reader(path);
+    BranchRecord record;
+    EXPECT_FALSE(reader.read(record));
+    std::remove(path.c_str());
+}
+
+TEST(BranchTraceTest, RoundTrip)
+{
+    const std::string path = tracePath("branch_trace_round_trip");
+    std::vector<BranchRecord> records = {
+        makeRecord(0x400000, 4, 0x400100, BranchRecord::Call, 10),
+        makeRecord(0x400120, 4, 0x400124, BranchRecord::Conditional, 8),
+        makeRecord(0x400130, 2, 0x400004,
+                   BranchRecord::Return | BranchRecord::Indirect, 3),
+        // going backwards, and at the extremes of the address space
+        makeRecord(0x10, 15, 0xffffffffffff0000, 0, 1),
+        makeRecord(0xffffffffffff0010, 4, 0x8,
+                   BranchRecord::Conditional, 1 << 20),
+    };
+
+    {
+        BranchTraceWriter writer(path);
+        for (const auto &record : records)
+            writer.write(record);
+        EXPECT_EQ(writer.size(), records.size());
+    }
+
+    BranchTraceReader reader(path);
+    BranchRecord record;
+    for (const auto &expected : records) {
+        ASSERT_TRUE(reader.read(record));
+        expectEqual(record, expected);
+        EXPECT_EQ(record.taken(), expected.target != expected.fallThrough);
+    }
+    EXPECT_FALSE(reader.read(record));
+    std::remove(path.c_str());
+}
+
+TEST(BranchTraceTest, TakenFlagFollowsTarget)
+{
+    const std::string path = tracePath("branch_trace_taken");
+    {
+        BranchTraceWriter writer(path);
+        BranchRecord record = makeRecord(0x1000, 4, 0x1004,
+                                         BranchRecord::Conditional, 1);
+        record.flags |= BranchRecord::Taken;
+        writer.write(record);
+    }
+
+    BranchTraceReader reader(path);
+    BranchRecord record;
+    ASSERT_TRUE(reader.read(record));
+    EXPECT_FALSE(record.taken());
+    EXPECT_TRUE(record.conditional());
+    std::remove(path.c_str());
+}
+
+TEST(BranchTraceTest, Compact)
+{
+    const std::string path = tracePath("branch_trace_compact");
+    const int num_branches = 10000;
+    std::mt19937 rng(1);
+    std::vector<BranchRecord> records;
+    {
+        BranchTraceWriter writer(path);
+        Addr pc = 0x400000;
+        for (int i = 0; i < num_branches; i++) {
+            pc += 4 * (rng() % 16);
+            Addr target = rng() % 2 ? pc + 4 : pc - 4 * (rng() % 64);
+            records.push_back(makeRecord(pc, 4, target,
+                                         BranchRecord::Conditional,
+                                         rng() % 16 + 1));
+            writer.write(records.back());
+            pc = target;
+        }
+    }
+
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    EXPECT_LT(file.tellg(), num_branches * 6);
+
+    BranchTraceReader reader(path);
+    BranchRecord record;
+    for (const auto &expected : records) {
+        ASSERT_TRUE(reader.read(record));
+        expectEqual(record, expected);
+    }
+    EXPECT_FALSE(reader.read(record));
+    std::remove(path.c_str());
+}
+
+TEST(BranchTraceTest, NotATrace)
+{
+    const std::string path = tracePath("branch_trace_bad");
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "not a branch trace";
+    }
+    ASSERT_ANY_THROW(BranchTraceReader reader(path));
+    std::remove(path.c_str());
+}
@@ -162,6 +162,20 @@ MultiperspectivePerceptron::init()
     computeBits(p.num_filter_entries, p.num_local_histories,
                 p.local_history_length, p.ignore_path_size);
 
+    for (auto &spec : specs) {
+        const int *xlat_table = (spec->width == 5) ? xlat4 : xlat;
+        transfer.push_back(xlat_table);
+        // the magnitudes of the counters are below 2^(width - 1)
+        std::vector<int> scaled(1 << (spec->width - 1));
+        for (int j = 0; j < scaled.size(); j += 1) {
+            scaled[j] = spec->coeff * xlat_table[j];
+        }
+        scaledTransfer.push_back(scaled);
+    }
+    hashedIndices.resize(specs.size());
+    featureWeights.resize(specs.size());
+    bestPreds.resize(specs.size());
+
     for (int i = 0; i < threadData.size(); i += 1) {
         threadData[i] = new ThreadData(p.num_filter_entries,
                                        p.num_local_histories,
@@ -306,11 +320,21 @@ MultiperspectivePerceptron::getIndex(ThreadID tid, const MPPBranchInfo &bi,
     return h;
 }
 
+void
+MultiperspectivePerceptron::computeIndices(ThreadID tid,
+        const MPPBranchInfo &bi, std::vector<unsigned int> &indices) const
+{
+    for (int i = 0; i < specs.size(); i += 1) {
+        indices[i] = getIndex(tid, bi, *specs[i], i);
+    }
+}
+
 int
 MultiperspectivePerceptron::computeOutput(ThreadID tid, MPPBranchInfo &bi)
 {
     // list of best predictors
-    std::vector<int> best_preds(specs.size(), -1);
+    std::vector<int> &best_preds = bestPreds;
+    std::fill(best_preds.begin(), best_preds.end(), -1);
 
     // initialize sum
     bi.yout = 0;
@@ -335,32 +359,40 @@ MultiperspectivePerceptron::computeOutput(ThreadID tid, MPPBranchInfo &bi)
     // begin computation of the sum for low-confidence branch
     int bestval = 0;
 
+    // get the hashes to index the tables
+    computeIndices(tid, bi, hashedIndices);
+
+    // gather the weights of the features
+    const std::vector<std::vector<short int>> &tables =
+        threadData[tid]->tables;
+    const std::vector<std::vector<std::array<bool, 2>>> &sign_bits =
+        threadData[tid]->sign_bits;
+    const int sign_idx = bi.getHPC() % n_sign_bits;
     for (int i = 0; i < specs.size(); i += 1) {
-        HistorySpec const &spec = *specs[i];
-        // get the hash to index the table
-        unsigned int hashed_idx = getIndex(tid, bi, spec, i);
-        // add the weight; first get the weight's magnitude
-        int counter = threadData[tid]->tables[i][hashed_idx];
-        // get the sign
-        bool sign =
-          threadData[tid]->sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits];
-        // apply the transfer function and multiply by a coefficient
-        int weight = spec.coeff * ((spec.width == 5) ?
-                                   xlat4[counter] : xlat[counter]);
+        unsigned int hashed_idx = hashedIndices[i];
+        // get the weight's magnitude, apply the transfer function and
+        // multiply by a coefficient
+        int weight = scaledTransfer[i][tables[i][hashed_idx]];
         // apply the sign
-        int val = sign ? -weight : weight;
-        // add the value
-        bi.yout += val;
-        // if this is one of those good features, add the value to bestval
-        if (threshold >= 0) {
-            for (int j = 0;
-                 j < std::min(nbest, (int) best_preds.size());
-                 j += 1)
-            {
-                if (best_preds[j] == i) {
-                    bestval += val;
-                    break;
-                }
+        featureWeights[i] = sign_bits[i][hashed_idx][sign_idx] ?
+                            -weight : weight;
+    }
+
+    // add the values, in a loop without dependencies on the tables
+    // that the compiler can vectorize
+    const int *weights = featureWeights.data();
+    int sum = 0;
+    for (int i = 0; i < specs.size(); i += 1) {
+        sum += weights[i];
+    }
+    bi.yout += sum;
+
+    // add the values of those good features to bestval
+    if (threshold >= 0) {
+        for (int j = 0; j < std::min(nbest, (int) best_preds.size());
+             j += 1) {
+            if (best_preds[j] >= 0) {
+                bestval += weights[best_preds[j]];
             }
         }
     }
@@ -413,6 +445,9 @@ MultiperspectivePerceptron::train(ThreadID tid, MPPBranchInfo &bi, bool taken)
     std::vector<std::vector<std::array<bool, 2>>> &sign_bits =
             threadData[tid]->sign_bits;
     std::vector<int> &mpreds = threadData[tid]->mpreds;
+    // get the hashes to index the tables, which do not change while
+    // training
+    computeIndices(tid, bi, hashedIndices);
     // was the prediction correct?
     bool correct = (bi.yout >= 1) == taken;
     // what is the magnitude of yout?
@@ -423,13 +458,10 @@ MultiperspectivePerceptron::train(ThreadID tid, MPPBranchInfo &bi, bool taken)
 
         // for each table, figure out if there was a misprediction
         for (int i = 0; i < specs.size(); i += 1) {
-            HistorySpec const &spec = *specs[i];
-            // get the hash to index the table
-            unsigned int hashed_idx = getIndex(tid, bi, spec, i);
+            unsigned int hashed_idx = hashedIndices[i];
             bool sign = sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits];
             int counter = tables[i][hashed_idx];
-            int weight = spec.coeff * ((spec.width == 5) ?
-                                       xlat4[counter] : xlat[counter]);
+            int weight = scaledTransfer[i][counter];
             if (sign) weight = -weight;
             bool pred = weight >= 1;
             if (pred != taken) {
@@ -473,7 +505,7 @@ MultiperspectivePerceptron::train(ThreadID tid, MPPBranchInfo &bi, bool taken)
     for (int i = 0; i < specs.size(); i += 1) {
         HistorySpec const &spec = *specs[i];
         // get the magnitude
-        unsigned int hashed_idx = getIndex(tid, bi, spec, i);
+        unsigned int hashed_idx = hashedIndices[i];
         int counter = tables[i][hashed_idx];
         // get the sign
         bool sign = sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits];
@@ -482,7 +514,7 @@ MultiperspectivePerceptron::train(ThreadID tid, MPPBranchInfo &bi, bool taken)
         // update the magnitude and sign
         tables[i][hashed_idx] = counter;
         sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits] = sign;
-        int weight = ((spec.width == 5) ? xlat4[counter] : xlat[counter]);
+        int weight = transfer[i][counter];
         // update the new version of yout
         if (sign) {
             newyout -= weight;
@@ -506,13 +538,11 @@ MultiperspectivePerceptron::train(ThreadID tid, MPPBranchInfo &bi, bool taken)
                 found = false;
                 for (int j = 0; j < specs.size(); j += 1) {
                     int i = (nrand + j) % specs.size();
-                    HistorySpec const &spec = *specs[i];
-                    unsigned int hashed_idx = getIndex(tid, bi, spec, i);
+                    unsigned int hashed_idx = hashedIndices[i];
                     int counter = tables[i][hashed_idx];
                     bool sign =
                         sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits];
-                    int weight = ((spec.width == 5) ?
-                            xlat4[counter] : xlat[counter]);
+                    int weight = transfer[i][counter];
                     int signed_weight = sign ? -weight : weight;
                     pout = newyout - signed_weight;
                     if ((pout >= 1) == taken) {
@@ -524,8 +554,7 @@ MultiperspectivePerceptron::train(ThreadID tid, MPPBranchInfo &bi, bool taken)
                 }
                 if (besti != -1) {
                     int i = besti;
-                    HistorySpec const &spec = *specs[i];
-                    unsigned int hashed_idx = getIndex(tid, bi, spec, i);
+                    unsigned int hashed_idx = hashedIndices[i];
                     int counter = tables[i][hashed_idx];
                     bool sign =
                         sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits];
@@ -533,8 +562,7 @@ MultiperspectivePerceptron::train(ThreadID tid, MPPBranchInfo &bi, bool taken)
                         counter--;
                         tables[i][hashed_idx] = counter;
                     }
-                    int weight = ((spec.width == 5) ?
-                            xlat4[counter] : xlat[counter]);
+                    int weight = transfer[i][counter];
                     int signed_weight = sign ? -weight : weight;
                     int out = pout + signed_weight;
                     round_counter += 1;
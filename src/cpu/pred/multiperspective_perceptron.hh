@@ -362,6 +362,25 @@ class MultiperspectivePerceptron : public BPredUnit
     std::vector<HistorySpec *> specs;
     std::vector<int> table_sizes;
 
+    /** Transfer function of each table, depending on its width */
+    std::vector<const int *> transfer;
+
+    /**
+     * Transfer function of each table scaled by the coefficient of its
+     * feature, indexed by the magnitude of the counters, so that the
+     * weights do not have to be scaled on every prediction
+     */
+    std::vector<std::vector<int>> scaledTransfer;
+
+    /**
+     * Working storage for the table indices, the signed weights of the
+     * features and the best features of the branch being predicted or
+     * trained, kept to avoid allocating them for every branch
+     */
+    std::vector<unsigned int> hashedIndices;
+    std::vector<int> featureWeights;
+    std::vector<int> bestPreds;
+
     /** runtime values and data used to count the size in bits */
     bool doing_local;
     bool doing_recency;
@@ -447,6 +466,17 @@ class MultiperspectivePerceptron : public BPredUnit
      */
     unsigned int getIndex(ThreadID tid, const MPPBranchInfo &bi,
             const HistorySpec &spec, int index) const;
+
+    /**
+     * Computes the position indices of all of the predictor tables. The
+     * indices only depend on the histories, so they are computed once
+     * and shared by all of the passes over the tables of a branch.
+     * @param tid Thread ID of the branch
+     * @param bi branch informaiton data
+     * @param indices vector to write the index of each table to
+     */
+    void computeIndices(ThreadID tid, const MPPBranchInfo &bi,
+            std::vector<unsigned int> &indices) const;
     /**
      * Finds the best subset of features to use in case of a low-confidence
      * branch, returns the result as an ordered vector of the indices to the
@@ -162,11 +162,45 @@ TAGEBase::initFoldedHistories(ThreadHistory & history)
     }
 }
 
+void
+TAGEBase::updateFoldedHistories(ThreadHistory & history)
+{
+    const uint8_t *h = history.gHist;
+    for (int i = 1; i <= nHistoryTables; i++) {
+        FoldedHistory &ci = history.computeIndices[i];
+        assert(history.computeTags[0][i].origLength == ci.origLength &&
+               history.computeTags[1][i].origLength == ci.origLength);
+        const unsigned out = h[ci.origLength];
+        ci.update(h[0], out);
+        history.computeTags[0][i].update(h[0], out);
+        history.computeTags[1][i].update(h[0], out);
+    }
+}
+
+void
+TAGEBase::restoreFoldedHistories(ThreadHistory & history,
+                                 const BranchInfo *bi)
+{
+    for (int i = 1; i <= nHistoryTables; i++) {
+        history.computeIndices[i].comp = bi->ci[i];
+        history.computeTags[0][i].comp = bi->ct0[i];
+        history.computeTags[1][i].comp = bi->ct1[i];
+    }
+}
+
 void
 TAGEBase::buildTageTables()
 {
+    // All of the tagged tables are allocated in a single contiguous
+    // block, which is walked linearly when the u counters are reset
+    size_t num_entries = 0;
     for (int i = 1; i <= nHistoryTables; i++) {
-        gtable[i] = new TageEntry[1<<(logTagTableSizes[i])];
+        num_entries += 1ULL << logTagTableSizes[i];
+    }
+    TageEntry *entries = new TageEntry[num_entries];
+    for (int i = 1; i <= nHistoryTables; i++) {
+        gtable[i] = entries;
+        entries += 1ULL << logTagTableSizes[i];
     }
 }
 
@@ -192,14 +226,8 @@ TAGEBase::btbUpdate(ThreadID tid, Addr branch_pc, BranchInfo* &bi)
         DPRINTF(Tage, "BTB miss resets prediction: %lx\n", branch_pc);
         assert(tHist.gHist == &tHist.globalHistory[tHist.ptGhist]);
         tHist.gHist[0] = 0;
-        for (int i = 1; i <= nHistoryTables; i++) {
-            tHist.computeIndices[i].comp = bi->ci[i];
-            tHist.computeTags[0][i].comp = bi->ct0[i];
-            tHist.computeTags[1][i].comp = bi->ct1[i];
-            tHist.computeIndices[i].update(tHist.gHist);
-            tHist.computeTags[0][i].update(tHist.gHist);
-            tHist.computeTags[1][i].update(tHist.gHist);
-        }
+        restoreFoldedHistories(tHist, bi);
+        updateFoldedHistories(tHist);
     }
 }
 
@@ -607,17 +635,14 @@ TAGEBase::updateHistories(ThreadID tid, Addr branch_pc, bool taken,
     }
 
     //prepare next index and tag computations for user branchs
-    for (int i = 1; i <= nHistoryTables; i++)
-    {
-        if (speculative) {
+    if (speculative) {
+        for (int i = 1; i <= nHistoryTables; i++) {
             bi->ci[i]  = tHist.computeIndices[i].comp;
             bi->ct0[i] = tHist.computeTags[0][i].comp;
             bi->ct1[i] = tHist.computeTags[1][i].comp;
         }
-        tHist.computeIndices[i].update(tHist.gHist);
-        tHist.computeTags[0][i].update(tHist.gHist);
-        tHist.computeTags[1][i].update(tHist.gHist);
     }
+    updateFoldedHistories(tHist);
     DPRINTF(Tage, "Updating global histories with branch:%lx; taken?:%d, "
             "path Hist: %x; pointer:%d\n", branch_pc, taken, tHist.pathHist,
             tHist.ptGhist);
@@ -641,14 +666,8 @@ TAGEBase::squash(ThreadID tid, bool taken, TAGEBase::BranchInfo *bi,
     tHist.ptGhist = bi->ptGhist;
     tHist.gHist = &(tHist.globalHistory[tHist.ptGhist]);
     tHist.gHist[0] = (taken ? 1 : 0);
-    for (int i = 1; i <= nHistoryTables; i++) {
-        tHist.computeIndices[i].comp = bi->ci[i];
-        tHist.computeTags[0][i].comp = bi->ct0[i];
-        tHist.computeTags[1][i].comp = bi->ct1[i];
-        tHist.computeIndices[i].update(tHist.gHist);
-        tHist.computeTags[0][i].update(tHist.gHist);
-        tHist.computeTags[1][i].update(tHist.gHist);
-    }
+    restoreFoldedHistories(tHist, bi);
+    updateFoldedHistories(tHist);
 }
 
 void
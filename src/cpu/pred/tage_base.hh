@@ -90,6 +90,7 @@ class TAGEBase : public SimObject
         int origLength;
         int outpoint;
         int bufferSize;
+        unsigned mask;
 
         FoldedHistory()
         {
@@ -101,14 +102,26 @@ class TAGEBase : public SimObject
             origLength = original_length;
             compLength = compressed_length;
             outpoint = original_length % compressed_length;
+            mask = (1ULL << compLength) - 1;
         }
 
-        void update(uint8_t * h)
+        /**
+         * Shifts in the newest outcome and shifts out the outcome that
+         * leaves the original history.
+         * @param in The newest outcome, h[0].
+         * @param out The outcome leaving the history, h[origLength].
+         */
+        void update(unsigned in, unsigned out)
         {
-            comp = (comp << 1) | h[0];
-            comp ^= h[origLength] << outpoint;
+            comp = (comp << 1) | in;
+            comp ^= out << outpoint;
             comp ^= (comp >> compLength);
-            comp &= (1ULL << compLength) - 1;
+            comp &= mask;
+        }
+
+        void update(uint8_t * h)
+        {
+            update(h[0], h[origLength]);
         }
     };
 
@@ -468,6 +481,23 @@ class TAGEBase : public SimObject
      */
     virtual void initFoldedHistories(ThreadHistory & history);
 
+    /**
+     * Updates the index and tag folded histories of all of the tagged
+     * tables with the newest outcome of the global history. The three
+     * histories of a table fold the same global history, so the outcome
+     * leaving it is read once per table.
+     * @param history The histories of the thread.
+     */
+    void updateFoldedHistories(ThreadHistory & history);
+
+    /**
+     * Restores the folded histories saved in a branch info.
+     * @param history The histories of the thread.
+     * @param bi The branch info holding the saved histories.
+     */
+    void restoreFoldedHistories(ThreadHistory & history,
+                                const BranchInfo *bi);
+
     int *histLengths;
     int *tableIndices;
     int *tableTags;
@@ -0,0 +1,203 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/pred/trace_replay.hh"
+
+#include <array>
+
+#include "arch/pcstate.hh"
+#include "base/logging.hh"
+#include "cpu/static_inst.hh"
+#include "sim/sim_exit.hh"
+
+namespace gem5
+{
+
+namespace branch_prediction
+{
+
+namespace
+{
+
+/**
+ * An instruction standing for a traced branch. The predictors only
+ * look at the control flags of the branches, the rest of their
+ * behaviour comes from the trace.
+ */
+class TraceBranchInst : public StaticInst
+{
+  public:
+    TraceBranchInst(uint8_t type)
+        : StaticInst("trace branch", No_OpClass)
+    {
+        flags[IsControl] = true;
+        flags[IsCondControl] = type & BranchRecord::Conditional;
+        flags[IsUncondControl] = !(type & BranchRecord::Conditional);
+        flags[IsIndirectControl] = type & BranchRecord::Indirect;
+        flags[IsDirectControl] = !(type & BranchRecord::Indirect);
+        flags[IsCall] = type & BranchRecord::Call;
+        flags[IsReturn] = type & BranchRecord::Return;
+    }
+
+    Fault
+    execute(ExecContext *xc, Trace::InstRecord *traceData) const override
+    {
+        panic("Traced branches cannot be executed.");
+    }
+
+    void
+    advancePC(TheISA::PCState &pc_state) const override
+    {
+        pc_state.advance();
+    }
+
+    TheISA::PCState
+    buildRetPC(const TheISA::PCState &cur_pc,
+               const TheISA::PCState &call_pc) const override
+    {
+        // the next PC of the call is the instruction following it
+        TheISA::PCState ret_pc = call_pc;
+        ret_pc.advance();
+        return ret_pc;
+    }
+
+    std::string
+    generateDisassembly(Addr pc,
+            const loader::SymbolTable *symtab) const override
+    {
+        return mnemonic;
+    }
+};
+
+/** Drives a branch predictor unit from the records of a trace. */
+class TracePredictor
+{
+  public:
+    TracePredictor(BPredUnit *bpred) : bpred(bpred) {}
+
+    Addr
+    predict(const BranchRecord &record, InstSeqNum seq_num)
+    {
+        // predict the next PC from the state of the PC at the branch
+        TheISA::PCState pc(record.pc);
+        pc.npc(record.fallThrough);
+        bpred->predict(branchInst(record.flags), seq_num, pc, tid);
+        return pc.instAddr();
+    }
+
+    void
+    squash(const BranchRecord &record, InstSeqNum seq_num)
+    {
+        bpred->squash(seq_num, TheISA::PCState(record.target),
+                      record.taken(), tid);
+    }
+
+    void update(InstSeqNum seq_num) { bpred->update(seq_num, tid); }
+
+  private:
+    /**
+     * Gets an instruction with the type of a traced branch, which is
+     * all the predictor needs to know about it.
+     * @param flags The flags of the branch record.
+     */
+    const StaticInstPtr &
+    branchInst(uint8_t flags)
+    {
+        const uint8_t type = flags & BranchRecord::TypeMask;
+        StaticInstPtr &inst = insts[type >> 1];
+        if (!inst)
+            inst = new TraceBranchInst(type);
+        return inst;
+    }
+
+    static constexpr ThreadID tid = 0;
+
+    BPredUnit *bpred;
+
+    /** Instructions for each type of branch, created on demand. */
+    std::array<StaticInstPtr, (BranchRecord::TypeMask >> 1) + 1> insts;
+};
+
+} // anonymous namespace
+
+BranchTraceReplay::BranchTraceReplay(const BranchTraceReplayParams &p)
+    : SimObject(p), bpred(p.branch_pred), traceFile(p.trace_file),
+      maxBranches(p.max_branches), commitDelay(p.commit_delay),
+      replayEvent([this]{ replay(); }, name()),
+      stats(this)
+{
+}
+
+void
+BranchTraceReplay::startup()
+{
+    schedule(replayEvent, curTick());
+}
+
+void
+BranchTraceReplay::replay()
+{
+    BranchTraceReader reader(traceFile);
+    TracePredictor pred(bpred);
+    const BranchReplayCounts counts =
+        replayBranchTrace(reader, pred, maxBranches, commitDelay);
+
+    stats.insts += counts.insts;
+    stats.branches += counts.branches;
+    stats.condBranches += counts.condBranches;
+    stats.mispredicts += counts.mispredicts;
+    stats.condMispredicts += counts.condMispredicts;
+
+    inform("Replayed %llu branches from %s.", counts.branches, traceFile);
+    exitSimLoop("branch trace replayed");
+}
+
+BranchTraceReplay::BranchTraceReplayStats::BranchTraceReplayStats(
+        statistics::Group *parent)
+    : statistics::Group(parent),
+      ADD_STAT(insts, statistics::units::Count::get(),
+               "Number of instructions committed by the traced program"),
+      ADD_STAT(branches, statistics::units::Count::get(),
+               "Number of branches replayed"),
+      ADD_STAT(condBranches, statistics::units::Count::get(),
+               "Number of conditional branches replayed"),
+      ADD_STAT(mispredicts, statistics::units::Count::get(),
+               "Number of branches whose next PC was mispredicted"),
+      ADD_STAT(condMispredicts, statistics::units::Count::get(),
+               "Number of conditional branches mispredicted"),
+      ADD_STAT(mpki, statistics::units::Rate<
+                    statistics::units::Count, statistics::units::Count>::get(),
+               "Number of mispredicted branches per thousand instructions",
+               mispredicts * 1000 / insts),
+      ADD_STAT(condMispredictRate, statistics::units::Ratio::get(),
+               "Fraction of the conditional branches mispredicted",
+               condMispredicts / condBranches)
+{
+    mpki.precision(4);
+    condMispredictRate.precision(6);
+}
+
+} // namespace branch_prediction
+} // namespace gem5
@@ -0,0 +1,110 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of a SimObject replaying branch traces through a branch
+ * predictor, without a CPU model.
+ */
+
+#ifndef __CPU_PRED_TRACE_REPLAY_HH__
+#define __CPU_PRED_TRACE_REPLAY_HH__
+
+#include <string>
+
+#include "base/statistics.hh"
+#include "cpu/pred/bpred_unit.hh"
+#include "cpu/pred/branch_trace.hh"
+#include "params/BranchTraceReplay.hh"
+#include "sim/eventq.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+namespace branch_prediction
+{
+
+/**
+ * Replays a trace of committed branches, as recorded by the branch
+ * trace probe of the atomic CPU, through a branch predictor and
+ * reports its accuracy. There is no wrong path in a trace, so every
+ * branch is resolved right after being predicted: mispredicted
+ * branches squash the predictor state they updated speculatively, and
+ * branches are committed once a configurable number of younger
+ * branches have been predicted. The simulation exits when the trace
+ * has been replayed, so many predictor configurations can be swept in
+ * parallel processes without simulating a CPU.
+ */
+class BranchTraceReplay : public SimObject
+{
+  public:
+    BranchTraceReplay(const BranchTraceReplayParams &p);
+
+    void startup() override;
+
+  private:
+    /** Replays the whole trace and exits the simulation loop. */
+    void replay();
+
+    /** The predictor being evaluated. */
+    BPredUnit *bpred;
+
+    /** Path of the trace. */
+    const std::string traceFile;
+
+    /** Number of branches to replay, zero for all of them. */
+    const uint64_t maxBranches;
+
+    /** Number of younger branches predicted before a branch commits. */
+    const unsigned commitDelay;
+
+    EventFunctionWrapper replayEvent;
+
+    struct BranchTraceReplayStats : public statistics::Group
+    {
+        BranchTraceReplayStats(statistics::Group *parent);
+
+        /** Number of instructions committed by the traced program. */
+        statistics::Scalar insts;
+        /** Number of branches replayed. */
+        statistics::Scalar branches;
+        /** Number of conditional branches replayed. */
+        statistics::Scalar condBranches;
+        /** Number of branches whose next PC was mispredicted. */
+        statistics::Scalar mispredicts;
+        /** Number of conditional branches mispredicted. */
+        statistics::Scalar condMispredicts;
+        /** Number of mispredicted branches per thousand instructions. */
+        statistics::Formula mpki;
+        /** Fraction of the conditional branches mispredicted. */
+        statistics::Formula condMispredictRate;
+    } stats;
+};
+
+} // namespace branch_prediction
+} // namespace gem5
+
+#endif // __CPU_PRED_TRACE_REPLAY_HH__
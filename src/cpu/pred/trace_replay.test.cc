@@ -0,0 +1,191 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <unordered_map>
+#include <vector>
+
+#include "cpu/pred/branch_trace.hh"
+
+using namespace gem5;
+using namespace gem5::branch_prediction;
+
+namespace
+{
+
+/**
+ * Predicts that every branch goes where it went the last time it was
+ * resolved, or falls through when it has not been seen yet.
+ */
+class LastTargetPredictor
+{
+  public:
+    Addr
+    predict(const BranchRecord &record, InstSeqNum seq_num)
+    {
+        predicted.push_back(seq_num);
+        auto it = targets.find(record.pc);
+        return it == targets.end() ? record.fallThrough : it->second;
+    }
+
+    void
+    squash(const BranchRecord &record, InstSeqNum seq_num)
+    {
+        // only the youngest branch can be squashed
+        EXPECT_EQ(seq_num, predicted.back());
+        squashed.push_back(seq_num);
+        targets[record.pc] = record.target;
+    }
+
+    void
+    update(InstSeqNum seq_num)
+    {
+        EXPECT_LE(seq_num, predicted.back());
+        EXPECT_GT(seq_num, committed);
+        committed = seq_num;
+        commits.push_back(seq_num);
+    }
+
+    std::unordered_map<Addr, Addr> targets;
+
+    std::vector<InstSeqNum> predicted;
+    std::vector<InstSeqNum> squashed;
+    std::vector<InstSeqNum> commits;
+    InstSeqNum committed = 0;
+};
+
+BranchRecord
+makeRecord(Addr pc, Addr target, uint8_t type, uint64_t insts)
+{
+    BranchRecord record;
+    record.pc = pc;
+    record.fallThrough = pc + 4;
+    record.target = target;
+    record.flags = type;
+    if (target != record.fallThrough)
+        record.flags |= BranchRecord::Taken;
+    record.insts = insts;
+    return record;
+}
+
+/**
+ * Records the trace of a loop running a number of times with a fixed
+ * trip count, calling a function at the start of every run.
+ */
+std::string
+recordLoops(const std::string &name, int runs, int trips)
+{
+    const std::string path = testing::TempDir() + name;
+    BranchTraceWriter writer(path);
+    for (int run = 0; run < runs; run++) {
+        writer.write(makeRecord(0x1000, 0x2000, BranchRecord::Call, 2));
+        for (int trip = 1; trip <= trips; trip++) {
+            const Addr target = trip < trips ? 0x2000 : 0x2014;
+            writer.write(makeRecord(0x2010, target,
+                                    BranchRecord::Conditional, 5));
+        }
+    }
+    return path;
+}
+
+} // anonymous namespace
+
+TEST(BranchTraceReplayTest, Mispredicts)
+{
+    const int runs = 4;
+    const int trips = 8;
+    const std::string path = recordLoops("trace_replay_counts", runs, trips);
+
+    BranchTraceReader reader(path);
+    LastTargetPredictor pred;
+    const BranchReplayCounts counts = replayBranchTrace(reader, pred, 0, 0);
+
+    EXPECT_EQ(counts.branches, runs * (trips + 1));
+    EXPECT_EQ(counts.condBranches, runs * trips);
+    EXPECT_EQ(counts.insts, runs * (2 + trips * 5));
+    // the loop branch mispredicts on the first and the last trip of
+    // every run, the call only the first time it is seen
+    EXPECT_EQ(counts.condMispredicts, 2 * runs);
+    EXPECT_EQ(counts.mispredicts, 2 * runs + 1);
+    EXPECT_EQ(pred.squashed.size(), counts.mispredicts);
+    EXPECT_EQ(pred.squashed.front(), 1);
+    EXPECT_EQ(pred.squashed.back(), counts.branches);
+    std::remove(path.c_str());
+}
+
+TEST(BranchTraceReplayTest, CommitDelay)
+{
+    const std::string path = recordLoops("trace_replay_delay", 2, 4);
+    const unsigned delay = 3;
+
+    BranchTraceReader reader(path);
+    LastTargetPredictor pred;
+    const BranchReplayCounts counts =
+        replayBranchTrace(reader, pred, 0, delay);
+
+    // branches commit in order once three younger ones were predicted,
+    // and the remaining ones all at once at the end of the trace
+    ASSERT_EQ(counts.branches, 10);
+    std::vector<InstSeqNum> expected;
+    for (InstSeqNum seq_num = 1; seq_num + delay <= 10; seq_num++)
+        expected.push_back(seq_num);
+    expected.push_back(10);
+    EXPECT_EQ(pred.commits, expected);
+    std::remove(path.c_str());
+}
+
+TEST(BranchTraceReplayTest, MaxBranches)
+{
+    const std::string path = recordLoops("trace_replay_max", 4, 8);
+
+    BranchTraceReader reader(path);
+    LastTargetPredictor pred;
+    const BranchReplayCounts counts = replayBranchTrace(reader, pred, 9, 0);
+
+    // a single run: the call and its loop
+    EXPECT_EQ(counts.branches, 9);
+    EXPECT_EQ(counts.condBranches, 8);
+    EXPECT_EQ(counts.mispredicts, 3);
+    EXPECT_EQ(counts.condMispredicts, 2);
+    EXPECT_EQ(pred.commits.back(), 9);
+    std::remove(path.c_str());
+}
+
+TEST(BranchTraceReplayTest, Empty)
+{
+    const std::string path = testing::TempDir() + "trace_replay_empty";
+    BranchTraceWriter(path).close();
+
+    BranchTraceReader reader(path);
+    LastTargetPredictor pred;
+    const BranchReplayCounts counts = replayBranchTrace(reader, pred, 0, 2);
+
+    EXPECT_EQ(counts.branches, 0);
+    EXPECT_EQ(counts.mispredicts, 0);
+    EXPECT_TRUE(pred.commits.empty());
+    std::remove(path.c_str());
+}
@@ -82,7 +82,7 @@ AtomicSimpleCPU::AtomicSimpleCPU(const AtomicSimpleCPUParams &p)
       icachePort(name() + ".icache_port", this),
       dcachePort(name() + ".dcache_port", this),
       dcache_access(false), dcache_latency(0),
-      ppCommit(nullptr)
+      ppCommit(nullptr), ppBranch(nullptr)
 {
     _status = Idle;
     ifetch_req = std::make_shared<Request>();
@@ -650,6 +650,11 @@ AtomicSimpleCPU::tick()
 
         Fault fault = NoFault;
 
+        // The control instruction being executed, if any, and the state
+        // of the PC before it executed, for the branch probe
+        StaticInstPtr branch_inst;
+        TheISA::PCState branch_pc;
+
         TheISA::PCState pcState = thread->pcState();
 
         bool needToFetch = !isRomMicroPC(pcState.microPC()) &&
@@ -683,12 +688,19 @@ AtomicSimpleCPU::tick()
 
             Tick stall_ticks = 0;
             if (curStaticInst) {
+                if (curStaticInst->isControl() && ppBranch->hasListeners())
+                    branch_pc = thread->pcState();
+
                 fault = curStaticInst->execute(&t_info, traceData);
 
                 // keep an instruction count
                 if (fault == NoFault) {
                     countInst();
                     ppCommit->notify(std::make_pair(thread, curStaticInst));
+                    if (curStaticInst->isControl() &&
+                        ppBranch->hasListeners()) {
+                        branch_inst = curStaticInst;
+                    }
                 } else if (traceData) {
                     traceFault();
                 }
@@ -725,8 +737,14 @@ AtomicSimpleCPU::tick()
             }
 
         }
-        if (fault != NoFault || !t_info.stayAtPC)
+        if (fault != NoFault || !t_info.stayAtPC) {
             advancePC(fault);
+
+            if (branch_inst) {
+                ppBranch->notify({thread, branch_inst, branch_pc,
+                                  thread->pcState()});
+            }
+        }
     }
 
     if (tryCompleteDrain())
@@ -764,6 +782,8 @@ AtomicSimpleCPU::regProbePoints()
 
     ppCommit = new ProbePointArg<std::pair<SimpleThread*, const StaticInstPtr>>
                                 (getProbeManager(), "Commit");
+    ppBranch = new ProbePointArg<CommittedBranch>(getProbeManager(),
+                                                  "Branch");
 }
 
 void
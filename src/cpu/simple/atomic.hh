@@ -59,6 +59,17 @@ class AtomicSimpleCPU : public BaseSimpleCPU
 
     void init() override;
 
+    /** A committed control instruction, notified by the Branch probe. */
+    struct CommittedBranch
+    {
+        SimpleThread *thread;
+        StaticInstPtr inst;
+        /** State of the PC before the instruction executed. */
+        TheISA::PCState pc;
+        /** State of the PC at the instruction committed next. */
+        TheISA::PCState nextPC;
+    };
+
   protected:
     EventFunctionWrapper tickEvent;
 
@@ -172,6 +183,7 @@ class AtomicSimpleCPU : public BaseSimpleCPU
 
     /** Probe Points. */
     ProbePointArg<std::pair<SimpleThread *, const StaticInstPtr>> *ppCommit;
+    ProbePointArg<CommittedBranch> *ppBranch;
 
   protected:
 
@@ -0,0 +1,96 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/simple/probes/branch_trace_recorder.hh"
+
+#include "base/output.hh"
+#include "sim/core.hh"
+
+namespace gem5
+{
+
+BranchTraceRecorder::BranchTraceRecorder(
+        const BranchTraceRecorderParams &p)
+    : ProbeListenerObject(p),
+      writer(simout.resolve(p.trace_file)),
+      instCount(0)
+{
+    // SimObjects are not destroyed on exit, flush the trace then
+    registerExitCallback([this]() { writer.close(); });
+}
+
+void
+BranchTraceRecorder::regProbeListeners()
+{
+    typedef ProbeListenerArg<BranchTraceRecorder,
+                             std::pair<SimpleThread *, StaticInstPtr>>
+        CommitListener;
+    typedef ProbeListenerArg<BranchTraceRecorder,
+                             AtomicSimpleCPU::CommittedBranch>
+        BranchListener;
+    listeners.push_back(new CommitListener(
+        this, "Commit", &BranchTraceRecorder::countInst));
+    listeners.push_back(new BranchListener(
+        this, "Branch", &BranchTraceRecorder::recordBranch));
+}
+
+void
+BranchTraceRecorder::countInst(
+        const std::pair<SimpleThread *, StaticInstPtr> &p)
+{
+    const StaticInstPtr &inst = p.second;
+    if (!inst->isMicroop() || inst->isLastMicroop())
+        ++instCount;
+}
+
+void
+BranchTraceRecorder::recordBranch(
+        const AtomicSimpleCPU::CommittedBranch &branch)
+{
+    // Branches between the microops of an instruction are not seen by
+    // the branch predictors
+    if (branch.nextPC.instAddr() == branch.pc.instAddr())
+        return;
+
+    const StaticInstPtr &inst = branch.inst;
+    branch_prediction::BranchRecord record;
+    record.pc = branch.pc.instAddr();
+    record.fallThrough = branch.pc.npc();
+    record.target = branch.nextPC.instAddr();
+    record.insts = instCount;
+    if (inst->isCondCtrl())
+        record.flags |= branch_prediction::BranchRecord::Conditional;
+    if (inst->isIndirectCtrl())
+        record.flags |= branch_prediction::BranchRecord::Indirect;
+    if (inst->isCall())
+        record.flags |= branch_prediction::BranchRecord::Call;
+    if (inst->isReturn())
+        record.flags |= branch_prediction::BranchRecord::Return;
+
+    writer.write(record);
+    instCount = 0;
+}
+
+} // namespace gem5
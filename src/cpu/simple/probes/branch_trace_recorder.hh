@@ -0,0 +1,66 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_SIMPLE_PROBES_BRANCH_TRACE_RECORDER_HH__
+#define __CPU_SIMPLE_PROBES_BRANCH_TRACE_RECORDER_HH__
+
+#include <utility>
+
+#include "cpu/pred/branch_trace.hh"
+#include "cpu/simple/atomic.hh"
+#include "params/BranchTraceRecorder.hh"
+#include "sim/probe/probe.hh"
+
+namespace gem5
+{
+
+/**
+ * Probe recording the branches committed by an atomic CPU, in the
+ * format replayed by the branch predictor trace replay, so that
+ * branch predictors can be evaluated without a CPU model.
+ */
+class BranchTraceRecorder : public ProbeListenerObject
+{
+  public:
+    BranchTraceRecorder(const BranchTraceRecorderParams &params);
+
+    void regProbeListeners() override;
+
+    /** Counts the committed instructions. */
+    void countInst(const std::pair<SimpleThread *, StaticInstPtr> &p);
+
+    /** Appends a committed branch to the trace. */
+    void recordBranch(const AtomicSimpleCPU::CommittedBranch &branch);
+
+  private:
+    branch_prediction::BranchTraceWriter writer;
+
+    /** Instructions committed since the previous branch recorded. */
+    uint64_t instCount;
+};
+
+} // namespace gem5
+
+#endif // __CPU_SIMPLE_PROBES_BRANCH_TRACE_RECORDER_HH__
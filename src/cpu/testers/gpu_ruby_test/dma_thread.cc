@@ -222,7 +222,7 @@ DmaThread::hitCallback(PacketPtr pkt)
         assert(outstandingAtomics.count(addr) > 0);
 
         // get return data
-        Value value = *(pkt->getPtr<Value>());
+        Value value = *(pkt->getConstPtr<Value>());
 
         // validate atomic op return
         OutstandingReq req = popOutstandingReq(outstandingAtomics, addr);
@@ -244,7 +244,7 @@ DmaThread::hitCallback(PacketPtr pkt)
         assert(outstandingLoads.count(addr) > 0);
 
         // get return data
-        Value value = *(pkt->getPtr<Value>());
+        Value value = *(pkt->getConstPtr<Value>());
         OutstandingReq req = popOutstandingReq(outstandingLoads, addr);
         assert(req.lane == 0);
         validateLoadResp(req.origLoc, req.lane, value);
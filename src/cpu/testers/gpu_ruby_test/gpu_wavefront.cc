@@ -289,7 +289,7 @@ GpuWavefront::hitCallback(PacketPtr pkt)
         assert(outstandingLoads.count(addr) > 0);
 
         // get return data
-        Value value = *(pkt->getPtr<Value>());
+        Value value = *(pkt->getConstPtr<Value>());
         OutstandingReq req = popOutstandingReq(outstandingLoads, addr);
         validateLoadResp(req.origLoc, req.lane, value);
 
@@ -326,7 +326,7 @@ GpuWavefront::hitCallback(PacketPtr pkt)
         assert(outstandingAtomics.count(addr) > 0);
 
         // get return data
-        Value value = *(pkt->getPtr<Value>());
+        Value value = *(pkt->getConstPtr<Value>());
 
         // validate atomic op return
         OutstandingReq req = popOutstandingReq(outstandingAtomics, addr);
@@ -0,0 +1,146 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+#include "cpu/timebuf.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/**
+ * A latch shaped like the O3 communication structs, i.e., a few hundred
+ * bytes of instruction pointers and per-thread signals.
+ */
+struct Latch
+{
+    int size = 0;
+    void *insts[32] = {};
+    uint64_t signals[8][4] = {};
+};
+
+/** Past and future latencies of a typical O3 time buffer. */
+const int past = 5;
+const int future = 5;
+
+/**
+ * A buffer that is written every cycle. Every element that enters the
+ * buffer has to be reset, which is what advance() used to do for every
+ * buffer regardless of its use.
+ */
+void
+BM_AdvanceWritten(benchmark::State &state)
+{
+    TimeBuffer<Latch> buf(past, future);
+    auto in = buf.getWire(0);
+    for (auto _ : state) {
+        in->size = 1;
+        buf.advance();
+    }
+}
+BENCHMARK(BM_AdvanceWritten);
+
+/** A buffer that is advanced every cycle but not written. */
+void
+BM_AdvanceIdle(benchmark::State &state)
+{
+    TimeBuffer<Latch> buf(past, future);
+    for (auto _ : state) {
+        buf.advance();
+        benchmark::DoNotOptimize(buf.isClean());
+    }
+}
+BENCHMARK(BM_AdvanceIdle);
+
+/**
+ * Skip over a number of idle cycles after a write, as a stalled
+ * pipeline does.
+ */
+void
+BM_AdvanceSkip(benchmark::State &state)
+{
+    TimeBuffer<Latch> buf(past, future);
+    auto in = buf.getWire(0);
+    const uint64_t cycles = state.range(0);
+    for (auto _ : state) {
+        in->size = 1;
+        buf.advance(cycles);
+    }
+    state.SetItemsProcessed(state.iterations() * cycles);
+}
+BENCHMARK(BM_AdvanceSkip)->RangeMultiplier(8)->Range(1, 4096);
+
+/** Reference for BM_AdvanceSkip, advancing one cycle at a time. */
+void
+BM_AdvanceStep(benchmark::State &state)
+{
+    TimeBuffer<Latch> buf(past, future);
+    auto in = buf.getWire(0);
+    const uint64_t cycles = state.range(0);
+    for (auto _ : state) {
+        in->size = 1;
+        for (uint64_t i = 0; i < cycles; i++)
+            buf.advance();
+    }
+    state.SetItemsProcessed(state.iterations() * cycles);
+}
+BENCHMARK(BM_AdvanceStep)->RangeMultiplier(8)->Range(1, 4096);
+
+/**
+ * The buffers of an O3 pipeline, as seen in a cycle: each one is read
+ * by a stage every cycle, but only written now and then, e.g., on a
+ * squash. The reads go through a const wire, or through a wire, which
+ * marks every element that is read as written.
+ */
+template <class Wire>
+void
+BM_AdvanceRead(benchmark::State &state)
+{
+    TimeBuffer<Latch> buf(past, future);
+    auto in = buf.getWire(0);
+    Wire out = buf.getWire(-past);
+    const int write_every = state.range(0);
+    int cycle = 0;
+    for (auto _ : state) {
+        if (++cycle == write_every) {
+            in->size = 1;
+            cycle = 0;
+        }
+        benchmark::DoNotOptimize(out->size);
+        buf.advance();
+    }
+}
+BENCHMARK_TEMPLATE(BM_AdvanceRead, TimeBuffer<Latch>::const_wire)
+    ->Arg(1)->Arg(16)->Arg(256);
+BENCHMARK_TEMPLATE(BM_AdvanceRead, TimeBuffer<Latch>::wire)
+    ->Arg(1)->Arg(16)->Arg(256);
+
+} // anonymous namespace
+
+BENCHMARK_MAIN();
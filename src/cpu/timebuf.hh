@@ -29,13 +29,28 @@
 #ifndef __BASE_TIMEBUF_HH__
 #define __BASE_TIMEBUF_HH__
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <cstring>
 #include <vector>
 
 namespace gem5
 {
 
+/**
+ * A circular buffer of elements, one per cycle, modelling the latches
+ * between pipeline stages. Every cycle, the element that moves into the
+ * furthest future position is reset to a zeroed, default constructed
+ * element.
+ *
+ * Elements are only reset if they were accessed through a non-const
+ * accessor or a wire since they were last reset; the other elements
+ * are still in the reset state. Advancing a buffer that is not in use,
+ * possibly over many cycles at once, is therefore cheap. Stages that
+ * only read a buffer should do so through a const_wire, which does not
+ * mark the elements it reads.
+ */
 template <class T>
 class TimeBuffer
 {
@@ -49,16 +64,50 @@ class TimeBuffer
     std::vector<char *> index;
     unsigned base;
 
+    /**
+     * Whether each element may have been written since it was last
+     * reset, and the number of such elements.
+     */
+    std::vector<uint8_t> dirty;
+    unsigned numDirty;
+
     void valid(int idx) const
     {
         assert (idx >= -past && idx <= future);
     }
 
+    /** Reset an element to its initial state if it may have changed. */
+    void
+    reset(int vector_index)
+    {
+        if (!dirty[vector_index])
+            return;
+
+        (reinterpret_cast<T *>(index[vector_index]))->~T();
+        std::memset(index[vector_index], 0, sizeof(T));
+        new (index[vector_index]) T;
+
+        dirty[vector_index] = 0;
+        --numDirty;
+    }
+
+    /** Mark an element as possibly written. */
+    void
+    markDirty(int vector_index)
+    {
+        if (!dirty[vector_index]) {
+            dirty[vector_index] = 1;
+            ++numDirty;
+        }
+    }
+
   public:
     friend class wire;
+    class const_wire;
     class wire
     {
         friend class TimeBuffer;
+        friend class const_wire;
       protected:
         TimeBuffer<T> *buffer;
         int index;
@@ -135,11 +184,38 @@ class TimeBuffer
         T *operator->() const { return buffer->access(index); }
     };
 
+    /** A wire that can only be read through. */
+    class const_wire
+    {
+      protected:
+        const TimeBuffer<T> *buffer;
+        int index;
+
+      public:
+        const_wire()
+        { }
+
+        const_wire(const wire &i)
+            : buffer(i.buffer), index(i.index)
+        { }
+
+        const const_wire &operator=(const wire &i)
+        {
+            buffer = i.buffer;
+            index = i.index;
+            return *this;
+        }
+
+        const T &operator*() const { return *buffer->access(index); }
+        const T *operator->() const { return buffer->access(index); }
+    };
+
 
   public:
     TimeBuffer(int p, int f)
         : past(p), future(f), size(past + future + 1),
-          data(new char[size * sizeof(T)]), index(size), base(0)
+          data(new char[size * sizeof(T)]), index(size), base(0),
+          dirty(size, 0), numDirty(0)
     {
         assert(past >= 0 && future >= 0);
         char *ptr = data;
@@ -184,11 +260,31 @@ class TimeBuffer
         int ptr = base + future;
         if (ptr >= (int)size)
             ptr -= size;
-        (reinterpret_cast<T *>(index[ptr]))->~T();
-        std::memset(index[ptr], 0, sizeof(T));
-        new (index[ptr]) T;
+        reset(ptr);
     }
 
+    /**
+     * Advance the buffer by a number of cycles at once, as if advance()
+     * was called that many times. Once every element has been reset,
+     * advancing further only rotates the buffer, so this takes constant
+     * time if the buffer has not been written.
+     *
+     * @param cycles Number of cycles to advance.
+     */
+    void
+    advance(uint64_t cycles)
+    {
+        const uint64_t stepped =
+            numDirty ? std::min<uint64_t>(cycles, size) : 0;
+        for (uint64_t i = 0; i < stepped; ++i)
+            advance();
+
+        base = (base + (cycles - stepped) % size) % size;
+    }
+
+    /** @return True if no element was written since it was reset. */
+    bool isClean() const { return numDirty == 0; }
+
   protected:
     //Calculate the index into this->index for element at position idx
     //relative to now
@@ -211,13 +307,22 @@ class TimeBuffer
     T *access(int idx)
     {
         int vector_index = calculateVectorIndex(idx);
+        markDirty(vector_index);
 
         return reinterpret_cast<T *>(index[vector_index]);
     }
 
+    const T *access(int idx) const
+    {
+        int vector_index = calculateVectorIndex(idx);
+
+        return reinterpret_cast<const T *>(index[vector_index]);
+    }
+
     T &operator[](int idx)
     {
         int vector_index = calculateVectorIndex(idx);
+        markDirty(vector_index);
 
         return reinterpret_cast<T &>(*index[vector_index]);
     }
@@ -0,0 +1,132 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "cpu/timebuf.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+struct Latch
+{
+    int size = 0;
+    int values[4] = {};
+
+    static int constructed;
+
+    Latch() { constructed++; }
+};
+
+int Latch::constructed = 0;
+
+} // anonymous namespace
+
+/** Values move from the future to the past as the buffer advances. */
+TEST(TimeBufferTest, Advance)
+{
+    TimeBuffer<Latch> buf(2, 1);
+    auto in = buf.getWire(0);
+    auto out = buf.getWire(-2);
+
+    in->size = 3;
+    buf.advance();
+    EXPECT_EQ(buf[-1].size, 3);
+    EXPECT_EQ(in->size, 0);
+    buf.advance();
+    EXPECT_EQ(out->size, 3);
+
+    // After a full rotation, the element has been reset
+    buf.advance();
+    buf.advance();
+    EXPECT_EQ(buf[0].size, 0);
+}
+
+/** Only the elements that were accessed are reset. */
+TEST(TimeBufferTest, ResetDirtyOnly)
+{
+    TimeBuffer<Latch> buf(3, 0);
+    EXPECT_TRUE(buf.isClean());
+
+    Latch::constructed = 0;
+    for (int i = 0; i < 8; i++)
+        buf.advance();
+    EXPECT_EQ(Latch::constructed, 0);
+
+    buf[0].values[2] = 7;
+    EXPECT_FALSE(buf.isClean());
+    for (int i = 0; i < 4; i++)
+        buf.advance();
+    EXPECT_EQ(Latch::constructed, 1);
+    EXPECT_TRUE(buf.isClean());
+
+    // Const accesses do not mark elements as written
+    const TimeBuffer<Latch> &cbuf = buf;
+    EXPECT_EQ(cbuf[-1].values[2], 0);
+    EXPECT_TRUE(buf.isClean());
+}
+
+/** Reading through a const wire does not mark elements as written. */
+TEST(TimeBufferTest, ConstWire)
+{
+    TimeBuffer<Latch> buf(2, 0);
+    auto in = buf.getWire(0);
+    TimeBuffer<Latch>::const_wire out = buf.getWire(-1);
+
+    in->size = 5;
+    buf.advance();
+    EXPECT_EQ(out->size, 5);
+    buf.advance();
+    buf.advance();
+    EXPECT_TRUE(buf.isClean());
+
+    for (int i = 0; i < 4; i++) {
+        EXPECT_EQ(out->size, 0);
+        buf.advance();
+    }
+    EXPECT_TRUE(buf.isClean());
+}
+
+/** Advancing many cycles at once matches advancing one at a time. */
+TEST(TimeBufferTest, AdvanceMany)
+{
+    TimeBuffer<Latch> one(2, 2), many(2, 2);
+    for (int i = -2; i <= 2; i++) {
+        one[i].size = i + 10;
+        many[i].size = i + 10;
+    }
+
+    for (uint64_t cycles : {1, 2, 3, 7, 1000}) {
+        for (uint64_t i = 0; i < cycles; i++)
+            one.advance();
+        many.advance(cycles);
+        for (int i = -2; i <= 2; i++)
+            EXPECT_EQ(one[i].size, many[i].size);
+        one[0].size = cycles;
+        many[0].size = cycles;
+    }
+}
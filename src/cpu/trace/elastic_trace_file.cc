@@ -0,0 +1,341 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/trace/elastic_trace_file.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include "base/logging.hh"
+#include "sim/byteswap.hh"
+
+namespace gem5
+{
+
+namespace elastic_trace_file
+{
+
+size_t
+blockSize(size_t num_records, size_t num_deps)
+{
+    size_t size = sizeof(BlockHeader) +
+        num_records * (5 * sizeof(uint64_t) + 3 * sizeof(uint32_t) +
+                       3 * sizeof(uint8_t)) +
+        num_deps * sizeof(uint32_t);
+    // Keep the next block aligned for its 64-bit columns
+    return (size + 7) & ~size_t(7);
+}
+
+namespace
+{
+
+template <typename T>
+void
+writeColumn(std::ofstream &out, const std::vector<T> &column)
+{
+    for (auto value: column) {
+        value = htole(value);
+        out.write((const char *)&value, sizeof(value));
+    }
+}
+
+} // anonymous namespace
+
+} // namespace elastic_trace_file
+
+using namespace elastic_trace_file;
+
+ElasticTraceWriter::ElasticTraceWriter(const std::string &_filename,
+        uint32_t window_size, uint64_t tick_freq,
+        uint32_t records_per_block)
+    : out(_filename, std::ios::out | std::ios::binary | std::ios::trunc),
+      filename(_filename), recordsPerBlock(records_per_block)
+{
+    fatal_if(!out.good(), "Could not open %s for writing.\n", filename);
+    fatal_if(recordsPerBlock == 0, "Blocks of %s must hold records.\n",
+             filename);
+
+    FileHeader file_header = {};
+    std::memcpy(file_header.magic, magic, sizeof(magic));
+    file_header.version = htole(version);
+    file_header.windowSize = htole(window_size);
+    file_header.tickFreq = htole(tick_freq);
+    out.write((const char *)&file_header, sizeof(file_header));
+}
+
+ElasticTraceWriter::~ElasticTraceWriter()
+{
+    close();
+}
+
+uint8_t
+ElasticTraceWriter::addDeps(uint64_t seq_num,
+                            const std::vector<uint64_t> &deps,
+                            const std::vector<uint64_t> *skip)
+{
+    uint8_t num_deps = 0;
+    for (auto dep: deps) {
+        if (skip && std::find(skip->begin(), skip->end(), dep) != skip->end())
+            continue;
+
+        fatal_if(dep >= seq_num ||
+                 seq_num - dep > std::numeric_limits<uint32_t>::max(),
+                 "Record %llu of %s has an invalid dependency on %llu.\n",
+                 seq_num, filename, dep);
+        fatal_if(num_deps == std::numeric_limits<uint8_t>::max(),
+                 "Record %llu of %s has too many dependencies.\n",
+                 seq_num, filename);
+        depDist.push_back(seq_num - dep);
+        num_deps++;
+    }
+    return num_deps;
+}
+
+void
+ElasticTraceWriter::write(const ElasticTraceRecord &record)
+{
+    seqNum.push_back(record.seqNum);
+    compDelay.push_back(record.compDelay);
+    physAddr.push_back(record.physAddr);
+    virtAddr.push_back(record.virtAddr);
+    pc.push_back(record.pc);
+    size.push_back(record.size);
+    flags.push_back(record.flags);
+    weight.push_back(record.weight);
+    type.push_back(record.type);
+    numRobDeps.push_back(addDeps(record.seqNum, record.robDep, nullptr));
+    // A register dependency that is also an order dependency is only
+    // honoured once during replay, so it is not written twice
+    numRegDeps.push_back(addDeps(record.seqNum, record.regDep,
+                                 &record.robDep));
+
+    if (seqNum.size() == recordsPerBlock)
+        flush();
+}
+
+void
+ElasticTraceWriter::flush()
+{
+    if (seqNum.empty())
+        return;
+
+    BlockHeader block_header;
+    block_header.numRecords = htole((uint32_t)seqNum.size());
+    block_header.numDeps = htole((uint32_t)depDist.size());
+    out.write((const char *)&block_header, sizeof(block_header));
+
+    writeColumn(out, seqNum);
+    writeColumn(out, compDelay);
+    writeColumn(out, physAddr);
+    writeColumn(out, virtAddr);
+    writeColumn(out, pc);
+    writeColumn(out, size);
+    writeColumn(out, flags);
+    writeColumn(out, weight);
+    writeColumn(out, depDist);
+    writeColumn(out, type);
+    writeColumn(out, numRobDeps);
+    writeColumn(out, numRegDeps);
+
+    const size_t unpadded = sizeof(block_header) +
+        seqNum.size() * (5 * sizeof(uint64_t) + 3 * sizeof(uint32_t) +
+                         3 * sizeof(uint8_t)) +
+        depDist.size() * sizeof(uint32_t);
+    const char padding[8] = {};
+    out.write(padding, blockSize(seqNum.size(), depDist.size()) - unpadded);
+
+    fatal_if(!out.good(), "Failed to write to %s.\n", filename);
+
+    seqNum.clear();
+    compDelay.clear();
+    physAddr.clear();
+    virtAddr.clear();
+    pc.clear();
+    size.clear();
+    flags.clear();
+    weight.clear();
+    depDist.clear();
+    type.clear();
+    numRobDeps.clear();
+    numRegDeps.clear();
+}
+
+void
+ElasticTraceWriter::close()
+{
+    if (!out.is_open())
+        return;
+
+    flush();
+    out.close();
+}
+
+ElasticTraceReader::ElasticTraceReader(const std::string &_filename)
+    : filename(_filename), data(nullptr), length(0)
+{
+    int fd = open(filename.c_str(), O_RDONLY);
+    fatal_if(fd < 0, "Could not open %s for reading.\n", filename);
+
+    struct stat st;
+    fatal_if(fstat(fd, &st) != 0, "Could not stat %s.\n", filename);
+    length = st.st_size;
+    fatal_if(length < sizeof(FileHeader),
+             "%s is too short to be a columnar elastic trace.\n", filename);
+
+    void *addr = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    fatal_if(addr == MAP_FAILED, "Could not map %s.\n", filename);
+    data = (const uint8_t *)addr;
+    // The trace is consumed from start to end
+    madvise(addr, length, MADV_SEQUENTIAL);
+
+    std::memcpy(&header, data, sizeof(header));
+    fatal_if(std::memcmp(header.magic, magic, sizeof(magic)) != 0,
+             "%s is not a columnar elastic trace.\n", filename);
+    header.version = letoh(header.version);
+    header.windowSize = letoh(header.windowSize);
+    header.tickFreq = letoh(header.tickFreq);
+    fatal_if(header.version != version,
+             "%s has unsupported columnar trace version %d.\n",
+             filename, header.version);
+
+    reset();
+}
+
+ElasticTraceReader::~ElasticTraceReader()
+{
+    munmap((void *)data, length);
+}
+
+bool
+ElasticTraceReader::isColumnar(const std::string &filename)
+{
+    std::ifstream in(filename, std::ios::in | std::ios::binary);
+    char file_magic[sizeof(magic)];
+    if (!in.read(file_magic, sizeof(file_magic)))
+        return false;
+    return std::memcmp(file_magic, magic, sizeof(magic)) == 0;
+}
+
+void
+ElasticTraceReader::reset()
+{
+    nextBlock = sizeof(FileHeader);
+    released = 0;
+    block = {};
+    index = 0;
+    depIndex = 0;
+}
+
+bool
+ElasticTraceReader::nextBlockHeader()
+{
+    if (nextBlock + sizeof(BlockHeader) > length)
+        return false;
+
+    const size_t start = nextBlock;
+
+    // Release the pages of the blocks consumed so far, which are not
+    // going to be accessed again unless the trace is reset
+    const size_t page_size = sysconf(_SC_PAGESIZE);
+    const size_t release_end = start & ~(page_size - 1);
+    if (release_end > released) {
+        madvise((void *)(data + released), release_end - released,
+                MADV_DONTNEED);
+        released = release_end;
+    }
+
+    std::memcpy(&block, data + start, sizeof(block));
+    block.numRecords = letoh(block.numRecords);
+    block.numDeps = letoh(block.numDeps);
+
+    nextBlock = start + blockSize(block.numRecords, block.numDeps);
+    fatal_if(nextBlock > length, "Truncated block at offset %d of %s.\n",
+             start, filename);
+
+    const uint8_t *column = data + start + sizeof(BlockHeader);
+    auto next_column = [&column](auto *&ptr, size_t count) {
+        ptr = (std::remove_reference_t<decltype(ptr)>)column;
+        column += count * sizeof(*ptr);
+    };
+    next_column(seqNum, block.numRecords);
+    next_column(compDelay, block.numRecords);
+    next_column(physAddr, block.numRecords);
+    next_column(virtAddr, block.numRecords);
+    next_column(pc, block.numRecords);
+    next_column(size, block.numRecords);
+    next_column(flags, block.numRecords);
+    next_column(weight, block.numRecords);
+    next_column(depDist, block.numDeps);
+    next_column(type, block.numRecords);
+    next_column(numRobDeps, block.numRecords);
+    next_column(numRegDeps, block.numRecords);
+
+    index = 0;
+    depIndex = 0;
+    return true;
+}
+
+bool
+ElasticTraceReader::read(ElasticTraceRecord &record)
+{
+    while (index == block.numRecords) {
+        if (!nextBlockHeader())
+            return false;
+    }
+
+    const uint32_t i = index++;
+    record.seqNum = letoh(seqNum[i]);
+    record.type = (ElasticTraceRecord::Type)type[i];
+    record.compDelay = letoh(compDelay[i]);
+    record.physAddr = letoh(physAddr[i]);
+    record.virtAddr = letoh(virtAddr[i]);
+    record.pc = letoh(pc[i]);
+    record.size = letoh(size[i]);
+    record.flags = letoh(flags[i]);
+    record.weight = letoh(weight[i]);
+
+    fatal_if(depIndex + numRobDeps[i] + numRegDeps[i] > block.numDeps,
+             "Record %llu of %s has more dependencies than its block.\n",
+             record.seqNum, filename);
+
+    record.robDep.clear();
+    for (int d = 0; d < numRobDeps[i]; d++)
+        record.robDep.push_back(record.seqNum - letoh(depDist[depIndex++]));
+    record.regDep.clear();
+    for (int d = 0; d < numRegDeps[i]; d++)
+        record.regDep.push_back(record.seqNum - letoh(depDist[depIndex++]));
+
+    return true;
+}
+
+} // namespace gem5
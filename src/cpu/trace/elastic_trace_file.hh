@@ -0,0 +1,308 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of a columnar binary format for elastic traces, along
+ * with a writer and a memory-mapped reader for it.
+ *
+ * The protobuf elastic traces are decoded one message at a time, which
+ * dominates the cost of replaying long traces. The columnar format
+ * stores the records in blocks, each block holding one array per
+ * field, so that a reader can stream through a memory-mapped file and
+ * decode a record with a handful of loads.
+ *
+ * A file starts with a FileHeader, followed by any number of blocks.
+ * Each block starts with a BlockHeader, followed by the columns below,
+ * with all values stored little endian:
+ *
+ *   uint64_t seqNum[numRecords]
+ *   uint64_t compDelay[numRecords]
+ *   uint64_t physAddr[numRecords]
+ *   uint64_t virtAddr[numRecords]
+ *   uint64_t pc[numRecords]
+ *   uint32_t size[numRecords]
+ *   uint32_t flags[numRecords]
+ *   uint32_t weight[numRecords]
+ *   uint32_t depDist[numDeps]
+ *   uint8_t  type[numRecords]
+ *   uint8_t  numRobDeps[numRecords]
+ *   uint8_t  numRegDeps[numRecords]
+ *
+ * and padding up to the next multiple of 8 bytes. The dependencies of
+ * a record are stored as the distance between its sequence number and
+ * the sequence number of the producer, order dependencies first. They
+ * are resolved when the trace is written, so register dependencies
+ * that are also order dependencies are already dropped.
+ */
+
+#ifndef __CPU_TRACE_ELASTIC_TRACE_FILE_HH__
+#define __CPU_TRACE_ELASTIC_TRACE_FILE_HH__
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace gem5
+{
+
+/** A record of the dependency trace, as held in memory. */
+struct ElasticTraceRecord
+{
+    /** Record types, matching the protobuf InstDepRecord types. */
+    enum Type : uint8_t
+    {
+        INVALID = 0,
+        LOAD = 1,
+        STORE = 2,
+        COMP = 3
+    };
+
+    uint64_t seqNum = 0;
+    Type type = INVALID;
+    uint64_t compDelay = 0;
+    uint64_t physAddr = 0;
+    uint64_t virtAddr = 0;
+    uint64_t pc = 0;
+    uint32_t size = 0;
+    uint32_t flags = 0;
+    /** Number of committed instructions filtered out before this one. */
+    uint32_t weight = 0;
+
+    /** Sequence numbers of the order dependencies. */
+    std::vector<uint64_t> robDep;
+    /** Sequence numbers of the register dependencies. */
+    std::vector<uint64_t> regDep;
+};
+
+namespace elastic_trace_file
+{
+
+/** Magic number identifying a columnar elastic trace. */
+constexpr char magic[8] = { 'g', 'e', 'm', '5', 'E', 'T', 'C', '\0' };
+
+/** Version of the format described above. */
+constexpr uint32_t version = 1;
+
+struct FileHeader
+{
+    char magic[8];
+    uint32_t version;
+    /** Dependency window size used when capturing the trace. */
+    uint32_t windowSize;
+    /** Tick frequency of the simulation that captured the trace. */
+    uint64_t tickFreq;
+    uint64_t reserved;
+};
+
+struct BlockHeader
+{
+    uint32_t numRecords;
+    uint32_t numDeps;
+};
+
+static_assert(sizeof(FileHeader) == 32, "Unexpected file header size");
+static_assert(sizeof(BlockHeader) == 8, "Unexpected block header size");
+
+/**
+ * @param num_records Number of records in a block.
+ * @param num_deps Number of dependencies in a block.
+ * @return Size of the block, including its header, in bytes.
+ */
+size_t blockSize(size_t num_records, size_t num_deps);
+
+} // namespace elastic_trace_file
+
+/**
+ * Writer of columnar elastic traces. Records are buffered until a
+ * block is full, and the last, possibly partial, block is written
+ * when the writer is closed or destroyed.
+ */
+class ElasticTraceWriter
+{
+  private:
+    std::ofstream out;
+
+    const std::string filename;
+
+    /** Maximum number of records in a block. */
+    const uint32_t recordsPerBlock;
+
+    /** @{ */
+    /** Columns of the block being filled. */
+    std::vector<uint64_t> seqNum;
+    std::vector<uint64_t> compDelay;
+    std::vector<uint64_t> physAddr;
+    std::vector<uint64_t> virtAddr;
+    std::vector<uint64_t> pc;
+    std::vector<uint32_t> size;
+    std::vector<uint32_t> flags;
+    std::vector<uint32_t> weight;
+    std::vector<uint32_t> depDist;
+    std::vector<uint8_t> type;
+    std::vector<uint8_t> numRobDeps;
+    std::vector<uint8_t> numRegDeps;
+    /** @} */
+
+    /** Write out the buffered records as a block. */
+    void flush();
+
+    /**
+     * Append the dependencies of a record to the block.
+     *
+     * @param seq_num Sequence number of the record.
+     * @param deps Sequence numbers of its producers.
+     * @param skip Dependencies not to write again, if any.
+     * @return The number of dependencies written.
+     */
+    uint8_t addDeps(uint64_t seq_num, const std::vector<uint64_t> &deps,
+                    const std::vector<uint64_t> *skip);
+
+  public:
+    /**
+     * Create a trace file and write its header.
+     *
+     * @param filename Path of the file to create.
+     * @param window_size Dependency window size of the trace.
+     * @param tick_freq Tick frequency of the simulation.
+     * @param records_per_block Maximum number of records in a block.
+     */
+    ElasticTraceWriter(const std::string &filename, uint32_t window_size,
+                       uint64_t tick_freq,
+                       uint32_t records_per_block=4096);
+
+    ~ElasticTraceWriter();
+
+    /**
+     * Append a record to the trace. The dependencies must refer to
+     * records that precede this one.
+     *
+     * @param record The record to append.
+     */
+    void write(const ElasticTraceRecord &record);
+
+    /** Write out any buffered records and close the file. */
+    void close();
+};
+
+/**
+ * Reader of columnar elastic traces. The file is memory mapped and
+ * read one block at a time, and the pages of the blocks that have
+ * been consumed are released, so that replaying a trace needs a
+ * bounded amount of memory whatever its length.
+ */
+class ElasticTraceReader
+{
+  private:
+    const std::string filename;
+
+    /** The mapped file. */
+    const uint8_t *data;
+
+    /** Length of the file in bytes. */
+    size_t length;
+
+    /** Offset of the block after the current one. */
+    size_t nextBlock;
+
+    /** Offset of the first byte not released yet. */
+    size_t released;
+
+    /** Index of the next record in the current block. */
+    uint32_t index;
+
+    /** Index of the next dependency in the current block. */
+    uint32_t depIndex;
+
+    elastic_trace_file::FileHeader header;
+
+    elastic_trace_file::BlockHeader block;
+
+    /** @{ */
+    /** Columns of the current block. */
+    const uint64_t *seqNum;
+    const uint64_t *compDelay;
+    const uint64_t *physAddr;
+    const uint64_t *virtAddr;
+    const uint64_t *pc;
+    const uint32_t *size;
+    const uint32_t *flags;
+    const uint32_t *weight;
+    const uint32_t *depDist;
+    const uint8_t *type;
+    const uint8_t *numRobDeps;
+    const uint8_t *numRegDeps;
+    /** @} */
+
+    /**
+     * Move on to the next block of the file.
+     *
+     * @return False if the end of the file was reached.
+     */
+    bool nextBlockHeader();
+
+  public:
+    /**
+     * Map a trace file and check its header.
+     *
+     * @param filename Path of the file to read.
+     */
+    ElasticTraceReader(const std::string &filename);
+
+    ~ElasticTraceReader();
+
+    /**
+     * Check if a file holds a columnar elastic trace.
+     *
+     * @param filename Path of the file to check.
+     * @return True if the file starts with the columnar magic number.
+     */
+    static bool isColumnar(const std::string &filename);
+
+    /** @return The dependency window size of the trace. */
+    uint32_t windowSize() const { return header.windowSize; }
+
+    /** @return The tick frequency the trace was captured with. */
+    uint64_t tickFreq() const { return header.tickFreq; }
+
+    /**
+     * Read the next record of the trace. The dependency vectors of the
+     * record are reused, so reading does not allocate once they are
+     * large enough.
+     *
+     * @param record The record to populate.
+     * @return False if the end of the trace was reached.
+     */
+    bool read(ElasticTraceRecord &record);
+
+    /** Go back to the beginning of the trace. */
+    void reset();
+};
+
+} // namespace gem5
+
+#endif // __CPU_TRACE_ELASTIC_TRACE_FILE_HH__
@@ -0,0 +1,175 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "cpu/trace/elastic_trace_file.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+std::string
+tracePath(const std::string &name)
+{
+    return testing::TempDir() + name;
+}
+
+ElasticTraceRecord
+makeRecord(uint64_t seq_num, ElasticTraceRecord::Type type,
+           std::vector<uint64_t> rob_dep, std::vector<uint64_t> reg_dep)
+{
+    ElasticTraceRecord record;
+    record.seqNum = seq_num;
+    record.type = type;
+    record.compDelay = seq_num * 500;
+    record.pc = 0x400000 + 4 * seq_num;
+    record.weight = seq_num % 3;
+    if (type != ElasticTraceRecord::COMP) {
+        record.physAddr = 0x80000000 + 64 * seq_num;
+        record.virtAddr = 0x7fff0000 + 64 * seq_num;
+        record.size = 8;
+        record.flags = 0x40;
+    }
+    record.robDep = rob_dep;
+    record.regDep = reg_dep;
+    return record;
+}
+
+void
+expectEqual(const ElasticTraceRecord &a, const ElasticTraceRecord &b)
+{
+    EXPECT_EQ(a.seqNum, b.seqNum);
+    EXPECT_EQ(a.type, b.type);
+    EXPECT_EQ(a.compDelay, b.compDelay);
+    EXPECT_EQ(a.physAddr, b.physAddr);
+    EXPECT_EQ(a.virtAddr, b.virtAddr);
+    EXPECT_EQ(a.pc, b.pc);
+    EXPECT_EQ(a.size, b.size);
+    EXPECT_EQ(a.flags, b.flags);
+    EXPECT_EQ(a.weight, b.weight);
+    EXPECT_EQ(a.robDep, b.robDep);
+    EXPECT_EQ(a.regDep, b.regDep);
+}
+
+} // anonymous namespace
+
+TEST(ElasticTraceFileTest, Header)
+{
+    const std::string path = tracePath("elastic_trace_header");
+    {
+        ElasticTraceWriter writer(path, 384, 1000000000000ULL);
+    }
+
+    EXPECT_TRUE(ElasticTraceReader::isColumnar(path));
+    ElasticTraceReader reader(path);
+    EXPECT_EQ(reader.windowSize(), 384);
+    EXPECT_EQ(reader.tickFreq(), 1000000000000ULL);
+
+    ElasticTraceRecord record;
+    EXPECT_FALSE(reader.read(record));
+    std::remove(path.c_str());
+}
+
+TEST(ElasticTraceFileTest, NotColumnar)
+{
+    const std::string path = tracePath("elastic_trace_not_columnar");
+    {
+        std::FILE *f = std::fopen(path.c_str(), "w");
+        ASSERT_NE(f, nullptr);
+        std::fputs("gem5", f);
+        std::fclose(f);
+    }
+    EXPECT_FALSE(ElasticTraceReader::isColumnar(path));
+    EXPECT_FALSE(ElasticTraceReader::isColumnar(path + ".missing"));
+    std::remove(path.c_str());
+}
+
+/**
+ * Records spanning several blocks, with the last block partially
+ * filled, are read back in order.
+ */
+TEST(ElasticTraceFileTest, RoundTrip)
+{
+    const std::string path = tracePath("elastic_trace_round_trip");
+    std::vector<ElasticTraceRecord> records;
+    records.push_back(makeRecord(1, ElasticTraceRecord::COMP, {}, {}));
+    for (uint64_t seq_num = 2; seq_num < 40; seq_num++) {
+        auto type = (ElasticTraceRecord::Type)(1 + seq_num % 3);
+        std::vector<uint64_t> rob_dep, reg_dep;
+        if (seq_num % 2)
+            rob_dep.push_back(seq_num - 1);
+        reg_dep.push_back(seq_num / 2);
+        if (seq_num > 20)
+            reg_dep.push_back(seq_num - 20);
+        records.push_back(makeRecord(seq_num, type, rob_dep, reg_dep));
+    }
+
+    {
+        ElasticTraceWriter writer(path, 64, 1000, 16);
+        for (const auto &record : records)
+            writer.write(record);
+    }
+
+    ElasticTraceReader reader(path);
+    ElasticTraceRecord record;
+    for (int pass = 0; pass < 2; pass++) {
+        for (const auto &expected : records) {
+            ASSERT_TRUE(reader.read(record));
+            expectEqual(record, expected);
+        }
+        EXPECT_FALSE(reader.read(record));
+        reader.reset();
+    }
+    std::remove(path.c_str());
+}
+
+/** Register dependencies duplicating order dependencies are dropped. */
+TEST(ElasticTraceFileTest, DuplicateDeps)
+{
+    const std::string path = tracePath("elastic_trace_duplicate_deps");
+    {
+        ElasticTraceWriter writer(path, 64, 1000);
+        writer.write(makeRecord(1, ElasticTraceRecord::LOAD, {}, {}));
+        writer.write(makeRecord(2, ElasticTraceRecord::COMP, {}, {}));
+        writer.write(makeRecord(3, ElasticTraceRecord::STORE, {1}, {1, 2}));
+    }
+
+    ElasticTraceReader reader(path);
+    ElasticTraceRecord record;
+    ASSERT_TRUE(reader.read(record));
+    ASSERT_TRUE(reader.read(record));
+    ASSERT_TRUE(reader.read(record));
+    EXPECT_EQ(record.seqNum, 3);
+    EXPECT_EQ(record.robDep, std::vector<uint64_t>({1}));
+    EXPECT_EQ(record.regDep, std::vector<uint64_t>({2}));
+    EXPECT_FALSE(reader.read(record));
+    std::remove(path.c_str());
+}
@@ -287,12 +287,38 @@ TraceCPU::ElasticDataGen::adjustInitTraceOffset(Tick& offset)
     }
 }
 
+TraceCPU::ElasticDataGen::~ElasticDataGen()
+{
+    for (auto &node : depGraph)
+        delete node.second;
+    for (auto node : freeNodes)
+        delete node;
+}
+
 void
 TraceCPU::ElasticDataGen::exit()
 {
     trace.reset();
 }
 
+TraceCPU::ElasticDataGen::GraphNode *
+TraceCPU::ElasticDataGen::allocNode()
+{
+    if (freeNodes.empty())
+        return new GraphNode;
+
+    GraphNode *node = freeNodes.back();
+    freeNodes.pop_back();
+    return node;
+}
+
+void
+TraceCPU::ElasticDataGen::freeNode(GraphNode *node)
+{
+    assert(node->dependents.empty());
+    freeNodes.push_back(node);
+}
+
 bool
 TraceCPU::ElasticDataGen::readNextWindow()
 {
@@ -312,7 +338,7 @@ TraceCPU::ElasticDataGen::readNextWindow()
     while (num_read != windowSize) {
 
         // Create a new graph node
-        GraphNode* new_node = new GraphNode;
+        GraphNode* new_node = allocNode();
 
         // Read the next line to get the next record. If that fails then end of
         // trace has been reached and traceComplete needs to be set in addition
@@ -320,6 +346,7 @@ TraceCPU::ElasticDataGen::readNextWindow()
         if (!trace.read(new_node)) {
             DPRINTF(TraceCPUData, "\tTrace complete!\n");
             traceComplete = true;
+            freeNode(new_node);
             return false;
         }
 
@@ -509,8 +536,8 @@ TraceCPU::ElasticDataGen::execute()
             (node_ptr->dependents).clear();
             // Update the stat for numOps simulated
             owner.updateNumOps(node_ptr->robNum);
-            // delete node
-            delete node_ptr;
+            // recycle node
+            freeNode(node_ptr);
             // remove from graph
             depGraph.erase(graph_itr);
         }
@@ -717,8 +744,8 @@ TraceCPU::ElasticDataGen::completeMemAccess(PacketPtr pkt)
         (node_ptr->dependents).clear();
         // Update the stat for numOps completed
         owner.updateNumOps(node_ptr->robNum);
-        // delete node
-        delete node_ptr;
+        // recycle node
+        freeNode(node_ptr);
         // remove from graph
         depGraph.erase(graph_itr);
     }
@@ -1196,13 +1223,23 @@ TraceCPU::DcachePort::recvReqRetry()
 
 TraceCPU::ElasticDataGen::InputStream::InputStream(
         const std::string& filename, const double time_multiplier) :
-    trace(filename),
     timeMultiplier(time_multiplier),
     microOpCount(0)
 {
+    if (ElasticTraceReader::isColumnar(filename)) {
+        columnarTrace.reset(new ElasticTraceReader(filename));
+        fatal_if(columnarTrace->tickFreq() != sim_clock::Frequency,
+                 "Trace %s was recorded with a different tick frequency %d\n",
+                 filename, columnarTrace->tickFreq());
+        windowSize = columnarTrace->windowSize();
+        return;
+    }
+
+    protoTrace.reset(new ProtoInputStream(filename));
+
     // Create a protobuf message for the header and read it from the stream
     ProtoMessage::InstDepRecordHeader header_msg;
-    if (!trace.read(header_msg)) {
+    if (!protoTrace->read(header_msg)) {
         panic("Failed to read packet header from %s\n", filename);
 
         if (header_msg.tick_freq() != sim_clock::Frequency) {
@@ -1219,14 +1256,52 @@ TraceCPU::ElasticDataGen::InputStream::InputStream(
 void
 TraceCPU::ElasticDataGen::InputStream::reset()
 {
-    trace.reset();
+    if (columnarTrace)
+        columnarTrace->reset();
+    else
+        protoTrace->reset();
 }
 
 bool
 TraceCPU::ElasticDataGen::InputStream::read(GraphNode* element)
+{
+    return columnarTrace ? readColumnar(element) : readProto(element);
+}
+
+bool
+TraceCPU::ElasticDataGen::InputStream::readColumnar(GraphNode* element)
+{
+    if (!columnarTrace->read(record))
+        return false;
+
+    element->seqNum = record.seqNum;
+    element->type = (RecordType)record.type;
+    // Scale the compute delay to effectively scale the Trace CPU frequency
+    element->compDelay = record.compDelay * timeMultiplier;
+
+    // The dependencies were resolved when writing the trace, so swap the
+    // lists rather than copying them. The old lists of the node are reused
+    // for the next record.
+    element->robDep.swap(record.robDep);
+    element->regDep.swap(record.regDep);
+
+    element->physAddr = record.physAddr;
+    element->virtAddr = record.virtAddr;
+    element->size = record.size;
+    element->flags = record.flags;
+    element->pc = record.pc;
+
+    // ROB occupancy number
+    microOpCount += 1 + record.weight;
+    element->robNum = microOpCount;
+    return true;
+}
+
+bool
+TraceCPU::ElasticDataGen::InputStream::readProto(GraphNode* element)
 {
     ProtoMessage::InstDepRecord pkt_msg;
-    if (trace.read(pkt_msg)) {
+    if (protoTrace->read(pkt_msg)) {
         // Required fields
         element->seqNum = pkt_msg.seq_num();
         element->type = pkt_msg.type();
@@ -40,12 +40,15 @@
 
 #include <cstdint>
 #include <list>
+#include <memory>
 #include <queue>
 #include <set>
 #include <unordered_map>
+#include <vector>
 
 #include "base/statistics.hh"
 #include "cpu/base.hh"
+#include "cpu/trace/elastic_trace_file.hh"
 #include "debug/TraceCPUData.hh"
 #include "debug/TraceCPUInst.hh"
 #include "params/TraceCPU.hh"
@@ -557,11 +560,15 @@ class TraceCPU : public BaseCPU
         class GraphNode
         {
           public:
-            /** Typedef for the list containing the ROB dependencies */
-            typedef std::list<NodeSeqNum> RobDepList;
+            /**
+             * Typedef for the list containing the ROB dependencies. A node
+             * has few dependencies, and vectors keep their storage when
+             * the node is recycled.
+             */
+            typedef std::vector<NodeSeqNum> RobDepList;
 
             /** Typedef for the list containing the register dependencies */
-            typedef std::list<NodeSeqNum> RegDepList;
+            typedef std::vector<NodeSeqNum> RegDepList;
 
             /** Instruction sequence number */
             NodeSeqNum seqNum;
@@ -756,13 +763,20 @@ class TraceCPU : public BaseCPU
         /**
          * The InputStream encapsulates a trace file and the
          * internal buffers and populates GraphNodes based on
-         * the input.
+         * the input. Both protobuf traces and columnar traces, as
+         * described in cpu/trace/elastic_trace_file.hh, are supported.
          */
         class InputStream
         {
           private:
-            /** Input file stream for the protobuf trace */
-            ProtoInputStream trace;
+            /** Input file stream for a protobuf trace */
+            std::unique_ptr<ProtoInputStream> protoTrace;
+
+            /** Reader of a columnar trace */
+            std::unique_ptr<ElasticTraceReader> columnarTrace;
+
+            /** Record read from a columnar trace */
+            ElasticTraceRecord record;
 
             /**
              * A multiplier for the compute delays in the trace to modulate
@@ -808,6 +822,12 @@ class TraceCPU : public BaseCPU
              */
             bool read(GraphNode* element);
 
+            /** Populate a node from a protobuf trace */
+            bool readProto(GraphNode* element);
+
+            /** Populate a node from a columnar trace */
+            bool readColumnar(GraphNode* element);
+
             /** Get window size from trace */
             uint32_t getWindowSize() const { return windowSize; }
 
@@ -836,8 +856,12 @@ class TraceCPU : public BaseCPU
         {
             DPRINTF(TraceCPUData, "Window size in the trace is %d.\n",
                     windowSize);
+            // The graph holds up to two windows of nodes
+            depGraph.reserve(2 * windowSize);
         }
 
+        ~ElasticDataGen();
+
         /**
          * Called from TraceCPU init(). Reads the first message from the
          * input trace file and returns the send tick.
@@ -993,6 +1017,19 @@ class TraceCPU : public BaseCPU
         /** Store the depGraph of GraphNodes */
         std::unordered_map<NodeSeqNum, GraphNode*> depGraph;
 
+        /**
+         * Nodes that have been removed from the graph and can be reused
+         * for new records, so that replaying a trace does not allocate a
+         * node per instruction.
+         */
+        std::vector<GraphNode *> freeNodes;
+
+        /** Get a node from the pool, allocating one if it is empty. */
+        GraphNode *allocNode();
+
+        /** Return a node that has left the graph to the pool. */
+        void freeNode(GraphNode *node);
+
         /**
          * Queue of dependency-free nodes that are pending issue because
          * resources are not available. This is chosen to be FIFO so that
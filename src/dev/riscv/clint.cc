@@ -185,7 +185,7 @@ Clint::write(PacketPtr pkt)
         pkt->getAddr(), pkt->getSize());
 
     // Perform register write
-    registers.write(pkt->getAddr(), pkt->getPtr<void>(), pkt->getSize());
+    registers.write(pkt->getAddr(), pkt->getConstPtr<void>(), pkt->getSize());
 
     pkt->makeResponse();
     return pioDelay;
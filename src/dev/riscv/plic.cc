@@ -148,7 +148,7 @@ Plic::write(PacketPtr pkt)
         pkt->getAddr(), pkt->getSize());
 
     // Perform register write
-    registers.write(pkt->getAddr(), pkt->getPtr<void>(), pkt->getSize());
+    registers.write(pkt->getAddr(), pkt->getConstPtr<void>(), pkt->getSize());
 
     // Propagate output changes
     propagateOutput();
@@ -234,7 +234,7 @@ Uart8250::write(PacketPtr pkt)
     DPRINTF(Uart, "Write register %#x value %#x\n", daddr,
             pkt->getRaw<uint8_t>());
 
-    registers.write(daddr, pkt->getPtr<void>(), pkt->getSize());
+    registers.write(daddr, pkt->getConstPtr<void>(), pkt->getSize());
 
     pkt->makeAtomicResponse();
     return pioDelay;
@@ -147,7 +147,7 @@ I8237::read(PacketPtr pkt)
 Tick
 I8237::write(PacketPtr pkt)
 {
-    regs.write(pkt->getAddr(), pkt->getPtr<void>(), pkt->getSize());
+    regs.write(pkt->getAddr(), pkt->getConstPtr<void>(), pkt->getSize());
     pkt->makeAtomicResponse();
     return latency;
 }
@@ -38,6 +38,7 @@
 # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+from m5.SimObject import *
 from m5.params import *
 from m5.proxy import *
 from m5.objects.QoSMemCtrl import *
@@ -55,6 +56,11 @@ class MemCtrl(QoSMemCtrl):
     cxx_header = "mem/mem_ctrl.hh"
     cxx_class = 'gem5::memory::MemCtrl'
 
+    cxx_exports = [
+        PyBindMethod("setFastMode"),
+        PyBindMethod("isFastMode"),
+    ]
+
     # single-ported on the system interface side, instantiate with a
     # bus in front of the controller for multiple ports
     port = ResponsePort("This port responds to memory requests")
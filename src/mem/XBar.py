@@ -83,6 +83,17 @@ class BaseXBar(ClockedObject):
     # Width governing the throughput of the crossbar
     width = Param.Unsigned("Datapath width per port (bytes)")
 
+    # Each request layer can be split into shards, interleaved on the
+    # packet address, that arbitrate and are occupied independently,
+    # modelling a banked interconnect in front of a banked
+    # destination. Many-core systems can use this to avoid all the
+    # cores contending for a single layer towards the shared cache.
+    request_layer_shards = Param.Unsigned(1, "Number of address-" \
+                                          "interleaved shards per request " \
+                                          "layer")
+    layer_shard_interleave = Param.MemorySize('64B', "Address interleaving " \
+                                              "granularity of the shards")
+
     # The default port can be left unconnected, or be used to connect
     # a default response port
     default = RequestPort("Port for connecting an optional default responder")
@@ -40,6 +40,7 @@
 
 #include "mem/abstract_mem.hh"
 
+#include <mutex>
 #include <vector>
 
 #include "arch/locked_mem.hh"
@@ -80,10 +81,16 @@ AbstractMemory::initState()
     if (file == "")
         return;
 
-    auto *object = loader::createObjectFile(file, true);
-    fatal_if(!object, "%s: Could not load %s.", name(), file);
+    // Memories may load their images concurrently
+    static std::mutex loaderMutex;
+    loader::ObjectFile *object;
+    {
+        std::lock_guard<std::mutex> lock(loaderMutex);
+        object = loader::createObjectFile(file, true);
+        fatal_if(!object, "%s: Could not load %s.", name(), file);
+        loader::debugSymbolTable.insert(*object->symtab().globals());
+    }
 
-    loader::debugSymbolTable.insert(*object->symtab().globals());
     loader::MemoryImage image = object->buildImage();
 
     AddrRange image_range(image.minAddr(), image.maxAddr());
@@ -218,6 +218,13 @@ class AbstractMemory : public ClockedObject
 
     void initState() override;
 
+    /**
+     * Loading the image only writes to this memory. The object file is
+     * opened and its symbols added to the debug symbol table under a
+     * lock.
+     */
+    bool independentInitState() const override { return true; }
+
     /**
      * See if this is a null memory that should never store data and
      * always return zero.
@@ -38,7 +38,7 @@
 
 from m5.params import *
 from m5.proxy import *
-from m5.SimObject import SimObject
+from m5.SimObject import SimObject, PyBindMethod
 
 from m5.objects.ClockedObject import ClockedObject
 from m5.objects.Compressors import BaseCacheCompressor
@@ -152,6 +152,31 @@ class BaseCache(ClockedObject):
     # data cache.
     write_allocator = Param.WriteAllocator(NULL, "Write allocator")
 
+    # When the caches are bypassed, i.e. in the 'atomic_noncaching'
+    # memory mode used when fast-forwarding with the
+    # NonCachingSimpleCPU, the accesses passing through the cache can
+    # be logged and applied to the tags and replacement state in
+    # batches, without moving any data. The blocks are refilled from
+    # memory when the caches are no longer bypassed, keeping the cache
+    # state warm across a fast-forward.
+    warm_when_bypassed = Param.Bool(False,
+        "Keep the tags and replacement state warm when bypassed")
+    warming_batch_size = Param.Unsigned(1024,
+        "Number of accesses logged before they are applied to the tags")
+
+    cxx_exports = [
+        PyBindMethod("demoteBlocks"),
+        PyBindMethod("resyncWarmedBlocks"),
+    ]
+
+    # Whole lines moving between the blocks of this cache and packets
+    # (fills, read responses and writebacks) can be passed as
+    # reference counted, copy-on-write line buffers rather than being
+    # copied, so that the levels of a hierarchy refer to the same copy
+    # of a line until one of them modifies it.
+    share_line_data = Param.Bool(False,
+        "Share whole-line data with packets instead of copying it")
+
 class Cache(BaseCache):
     type = 'Cache'
     cxx_header = 'mem/cache/cache.hh'
@@ -109,6 +109,10 @@ BaseCache::BaseCache(const BaseCacheParams &p, unsigned blk_size)
       noTargetMSHR(nullptr),
       missCount(p.max_miss_count),
       addrRanges(p.addr_ranges.begin(), p.addr_ranges.end()),
+      warmWhenBypassed(p.warm_when_bypassed),
+      warmingBatchSize(p.warming_batch_size),
+      warmingResyncPending(false),
+      shareLineData(p.share_line_data),
       system(p.system),
       stats(*this)
 {
@@ -123,7 +127,6 @@ BaseCache::BaseCache(const BaseCacheParams &p, unsigned blk_size)
 
     tempBlock = new TempCacheBlk(blkSize);
 
-    tags->tagsInit();
     if (prefetcher)
         prefetcher->setCache(this);
 
@@ -134,6 +137,11 @@ BaseCache::BaseCache(const BaseCacheParams &p, unsigned blk_size)
         "Compressed cache %s does not have a compression algorithm", name());
     if (compressor)
         compressor->setCache(this);
+
+    fatal_if(warmWhenBypassed && !warmingBatchSize,
+             "Cache %s needs a non-zero warming batch size", name());
+    if (warmWhenBypassed)
+        warmingLog.reserve(warmingBatchSize);
 }
 
 BaseCache::~BaseCache()
@@ -558,6 +566,12 @@ BaseCache::recvTimingResp(PacketPtr pkt)
 Tick
 BaseCache::recvAtomic(PacketPtr pkt)
 {
+    // if we were warmed while bypassed, a cache above may ask us for
+    // data while refilling its own blocks, before we are asked to
+    // refill ours
+    if (warmingResyncPending)
+        resyncWarmedBlocks();
+
     // should assert here that there are no outstanding MSHRs or
     // writebacks... that would mean that someone used an atomic
     // access in timing mode
@@ -652,6 +666,10 @@ BaseCache::functionalAccess(PacketPtr pkt, bool from_cpu_side)
     // needs to be found.  As a result we always update the request if
     // we have it, but only declare it satisfied if we are the owner.
 
+    // a functional write updates the block in place
+    if (blk && pkt->isWrite())
+        unshareBlockData(blk);
+
     // see if we have data at all (owned or otherwise)
     bool have_data = blk && blk->isValid()
         && pkt->trySatisfyFunctional(&cbpw, blk_addr, is_secure, blkSize,
@@ -704,8 +722,11 @@ BaseCache::updateBlockData(CacheBlk *blk, const PacketPtr cpkt,
     }
 
     // Actually perform the data update
-    if (cpkt) {
+    if (cpkt && !shareDataToBlock(blk, cpkt)) {
+        unshareBlockData(blk);
         cpkt->writeDataToBlock(blk->data, blkSize);
+        if (cpkt->getSize() == blkSize)
+            stats.lineCopies++;
     }
 
     if (ppDataUpdate->hasListeners()) {
@@ -717,6 +738,48 @@ BaseCache::updateBlockData(CacheBlk *blk, const PacketPtr cpkt,
     }
 }
 
+bool
+BaseCache::shareDataToBlock(CacheBlk *blk, const PacketPtr pkt)
+{
+    // the temporary block owns its storage, and partial or masked
+    // writes have to be merged with the existing data
+    if (!shareLineData || blk == tempBlock || pkt->getSize() != blkSize ||
+        pkt->isMaskedWrite()) {
+        return false;
+    }
+
+    LineBufferPtr buf = pkt->shareData();
+    if (!buf)
+        return false;
+
+    blk->shareData(buf);
+    stats.lineShares++;
+    return true;
+}
+
+bool
+BaseCache::shareDataToPacket(PacketPtr pkt, CacheBlk *blk)
+{
+    // static data belongs to the sender, who expects the line to be
+    // copied to its own storage
+    if (!shareLineData || blk == tempBlock || pkt->getSize() != blkSize ||
+        pkt->hasStaticData()) {
+        return false;
+    }
+
+    pkt->deleteData();
+    pkt->dataShared(blk->getSharedData(blkSize));
+    stats.lineShares++;
+    return true;
+}
+
+void
+BaseCache::unshareBlockData(CacheBlk *blk)
+{
+    if (blk->unshareData(blkSize))
+        stats.lineUnshares++;
+}
+
 void
 BaseCache::cmpAndSwap(CacheBlk *blk, PacketPtr pkt)
 {
@@ -727,6 +790,8 @@ BaseCache::cmpAndSwap(CacheBlk *blk, PacketPtr pkt)
     uint64_t condition_val64;
     uint32_t condition_val32;
 
+    unshareBlockData(blk);
+
     int offset = pkt->getOffset(blkSize);
     uint8_t *blk_data = blk->data + offset;
 
@@ -1037,6 +1102,7 @@ BaseCache::satisfyRequest(PacketPtr pkt, CacheBlk *blk, bool, bool)
 
             // extract data from cache and save it into the data field in
             // the packet as a return value from this atomic op
+            unshareBlockData(blk);
             int offset = tags->extractBlkOffset(pkt->getAddr());
             uint8_t *blk_data = blk->data + offset;
             pkt->setData(blk_data);
@@ -1079,7 +1145,11 @@ BaseCache::satisfyRequest(PacketPtr pkt, CacheBlk *blk, bool, bool)
 
         // all read responses have a data payload
         assert(pkt->hasRespData());
-        pkt->setDataFromBlock(blk->data, blkSize);
+        if (!shareDataToPacket(pkt, blk)) {
+            pkt->setDataFromBlock(blk->data, blkSize);
+            if (pkt->getSize() == blkSize)
+                stats.lineCopies++;
+        }
     } else if (pkt->isUpgrade()) {
         // sanity check
         assert(!pkt->hasSharers());
@@ -1650,8 +1720,11 @@ BaseCache::writebackBlk(CacheBlk *blk)
     // make sure the block is not marked dirty
     blk->clearCoherenceBits(CacheBlk::DirtyBit);
 
-    pkt->allocate();
-    pkt->setDataFromBlock(blk->data, blkSize);
+    if (!shareDataToPacket(pkt, blk)) {
+        pkt->allocate();
+        pkt->setDataFromBlock(blk->data, blkSize);
+        stats.lineCopies++;
+    }
 
     // When a block is compressed, it must first be decompressed before being
     // sent for writeback.
@@ -1695,8 +1768,11 @@ BaseCache::writecleanBlk(CacheBlk *blk, Request::Flags dest, PacketId id)
     // make sure the block is not marked dirty
     blk->clearCoherenceBits(CacheBlk::DirtyBit);
 
-    pkt->allocate();
-    pkt->setDataFromBlock(blk->data, blkSize);
+    if (!shareDataToPacket(pkt, blk)) {
+        pkt->allocate();
+        pkt->setDataFromBlock(blk->data, blkSize);
+        stats.lineCopies++;
+    }
 
     // When a block is compressed, it must first be decompressed before being
     // sent for writeback.
@@ -1720,6 +1796,27 @@ BaseCache::memInvalidate()
     tags->forEachBlk([this](CacheBlk &blk) { invalidateVisitor(blk); });
 }
 
+void
+BaseCache::demoteBlocks()
+{
+    if (!warmWhenBypassed) {
+        memInvalidate();
+        return;
+    }
+
+    // keep the tags and replacement state, but drop the coherence
+    // permissions, any dirty data should already have been written
+    // back
+    tags->forEachBlk([this](CacheBlk &blk) {
+        if (blk.isValid()) {
+            panic_if(blk.isSet(CacheBlk::DirtyBit), "%s demoting dirty "
+                     "block %s", name(), blk.print());
+            blk.clearCoherenceBits(CacheBlk::AllBits);
+            warmingResyncPending = true;
+        }
+    });
+}
+
 bool
 BaseCache::isDirty() const
 {
@@ -1769,6 +1866,170 @@ BaseCache::invalidateVisitor(CacheBlk &blk)
     }
 }
 
+DrainState
+BaseCache::drain()
+{
+    // make sure the tags reflect all the accesses seen so far, before
+    // leaving the bypassed mode
+    if (!warmingLog.empty())
+        applyWarmingLog();
+
+    return DrainState::Drained;
+}
+
+void
+BaseCache::drainResume()
+{
+    ClockedObject::drainResume();
+
+    if (!warmingResyncPending || system->bypassCaches())
+        return;
+
+    // The tag-only blocks can only be refilled with atomic accesses,
+    // which m5.switchCpus() does by passing through the atomic mode
+    // when leaving the bypassed mode.
+    fatal_if(!system->isAtomicMode(), "%s: blocks warmed while bypassed "
+             "have to be refilled in the atomic mode before entering the "
+             "timing mode, see m5.memResync()", name());
+
+    resyncWarmedBlocks();
+}
+
+void
+BaseCache::logWarmingAccess(PacketPtr pkt)
+{
+    if (!(pkt->isRead() || pkt->isWrite()) || pkt->req->isUncacheable())
+        return;
+
+    warmingLog.push_back({pkt->getBlockAddr(blkSize),
+                          pkt->req->requestorId(), pkt->isSecure()});
+
+    if (warmingLog.size() == warmingBatchSize)
+        applyWarmingLog();
+}
+
+void
+BaseCache::applyWarmingLog()
+{
+    DPRINTF(Cache, "%s: applying %d warming accesses\n", __func__,
+            warmingLog.size());
+
+    for (const auto &rec : warmingLog) {
+        const RequestPtr &req = warmingRequest(rec.addr, rec.requestorId,
+                                               rec.isSecure);
+
+        // the command only matters to replacement policies that look
+        // at the access type, and the packet never leaves the cache
+        Packet pkt(req, MemCmd::ReadReq);
+
+        Cycles lat(0);
+        CacheBlk *blk = tags->accessBlock(&pkt, lat);
+        stats.warmingAccesses++;
+        if (blk)
+            continue;
+
+        // mostly exclusive caches only allocate on fills from
+        // non-caching sources, which we cannot tell apart here
+        if (clusivity == enums::mostly_excl)
+            continue;
+
+        warmingEvictBlks.clear();
+        CacheBlk *victim = tags->findVictim(rec.addr, rec.isSecure,
+                                           blkSize * 8, warmingEvictBlks);
+        if (!victim)
+            continue;
+
+        for (auto evict_blk : warmingEvictBlks) {
+            if (evict_blk->isValid()) {
+                panic_if(evict_blk->isSet(CacheBlk::DirtyBit), "%s evicting "
+                         "dirty block %s when warming", name(),
+                         evict_blk->print());
+                stats.replacements++;
+                invalidateBlock(evict_blk);
+            }
+        }
+
+        tags->insertBlock(&pkt, victim);
+        if (compressor) {
+            compressor->setSizeBits(victim, blkSize * 8);
+            compressor->setDecompressionLatency(victim, Cycles(0));
+        }
+        stats.warmingMisses++;
+        warmingResyncPending = true;
+    }
+
+    warmingLog.clear();
+}
+
+const RequestPtr &
+BaseCache::warmingRequest(Addr addr, RequestorID id, bool is_secure)
+{
+    if (warmingReqs.empty())
+        warmingReqs.resize(2 * system->maxRequestors());
+
+    assert(id < system->maxRequestors());
+    RequestPtr &req = warmingReqs[2 * id + is_secure];
+    if (!req) {
+        req = std::make_shared<Request>(addr, blkSize,
+            is_secure ? Request::SECURE : 0, id);
+    }
+    req->setPaddr(addr);
+    return req;
+}
+
+void
+BaseCache::resyncWarmedBlocks()
+{
+    if (!warmingResyncPending)
+        return;
+
+    panic_if(!system->isAtomicMode() || system->bypassCaches(),
+             "%s: warmed blocks can only be refilled in the atomic mode",
+             name());
+
+    // clear the flag first, so that any request reaching us while we
+    // refill does not start another pass
+    warmingResyncPending = false;
+
+    DPRINTF(Cache, "%s: resynchronising warmed blocks\n", __func__);
+
+    // blocks are filled clean, and the cache below decides if they are
+    // shared, as for any other read miss
+    const bool force_clean_rsp = isReadOnly ||
+        clusivity == enums::mostly_excl;
+    const MemCmd cmd = force_clean_rsp ? MemCmd::ReadCleanReq :
+                                         MemCmd::ReadSharedReq;
+
+    tags->forEachBlk([this, cmd](CacheBlk &blk) {
+        if (!blk.isValid() || blk.isSet(CacheBlk::ReadableBit))
+            return;
+
+        const RequestPtr &req = warmingRequest(regenerateBlkAddr(&blk),
+            blk.getSrcRequestorId(), blk.isSecure());
+        req->taskId(blk.getTaskId());
+
+        // the response is written straight into the block
+        unshareBlockData(&blk);
+
+        Packet pkt(req, cmd, blkSize);
+        pkt.dataStatic(blk.data);
+        memSidePort.sendAtomic(&pkt);
+        assert(pkt.isResponse());
+
+        // same state transitions as a regular fill
+        blk.setCoherenceBits(CacheBlk::ReadableBit);
+        if (!pkt.hasSharers()) {
+            blk.setCoherenceBits(CacheBlk::WritableBit);
+            if (pkt.cacheResponding())
+                blk.setCoherenceBits(CacheBlk::DirtyBit);
+        }
+        blk.setWhenReady(clockEdge());
+
+        DPRINTF(CacheVerbose, "%s: resynchronised %s\n", __func__,
+                blk.print());
+    });
+}
+
 Tick
 BaseCache::nextQueueReadyTime() const
 {
@@ -2179,6 +2440,16 @@ BaseCache::CacheStats::CacheStats(BaseCache &c)
              "number of replacements"),
     ADD_STAT(dataExpansions, statistics::units::Count::get(),
              "number of data expansions"),
+    ADD_STAT(warmingAccesses, statistics::units::Count::get(),
+             "number of accesses applied to the tags when warming"),
+    ADD_STAT(warmingMisses, statistics::units::Count::get(),
+             "number of warming accesses that allocated a block"),
+    ADD_STAT(lineCopies, statistics::units::Count::get(),
+             "number of whole lines copied between blocks and packets"),
+    ADD_STAT(lineShares, statistics::units::Count::get(),
+             "number of whole lines shared between blocks and packets"),
+    ADD_STAT(lineUnshares, statistics::units::Count::get(),
+             "number of shared lines copied before being modified"),
     ADD_STAT(dataContractions, statistics::units::Count::get(),
              "number of data contractions"),
     cmd(MemCmd::NUM_MEM_CMDS)
@@ -2398,6 +2669,11 @@ BaseCache::CacheStats::regStats()
     }
 
     dataExpansions.flags(nozero | nonan);
+    warmingAccesses.flags(nozero | nonan);
+    warmingMisses.flags(nozero | nonan);
+    lineCopies.flags(nozero | nonan);
+    lineShares.flags(nozero | nonan);
+    lineUnshares.flags(nozero | nonan);
     dataContractions.flags(nozero | nonan);
 }
 
@@ -2467,13 +2743,29 @@ Tick
 BaseCache::CpuSidePort::recvAtomic(PacketPtr pkt)
 {
     if (cache->system->bypassCaches()) {
-        // Forward the request if the system is in cache bypass mode.
+        // Forward the request if the system is in cache bypass mode,
+        // noting the access if we keep the tags warm
+        if (cache->warmWhenBypassed)
+            cache->logWarmingAccess(pkt);
         return cache->memSidePort.sendAtomic(pkt);
     } else {
         return cache->recvAtomic(pkt);
     }
 }
 
+Tick
+BaseCache::CpuSidePort::recvAtomicBackdoor(PacketPtr pkt,
+                                           MemBackdoorPtr &backdoor)
+{
+    // Pass on any backdoor offered by the memory below when bypassed,
+    // as the cache holds no data. When warming we need to see every
+    // access, so no backdoor is handed out.
+    if (cache->system->bypassCaches() && !cache->warmWhenBypassed)
+        return cache->memSidePort.sendAtomicBackdoor(pkt, backdoor);
+    else
+        return recvAtomic(pkt);
+}
+
 void
 BaseCache::CpuSidePort::recvFunctional(PacketPtr pkt)
 {
@@ -324,6 +324,9 @@ class BaseCache : public ClockedObject
 
         virtual Tick recvAtomic(PacketPtr pkt) override;
 
+        virtual Tick recvAtomicBackdoor(PacketPtr pkt,
+                                        MemBackdoorPtr &backdoor) override;
+
         virtual void recvFunctional(PacketPtr pkt) override;
 
         virtual AddrRangeList getAddrRanges() const override;
@@ -623,6 +626,34 @@ class BaseCache : public ClockedObject
     void updateBlockData(CacheBlk *blk, const PacketPtr cpkt,
         bool has_old_data);
 
+    /**
+     * Try to make a block refer to the line buffer of a packet carrying
+     * a whole line, rather than copying the line into the block.
+     *
+     * @param blk The block being written.
+     * @param pkt The packet holding the new data.
+     * @return True if the data was shared, false if it must be copied.
+     */
+    bool shareDataToBlock(CacheBlk *blk, const PacketPtr pkt);
+
+    /**
+     * Try to make a packet asking for a whole line refer to the line
+     * buffer of a block, rather than copying the line into the packet.
+     *
+     * @param pkt The packet to provide with data.
+     * @param blk The block holding the data.
+     * @return True if the data was shared, false if it must be copied.
+     */
+    bool shareDataToPacket(PacketPtr pkt, CacheBlk *blk);
+
+    /**
+     * Make sure the data of a block is not shared with anyone else
+     * before it is modified in place.
+     *
+     * @param blk The block about to be modified.
+     */
+    void unshareBlockData(CacheBlk *blk);
+
     /**
      * Handle doing the Compare and Swap function for SPARC.
      */
@@ -862,6 +893,49 @@ class BaseCache : public ClockedObject
      */
     virtual void memInvalidate() override;
 
+    DrainState drain() override;
+    void drainResume() override;
+
+    /**
+     * An access seen while the caches are bypassed, to be applied to
+     * the tags when warming. Only the information needed to look up
+     * and insert a block is kept.
+     */
+    struct WarmingRecord
+    {
+        Addr addr;
+        RequestorID requestorId;
+        bool isSecure;
+    };
+
+    /**
+     * Log an access forwarded while the caches are bypassed, applying
+     * the log to the tags when it is full.
+     *
+     * @param pkt The request forwarded to the memory below
+     */
+    void logWarmingAccess(PacketPtr pkt);
+
+    /**
+     * Apply the logged accesses to the tags and replacement state
+     * without moving any data. Blocks allocated this way are valid
+     * but without any coherence permissions (tag-only), and evicting
+     * them is silent as they are never dirty.
+     */
+    void applyWarmingLog();
+
+    /**
+     * Get the request used to look up or refill a block when warming,
+     * reusing one request per requestor and security state.
+     *
+     * @param addr The block address
+     * @param id The requestor the block is accessed on behalf of
+     * @param is_secure Whether the block is in the secure space
+     * @return The request, with its address set to addr
+     */
+    const RequestPtr &warmingRequest(Addr addr, RequestorID id,
+                                     bool is_secure);
+
     /**
      * Determine if there are any dirty blocks in the cache.
      *
@@ -981,6 +1055,39 @@ class BaseCache : public ClockedObject
      * Normally this is all possible memory addresses. */
     const AddrRangeList addrRanges;
 
+    /**
+     * Keep the tags and replacement state warm when the caches are
+     * bypassed, i.e. when the system is in the 'atomic_noncaching'
+     * mode.
+     */
+    const bool warmWhenBypassed;
+
+    /**
+     * Accesses logged while warming, applied in batches of at most
+     * warmingBatchSize. The log is allocated once, and reused.
+     */
+    std::vector<WarmingRecord> warmingLog;
+    const unsigned warmingBatchSize;
+
+    /**
+     * Requests used to look up, insert and refill blocks when
+     * warming, one per requestor and security state, created on
+     * first use.
+     */
+    std::vector<RequestPtr> warmingReqs;
+
+    /** Blocks to be evicted when warming, reused across insertions. */
+    std::vector<CacheBlk*> warmingEvictBlks;
+
+    /** Are there tag-only blocks left by warming? */
+    bool warmingResyncPending;
+
+    /**
+     * Share whole-line data between blocks and packets using
+     * copy-on-write line buffers instead of copying it.
+     */
+    const bool shareLineData;
+
   public:
     /** System we are currently operating in. */
     System *system;
@@ -1127,6 +1234,18 @@ class BaseCache : public ClockedObject
         /** Number of data expansions. */
         statistics::Scalar dataExpansions;
 
+        /** Number of accesses applied to the tags when warming. */
+        statistics::Scalar warmingAccesses;
+        /** Number of warming accesses that allocated a tag-only block. */
+        statistics::Scalar warmingMisses;
+
+        /** Number of whole lines copied between blocks and packets. */
+        statistics::Scalar lineCopies;
+        /** Number of whole lines shared between blocks and packets. */
+        statistics::Scalar lineShares;
+        /** Number of shared lines copied before a block was modified. */
+        statistics::Scalar lineUnshares;
+
         /**
          * Number of data contractions (blocks that had their compression
          * factor improved).
@@ -1161,6 +1280,26 @@ class BaseCache : public ClockedObject
 
     const AddrRangeList &getAddrRanges() const { return addrRanges; }
 
+    /**
+     * Bring the data of all tag-only blocks back from the memory
+     * below using regular atomic reads, so that the snoop filters
+     * and the caches below see the blocks as if they had been filled
+     * on a miss. This has to be done in the 'atomic' memory mode,
+     * i.e. after leaving the bypassed mode and before entering the
+     * timing mode, see m5.memResync().
+     */
+    void resyncWarmedBlocks();
+
+    /**
+     * Prepare the cache to be bypassed. If the cache is warmed when
+     * bypassed, the blocks are demoted to tag-only blocks, keeping the
+     * tags and replacement state, and their data is brought back by
+     * resyncWarmedBlocks(). Otherwise, the blocks are invalidated as by
+     * memInvalidate(). Dirty blocks have to be written back first, see
+     * m5.memBypass().
+     */
+    void demoteBlocks();
+
     MSHR *allocateMissBuffer(PacketPtr pkt, Tick time, bool sched_send = true)
     {
         MSHR *mshr = mshrQueue.allocate(pkt->getBlockAddr(blkSize), blkSize,
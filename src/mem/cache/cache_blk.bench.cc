@@ -0,0 +1,151 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "base/gtest/cur_tick_fake.hh"
+#include "mem/cache/cache_blk.hh"
+#include "mem/line_buffer.hh"
+#include "mem/packet.hh"
+#include "mem/request.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+GTestTickHandler tickHandler;
+
+const unsigned blkSize = 64;
+
+/**
+ * The blocks holding a line at every level of a hierarchy, from the
+ * last level to the first one.
+ */
+class Hierarchy
+{
+  public:
+    std::vector<std::unique_ptr<uint8_t[]>> storage;
+    std::vector<std::unique_ptr<CacheBlk>> blks;
+
+    Hierarchy(int levels)
+    {
+        for (int i = 0; i < levels; i++) {
+            storage.emplace_back(new uint8_t[blkSize]());
+            blks.emplace_back(new CacheBlk);
+            blks.back()->data = storage.back().get();
+            blks.back()->insert(0x40, false);
+        }
+    }
+};
+
+PacketPtr
+makeResp(const RequestPtr &req)
+{
+    PacketPtr pkt = new Packet(req, MemCmd::ReadResp, blkSize);
+    return pkt;
+}
+
+/**
+ * Fill a line from memory into every level of a hierarchy by copying
+ * it between the packets and the blocks, as the caches do when lines
+ * are not shared.
+ */
+void
+BM_FillCopy(benchmark::State &state)
+{
+    const int levels = state.range(0);
+    Hierarchy hier(levels);
+    RequestPtr req = std::make_shared<Request>(0x40, blkSize, 0, 0);
+
+    for (auto _ : state) {
+        PacketPtr pkt = makeResp(req);
+        pkt->allocate();
+        for (auto &blk : hier.blks) {
+            pkt->writeDataToBlock(blk->data, blkSize);
+            delete pkt;
+            pkt = makeResp(req);
+            pkt->allocate();
+            pkt->setDataFromBlock(blk->data, blkSize);
+        }
+        benchmark::DoNotOptimize(pkt->getConstPtr<uint8_t>());
+        delete pkt;
+    }
+    state.SetBytesProcessed(state.iterations() * levels * 2 * blkSize);
+}
+BENCHMARK(BM_FillCopy)->DenseRange(1, 4);
+
+/**
+ * Fill a line from memory into every level of a hierarchy by sharing a
+ * single buffer between the packets and the blocks.
+ */
+void
+BM_FillShare(benchmark::State &state)
+{
+    const int levels = state.range(0);
+    Hierarchy hier(levels);
+    RequestPtr req = std::make_shared<Request>(0x40, blkSize, 0, 0);
+
+    for (auto _ : state) {
+        PacketPtr pkt = makeResp(req);
+        pkt->allocate();
+        for (auto &blk : hier.blks) {
+            blk->shareData(pkt->shareData());
+            delete pkt;
+            pkt = makeResp(req);
+            pkt->dataShared(blk->getSharedData(blkSize));
+        }
+        benchmark::DoNotOptimize(pkt->getConstPtr<uint8_t>());
+        delete pkt;
+    }
+    state.SetBytesProcessed(state.iterations() * levels * 2 * blkSize);
+}
+BENCHMARK(BM_FillShare)->DenseRange(1, 4);
+
+/**
+ * Write to a line that is shared by every level of a hierarchy, which
+ * takes a private copy of it.
+ */
+void
+BM_WriteShared(benchmark::State &state)
+{
+    Hierarchy hier(1);
+    RequestPtr req = std::make_shared<Request>(0x40, blkSize, 0, 0);
+    for (auto _ : state) {
+        PacketPtr pkt = makeResp(req);
+        pkt->dataShared(hier.blks[0]->getSharedData(blkSize));
+        benchmark::DoNotOptimize(pkt->getPtr<uint8_t>());
+        delete pkt;
+    }
+}
+BENCHMARK(BM_WriteShared);
+
+} // anonymous namespace
+
+BENCHMARK_MAIN();
@@ -48,6 +48,7 @@
 
 #include <cassert>
 #include <cstdint>
+#include <cstring>
 #include <iosfwd>
 #include <list>
 #include <string>
@@ -55,6 +56,7 @@
 #include "base/printable.hh"
 #include "base/types.hh"
 #include "mem/cache/tags/tagged_entry.hh"
+#include "mem/line_buffer.hh"
 #include "mem/packet.hh"
 #include "mem/request.hh"
 #include "sim/cur_tick.hh"
@@ -109,6 +111,16 @@ class CacheBlk : public TaggedEntry
     Tick whenReady;
 
   protected:
+    /**
+     * Line buffer holding the block's data when it is shared with
+     * packets or blocks in other caches, in which case the data pointer
+     * refers to the buffer rather than the block's own storage.
+     */
+    LineBufferPtr sharedData;
+
+    /** The block's own storage while the data pointer is shared. */
+    uint8_t *ownData;
+
     /**
      * Represents that the indicated thread context has a "lock" on
      * the block, in the LL/SC sense.
@@ -152,7 +164,8 @@ class CacheBlk : public TaggedEntry
     std::list<Lock> lockList;
 
   public:
-    CacheBlk() : TaggedEntry(), data(nullptr), _tickInserted(0)
+    CacheBlk()
+      : TaggedEntry(), data(nullptr), ownData(nullptr), _tickInserted(0)
     {
         invalidate();
     }
@@ -209,6 +222,66 @@ class CacheBlk : public TaggedEntry
         setRefCount(0);
         setSrcRequestorId(Request::invldRequestorId);
         lockList.clear();
+
+        releaseData();
+    }
+
+    /**
+     * Make the block refer to a shared line buffer instead of holding
+     * its own copy of the data.
+     *
+     * @param buf The buffer holding the new contents of the block.
+     */
+    void
+    shareData(const LineBufferPtr &buf)
+    {
+        assert(buf);
+        if (!sharedData)
+            ownData = data;
+        sharedData = buf;
+        data = buf->data();
+    }
+
+    /**
+     * Get a line buffer holding the data of this block, so that it can
+     * be referenced by packets without being copied. The storage of a
+     * block belongs to the tags, and cannot be handed over to a buffer,
+     * so if the data is not shared yet it is copied to a new buffer,
+     * which the block then refers to. The line is therefore copied once
+     * when it is first shared, and not again until it is modified.
+     *
+     * @param size The size of the block, in bytes.
+     * @return The line buffer holding the block's data.
+     */
+    const LineBufferPtr &
+    getSharedData(unsigned size)
+    {
+        if (!sharedData)
+            shareData(new LineBuffer(data, size));
+        return sharedData;
+    }
+
+    /** @return True if the block data is held in a shared buffer. */
+    bool hasSharedData() const { return (bool)sharedData; }
+
+    /**
+     * Make sure the block's data can be modified without affecting
+     * other holders of its line buffer. A buffer that is no longer
+     * referenced elsewhere is kept, otherwise its contents are copied
+     * back into the block's own storage.
+     *
+     * @param size The size of the block, in bytes.
+     * @return True if the data had to be copied.
+     */
+    bool
+    unshareData(unsigned size)
+    {
+        if (!sharedData || !sharedData->isShared())
+            return false;
+
+        std::memcpy(ownData, data, size);
+        releaseData();
+        return true;
     }
 
     /**
@@ -452,6 +525,19 @@ class CacheBlk : public TaggedEntry
     }
 
   protected:
+    /**
+     * Stop referring to a shared line buffer, if any, and point the
+     * data back to the block's own storage without copying it.
+     */
+    void
+    releaseData()
+    {
+        if (sharedData) {
+            data = ownData;
+            sharedData = nullptr;
+        }
+    }
+
     /** The current coherence status of this block. @sa CoherenceBits */
     unsigned coherence;
 
@@ -0,0 +1,129 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+
+#include "base/gtest/cur_tick_fake.hh"
+#include "mem/cache/cache_blk.hh"
+#include "mem/line_buffer.hh"
+
+using namespace gem5;
+
+// Instantiate the fake class to have a valid curTick of 0
+GTestTickHandler tickHandler;
+
+namespace
+{
+
+const unsigned blkSize = 64;
+
+/** A block with its own storage, filled with a pattern. */
+class CacheBlkSharedDataTest : public testing::Test
+{
+  protected:
+    uint8_t storage[blkSize];
+    CacheBlk blk;
+
+    void
+    SetUp() override
+    {
+        for (unsigned i = 0; i < blkSize; i++)
+            storage[i] = i;
+        blk.data = storage;
+        blk.insert(0x40, false);
+    }
+};
+
+} // anonymous namespace
+
+/** A block can refer to a line buffer instead of its storage. */
+TEST_F(CacheBlkSharedDataTest, ShareData)
+{
+    LineBufferPtr buf = new LineBuffer(blkSize);
+    std::memset(buf->data(), 0xaa, blkSize);
+
+    blk.shareData(buf);
+    EXPECT_TRUE(blk.hasSharedData());
+    EXPECT_EQ(blk.data, buf->data());
+    EXPECT_TRUE(buf->isShared());
+
+    // The storage of the block is left untouched
+    EXPECT_EQ(storage[1], 1);
+}
+
+/**
+ * Getting a buffer for the block copies its data once, after which the
+ * same buffer is handed out.
+ */
+TEST_F(CacheBlkSharedDataTest, GetSharedData)
+{
+    LineBufferPtr buf = blk.getSharedData(blkSize);
+    EXPECT_NE(buf->data(), storage);
+    EXPECT_EQ(std::memcmp(buf->data(), storage, blkSize), 0);
+    EXPECT_EQ(blk.data, buf->data());
+
+    EXPECT_EQ(blk.getSharedData(blkSize), buf);
+}
+
+/** Modifying a line also held elsewhere copies it back to the storage. */
+TEST_F(CacheBlkSharedDataTest, UnshareCopiesBack)
+{
+    LineBufferPtr buf = new LineBuffer(blkSize);
+    std::memset(buf->data(), 0xaa, blkSize);
+    blk.shareData(buf);
+
+    EXPECT_TRUE(blk.unshareData(blkSize));
+    EXPECT_FALSE(blk.hasSharedData());
+    EXPECT_EQ(blk.data, storage);
+    EXPECT_EQ(storage[1], 0xaa);
+    EXPECT_FALSE(buf->isShared());
+}
+
+/** A line only held by the block is modified in place. */
+TEST_F(CacheBlkSharedDataTest, UnshareSoleHolder)
+{
+    const uint8_t *data = blk.getSharedData(blkSize)->data();
+
+    EXPECT_FALSE(blk.unshareData(blkSize));
+    EXPECT_TRUE(blk.hasSharedData());
+    EXPECT_EQ(blk.data, data);
+}
+
+/** Invalidation drops the buffer without copying it. */
+TEST_F(CacheBlkSharedDataTest, InvalidateReleasesData)
+{
+    LineBufferPtr buf = new LineBuffer(blkSize);
+    std::memset(buf->data(), 0xaa, blkSize);
+    blk.shareData(buf);
+
+    blk.invalidate();
+    EXPECT_FALSE(blk.hasSharedData());
+    EXPECT_EQ(blk.data, storage);
+    EXPECT_EQ(storage[1], 1);
+    EXPECT_FALSE(buf->isShared());
+}
@@ -53,6 +53,14 @@ class BaseCacheCompressor(SimObject):
     decomp_extra_latency = Param.Cycles(1, "Number of extra cycles required "
         "to finish decompression (e.g., due to shifting and packaging).")
 
+    # Identical lines (e.g., zero or otherwise frequently written lines)
+    # compress the same way every time, so the results can be looked up
+    # by contents instead of compressing the line again. Only the
+    # per-pattern statistics of the dictionary compressors are affected,
+    # as they are only updated when a line is actually compressed.
+    memo_entries = Param.Unsigned(0, "Number of entries of the table "
+        "memoizing compression results by line contents (0 to disable)")
+
 class BaseDictionaryCompressor(BaseCacheCompressor):
     type = 'BaseDictionaryCompressor'
     abstract = True
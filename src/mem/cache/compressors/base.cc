@@ -36,6 +36,7 @@
 #include <climits>
 #include <cmath>
 #include <cstdint>
+#include <cstring>
 #include <string>
 
 #include "base/logging.hh"
@@ -89,7 +90,7 @@ Base::Base(const Params &p)
     compExtraLatency(p.comp_extra_latency),
     decompChunksPerCycle(p.decomp_chunks_per_cycle),
     decompExtraLatency(p.decomp_extra_latency),
-    cache(nullptr), stats(*this)
+    cache(nullptr), memo(p.memo_entries, blkSize), stats(*this)
 {
     fatal_if(64 % chunkSizeBits,
         "64 must be a multiple of the chunk granularity.");
@@ -150,23 +151,49 @@ Base::fromChunks(const std::vector<Chunk>& chunks, uint64_t* data) const
 std::unique_ptr<Base::CompressionData>
 Base::compress(const uint64_t* data, Cycles& comp_lat, Cycles& decomp_lat)
 {
-    // Apply compression
-    std::unique_ptr<CompressionData> comp_data =
-        compress(toChunks(data), comp_lat, decomp_lat);
-
-    // If we are in debug mode apply decompression just after the compression.
-    // If the results do not match, we've got an error
-    #ifdef DEBUG_COMPRESSION
-    uint64_t decomp_data[blkSize/8];
-
-    // Apply decompression
-    decompress(comp_data.get(), decomp_data);
-
-    // Check if decompressed line matches original cache line
-    fatal_if(std::memcmp(data, decomp_data, blkSize),
-             "Decompressed line does not match original line.");
+    // Identical lines always compress the same way, so look for the
+    // results of a previous compression of this line. The decompression
+    // checks below need the full compression data, so do not memoize
+    // when debugging the compressors
+    bool memoize = false;
+    #ifndef DEBUG_COMPRESSION
+    memoize = memo.enabled() && isMemoizable();
     #endif
 
+    std::unique_ptr<CompressionData> comp_data;
+    const MemoTable::Result* memoized =
+        memoize ? memo.lookup(data) : nullptr;
+    if (memoized) {
+        // Only the size of the memoized compression is known
+        comp_data.reset(new CompressionData());
+        comp_data->setSizeBits(memoized->sizeBits);
+        comp_lat = memoized->compLat;
+        decomp_lat = memoized->decompLat;
+        stats.memoHits++;
+    } else {
+        // Apply compression
+        comp_data = compress(toChunks(data), comp_lat, decomp_lat);
+        stats.memoMisses++;
+
+        if (memoize) {
+            memo.insert(data, {comp_data->getSizeBits(), comp_lat,
+                               decomp_lat});
+        }
+
+        // If we are in debug mode apply decompression just after the
+        // compression. If the results do not match, we've got an error
+        #ifdef DEBUG_COMPRESSION
+        uint64_t decomp_data[blkSize/8];
+
+        // Apply decompression
+        decompress(comp_data.get(), decomp_data);
+
+        // Check if decompressed line matches original cache line
+        fatal_if(std::memcmp(data, decomp_data, blkSize),
+                 "Decompressed line does not match original line.");
+        #endif
+    }
+
     // Get compression size. If compressed size is greater than the size
     // threshold, the compression is seen as unsuccessful
     std::size_t comp_size_bits = comp_data->getSizeBits();
@@ -246,7 +273,11 @@ Base::BaseStats::BaseStats(Base& _compressor)
                 statistics::units::Bit, statistics::units::Count>::get(),
              "Average compression size"),
     ADD_STAT(decompressions, statistics::units::Count::get(),
-             "Total number of decompressions")
+             "Total number of decompressions"),
+    ADD_STAT(memoHits, statistics::units::Count::get(),
+             "Number of compressions whose results were memoized"),
+    ADD_STAT(memoMisses, statistics::units::Count::get(),
+             "Number of compressions that were not memoized")
 {
 }
 
@@ -270,6 +301,9 @@ Base::BaseStats::regStats()
     avgCompressionSizeBits.flags(statistics::total | statistics::nozero |
         statistics::nonan);
     avgCompressionSizeBits = compressionSizeBits / compressions;
+
+    memoHits.flags(statistics::nozero);
+    memoMisses.flags(statistics::nozero);
 }
 
 } // namespace compression
@@ -41,6 +41,7 @@
 #include "base/compiler.hh"
 #include "base/statistics.hh"
 #include "base/types.hh"
+#include "mem/cache/compressors/memo.hh"
 #include "sim/sim_object.hh"
 
 namespace gem5
@@ -129,6 +130,9 @@ class Base : public SimObject
     /** Pointer to the parent cache. */
     BaseCache* cache;
 
+    /** Results of previous compressions, by line contents. */
+    MemoTable memo;
+
     struct BaseStats : public statistics::Group
     {
         const Base& compressor;
@@ -154,8 +158,23 @@ class Base : public SimObject
 
         /** Number of decompressions performed. */
         statistics::Scalar decompressions;
+
+        /** Number of compressions whose results were memoized. */
+        statistics::Scalar memoHits;
+
+        /** Number of compressions that had to be performed. */
+        statistics::Scalar memoMisses;
     } stats;
 
+    /**
+     * Whether the results of a compression only depend on the contents of
+     * the line, so that they can be memoized. Compressors that adapt to
+     * the data they have seen must not be memoized.
+     *
+     * @return True if the compression results can be memoized.
+     */
+    virtual bool isMemoizable() const { return true; }
+
     /**
      * This function splits the raw data into chunks, so that it can be
      * parsed by the compressor.
@@ -177,6 +177,9 @@ class FrequentValues : public Base
 
     void decompress(const CompressionData* comp_data, uint64_t* data) override;
 
+    /** The encoding depends on the values sampled so far. */
+    bool isMemoizable() const override { return false; }
+
   public:
     typedef FrequentValuesCompressorParams Params;
     FrequentValues(const Params &p);
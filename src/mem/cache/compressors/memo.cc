@@ -0,0 +1,91 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @file
+ * Implementation of a table memoizing the results of compressions by
+ * line contents.
+ */
+
+#include "mem/cache/compressors/memo.hh"
+
+#include <cstring>
+
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+GEM5_DEPRECATED_NAMESPACE(Compressor, compression);
+namespace compression
+{
+
+MemoTable::MemoTable(std::size_t num_entries, std::size_t blk_size)
+  : blkSize(blk_size), entries(num_entries),
+    lines(num_entries * (blk_size / sizeof(uint64_t)))
+{
+    fatal_if(blkSize % sizeof(uint64_t),
+        "Memoized lines must be a multiple of 64 bits long.");
+}
+
+std::size_t
+MemoTable::index(const uint64_t* data) const
+{
+    uint64_t hash = 0;
+    for (std::size_t i = 0; i < blkSize / sizeof(uint64_t); i++) {
+        hash ^= (data[i] + i) * 0x9e3779b97f4a7c15ULL;
+    }
+    return (hash ^ (hash >> 32)) % entries.size();
+}
+
+const MemoTable::Result*
+MemoTable::lookup(const uint64_t* data) const
+{
+    if (!enabled()) {
+        return nullptr;
+    }
+
+    const std::size_t i = index(data);
+    const uint64_t* line = &lines[i * (blkSize / sizeof(uint64_t))];
+    if (entries[i].valid && std::memcmp(line, data, blkSize) == 0) {
+        return &entries[i].result;
+    }
+    return nullptr;
+}
+
+void
+MemoTable::insert(const uint64_t* data, const Result& result)
+{
+    if (!enabled()) {
+        return;
+    }
+
+    const std::size_t i = index(data);
+    entries[i].valid = true;
+    entries[i].result = result;
+    std::memcpy(&lines[i * (blkSize / sizeof(uint64_t))], data, blkSize);
+}
+
+} // namespace compression
+} // namespace gem5
@@ -0,0 +1,123 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @file
+ * Definition of a table memoizing the results of compressions by line
+ * contents.
+ */
+
+#ifndef __MEM_CACHE_COMPRESSORS_MEMO_HH__
+#define __MEM_CACHE_COMPRESSORS_MEMO_HH__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "base/compiler.hh"
+#include "base/types.hh"
+
+namespace gem5
+{
+
+GEM5_DEPRECATED_NAMESPACE(Compressor, compression);
+namespace compression
+{
+
+/**
+ * Direct-mapped table of previous compression results, indexed by a hash
+ * of the line contents. A copy of the line of each entry is kept, so
+ * that a lookup only hits for identical contents; a line whose contents
+ * changed since it was compressed looks up the entry of its new
+ * contents instead.
+ */
+class MemoTable
+{
+  public:
+    /** The results of the compression of a line. */
+    struct Result
+    {
+        /** Size of the compressed line, in number of bits. */
+        std::size_t sizeBits = 0;
+        Cycles compLat;
+        Cycles decompLat;
+    };
+
+    /**
+     * @param num_entries Number of entries of the table, zero to disable
+     *        memoization.
+     * @param blk_size Size of a line, in bytes.
+     */
+    MemoTable(std::size_t num_entries, std::size_t blk_size);
+
+    /** @return Whether the table can hold any results. */
+    bool enabled() const { return !entries.empty(); }
+
+    /**
+     * Look for the results of a previous compression of a line.
+     *
+     * @param data The contents of the line.
+     * @return The results, or nullptr if they are not in the table.
+     */
+    const Result* lookup(const uint64_t* data) const;
+
+    /**
+     * Record the results of the compression of a line, replacing the
+     * results of the line that maps to the same entry, if any.
+     *
+     * @param data The contents of the line.
+     * @param result The results of its compression.
+     */
+    void insert(const uint64_t* data, const Result& result);
+
+  private:
+    struct Entry
+    {
+        bool valid = false;
+        Result result;
+    };
+
+    /**
+     * Get the index of the entry of a line. The words are mixed
+     * independently of each other, so that the hash can be vectorized by
+     * the compiler.
+     *
+     * @param data The contents of the line.
+     * @return The index of its entry.
+     */
+    std::size_t index(const uint64_t* data) const;
+
+    /** Size of a line, in bytes. */
+    const std::size_t blkSize;
+
+    std::vector<Entry> entries;
+
+    /** Contents of the line of each entry. */
+    std::vector<uint64_t> lines;
+};
+
+} // namespace compression
+} // namespace gem5
+
+#endif //__MEM_CACHE_COMPRESSORS_MEMO_HH__
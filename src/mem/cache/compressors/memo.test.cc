@@ -0,0 +1,196 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "base/types.hh"
+#include "mem/cache/compressors/memo.hh"
+
+using namespace gem5;
+using namespace gem5::compression;
+
+namespace
+{
+
+const std::size_t blkSize = 64;
+const std::size_t lineWords = blkSize / sizeof(uint64_t);
+
+typedef std::vector<uint64_t> Line;
+
+/**
+ * A compressor whose results depend on the whole line: every distinct
+ * word is stored once, and every word is encoded as an index into them.
+ */
+MemoTable::Result
+compressLine(const Line& line)
+{
+    const std::set<uint64_t> values(line.begin(), line.end());
+    std::size_t index_bits = 0;
+    while ((1ULL << index_bits) < values.size()) {
+        index_bits++;
+    }
+
+    MemoTable::Result result;
+    result.sizeBits = 64 * values.size() + index_bits * line.size();
+    result.compLat = Cycles(values.size());
+    result.decompLat = Cycles(index_bits + 1);
+    return result;
+}
+
+/** Compress a line the way the compressors do, using the memo first. */
+MemoTable::Result
+memoizedCompress(MemoTable& memo, const Line& line, bool& hit)
+{
+    const MemoTable::Result* memoized = memo.lookup(line.data());
+    hit = memoized;
+    if (memoized) {
+        return *memoized;
+    }
+    const MemoTable::Result result = compressLine(line);
+    memo.insert(line.data(), result);
+    return result;
+}
+
+void
+expectEqual(const MemoTable::Result& a, const MemoTable::Result& b)
+{
+    EXPECT_EQ(a.sizeBits, b.sizeBits);
+    EXPECT_EQ(uint64_t(a.compLat), uint64_t(b.compLat));
+    EXPECT_EQ(uint64_t(a.decompLat), uint64_t(b.decompLat));
+}
+
+} // anonymous namespace
+
+/** A disabled table never holds any results. */
+TEST(CompressionMemoTest, Disabled)
+{
+    MemoTable memo(0, blkSize);
+    EXPECT_FALSE(memo.enabled());
+
+    const Line line(lineWords, 0);
+    memo.insert(line.data(), compressLine(line));
+    EXPECT_EQ(memo.lookup(line.data()), nullptr);
+}
+
+/** The results of a compression are found for the same contents. */
+TEST(CompressionMemoTest, Hit)
+{
+    MemoTable memo(16, blkSize);
+    EXPECT_TRUE(memo.enabled());
+
+    Line line(lineWords, 0);
+    line[3] = 0xdeadbeef;
+    EXPECT_EQ(memo.lookup(line.data()), nullptr);
+
+    memo.insert(line.data(), compressLine(line));
+
+    // A copy of the line is looked up by contents, not by address
+    const Line copy = line;
+    const MemoTable::Result* memoized = memo.lookup(copy.data());
+    ASSERT_NE(memoized, nullptr);
+    expectEqual(*memoized, compressLine(line));
+}
+
+/**
+ * Changing the data of a line in place must not return the results of
+ * its old contents.
+ */
+TEST(CompressionMemoTest, DataChange)
+{
+    MemoTable memo(16, blkSize);
+
+    Line line(lineWords, 0x1111);
+    memo.insert(line.data(), compressLine(line));
+    ASSERT_NE(memo.lookup(line.data()), nullptr);
+
+    for (std::size_t i = 0; i < lineWords; i++) {
+        const uint64_t old_word = line[i];
+        line[i] = i + 1;
+        EXPECT_EQ(memo.lookup(line.data()), nullptr) << "word " << i;
+        line[i] = old_word;
+    }
+
+    // The old contents are still memoized
+    const MemoTable::Result* memoized = memo.lookup(line.data());
+    ASSERT_NE(memoized, nullptr);
+    expectEqual(*memoized, compressLine(line));
+}
+
+/** A line replaces the results of another line mapping to its entry. */
+TEST(CompressionMemoTest, Replacement)
+{
+    MemoTable memo(1, blkSize);
+
+    const Line a(lineWords, 0);
+    const Line b(lineWords, 7);
+    memo.insert(a.data(), compressLine(a));
+    memo.insert(b.data(), compressLine(b));
+
+    EXPECT_EQ(memo.lookup(a.data()), nullptr);
+    const MemoTable::Result* memoized = memo.lookup(b.data());
+    ASSERT_NE(memoized, nullptr);
+    expectEqual(*memoized, compressLine(b));
+}
+
+/**
+ * Over a stream of lines with repeated and modified contents, the
+ * memoized results always match a fresh compression of the line.
+ */
+TEST(CompressionMemoTest, MatchesFreshCompression)
+{
+    MemoTable memo(8, blkSize);
+    std::mt19937 rng(1);
+
+    // A few lines, including a zero line, written over and over
+    std::vector<Line> lines;
+    lines.emplace_back(lineWords, 0);
+    for (int i = 0; i < 15; i++) {
+        Line line(lineWords);
+        for (auto& word : line) {
+            word = rng() % 4;
+        }
+        lines.push_back(line);
+    }
+
+    int hits = 0;
+    for (int i = 0; i < 10000; i++) {
+        Line& line = lines[rng() % lines.size()];
+        if (rng() % 4 == 0) {
+            line[rng() % lineWords] = rng() % 4;
+        }
+
+        bool hit;
+        const MemoTable::Result result = memoizedCompress(memo, line, hit);
+        expectEqual(result, compressLine(line));
+        hits += hit;
+    }
+    EXPECT_GT(hits, 0);
+}
@@ -101,6 +101,13 @@ class Multi : public Base
         statistics::Vector2d ranks;
     } multiStats;
 
+    /**
+     * The ranking of the sub-compressors is recorded for every
+     * compression, so it cannot be memoized. The sub-compressors can be
+     * memoized on their own, though.
+     */
+    bool isMemoizable() const override { return false; }
+
   public:
     typedef MultiCompressorParams Params;
     Multi(const Params &p);
@@ -70,6 +70,13 @@ BaseTags::BaseTags(const Params &p)
     registerExitCallback([this]() { cleanupRefs(); });
 }
 
+void
+BaseTags::init()
+{
+    ClockedObject::init();
+    tagsInit();
+}
+
 ReplaceableEntry*
 BaseTags::findBlockBySetAndWay(int set, int way) const
 {
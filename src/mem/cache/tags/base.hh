@@ -173,6 +173,15 @@ class BaseTags : public ClockedObject
      */
     virtual void tagsInit() = 0;
 
+    /** Initialize the blocks through tagsInit(). */
+    void init() override;
+
+    /**
+     * The tags only set up their own blocks, and the replacement and
+     * indexing policies they own, in init().
+     */
+    bool independentInit() const override { return true; }
+
     /**
      * Average in the reference count for valid blocks when the simulation
      * exits.
@@ -105,7 +105,7 @@ CfiMemory::ProgramBuffer::setup(ssize_t buffer_size)
 
 bool
 CfiMemory::ProgramBuffer::write(Addr flash_address,
-    void *data_ptr, ssize_t size)
+    const void *data_ptr, ssize_t size)
 {
     if (bytesWritten >= buffer.size())
         return true;
@@ -585,7 +585,7 @@ CfiMemory::write(PacketPtr pkt)
           // Write to the buffer and check if a writeback is needed
           // (if the buffer is full)
           auto writeback = programBuffer.write(
-              flash_address, pkt->getPtr<void>(), pkt->getSize());
+              flash_address, pkt->getConstPtr<void>(), pkt->getSize());
 
           if (writeback) {
               if (new_cmd == CfiCommand::BUFFERED_PROGRAM_CONFIRM) {
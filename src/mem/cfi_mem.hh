@@ -197,7 +197,7 @@ class CfiMemory : public AbstractMemory
          *
          * @return true if buffer needs to be written back to flash
          */
-        bool write(Addr flash_address, void *data_ptr, ssize_t size);
+        bool write(Addr flash_address, const void *data_ptr, ssize_t size);
 
         bool writeback();
 
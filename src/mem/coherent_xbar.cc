@@ -164,7 +164,8 @@ CoherentXBar::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
     // test if the crossbar should be considered occupied for the current
     // port, and exclude express snoops from the check
     if (!is_express_snoop &&
-        !reqLayers[mem_side_port_id]->tryTiming(src_port)) {
+        !reqLayers[mem_side_port_id]->tryTiming(src_port,
+                                            pkt->getAddr())) {
         DPRINTF(CoherentXBar, "%s: src %s packet %s BUSY\n", __func__,
                 src_port->name(), pkt->print());
         return false;
@@ -211,7 +212,8 @@ CoherentXBar::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
 
                 // update the layer state and schedule an idle event
                 reqLayers[mem_side_port_id]->failedTiming(src_port,
-                                                        clockEdge(Cycles(1)));
+                                                        clockEdge(Cycles(1)),
+                                                        pkt->getAddr());
                 return false;
             }
         }
@@ -320,7 +322,8 @@ CoherentXBar::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
 
         // update the layer state and schedule an idle event
         reqLayers[mem_side_port_id]->failedTiming(src_port,
-                                                clockEdge(Cycles(1)));
+                                                clockEdge(Cycles(1)),
+                                                pkt->getAddr());
     } else {
         // express snoops currently bypass the crossbar state entirely
         if (!is_express_snoop) {
@@ -349,7 +352,8 @@ CoherentXBar::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
             }
 
             // update the layer state and schedule an idle event
-            reqLayers[mem_side_port_id]->succeededTiming(packetFinishTime);
+            reqLayers[mem_side_port_id]->succeededTiming(packetFinishTime,
+                                                     pkt->getAddr());
         }
 
         // stats updates only consider packets that were successfully sent
@@ -217,11 +217,14 @@ class CoherentXBar : public BaseXBar
       public:
 
         /**
-         * Create a snoop response port that mirrors a given CPU-side port.
+         * Create a snoop response port that mirrors a given CPU-side
+         * port. The port is numbered after the memory-side ports, as
+         * it competes with them for the response layers.
          */
         SnoopRespPort(QueuedResponsePort& cpu_side_port,
                       CoherentXBar& _xbar) :
-            RequestPort(cpu_side_port.name() + ".snoopRespPort", &_xbar),
+            RequestPort(cpu_side_port.name() + ".snoopRespPort", &_xbar,
+                        _xbar.memSidePorts.size() + cpu_side_port.getId()),
             cpuSidePort(cpu_side_port) { }
 
         /**
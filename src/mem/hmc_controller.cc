@@ -51,7 +51,8 @@ bool HMCController::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
 
     // test if the layer should be considered occupied for the current
     // port
-    if (!reqLayers[mem_side_port_id]->tryTiming(src_port)) {
+    if (!reqLayers[mem_side_port_id]->tryTiming(src_port,
+                                            pkt->getAddr())) {
         DPRINTF(HMCController, "recvTimingReq: src %s %s 0x%x BUSY\n",
                 src_port->name(), pkt->cmdString(), pkt->getAddr());
         return false;
@@ -94,7 +95,8 @@ bool HMCController::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
 
         // occupy until the header is sent
         reqLayers[mem_side_port_id]->failedTiming(src_port,
-                                                clockEdge(Cycles(1)));
+                                                clockEdge(Cycles(1)),
+                                                pkt->getAddr());
 
         return false;
     }
@@ -105,7 +107,8 @@ bool HMCController::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
         routeTo[pkt->req] = cpu_side_port_id;
     }
 
-    reqLayers[mem_side_port_id]->succeededTiming(packetFinishTime);
+    reqLayers[mem_side_port_id]->succeededTiming(packetFinishTime,
+                                                     pkt->getAddr());
 
     // stats updates
     pktCount[cpu_side_port_id][mem_side_port_id]++;
@@ -0,0 +1,121 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of a reference counted buffer holding the data of a
+ * cache line.
+ */
+
+#ifndef __MEM_LINE_BUFFER_HH__
+#define __MEM_LINE_BUFFER_HH__
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+#include "base/refcnt.hh"
+
+namespace gem5
+{
+
+/**
+ * A reference counted buffer holding the data of a cache line. Line
+ * buffers allow packets and cache blocks to refer to the same copy of
+ * a line rather than copying it at every level of the hierarchy. The
+ * buffer is copy-on-write: a holder that wants to modify the data
+ * while other holders refer to the same buffer must first take a
+ * private copy of it.
+ */
+class LineBuffer : public RefCounted
+{
+  private:
+    /** The line data, owned by the buffer. */
+    std::unique_ptr<uint8_t[]> bytes;
+
+    /** Size of the line, in bytes. */
+    const unsigned _size;
+
+  public:
+    /**
+     * Allocate a new buffer, leaving its contents uninitialized.
+     *
+     * @param size Size of the line in bytes.
+     */
+    explicit LineBuffer(unsigned size)
+        : bytes(new uint8_t[size]), _size(size)
+    {}
+
+    /**
+     * Create a buffer holding a copy of the given data.
+     *
+     * @param src Data to copy into the buffer.
+     * @param size Size of the line in bytes.
+     */
+    LineBuffer(const uint8_t *src, unsigned size)
+        : LineBuffer(size)
+    {
+        std::memcpy(bytes.get(), src, size);
+    }
+
+    /**
+     * Create a buffer that takes ownership of an array, which must
+     * have been allocated using new [], without copying it.
+     *
+     * @param array Array to adopt.
+     * @param size Size of the line in bytes.
+     * @return A buffer owning the array.
+     */
+    static LineBuffer *
+    adopt(uint8_t *array, unsigned size)
+    {
+        return new LineBuffer(array, size, true);
+    }
+
+    /** @return A pointer to the line data. */
+    uint8_t *data() const { return bytes.get(); }
+
+    /** @return The size of the line, in bytes. */
+    unsigned size() const { return _size; }
+
+    /**
+     * Check if more than one holder refers to this buffer, in which
+     * case the data must not be modified in place.
+     *
+     * @return True if the buffer is shared.
+     */
+    bool isShared() const { return getCount() > 1; }
+
+  private:
+    LineBuffer(uint8_t *array, unsigned size, bool)
+        : bytes(array), _size(size)
+    {}
+};
+
+typedef RefCountingPtr<LineBuffer> LineBufferPtr;
+
+} // namespace gem5
+
+#endif // __MEM_LINE_BUFFER_HH__
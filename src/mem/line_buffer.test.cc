@@ -0,0 +1,74 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+
+#include "mem/line_buffer.hh"
+
+using namespace gem5;
+
+/** A buffer created from existing data holds its own copy of it. */
+TEST(LineBufferTest, CopyOnConstruction)
+{
+    uint8_t src[64];
+    for (int i = 0; i < 64; i++)
+        src[i] = i;
+
+    LineBufferPtr buf = new LineBuffer(src, sizeof(src));
+    ASSERT_EQ(64, buf->size());
+    ASSERT_NE(src, buf->data());
+    ASSERT_EQ(0, std::memcmp(src, buf->data(), sizeof(src)));
+
+    src[0] = 0xff;
+    ASSERT_EQ(0, buf->data()[0]);
+}
+
+/** Adopting an array hands it over to the buffer without copying it. */
+TEST(LineBufferTest, Adopt)
+{
+    uint8_t *array = new uint8_t[64];
+    LineBufferPtr buf = LineBuffer::adopt(array, 64);
+    ASSERT_EQ(array, buf->data());
+    ASSERT_EQ(64, buf->size());
+}
+
+/** A buffer is only shared while more than one holder refers to it. */
+TEST(LineBufferTest, Sharing)
+{
+    LineBufferPtr first = new LineBuffer(64);
+    ASSERT_FALSE(first->isShared());
+
+    {
+        LineBufferPtr second = first;
+        ASSERT_TRUE(first->isShared());
+        ASSERT_TRUE(second->isShared());
+        ASSERT_EQ(first->data(), second->data());
+    }
+
+    ASSERT_FALSE(first->isShared());
+}
@@ -58,6 +58,10 @@ namespace memory
 MemCtrl::MemCtrl(const MemCtrlParams &p) :
     qos::MemCtrl(p),
     port(name() + ".port", *this), isTimingMode(false),
+    // until a detailed window has been observed, fall back on the
+    // unloaded access latency of the media
+    fastMode(p.dram ? p.dram->accessLatency() : 0,
+             p.nvm ? p.nvm->accessLatency() : 0),
     retryRdReq(false), retryWrReq(false),
     nextReqEvent([this]{ processNextReqEvent(); }, name()),
     respondEvent([this]{ processRespondEvent(); }, name()),
@@ -448,6 +452,10 @@ MemCtrl::recvTimingReq(PacketPtr pkt)
               pkt->print());
     }
 
+    if (fastMode.isFast()) {
+        recvTimingReqFast(pkt, is_dram);
+        return true;
+    }
 
     // Find out how many memory packets a pkt translates to
     // If the burst size is equal or larger than the pkt size, then a pkt
@@ -495,6 +503,48 @@ MemCtrl::recvTimingReq(PacketPtr pkt)
     return true;
 }
 
+void
+MemCtrl::recvTimingReqFast(PacketPtr pkt, bool is_dram)
+{
+    // the queues are empty when switching to fast mode, and nothing
+    // is ever added to them, so there is no need to check the write
+    // queue for overlapping transactions
+    assert(!totalReadQueueSize && !totalWriteQueueSize && respQueue.empty());
+
+    const RequestorID id = pkt->requestorId();
+    const unsigned size = pkt->getSize();
+
+    if (pkt->isWrite()) {
+        DPRINTF(MemCtrl, "Fast write to addr %#x\n", pkt->getAddr());
+
+        stats.writeReqs++;
+        stats.fastWriteReqs++;
+        stats.bytesWrittenSys += size;
+        stats.requestorWriteAccesses[id]++;
+        stats.requestorWriteBytes[id] += size;
+
+        // as in the detailed mode writes complete when they are
+        // accepted by the controller
+        accessAndRespond(pkt, frontendLatency);
+    } else {
+        assert(pkt->isRead());
+
+        const Tick lat = fastMode.readLatency(is_dram);
+
+        DPRINTF(MemCtrl, "Fast read to addr %#x, latency %d\n",
+                pkt->getAddr(), lat);
+
+        stats.readReqs++;
+        stats.fastReadReqs++;
+        stats.bytesReadSys += size;
+        stats.requestorReadAccesses[id]++;
+        stats.requestorReadBytes[id] += size;
+        stats.requestorReadTotalLat[id] += lat;
+
+        accessAndRespond(pkt, frontendLatency + backendLatency + lat);
+    }
+}
+
 void
 MemCtrl::processRespondEvent()
 {
@@ -861,6 +911,10 @@ MemCtrl::doBurstAccess(MemPacket* mem_pkt)
         // Update latency stats
         stats.requestorReadTotalLat[mem_pkt->requestorId()] +=
             mem_pkt->readyTime - mem_pkt->entryTime;
+
+        // and calibrate the latency model used in fast mode
+        fastMode.sample(mem_pkt->isDram(),
+                        mem_pkt->readyTime - mem_pkt->entryTime);
         stats.requestorReadBytes[mem_pkt->requestorId()] += mem_pkt->size;
     } else {
         ++writesThisTime;
@@ -1280,7 +1334,11 @@ MemCtrl::CtrlStats::CtrlStats(MemCtrl &_ctrl)
              "Per-requestor read average memory access latency"),
     ADD_STAT(requestorWriteAvgLat, statistics::units::Rate<
                 statistics::units::Tick, statistics::units::Count>::get(),
-             "Per-requestor write average memory access latency")
+             "Per-requestor write average memory access latency"),
+    ADD_STAT(fastReadReqs, statistics::units::Count::get(),
+             "Number of read requests serviced in fast mode"),
+    ADD_STAT(fastWriteReqs, statistics::units::Count::get(),
+             "Number of write requests serviced in fast mode")
 {
 }
 
@@ -1446,16 +1504,35 @@ MemCtrl::drain()
 void
 MemCtrl::drainResume()
 {
-    if (!isTimingMode && system()->isTimingMode()) {
-        // if we switched to timing mode, kick things into action,
-        // and behave as if we restored from a checkpoint
+    const bool was_fast = fastMode.isFast();
+
+    switch (fastMode.resume(isTimingMode, system()->isTimingMode())) {
+      case MemCtrlFastMode::StartDetailed:
+        // if we switched to detailed timing mode, kick things into
+        // action, and behave as if we restored from a checkpoint, thus
+        // resynchronising the bank and refresh state with the current
+        // tick
         startup();
-        dram->startup();
-    } else if (isTimingMode && !system()->isTimingMode()) {
-        // if we switch from timing mode, stop the refresh events to
-        // not cause issues with KVM
+        if (dram)
+            dram->startup();
+        break;
+      case MemCtrlFastMode::StopDetailed:
+        // if we switch from detailed timing mode, stop the refresh
+        // events to not cause issues with KVM, or to avoid spending
+        // time on them when fast-forwarding
         if (dram)
             dram->suspend();
+        break;
+      case MemCtrlFastMode::NoTransition:
+        break;
+    }
+
+    if (!was_fast && fastMode.isFast()) {
+        DPRINTF(MemCtrl, "Switching to fast mode, read latency DRAM %d "
+                "NVM %d\n", fastMode.readLatency(true),
+                fastMode.readLatency(false));
+    } else if (was_fast && !fastMode.isFast()) {
+        DPRINTF(MemCtrl, "Switching to detailed mode\n");
     }
 
     // update the mode
@@ -55,6 +55,7 @@
 #include "base/callback.hh"
 #include "base/statistics.hh"
 #include "enums/MemSched.hh"
+#include "mem/mem_ctrl_fast_mode.hh"
 #include "mem/qos/mem_ctrl.hh"
 #include "mem/qport.hh"
 #include "params/MemCtrl.hh"
@@ -280,6 +281,21 @@ class MemCtrl : public qos::MemCtrl
      */
     bool isTimingMode;
 
+    /**
+     * Fast-forward timing mode, in which requests bypass the queues
+     * and the media state machines.
+     */
+    MemCtrlFastMode fastMode;
+
+    /**
+     * Service a request in fast mode, skipping the read and write
+     * queues and the media specific timing.
+     *
+     * @param pkt The request packet from the outside world
+     * @param is_dram Does this packet access DRAM?
+     */
+    void recvTimingReqFast(PacketPtr pkt, bool is_dram);
+
     /**
      * Remember if we have to retry a request when available.
      */
@@ -589,6 +605,10 @@ class MemCtrl : public qos::MemCtrl
         // per-requestor raed and write average memory access latency
         statistics::Formula requestorReadAvgLat;
         statistics::Formula requestorWriteAvgLat;
+
+        // requests serviced with the fast-forward latency model
+        statistics::Scalar fastReadReqs;
+        statistics::Scalar fastWriteReqs;
     };
 
     CtrlStats stats;
@@ -699,6 +719,24 @@ class MemCtrl : public qos::MemCtrl
      */
     bool inWriteBusState(bool next_state) const;
 
+    /**
+     * Switch between the detailed timing mode and the fast-forward
+     * mode. The switch takes effect when the system is resumed after
+     * a drain, at which point the bank and refresh state is suspended
+     * or resynchronised as needed.
+     *
+     * @param fast Use the average latency model rather than the media
+     *             specific state machines
+     */
+    void setFastMode(bool fast) { fastMode.request(fast); }
+
+    /**
+     * Is the controller currently in the fast-forward mode?
+     *
+     * @return true if requests bypass the detailed timing model
+     */
+    bool isFastMode() const { return fastMode.isFast(); }
+
     Port &getPort(const std::string &if_name,
                   PortID idx=InvalidPortID) override;
 
@@ -0,0 +1,193 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of the fast-forward mode of the memory controller.
+ */
+
+#ifndef __MEM_CTRL_FAST_MODE_HH__
+#define __MEM_CTRL_FAST_MODE_HH__
+
+#include <cstdint>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+/**
+ * Tracks the fast-forward timing mode of a memory controller, in which
+ * requests bypass the queues and the media state machines, and reads
+ * are serviced with an average latency calibrated from the most recent
+ * detailed window. The requested mode is applied when the system
+ * resumes from a drain.
+ */
+class MemCtrlFastMode
+{
+  public:
+    /** What switching modes requires from the media state machines. */
+    enum Transition
+    {
+        /** The media state machines keep running or stay stopped. */
+        NoTransition,
+        /** Resynchronise the bank and refresh state and start them. */
+        StartDetailed,
+        /** Stop them, including the refresh events. */
+        StopDetailed
+    };
+
+    /**
+     * @param dram_lat Unloaded access latency of the DRAM, used until a
+     *        detailed window has been observed.
+     * @param nvm_lat Unloaded access latency of the NVM.
+     */
+    MemCtrlFastMode(Tick dram_lat, Tick nvm_lat)
+    {
+        dram.readLatency = dram_lat;
+        nvm.readLatency = nvm_lat;
+    }
+
+    /**
+     * Request a switch between the detailed and the fast-forward mode,
+     * to be applied on the next resume.
+     *
+     * @param fast Use the average latency model
+     */
+    void request(bool fast) { requested = fast; }
+
+    /** @return true if requests bypass the detailed timing model */
+    bool isFast() const { return fast; }
+
+    /**
+     * Record the queueing and access latency of a read burst serviced
+     * in the detailed mode.
+     *
+     * @param is_dram Was the burst serviced by the DRAM?
+     * @param lat Latency of the burst
+     */
+    void
+    sample(bool is_dram, Tick lat)
+    {
+        LatencyModel &model = is_dram ? dram : nvm;
+        model.totLat += lat;
+        model.samples++;
+    }
+
+    /**
+     * @param is_dram Does the read access the DRAM?
+     * @return The latency of a read in fast mode
+     */
+    Tick
+    readLatency(bool is_dram) const
+    {
+        return is_dram ? dram.readLatency : nvm.readLatency;
+    }
+
+    /**
+     * Apply the requested mode when the system resumes. The media state
+     * machines only run in timing mode when not fast-forwarding.
+     * Switching to fast mode uses what was learned in the last detailed
+     * window, and switching back to the detailed mode starts a new one.
+     *
+     * @param was_timing Was the system in timing mode before the drain?
+     * @param is_timing Is the system resuming in timing mode?
+     * @return What to do with the media state machines
+     */
+    Transition
+    resume(bool was_timing, bool is_timing)
+    {
+        const bool was_detailed = was_timing && !fast;
+        const bool is_detailed = is_timing && !requested;
+
+        Transition transition = NoTransition;
+        if (!was_detailed && is_detailed) {
+            transition = StartDetailed;
+            dram.reset();
+            nvm.reset();
+        } else if (was_detailed && !is_detailed) {
+            transition = StopDetailed;
+        }
+
+        if (!fast && requested) {
+            dram.calibrate();
+            nvm.calibrate();
+        }
+
+        fast = requested;
+        return transition;
+    }
+
+  private:
+    /**
+     * Latency model of a media type. The detailed mode accumulates the
+     * latency of every read burst, and the average of the window is
+     * used to service reads when switching to fast mode.
+     */
+    struct LatencyModel
+    {
+        /** Sum of burst latencies in the current detailed window */
+        Tick totLat = 0;
+        /** Number of read bursts in the current detailed window */
+        uint64_t samples = 0;
+        /** Latency used to service reads in fast mode */
+        Tick readLatency = 0;
+
+        /** Start a new detailed window. */
+        void
+        reset()
+        {
+            totLat = 0;
+            samples = 0;
+        }
+
+        /**
+         * Update the read latency from the detailed window, keeping
+         * the previous calibration if no reads were seen, and start a
+         * new window.
+         */
+        void
+        calibrate()
+        {
+            if (samples)
+                readLatency = totLat / samples;
+            reset();
+        }
+    };
+
+    LatencyModel dram;
+    LatencyModel nvm;
+
+    bool fast = false;
+    bool requested = false;
+};
+
+} // namespace memory
+} // namespace gem5
+
+#endif //__MEM_CTRL_FAST_MODE_HH__
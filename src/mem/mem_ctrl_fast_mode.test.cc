@@ -0,0 +1,138 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "base/types.hh"
+#include "mem/mem_ctrl_fast_mode.hh"
+
+using namespace gem5;
+using namespace gem5::memory;
+
+/** Until a detailed window was seen, reads use the unloaded latency. */
+TEST(MemCtrlFastModeTest, UnloadedLatency)
+{
+    MemCtrlFastMode mode(30, 100);
+    EXPECT_FALSE(mode.isFast());
+
+    // fast-forward straight from the start of the simulation
+    mode.request(true);
+    EXPECT_FALSE(mode.isFast());
+    EXPECT_EQ(mode.resume(false, true), MemCtrlFastMode::NoTransition);
+    EXPECT_TRUE(mode.isFast());
+    EXPECT_EQ(mode.readLatency(true), 30);
+    EXPECT_EQ(mode.readLatency(false), 100);
+}
+
+/** The requested mode only takes effect on resume. */
+TEST(MemCtrlFastModeTest, SwitchOnResume)
+{
+    MemCtrlFastMode mode(30, 100);
+
+    mode.request(true);
+    EXPECT_FALSE(mode.isFast());
+    EXPECT_EQ(mode.resume(true, true), MemCtrlFastMode::StopDetailed);
+    EXPECT_TRUE(mode.isFast());
+
+    // resuming again without a new request keeps the mode
+    EXPECT_EQ(mode.resume(true, true), MemCtrlFastMode::NoTransition);
+    EXPECT_TRUE(mode.isFast());
+
+    mode.request(false);
+    EXPECT_TRUE(mode.isFast());
+    EXPECT_EQ(mode.resume(true, true), MemCtrlFastMode::StartDetailed);
+    EXPECT_FALSE(mode.isFast());
+}
+
+/**
+ * The media state machines run only in timing mode when not
+ * fast-forwarding, whatever the order of the switches.
+ */
+TEST(MemCtrlFastModeTest, TimingModeSwitches)
+{
+    MemCtrlFastMode mode(30, 100);
+
+    // leaving and entering the timing mode in detailed mode
+    EXPECT_EQ(mode.resume(true, false), MemCtrlFastMode::StopDetailed);
+    EXPECT_EQ(mode.resume(false, true), MemCtrlFastMode::StartDetailed);
+
+    // atomic mode stays stopped when switching to fast mode
+    mode.request(true);
+    EXPECT_EQ(mode.resume(false, false), MemCtrlFastMode::NoTransition);
+    EXPECT_TRUE(mode.isFast());
+
+    // and in fast mode, entering timing mode does not start them
+    EXPECT_EQ(mode.resume(false, true), MemCtrlFastMode::NoTransition);
+
+    // switching to detailed mode and to atomic mode at once
+    mode.request(false);
+    EXPECT_EQ(mode.resume(true, false), MemCtrlFastMode::NoTransition);
+    EXPECT_FALSE(mode.isFast());
+    EXPECT_EQ(mode.resume(false, true), MemCtrlFastMode::StartDetailed);
+}
+
+/** Fast mode uses the average read latency of the detailed window. */
+TEST(MemCtrlFastModeTest, Calibration)
+{
+    MemCtrlFastMode mode(30, 100);
+    mode.resume(false, true);
+
+    mode.sample(true, 40);
+    mode.sample(true, 60);
+    mode.sample(false, 200);
+    // not applied until the switch
+    EXPECT_EQ(mode.readLatency(true), 30);
+
+    mode.request(true);
+    mode.resume(true, true);
+    EXPECT_EQ(mode.readLatency(true), 50);
+    EXPECT_EQ(mode.readLatency(false), 200);
+
+    // a new window starts when returning to the detailed mode, and the
+    // samples of the previous one are not counted again
+    mode.request(false);
+    mode.resume(true, true);
+    mode.sample(true, 80);
+    mode.request(true);
+    mode.resume(true, true);
+    EXPECT_EQ(mode.readLatency(true), 80);
+
+    // without any reads, the previous calibration is kept
+    EXPECT_EQ(mode.readLatency(false), 200);
+}
+
+/** Samples taken outside of a detailed window are discarded. */
+TEST(MemCtrlFastModeTest, NewWindowOnStart)
+{
+    MemCtrlFastMode mode(30, 100);
+
+    mode.sample(true, 1000);
+    EXPECT_EQ(mode.resume(false, true), MemCtrlFastMode::StartDetailed);
+    mode.sample(true, 20);
+
+    mode.request(true);
+    mode.resume(true, true);
+    EXPECT_EQ(mode.readLatency(true), 20);
+}
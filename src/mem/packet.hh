@@ -60,6 +60,7 @@
 #include "base/printable.hh"
 #include "base/types.hh"
 #include "mem/htm.hh"
+#include "mem/line_buffer.hh"
 #include "mem/request.hh"
 #include "sim/byteswap.hh"
 
@@ -342,6 +343,10 @@ class Packet : public Printable
         /// the packet is destroyed. The pointer is assumed to be pointing
         /// to an array, and delete [] is consequently called
         DYNAMIC_DATA           = 0x00002000,
+        /// The data pointer points into a reference counted line
+        /// buffer that may also be held by other packets and cache
+        /// blocks, and is copied before being modified
+        SHARED_DATA            = 0x00004000,
 
         /// suppress the error if this packet encounters a functional
         /// access failure.
@@ -375,6 +380,12 @@ class Packet : public Printable
     */
     PacketDataPtr data;
 
+    /**
+     * The line buffer the data pointer refers to when the packet
+     * carries shared data, and null otherwise.
+     */
+    LineBufferPtr lineBuffer;
+
     /// The address of the request.  This address could be virtual or
     /// physical, depending on the system configuration.
     Addr addr;
@@ -953,6 +964,11 @@ class Packet : public Printable
             if (pkt->flags.isSet(STATIC_DATA)) {
                 data = pkt->data;
                 flags.set(STATIC_DATA);
+            } else if (pkt->flags.isSet(SHARED_DATA) &&
+                       pkt->getSize() == getSize()) {
+                // a shared line is simply referenced by the new
+                // packet, and only copied if either of them writes it
+                dataShared(pkt->lineBuffer);
             } else {
                 allocate();
             }
@@ -1133,7 +1149,7 @@ class Packet : public Printable
     void
     dataStatic(T *p)
     {
-        assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA));
+        assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA|SHARED_DATA));
         data = (PacketDataPtr)p;
         flags.set(STATIC_DATA);
     }
@@ -1150,7 +1166,7 @@ class Packet : public Printable
     void
     dataStaticConst(const T *p)
     {
-        assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA));
+        assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA|SHARED_DATA));
         data = const_cast<PacketDataPtr>(p);
         flags.set(STATIC_DATA);
     }
@@ -1171,20 +1187,71 @@ class Packet : public Printable
     void
     dataDynamic(T *p)
     {
-        assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA));
+        assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA|SHARED_DATA));
         data = (PacketDataPtr)p;
         flags.set(DYNAMIC_DATA);
     }
 
+    /**
+     * Set the data pointer to a reference counted line buffer. Shared
+     * data allows a cache line to travel between packets and cache
+     * blocks without being copied at every level of the
+     * hierarchy. The buffer is copy-on-write, and whoever modifies it
+     * while it is still referenced elsewhere first takes a private
+     * copy, see getPtr().
+     */
+    void
+    dataShared(const LineBufferPtr &buf)
+    {
+        assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA|SHARED_DATA));
+        assert(buf && buf->size() == getSize());
+        lineBuffer = buf;
+        data = buf->data();
+        flags.set(SHARED_DATA);
+    }
+
+    /**
+     * Get a line buffer holding the data of this packet so that it
+     * can be referenced by others without being copied. Dynamic data
+     * is handed over to a new line buffer, which the packet then
+     * shares. Static data belongs to the sender and cannot be shared.
+     *
+     * @return The line buffer, or null if the data cannot be shared.
+     */
+    LineBufferPtr
+    shareData()
+    {
+        if (flags.isSet(DYNAMIC_DATA)) {
+            lineBuffer = LineBuffer::adopt(data, getSize());
+            flags.clear(DYNAMIC_DATA);
+            flags.set(SHARED_DATA);
+        }
+        return lineBuffer;
+    }
+
+    /** @return True if the packet data is held in a shared buffer. */
+    bool hasSharedData() const { return flags.isSet(SHARED_DATA); }
+
+    /** @return True if the packet data belongs to the sender. */
+    bool hasStaticData() const { return flags.isSet(STATIC_DATA); }
+
     /**
      * get a pointer to the data ptr.
+     *
+     * As the caller may modify the data, a packet whose line buffer is
+     * also referenced elsewhere (see dataShared()) first takes a copy
+     * of the line, which allocates and copies a line. Callers that only
+     * read the data should use getConstPtr(), which never copies.
      */
     template <typename T>
     T*
     getPtr()
     {
-        assert(flags.isSet(STATIC_DATA|DYNAMIC_DATA));
+        assert(flags.isSet(STATIC_DATA|DYNAMIC_DATA|SHARED_DATA));
         assert(!isMaskedWrite());
+        // the caller may modify the data, so make sure no other
+        // holder of the line sees the update
+        unshareData(true);
         return (T*)data;
     }
 
@@ -1192,7 +1259,7 @@ class Packet : public Printable
     const T*
     getConstPtr() const
     {
-        assert(flags.isSet(STATIC_DATA|DYNAMIC_DATA));
+        assert(flags.isSet(STATIC_DATA|DYNAMIC_DATA|SHARED_DATA));
         return (const T*)data;
     }
 
@@ -1254,9 +1321,13 @@ class Packet : public Printable
         // we should never be copying data onto itself, which means we
         // must idenfity packets with static data, as they carry the
         // same pointer from source to destination and back
-        assert(p != getPtr<uint8_t>() || flags.isSet(STATIC_DATA));
+        assert(p != data || flags.isSet(STATIC_DATA));
+
+        // the whole payload is overwritten, so there is no need to
+        // copy a shared line before detaching from it
+        unshareData(false);
 
-        if (p != getPtr<uint8_t>()) {
+        if (p != getConstPtr<uint8_t>()) {
             // for packet with allocated dynamic data, we copy data from
             // one to the other, e.g. a forwarded response to a response
             std::memcpy(getPtr<uint8_t>(), p, getSize());
@@ -1317,7 +1388,8 @@ class Packet : public Printable
         if (flags.isSet(DYNAMIC_DATA))
             delete [] data;
 
-        flags.clear(STATIC_DATA|DYNAMIC_DATA);
+        lineBuffer = nullptr;
+        flags.clear(STATIC_DATA|DYNAMIC_DATA|SHARED_DATA);
         data = NULL;
     }
 
@@ -1328,7 +1400,7 @@ class Packet : public Printable
         // if either this command or the response command has a data
         // payload, actually allocate space
         if (hasData() || hasRespData()) {
-            assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA));
+            assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA|SHARED_DATA));
             flags.set(DYNAMIC_DATA);
             data = new uint8_t[getSize()];
         }
@@ -1336,6 +1408,29 @@ class Packet : public Printable
 
     /** @} */
 
+  private:
+    /**
+     * Detach the packet from a line buffer that is also referenced
+     * elsewhere, giving it dynamic data of its own. A buffer only
+     * held by this packet is kept, as it can be modified in place.
+     *
+     * @param copy Whether to copy the line into the private data.
+     */
+    void
+    unshareData(bool copy)
+    {
+        if (!flags.isSet(SHARED_DATA) || !lineBuffer->isShared())
+            return;
+
+        data = new uint8_t[getSize()];
+        if (copy)
+            std::memcpy(data, lineBuffer->data(), getSize());
+        lineBuffer = nullptr;
+        flags.clear(SHARED_DATA);
+        flags.set(DYNAMIC_DATA);
+    }
+
+  public:
     /** Get the data in the packet without byte swapping. */
     template <typename T>
     T getRaw() const;
@@ -1370,10 +1465,17 @@ class Packet : public Printable
         }
         // all packets that are carrying a payload should have a valid
         // data pointer
+        if (!other->hasData()) {
+            return trySatisfyFunctional(other, other->getAddr(),
+                                        other->isSecure(), other->getSize(),
+                                        NULL);
+        }
+        // only a functional write modifies the data of the other
+        // packet, so do not copy a shared line to satisfy a read
+        uint8_t *other_data = isWrite() ? other->getPtr<uint8_t>() :
+            const_cast<uint8_t *>(other->getConstPtr<uint8_t>());
         return trySatisfyFunctional(other, other->getAddr(), other->isSecure(),
-                                    other->getSize(),
-                                    other->hasData() ?
-                                    other->getPtr<uint8_t>() : NULL);
+                                    other->getSize(), other_data);
     }
 
     /**
@@ -0,0 +1,169 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+#include "base/gtest/cur_tick_fake.hh"
+#include "mem/line_buffer.hh"
+#include "mem/packet.hh"
+#include "mem/request.hh"
+
+using namespace gem5;
+
+// Instantiate the fake class to have a valid curTick of 0
+GTestTickHandler tickHandler;
+
+namespace
+{
+
+const unsigned lineSize = 64;
+
+/** Create a response carrying a whole line, filled with a pattern. */
+std::unique_ptr<Packet>
+makeLine(uint8_t seed)
+{
+    RequestPtr req = std::make_shared<Request>(0x1000, lineSize, 0, 0);
+    std::unique_ptr<Packet> pkt(new Packet(req, MemCmd::ReadResp));
+    pkt->allocate();
+    uint8_t *data = pkt->getPtr<uint8_t>();
+    for (unsigned i = 0; i < lineSize; i++)
+        data[i] = seed + i;
+    return pkt;
+}
+
+} // anonymous namespace
+
+/** Sharing dynamic data hands it over to a buffer without copying it. */
+TEST(PacketSharedDataTest, ShareDynamicData)
+{
+    auto pkt = makeLine(0);
+    const uint8_t *data = pkt->getConstPtr<uint8_t>();
+    ASSERT_FALSE(pkt->hasSharedData());
+
+    LineBufferPtr buf = pkt->shareData();
+    ASSERT_TRUE(buf);
+    EXPECT_TRUE(pkt->hasSharedData());
+    EXPECT_EQ(buf->data(), data);
+    EXPECT_EQ(pkt->getConstPtr<uint8_t>(), data);
+
+    // Sharing again returns the same buffer
+    EXPECT_EQ(pkt->shareData(), buf);
+}
+
+/** Static data belongs to the sender, and cannot be shared. */
+TEST(PacketSharedDataTest, StaticDataNotShared)
+{
+    RequestPtr req = std::make_shared<Request>(0x1000, lineSize, 0, 0);
+    Packet pkt(req, MemCmd::ReadResp);
+    uint8_t data[lineSize];
+    pkt.dataStatic(data);
+
+    EXPECT_FALSE(pkt.shareData());
+    EXPECT_FALSE(pkt.hasSharedData());
+}
+
+/** Copies of a packet refer to its shared line instead of copying it. */
+TEST(PacketSharedDataTest, CopyForwardsSharedLine)
+{
+    auto pkt = makeLine(0);
+    LineBufferPtr buf = pkt->shareData();
+
+    Packet copy(pkt.get(), false, true);
+    EXPECT_TRUE(copy.hasSharedData());
+    EXPECT_EQ(copy.getConstPtr<uint8_t>(), buf->data());
+}
+
+/** Writing a line held elsewhere copies it first. */
+TEST(PacketSharedDataTest, WriteUnsharesLine)
+{
+    auto pkt = makeLine(0);
+    LineBufferPtr buf = pkt->shareData();
+    ASSERT_TRUE(buf->isShared());
+
+    uint8_t *data = pkt->getPtr<uint8_t>();
+    EXPECT_NE(data, buf->data());
+    EXPECT_FALSE(pkt->hasSharedData());
+    EXPECT_FALSE(buf->isShared());
+    EXPECT_EQ(std::memcmp(data, buf->data(), lineSize), 0);
+
+    // The other holders do not see the update
+    data[0] = 0xff;
+    EXPECT_EQ(buf->data()[0], 0);
+}
+
+/** A line only held by the packet is written in place. */
+TEST(PacketSharedDataTest, WriteSoleHolderInPlace)
+{
+    auto pkt = makeLine(0);
+    const uint8_t *data = pkt->shareData()->data();
+
+    EXPECT_EQ(pkt->getPtr<uint8_t>(), data);
+    EXPECT_TRUE(pkt->hasSharedData());
+}
+
+/** Overwriting the whole payload detaches from the line without copying. */
+TEST(PacketSharedDataTest, SetDataUnsharesLine)
+{
+    auto pkt = makeLine(0);
+    LineBufferPtr buf = pkt->shareData();
+
+    auto other = makeLine(100);
+    pkt->setData(other->getConstPtr<uint8_t>());
+    EXPECT_FALSE(pkt->hasSharedData());
+    EXPECT_FALSE(buf->isShared());
+    EXPECT_EQ(pkt->getConstPtr<uint8_t>()[0], 100);
+    EXPECT_EQ(buf->data()[0], 0);
+}
+
+/** Functional reads from a packet holding a shared line do not copy it. */
+TEST(PacketSharedDataTest, FunctionalReadKeepsLineShared)
+{
+    auto pkt = makeLine(0);
+    LineBufferPtr buf = pkt->shareData();
+
+    RequestPtr req = std::make_shared<Request>(0x1008, 8, 0, 0);
+    Packet read(req, MemCmd::ReadReq);
+    read.allocate();
+    EXPECT_TRUE(read.trySatisfyFunctional(pkt.get()));
+    EXPECT_EQ(read.getConstPtr<uint8_t>()[0], 8);
+    EXPECT_TRUE(pkt->hasSharedData());
+    EXPECT_TRUE(buf->isShared());
+    EXPECT_EQ(pkt->getConstPtr<uint8_t>(), buf->data());
+}
+
+/** Deleting the data drops the reference to the line. */
+TEST(PacketSharedDataTest, DeleteDataReleasesLine)
+{
+    auto pkt = makeLine(0);
+    LineBufferPtr buf = pkt->shareData();
+
+    pkt->deleteData();
+    EXPECT_FALSE(pkt->hasSharedData());
+    EXPECT_FALSE(buf->isShared());
+}
@@ -380,7 +380,7 @@ AbstractController::recvTimingResp(PacketPtr pkt)
         (*msg).m_MessageSize = MessageSizeType_Response_Data;
 
         // Copy data from the packet
-        (*msg).m_DataBlk.setData(pkt->getPtr<uint8_t>(), 0,
+        (*msg).m_DataBlk.setData(pkt->getConstPtr<uint8_t>(), 0,
                                  RubySystem::getBlockSizeBytes());
     } else if (pkt->isWrite()) {
         (*msg).m_Type = MemoryRequestType_MEMORY_WB;
@@ -76,6 +76,12 @@ class CacheMemory : public SimObject
 
     void init();
 
+    /**
+     * The cache only allocates its own sets, and the replacement data of
+     * the replacement policy it owns, in init().
+     */
+    bool independentInit() const override { return true; }
+
     // Public Methods
     // perform a cache access and see if we hit or not.  Return true on a hit.
     bool tryCacheAccess(Addr address, RubyRequestType type,
@@ -66,6 +66,9 @@ class DirectoryMemory : public SimObject
 
     void init();
 
+    /** The directory only allocates its own entries in init(). */
+    bool independentInit() const override { return true; }
+
     /**
      * Return the index in the directory based on an address
      *
@@ -561,7 +561,7 @@ GPUCoalescer::hitCallback(CoalescedRequest* crequest,
             pktList.size(), request_line_address);
     for (auto& pkt : pktList) {
         request_address = pkt->getAddr();
-        if (pkt->getPtr<uint8_t>()) {
+        if (pkt->getConstPtr<uint8_t>()) {
             if ((type == RubyRequestType_LD) ||
                 (type == RubyRequestType_ATOMIC) ||
                 (type == RubyRequestType_ATOMIC_RETURN) ||
@@ -572,7 +572,7 @@ GPUCoalescer::hitCallback(CoalescedRequest* crequest,
                 pkt->setData(
                     data.getData(getOffset(request_address), pkt->getSize()));
             } else {
-                data.setData(pkt->getPtr<uint8_t>(),
+                data.setData(pkt->getConstPtr<uint8_t>(),
                              getOffset(request_address), pkt->getSize());
             }
         } else {
@@ -145,7 +145,7 @@ VIPERCoalescer::issueRequest(CoalescedRequest* crequest)
                                                         tmpPkt->getAtomicOp());
             atomicOps.push_back(tmpAtomicOp);
         } else if (tmpPkt->isWrite()) {
-            dataBlock.setData(tmpPkt->getPtr<uint8_t>(),
+            dataBlock.setData(tmpPkt->getConstPtr<uint8_t>(),
                               tmpOffset, tmpSize);
         }
         for (int j = 0; j < tmpSize; j++) {
@@ -0,0 +1,171 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of the structure tracking the ports waiting for a
+ * crossbar layer.
+ */
+
+#ifndef __MEM_WAITING_PORTS_HH__
+#define __MEM_WAITING_PORTS_HH__
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+/**
+ * The ports waiting for a crossbar layer, retried in the order they
+ * started waiting. A port waits at most once at any given time, and
+ * ports are identified by their id. A bit mask indexed by id tracks
+ * which ports are waiting, and a ring buffer keeps them in order,
+ * making every operation constant time. Both structures grow with the
+ * ids seen, and once every port of the crossbar has waited no further
+ * allocation takes place.
+ *
+ * @tparam PortType The type of the waiting ports, providing getId().
+ */
+template <typename PortType>
+class WaitingPorts
+{
+  private:
+    /** The waiting ports, in retry order starting from head. */
+    std::vector<PortType*> ring;
+
+    /** Position of the first waiting port in the ring. */
+    size_t head;
+
+    /** Number of waiting ports. */
+    size_t count;
+
+    /** One bit per port id, set while the port is waiting. */
+    std::vector<uint64_t> mask;
+
+    static size_t word(PortID id) { return id / 64; }
+    static uint64_t bit(PortID id) { return 1ULL << (id % 64); }
+
+    /**
+     * Mark a port as waiting, making room for it in the ring and the
+     * mask as needed.
+     */
+    void
+    insert(PortType *port)
+    {
+        const PortID id = port->getId();
+        assert(id != InvalidPortID);
+        assert(!contains(port));
+
+        if (word(id) >= mask.size())
+            mask.resize(word(id) + 1, 0);
+        mask[word(id)] |= bit(id);
+
+        if (count == ring.size()) {
+            // unroll the ring into a larger one, keeping the order
+            std::vector<PortType*> larger(std::max<size_t>(4, 2 * count));
+            for (size_t i = 0; i < count; ++i)
+                larger[i] = ring[(head + i) % ring.size()];
+            ring.swap(larger);
+            head = 0;
+        }
+        ++count;
+    }
+
+  public:
+    WaitingPorts() : head(0), count(0) {}
+
+    /** @return True if no port is waiting. */
+    bool empty() const { return count == 0; }
+
+    /** @return The number of waiting ports. */
+    size_t size() const { return count; }
+
+    /**
+     * Check if a port is waiting.
+     *
+     * @param port The port to look for.
+     * @return True if the port is waiting.
+     */
+    bool
+    contains(const PortType *port) const
+    {
+        const PortID id = port->getId();
+        return word(id) < mask.size() && (mask[word(id)] & bit(id));
+    }
+
+    /**
+     * Add a port to be retried after all the ports already waiting.
+     *
+     * @param port The port to add, which must not be waiting already.
+     */
+    void
+    push_back(PortType *port)
+    {
+        insert(port);
+        ring[(head + count - 1) % ring.size()] = port;
+    }
+
+    /**
+     * Add a port to be retried before all the ports already waiting.
+     *
+     * @param port The port to add, which must not be waiting already.
+     */
+    void
+    push_front(PortType *port)
+    {
+        insert(port);
+        head = (head + ring.size() - 1) % ring.size();
+        ring[head] = port;
+    }
+
+    /** @return The first port to retry. */
+    PortType *
+    front() const
+    {
+        assert(!empty());
+        return ring[head];
+    }
+
+    /** Remove the first port to retry. */
+    void
+    pop_front()
+    {
+        assert(!empty());
+        const PortID id = ring[head]->getId();
+        mask[word(id)] &= ~bit(id);
+        head = (head + 1) % ring.size();
+        --count;
+    }
+};
+
+} // namespace gem5
+
+#endif //__MEM_WAITING_PORTS_HH__
@@ -0,0 +1,117 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "mem/waiting_ports.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** A minimal port, only providing an id. */
+class FakePort
+{
+  private:
+    const PortID id;
+
+  public:
+    FakePort(PortID _id) : id(_id) {}
+    PortID getId() const { return id; }
+};
+
+} // anonymous namespace
+
+/** Ports are retried in the order they started waiting. */
+TEST(WaitingPortsTest, FifoOrder)
+{
+    std::vector<FakePort> ports;
+    for (int i = 0; i < 100; i++)
+        ports.emplace_back(i);
+
+    WaitingPorts<FakePort> waiting;
+    ASSERT_TRUE(waiting.empty());
+
+    for (int i = 99; i >= 0; i--)
+        waiting.push_back(&ports[i]);
+    ASSERT_EQ(100, waiting.size());
+
+    for (int i = 99; i >= 0; i--) {
+        ASSERT_TRUE(waiting.contains(&ports[i]));
+        ASSERT_EQ(&ports[i], waiting.front());
+        waiting.pop_front();
+        ASSERT_FALSE(waiting.contains(&ports[i]));
+    }
+    ASSERT_TRUE(waiting.empty());
+}
+
+/** A port pushed to the front is retried before the others. */
+TEST(WaitingPortsTest, PushFront)
+{
+    FakePort a(0), b(1), c(70);
+    WaitingPorts<FakePort> waiting;
+
+    waiting.push_back(&a);
+    waiting.push_back(&b);
+    waiting.push_front(&c);
+
+    ASSERT_EQ(&c, waiting.front());
+    waiting.pop_front();
+    ASSERT_EQ(&a, waiting.front());
+    waiting.pop_front();
+    ASSERT_EQ(&b, waiting.front());
+    waiting.pop_front();
+    ASSERT_TRUE(waiting.empty());
+}
+
+/** The order is kept when the ring wraps around and grows. */
+TEST(WaitingPortsTest, WrapAndGrow)
+{
+    std::vector<FakePort> ports;
+    for (int i = 0; i < 16; i++)
+        ports.emplace_back(i);
+
+    WaitingPorts<FakePort> waiting;
+    for (int i = 0; i < 3; i++)
+        waiting.push_back(&ports[i]);
+    waiting.pop_front();
+    waiting.pop_front();
+
+    // the ring now starts in the middle of its storage
+    waiting.push_front(&ports[1]);
+    for (int i = 3; i < 16; i++)
+        waiting.push_back(&ports[i]);
+
+    ASSERT_EQ(15, waiting.size());
+    for (int i = 1; i < 16; i++) {
+        ASSERT_EQ(&ports[i], waiting.front());
+        waiting.pop_front();
+    }
+    ASSERT_TRUE(waiting.empty());
+}
@@ -45,6 +45,7 @@
 
 #include "mem/xbar.hh"
 
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/AddrRanges.hh"
@@ -61,6 +62,8 @@ BaseXBar::BaseXBar(const BaseXBarParams &p)
       responseLatency(p.response_latency),
       headerLatency(p.header_latency),
       width(p.width),
+      reqLayerShards(p.request_layer_shards),
+      layerShardShift(floorLog2(p.layer_shard_interleave)),
       gotAddrRanges(p.port_default_connection_count +
                           p.port_mem_side_ports_connection_count, false),
       gotAllAddrRanges(false), defaultPortID(InvalidPortID),
@@ -73,6 +76,10 @@ BaseXBar::BaseXBar(const BaseXBarParams &p)
       ADD_STAT(pktSize, statistics::units::Byte::get(),
                "Cumulative packet size per connected requestor and responder")
 {
+    fatal_if(!reqLayerShards, "%s needs at least one request layer shard",
+             name());
+    fatal_if(!isPowerOf2(p.layer_shard_interleave),
+             "%s layer shard interleaving must be a power of 2", name());
 }
 
 BaseXBar::~BaseXBar()
@@ -139,15 +146,28 @@ BaseXBar::calcPacketTiming(PacketPtr pkt, Tick header_delay)
     // thus regulates throughput
 }
 
+template <typename SrcType, typename DstType>
+BaseXBar::Layer<SrcType, DstType>::Shard::Shard(Layer &layer) :
+    state(IDLE),
+    releaseEvent([this, &layer]{ layer.releaseLayer(*this); }, layer.name())
+{
+}
+
 template <typename SrcType, typename DstType>
 BaseXBar::Layer<SrcType, DstType>::Layer(DstType& _port, BaseXBar& _xbar,
-                                       const std::string& _name) :
+                                       const std::string& _name,
+                                       unsigned num_shards) :
     statistics::Group(&_xbar, _name.c_str()),
-    port(_port), xbar(_xbar), _name(xbar.name() + "." + _name), state(IDLE),
-    waitingForPeer(NULL), releaseEvent([this]{ releaseLayer(); }, name()),
+    port(_port), xbar(_xbar), _name(xbar.name() + "." + _name),
+    shardShift(xbar.layerShardShift),
+    waitingForPeer(NULL), waitingForPeerShard(NULL),
     ADD_STAT(occupancy, statistics::units::Tick::get(), "Layer occupancy (ticks)"),
     ADD_STAT(utilization, statistics::units::Ratio::get(), "Layer utilization")
 {
+    assert(num_shards);
+    for (unsigned i = 0; i < num_shards; ++i)
+        shards.emplace_back(new Shard(*this));
+
     occupancy
         .flags(statistics::nozero);
 
@@ -155,21 +175,23 @@ BaseXBar::Layer<SrcType, DstType>::Layer(DstType& _port, BaseXBar& _xbar,
         .precision(1)
         .flags(statistics::nozero);
 
-    utilization = occupancy / simTicks;
+    // the occupancy is accumulated over all the shards
+    utilization = occupancy / simTicks / statistics::constant(num_shards);
 }
 
 template <typename SrcType, typename DstType>
-void BaseXBar::Layer<SrcType, DstType>::occupyLayer(Tick until)
+void
+BaseXBar::Layer<SrcType, DstType>::occupyLayer(Shard &shard, Tick until)
 {
     // ensure the state is busy at this point, as the layer should
     // transition from idle as soon as it has decided to forward the
     // packet to prevent any follow-on calls to sendTiming seeing an
     // unoccupied layer
-    assert(state == BUSY);
+    assert(shard.state == BUSY);
 
     // until should never be 0 as express snoops never occupy the layer
     assert(until != 0);
-    xbar.schedule(releaseEvent, until);
+    xbar.schedule(shard.releaseEvent, until);
 
     // account for the occupied ticks
     occupancy += until - curTick();
@@ -180,51 +202,50 @@ void BaseXBar::Layer<SrcType, DstType>::occupyLayer(Tick until)
 
 template <typename SrcType, typename DstType>
 bool
-BaseXBar::Layer<SrcType, DstType>::tryTiming(SrcType* src_port)
+BaseXBar::Layer<SrcType, DstType>::tryTiming(SrcType* src_port, Addr addr)
 {
+    Shard &shard = shardOf(addr);
+
     // if we are in the retry state, we will not see anything but the
     // retrying port (or in the case of the snoop ports the snoop
     // response port that mirrors the actual CPU-side port) as we leave
     // this state again in zero time if the peer does not immediately
     // call the layer when receiving the retry
 
-    // first we see if the layer is busy, next we check if the
+    // first we see if the shard is busy, next we check if the
     // destination port is already engaged in a transaction waiting
     // for a retry from the peer
-    if (state == BUSY || waitingForPeer != NULL) {
+    if (shard.state == BUSY || waitingForPeer != NULL) {
         // the port should not be waiting already
-        assert(std::find(waitingForLayer.begin(), waitingForLayer.end(),
-                         src_port) == waitingForLayer.end());
+        assert(!shard.waitingForLayer.contains(src_port));
 
         // put the port at the end of the retry list waiting for the
         // layer to be freed up (and in the case of a busy peer, for
         // that transaction to go through, and then the layer to free
         // up)
-        waitingForLayer.push_back(src_port);
+        shard.waitingForLayer.push_back(src_port);
         return false;
     }
 
-    state = BUSY;
+    shard.state = BUSY;
 
     return true;
 }
 
 template <typename SrcType, typename DstType>
 void
-BaseXBar::Layer<SrcType, DstType>::succeededTiming(Tick busy_time)
+BaseXBar::Layer<SrcType, DstType>::succeededTiming(Tick busy_time,
+                                                   Addr addr)
 {
-    // we should have gone from idle or retry to busy in the tryTiming
-    // test
-    assert(state == BUSY);
-
-    // occupy the layer accordingly
-    occupyLayer(busy_time);
+    // occupy the shard accordingly, having gone from idle or retry
+    // to busy in the tryTiming test
+    occupyLayer(shardOf(addr), busy_time);
 }
 
 template <typename SrcType, typename DstType>
 void
 BaseXBar::Layer<SrcType, DstType>::failedTiming(SrcType* src_port,
-                                              Tick busy_time)
+                                              Tick busy_time, Addr addr)
 {
     // ensure no one got in between and tried to send something to
     // this port
@@ -233,34 +254,35 @@ BaseXBar::Layer<SrcType, DstType>::failedTiming(SrcType* src_port,
     // if the source port is the current retrying one or not, we have
     // failed in forwarding and should track that we are now waiting
     // for the peer to send a retry
+    Shard &shard = shardOf(addr);
     waitingForPeer = src_port;
+    waitingForPeerShard = &shard;
 
-    // we should have gone from idle or retry to busy in the tryTiming
-    // test
-    assert(state == BUSY);
-
-    // occupy the bus accordingly
-    occupyLayer(busy_time);
+    // occupy the shard accordingly, having gone from idle or retry
+    // to busy in the tryTiming test
+    occupyLayer(shard, busy_time);
 }
 
 template <typename SrcType, typename DstType>
 void
-BaseXBar::Layer<SrcType, DstType>::releaseLayer()
+BaseXBar::Layer<SrcType, DstType>::releaseLayer(Shard &shard)
 {
     // releasing the bus means we should now be idle
-    assert(state == BUSY);
-    assert(!releaseEvent.scheduled());
+    assert(shard.state == BUSY);
+    assert(!shard.releaseEvent.scheduled());
 
     // update the state
-    state = IDLE;
+    shard.state = IDLE;
 
     // bus layer is now idle, so if someone is waiting we can retry
-    if (!waitingForLayer.empty()) {
+    if (!shard.waitingForLayer.empty()) {
         // there is no point in sending a retry if someone is still
         // waiting for the peer
         if (waitingForPeer == NULL)
-            retryWaiting();
-    } else if (waitingForPeer == NULL && drainState() == DrainState::Draining) {
+            retryWaiting(shard);
+    } else if (waitingForPeer == NULL &&
+               drainState() == DrainState::Draining &&
+               drain() == DrainState::Drained) {
         DPRINTF(Drain, "Crossbar done draining, signaling drain manager\n");
         //If we weren't able to drain before, do it now.
         signalDrainDone();
@@ -269,36 +291,36 @@ BaseXBar::Layer<SrcType, DstType>::releaseLayer()
 
 template <typename SrcType, typename DstType>
 void
-BaseXBar::Layer<SrcType, DstType>::retryWaiting()
+BaseXBar::Layer<SrcType, DstType>::retryWaiting(Shard &shard)
 {
     // this should never be called with no one waiting
-    assert(!waitingForLayer.empty());
+    assert(!shard.waitingForLayer.empty());
 
     // we always go to retrying from idle
-    assert(state == IDLE);
+    assert(shard.state == IDLE);
 
     // update the state
-    state = RETRY;
+    shard.state = RETRY;
 
     // set the retrying port to the front of the retry list and pop it
     // off the list
-    SrcType* retryingPort = waitingForLayer.front();
-    waitingForLayer.pop_front();
+    SrcType* retryingPort = shard.waitingForLayer.front();
+    shard.waitingForLayer.pop_front();
 
     // tell the port to retry, which in some cases ends up calling the
     // layer again
     sendRetry(retryingPort);
 
-    // If the layer is still in the retry state, sendTiming wasn't
+    // If the shard is still in the retry state, sendTiming wasn't
     // called in zero time (e.g. the cache does this when a writeback
     // is squashed)
-    if (state == RETRY) {
+    if (shard.state == RETRY) {
         // update the state to busy and reset the retrying port, we
         // have done our bit and sent the retry
-        state = BUSY;
+        shard.state = BUSY;
 
         // occupy the crossbar layer until the next clock edge
-        occupyLayer(xbar.clockEdge());
+        occupyLayer(shard, xbar.clockEdge());
     }
 }
 
@@ -311,19 +333,33 @@ BaseXBar::Layer<SrcType, DstType>::recvRetry()
     assert(waitingForPeer != NULL);
 
     // add the port where the failed packet originated to the front of
-    // the waiting ports for the layer, this allows us to call retry
-    // on the port immediately if the crossbar layer is idle
-    waitingForLayer.push_front(waitingForPeer);
+    // the waiting ports for its shard, this allows us to call retry
+    // on the port immediately if the shard is idle
+    Shard &peer_shard = *waitingForPeerShard;
+    peer_shard.waitingForLayer.push_front(waitingForPeer);
 
     // we are no longer waiting for the peer
     waitingForPeer = NULL;
+    waitingForPeerShard = NULL;
 
-    // if the layer is idle, retry this port straight away, if we
-    // are busy, then simply let the port wait for its turn
-    if (state == IDLE) {
-        retryWaiting();
+    // if the shard is idle, retry this port straight away, if it is
+    // busy, then simply let the port wait for its turn
+    if (peer_shard.state == IDLE) {
+        retryWaiting(peer_shard);
     } else {
-        assert(state == BUSY);
+        assert(peer_shard.state == BUSY);
+    }
+
+    // any other idle shard has ports that were held back while we
+    // were waiting for the peer, so retry them as well, unless the
+    // destination turned a packet away once more
+    for (auto &shard : shards) {
+        if (waitingForPeer != NULL)
+            break;
+        if (shard.get() != &peer_shard && shard->state == IDLE &&
+            !shard->waitingForLayer.empty()) {
+            retryWaiting(*shard);
+        }
     }
 }
 
@@ -590,12 +626,13 @@ BaseXBar::Layer<SrcType, DstType>::drain()
     //We should check that we're not "doing" anything, and that noone is
     //waiting. We might be idle but have someone waiting if the device we
     //contacted for a retry didn't actually retry.
-    if (state != IDLE) {
-        DPRINTF(Drain, "Crossbar not drained\n");
-        return DrainState::Draining;
-    } else {
-        return DrainState::Drained;
+    for (const auto &shard : shards) {
+        if (shard->state != IDLE) {
+            DPRINTF(Drain, "Crossbar not drained\n");
+            return DrainState::Draining;
+        }
     }
+    return DrainState::Drained;
 }
 
 /**
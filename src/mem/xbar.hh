@@ -46,12 +46,14 @@
 #ifndef __MEM_XBAR_HH__
 #define __MEM_XBAR_HH__
 
-#include <deque>
+#include <memory>
 #include <unordered_map>
+#include <vector>
 
 #include "base/addr_range_map.hh"
 #include "base/types.hh"
 #include "mem/qport.hh"
+#include "mem/waiting_ports.hh"
 #include "params/BaseXBar.hh"
 #include "sim/clocked_object.hh"
 #include "sim/stats.hh"
@@ -86,6 +88,14 @@ class BaseXBar : public ClockedObject
      * or CPU-side ports, depending on the direction of the
      * layer. Thus, a request layer has a retry list containing
      * CPU-side ports, whereas a response layer holds memory-side ports.
+     *
+     * A layer can be split into a number of shards, interleaved on
+     * the packet address, each arbitrating and occupied on its own,
+     * thus modelling a banked interconnect where packets to different
+     * banks of the destination do not contend with each other. The
+     * shards share the flow control with the destination port, and
+     * when the destination asks for a retry none of the shards can
+     * send until it is received.
      */
     template <typename SrcType, typename DstType>
     class Layer : public Drainable, public statistics::Group
@@ -100,8 +110,10 @@ class BaseXBar : public ClockedObject
          * @param _port destination port the layer converges at
          * @param _xbar the crossbar this layer belongs to
          * @param _name the layer's name
+         * @param num_shards number of address-interleaved shards
          */
-        Layer(DstType& _port, BaseXBar& _xbar, const std::string& _name);
+        Layer(DstType& _port, BaseXBar& _xbar, const std::string& _name,
+              unsigned num_shards = 1);
 
         /**
          * Drain according to the normal semantics, so that the crossbar
@@ -124,10 +136,11 @@ class BaseXBar : public ClockedObject
          * updated accordingly.
          *
          * @param port Source port presenting the packet
+         * @param addr Address of the packet, selecting the shard
          *
          * @return True if the layer accepts the packet
          */
-        bool tryTiming(SrcType* src_port);
+        bool tryTiming(SrcType* src_port, Addr addr = 0);
 
         /**
          * Deal with a destination port accepting a packet by potentially
@@ -135,8 +148,9 @@ class BaseXBar : public ClockedObject
          * occupying the layer accordingly.
          *
          * @param busy_time Time to spend as a result of a successful send
+         * @param addr Address of the packet, selecting the shard
          */
-        void succeededTiming(Tick busy_time);
+        void succeededTiming(Tick busy_time, Addr addr = 0);
 
         /**
          * Deal with a destination port not accepting a packet by
@@ -146,16 +160,9 @@ class BaseXBar : public ClockedObject
          *
          * @param src_port Source port
          * @param busy_time Time to spend as a result of a failed send
+         * @param addr Address of the packet, selecting the shard
          */
-        void failedTiming(SrcType* src_port, Tick busy_time);
-
-        void occupyLayer(Tick until);
-
-        /**
-         * Send a retry to the port at the head of waitingForLayer. The
-         * caller must ensure that the list is not empty.
-         */
-        void retryWaiting();
+        void failedTiming(SrcType* src_port, Tick busy_time, Addr addr = 0);
 
         /**
          * Handle a retry from a neighbouring module. This wraps
@@ -202,34 +209,68 @@ class BaseXBar : public ClockedObject
          */
         enum State { IDLE, BUSY, RETRY };
 
-        State state;
-
         /**
-         * A deque of ports that retry should be called on because
-         * the original send was delayed due to a busy layer.
+         * The arbitration state of one shard of the layer. Without
+         * sharding, the layer has a single shard.
          */
-        std::deque<SrcType*> waitingForLayer;
+        struct Shard
+        {
+            Shard(Layer &layer);
+
+            State state;
+
+            /**
+             * The ports that retry should be called on because the
+             * original send was delayed due to a busy shard.
+             */
+            WaitingPorts<SrcType> waitingForLayer;
+
+            EventFunctionWrapper releaseEvent;
+        };
+
+        std::vector<std::unique_ptr<Shard>> shards;
+
+        /** Log2 of the address interleaving of the shards. */
+        const unsigned shardShift;
+
+        /** Get the shard arbitrating for the given address. */
+        Shard &
+        shardOf(Addr addr)
+        {
+            return *shards[(addr >> shardShift) % shards.size()];
+        }
 
         /**
          * Track who is waiting for the retry when receiving it from a
-         * peer. If no port is waiting NULL is stored.
+         * peer, and in which shard. If no port is waiting NULL is
+         * stored.
          */
         SrcType* waitingForPeer;
+        Shard* waitingForPeerShard;
+
+        void occupyLayer(Shard &shard, Tick until);
 
         /**
-         * Release the layer after being occupied and return to an
+         * Send a retry to the port at the head of the waiting ports of
+         * a shard. The caller must ensure that there is one.
+         */
+        void retryWaiting(Shard &shard);
+
+        /**
+         * Release a shard after being occupied and return to an
          * idle state where we proceed to send a retry to any
          * potential waiting port, or drain if asked to do so.
          */
-        void releaseLayer();
-        EventFunctionWrapper releaseEvent;
+        void releaseLayer(Shard &shard);
 
         /**
          * Stats for occupancy and utilization. These stats capture
          * the time the layer spends in the busy state and are thus only
-         * relevant when the memory system is in timing mode.
+         * relevant when the memory system is in timing mode. The
+         * occupancy is sharded per simulation thread, as the layer can
+         * be used by ports on different event queues.
          */
-        statistics::Scalar occupancy;
+        statistics::ShardedScalar occupancy;
         statistics::Formula utilization;
 
     };
@@ -246,7 +287,7 @@ class BaseXBar : public ClockedObject
          */
         ReqLayer(RequestPort& _port, BaseXBar& _xbar,
         const std::string& _name) :
-            Layer(_port, _xbar, _name)
+            Layer(_port, _xbar, _name, _xbar.reqLayerShards)
         {}
 
       protected:
@@ -316,6 +357,13 @@ class BaseXBar : public ClockedObject
     /** the width of the xbar in bytes */
     const uint32_t width;
 
+    /**
+     * Number of address-interleaved shards of each request layer, and
+     * the address interleaving granularity of the shards.
+     */
+    const unsigned reqLayerShards;
+    const unsigned layerShardShift;
+
     AddrRangeMap<PortID, 3> portMap;
 
     /**
@@ -397,11 +445,12 @@ class BaseXBar : public ClockedObject
      * size are two-dimensional vectors that are indexed by the
      * CPU-side port and memory-side port id (thus the neighbouring memory-side
      * ports and neighbouring CPU-side ports), summing up both directions
-     * (request and response).
+     * (request and response). They are sharded per simulation thread,
+     * as the ports of a crossbar may belong to different event queues.
      */
-    statistics::Vector transDist;
-    statistics::Vector2d pktCount;
-    statistics::Vector2d pktSize;
+    statistics::ShardedVector transDist;
+    statistics::ShardedVector2d pktCount;
+    statistics::ShardedVector2d pktSize;
 
   public:
 
@@ -116,11 +116,21 @@ def parse_options():
     option("--stats-help",
            action="callback", callback=_stats_help,
            help="Display documentation for available stat visitors")
+    option("--host-counters", action="store_true", default=False,
+        help="Count host cycles, instructions, cache misses and branch " \
+             "misses of the simulator in the statistics")
+    option("--host-event-profile", metavar="N", type='int', default=0,
+        help="Count the host events of one out of N simulation events, " \
+             "by event, in host_events.txt (implies --host-counters)")
 
     # Configuration Options
     group("Configuration Options")
     option("--dump-config", metavar="FILE", default="config.ini",
         help="Dump configuration output file [Default: %default]")
+    option("--binary-config", metavar="FILE", default=None,
+        help="Also dump the configuration in a binary form that C++ " \
+             "configured gem5 can instantiate without Python " \
+             "[Default: %default]")
     option("--json-config", metavar="FILE", default="config.json",
         help="Create JSON output of the configuration [Default: %default]")
     option("--dot-config", metavar="FILE", default="config.dot",
@@ -128,6 +138,12 @@ def parse_options():
     option("--dot-dvfs-config", metavar="FILE", default=None,
         help="Create DOT & pdf outputs of the DVFS configuration" + \
              " [Default: %default]")
+    option("--startup-threads", metavar="N", type='int', default=1,
+        help="Use N host threads to initialize the SimObjects that " \
+             "support it [Default: %default]")
+    option("--startup-breakdown", action="store_true", default=False,
+        help="Print the host time spent in each phase of the " \
+             "instantiation of the simulated system")
 
     # Debugging options
     group("Debugging Options")
@@ -144,6 +160,12 @@ def parse_options():
         help="End debug output at TICK")
     option("--debug-file", metavar="FILE", default="cout",
         help="Sets the output file for debug [Default: %default]")
+    option("--debug-binary", action="store_true", default=False,
+        help="Record debug output in a binary trace, which is much faster " \
+             "to write, to be decoded by decode_debug_trace")
+    option("--debug-flight-recorder", metavar="SIZE",
+        help="Keep the last SIZE bytes of debug output in memory, and " \
+             "only write them on a panic, a fatal error or an exit event")
     option("--debug-ignore", metavar="EXPR", action='append', split=':',
         help="Ignore EXPR sim objects")
     option("--remote-gdb-port", type='int', default=7000,
@@ -222,6 +244,7 @@ def main(*args):
     from . import stats
     from . import trace
 
+    from .util import convert
     from .util import inform, fatal, panic, isInteractive
     from m5.util.terminal_formatter import TerminalFormatter
 
@@ -417,12 +440,31 @@ def main(*args):
         e = event.create(trace.disable, event.Event.Debug_Enable_Pri)
         event.mainq.schedule(e, options.debug_end)
 
-    trace.output(options.debug_file)
+    if options.debug_flight_recorder:
+        debug_file = options.debug_file
+        if debug_file in ('cout', 'cerr'):
+            debug_file = 'flight_recorder.bin' if options.debug_binary \
+                else 'flight_recorder.txt'
+        trace.flightRecorder(debug_file,
+            convert.toMemorySize(options.debug_flight_recorder))
+    elif options.debug_binary:
+        debug_file = options.debug_file
+        if debug_file in ('cout', 'cerr'):
+            debug_file = 'trace.bin'
+        trace.binaryOutput(debug_file)
+    else:
+        trace.output(options.debug_file)
 
     for ignore in options.debug_ignore:
         _check_tracing()
         trace.ignore(ignore)
 
+    if options.host_counters or options.host_event_profile:
+        import _m5.core
+        if _m5.core.enableHostCounters() and options.host_event_profile:
+            _m5.core.profileHostEvents(options.host_event_profile,
+                                       "host_events.txt")
+
     sys.argv = arguments
     sys.path = [ os.path.dirname(sys.argv[0]) ] + sys.path
 
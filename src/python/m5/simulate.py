@@ -40,6 +40,7 @@
 import atexit
 import os
 import sys
+import time
 
 # import the wrapped C++ functions
 import _m5.drain
@@ -67,6 +68,58 @@ _memory_modes = {
 
 _drain_manager = _m5.drain.DrainManager.instance()
 
+# Host time spent in each phase of the instantiation of the simulated
+# system, as a list of (phase, seconds) in the order of the phases
+_startup_phases = []
+_phase_start = None
+
+def _phase(name):
+    """Record the host time spent since the end of the previous phase
+    of the instantiation as the time taken by the given phase."""
+    global _phase_start
+    now = time.perf_counter()
+    _startup_phases.append((name, now - _phase_start))
+    _phase_start = now
+
+def _printStartupBreakdown():
+    total = sum(seconds for name, seconds in _startup_phases)
+    print("Startup time breakdown:")
+    for name, seconds in _startup_phases:
+        print("  %-24s %9.3fs %5.1f%%" %
+              (name, seconds, 100.0 * seconds / total if total else 0.0))
+    print("  %-24s %9.3fs" % ("total", total))
+
+def _overridden(cls, method):
+    """Check if a SimObject class overrides a method in Python."""
+    for base in cls.__mro__:
+        if base is SimObject.SimObject:
+            return False
+        if method in base.__dict__:
+            return True
+    return False
+
+def _callAll(objs, method, call_all, *args):
+    """Call a method on a list of SimObjects, in order.
+
+    Runs of objects that do not override the method in Python are
+    handed to call_all(), which calls the C++ method on all of them at
+    once rather than going through Python for every object.
+    """
+    cc_class = SimObject.SimObject.getCCClass()
+    run = []
+    for obj in objs:
+        cc_obj = obj.getCCObject()
+        if not _overridden(type(obj), method) and \
+                isinstance(cc_obj, cc_class):
+            run.append(cc_obj)
+            continue
+        if run:
+            call_all(run, *args)
+            run = []
+        getattr(obj, method)(*args)
+    if run:
+        call_all(run, *args)
+
 # The final hook to generate .ini files.  Called from the user script
 # once the config is built.
 def instantiate(ckpt_dir=None):
@@ -77,6 +130,9 @@ def instantiate(ckpt_dir=None):
     if not root:
         fatal("Need to instantiate Root() before calling instantiate()")
 
+    global _phase_start
+    _phase_start = time.perf_counter()
+
     # we need to fix the global frequency
     ticks.fixGlobalFrequency()
 
@@ -84,16 +140,30 @@ def instantiate(ckpt_dir=None):
     # hierarchy so we catch them with future descendants() walks
     for obj in root.descendants(): obj.adoptOrphanParams()
 
+    # The hierarchy is complete, so walk it only once from now on
+    descendants = list(root.descendants())
+
     # Unproxy in sorted order for determinism
-    for obj in root.descendants(): obj.unproxyParams()
+    for obj in descendants: obj.unproxyParams()
+    _phase("unproxy params")
 
     if options.dump_config:
-        ini_file = open(os.path.join(options.outdir, options.dump_config), 'w')
+        ini_path = os.path.join(options.outdir, options.dump_config)
+        ini_file = open(ini_path, 'w')
         # Print ini sections in sorted order for easier diffing
-        for obj in sorted(root.descendants(), key=lambda o: o.path()):
+        for obj in sorted(descendants, key=lambda o: o.path()):
             obj.print_ini(ini_file)
         ini_file.close()
 
+        # The binary form of the elaborated configuration can be
+        # instantiated again without Python, see util/cxx_config
+        if options.binary_config:
+            bin_path = os.path.join(options.outdir, options.binary_config)
+            if not _m5.core.writeBinaryConfig(ini_path, bin_path):
+                fatal("Failed to write binary config %s" % bin_path)
+    elif options.binary_config:
+        fatal("--binary-config requires --dump-config")
+
     if options.json_config:
         try:
             import json
@@ -108,26 +178,34 @@ def instantiate(ckpt_dir=None):
     if options.dot_config:
         do_dot(root, options.outdir, options.dot_config)
         do_ruby_dot(root, options.outdir, options.dot_config)
+    _phase("dump config")
 
     # Initialize the global statistics
     stats.initSimStats()
 
     # Create the C++ sim objects and connect ports
-    for obj in root.descendants(): obj.createCCObject()
-    for obj in root.descendants(): obj.connectPorts()
+    for obj in descendants: obj.createCCObject()
+    _phase("create objects")
+    for obj in descendants: obj.connectPorts()
+    _phase("connect ports")
 
     # Do a second pass to finish initializing the sim objects
-    for obj in root.descendants(): obj.init()
+    _callAll(descendants, "init", _m5.core.initAll, options.startup_threads)
+    _phase("init")
 
-    # Do a third pass to initialize statistics
+    # Do a third pass to initialize statistics. The stat names are
+    # registered globally, so this is always done in order.
     stats._bindStatHierarchy(root)
     root.regStats()
+    _phase("register stats")
 
     # Do a fourth pass to initialize probe points
-    for obj in root.descendants(): obj.regProbePoints()
+    _callAll(descendants, "regProbePoints", _m5.core.regProbePointsAll)
 
     # Do a fifth pass to connect probe listeners
-    for obj in root.descendants(): obj.regProbeListeners()
+    _callAll(descendants, "regProbeListeners",
+             _m5.core.regProbeListenersAll)
+    _phase("register probes")
 
     # We want to generate the DVFS diagram for the system. This can only be
     # done once all of the CPP objects have been created and initialised so
@@ -138,13 +216,17 @@ def instantiate(ckpt_dir=None):
     # We're done registering statistics.  Enable the stats package now.
     stats.enable()
 
-    # Restore checkpoint (if any)
+    # Restore checkpoint (if any). Checkpoint sections are tracked
+    # globally while unserializing, so objects are restored in order.
     if ckpt_dir:
         _drain_manager.preCheckpointRestore()
         ckpt = _m5.core.getCheckpoint(ckpt_dir)
-        for obj in root.descendants(): obj.loadState(ckpt)
+        _callAll(descendants, "loadState", _m5.core.loadStateAll, ckpt)
+        _phase("load checkpoint")
     else:
-        for obj in root.descendants(): obj.initState()
+        _callAll(descendants, "initState", _m5.core.initStateAll,
+                 options.startup_threads)
+        _phase("init state")
 
     # Check to see if any of the stat events are in the past after resuming from
     # a checkpoint, If so, this call will shift them to be at a valid time.
@@ -155,10 +237,18 @@ def simulate(*args, **kwargs):
     global need_startup
 
     if need_startup:
+        from m5 import options
+
+        global _phase_start
+        _phase_start = time.perf_counter()
         root = objects.Root.getInstance()
-        for obj in root.descendants(): obj.startup()
+        _callAll(list(root.descendants()), "startup", _m5.core.startupAll)
+        _phase("startup")
         need_startup = False
 
+        if options.startup_breakdown:
+            _printStartupBreakdown()
+
         # Python exit handlers happen in reverse order.
         # We want to dump stats last.
         atexit.register(stats.dump)
@@ -225,6 +315,28 @@ def memInvalidate(root):
     for obj in root.descendants():
         obj.memInvalidate()
 
+def memBypass(root):
+    """Invalidate the memory system before the caches are bypassed.
+
+    Caches warmed while bypassed keep their tags instead, see
+    memResync(). Dirty blocks have to be written back first.
+    """
+    for obj in root.descendants():
+        if isinstance(obj, objects.BaseCache):
+            obj.demoteBlocks()
+        else:
+            obj.memInvalidate()
+
+def memResync(root):
+    """Refill the blocks of caches warmed while bypassed.
+
+    This has to be called with the system drained and in the 'atomic'
+    memory mode, after leaving the 'atomic_noncaching' mode.
+    """
+    for obj in root.descendants():
+        if isinstance(obj, objects.BaseCache):
+            obj.resyncWarmedBlocks()
+
 def checkpoint(dir):
     root = objects.Root.getInstance()
     if not isinstance(root, objects.Root):
@@ -311,13 +423,50 @@ def switchCpus(system, cpuList, verbose=True):
         # hardware virtualized CPU.
         if memory_mode == objects.params.atomic_noncaching:
             memWriteback(system)
-            memInvalidate(system)
+            memBypass(system)
+        elif system.getMemoryMode() == objects.params.atomic_noncaching:
+            # Caches that kept their tags warm while bypassed refill
+            # their blocks with atomic reads, so pass through the
+            # atomic mode before entering any other mode.
+            _changeMemoryMode(system, objects.params.atomic)
+            memResync(system)
 
-        _changeMemoryMode(system, memory_mode)
+        if system.getMemoryMode() != memory_mode:
+            _changeMemoryMode(system, memory_mode)
 
     for old_cpu, new_cpu in cpuList:
         new_cpu.takeOverFrom(old_cpu)
 
+def switchMemCtrlMode(ctrls, fast, verbose=True):
+    """Switch memory controllers between detailed and fast timing.
+
+    In the fast mode the controllers service requests with an average
+    latency calibrated from the most recent detailed window, bypassing
+    the media specific bank and refresh state machines. The bank and
+    refresh state is resynchronised when switching back to the
+    detailed mode.
+
+    Arguments:
+      ctrls -- List of MemCtrl objects to switch
+      fast -- True to switch to the fast mode, False for detailed
+    """
+
+    if verbose:
+        print("switching memory controllers to %s mode" %
+              ("fast" if fast else "detailed"))
+
+    if not isinstance(ctrls, list):
+        raise RuntimeError("Must pass a list to this function")
+    for ctrl in ctrls:
+        if not isinstance(ctrl, objects.MemCtrl):
+            raise TypeError("%s is not of type MemCtrl" % ctrl)
+
+    drain()
+
+    # The new mode is applied when the controllers resume
+    for ctrl in ctrls:
+        ctrl.setFastMode(fast)
+
 def notifyFork(root):
     for obj in root.descendants():
         obj.notifyFork()
@@ -183,6 +183,27 @@ def _hdf5Factory(fn, chunking=10, desc=True, formulas=True):
 
     return _m5.stats.initHDF5(fn, chunking, desc, formulas)
 
+@_url_factory([ "binary", ])
+def _binaryFactory(fn):
+    """Output stats in a delta-encoded binary format.
+
+    Binary stat files are meant for time series with many dumps. The
+    names, units and shapes of the stats are written once, and each
+    dump only stores the values that changed since the previous one,
+    which keeps both the dumps and the files small. The files can be
+    read using util/decode_binary_stats.py.
+
+    Known limitations:
+      * Sparse histograms are not supported.
+      * Only stats enabled for display are written.
+
+    Example:
+      binary://stats.bin
+
+    """
+
+    return _m5.stats.initBinary(fn)
+
 @_url_factory(["json"])
 def _jsonFactory(fn):
     """Output stats in JSON format.
@@ -225,6 +246,9 @@ def addStatVisitor(url):
 
     outputList.append(factory(parsed))
 
+    if _m5.stats.enabled():
+        _updateNativeDump()
+
 def printStatVisitorTypes():
     """List available stat visitors and their documentation"""
 
@@ -324,6 +348,24 @@ def enable():
 
     _m5.stats.enable();
 
+    _updateNativeDump()
+
+def _updateNativeDump():
+    '''Dump the statistics from C++ if all the outputs are implemented in
+    C++ and the whole hierarchy is dumped. The C++ dump flattens the
+    statistics tree once rather than walking it from Python on every
+    dump, which makes frequent periodic dumps considerably cheaper.'''
+
+    native = outputList and not global_dump_roots and \
+        all(isinstance(output, _m5.stats.Output) for output in outputList)
+
+    if native:
+        _m5.stats.enableNativeDump(outputList)
+        _m5.stats.registerNativeStatsHandlers()
+    else:
+        _m5.stats.disableNativeDump()
+        _m5.stats.registerPythonStatsHandlers()
+
 def prepare():
     '''Prepare all stats for data access.  This must be done before
     dumping and serialization.'''
@@ -361,8 +403,8 @@ def _dump_to_visitor(visitor, roots=None):
         for stat in stats_list:
             stat.visit(visitor)
 
-lastDump = 0
-# List[SimObject].
+# List[SimObject]. The roots must be set before the statistics are
+# enabled.
 global_dump_roots = []
 
 def dump(roots=None):
@@ -374,11 +416,11 @@ def dump(roots=None):
     global global_dump_roots
     all_roots.extend(global_dump_roots)
 
-    now = m5.curTick()
-    global lastDump
-    assert lastDump <= now
-    new_dump = lastDump != now
-    lastDump = now
+    if not all_roots and _m5.stats.nativeDumpEnabled():
+        _m5.stats.nativeDump()
+        return
+
+    new_dump = _m5.stats.markDump()
 
     # Don't allow multiple global stat dumps in the same tick. It's
     # still possible to dump a multiple sub-trees.
@@ -25,4 +25,5 @@
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 # Export native methods to Python
-from _m5.trace import output, ignore, disable, enable
+from _m5.trace import output, binaryOutput, flightRecorder, ignore, \
+    disable, enable
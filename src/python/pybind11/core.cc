@@ -50,13 +50,16 @@
 #include "base/inet.hh"
 #include "base/loader/elf_object.hh"
 #include "base/logging.hh"
+#include "base/output.hh"
 #include "base/random.hh"
 #include "base/socket.hh"
 #include "base/temperature.hh"
 #include "base/types.hh"
 #include "sim/core.hh"
 #include "sim/cur_tick.hh"
+#include "sim/cxx_config_binary.hh"
 #include "sim/drain.hh"
+#include "sim/host_counters.hh"
 #include "sim/serialize.hh"
 #include "sim/sim_object.hh"
 
@@ -319,6 +322,56 @@ pybind_init_core(py::module_ &m_native)
 
         ;
 
+    /*
+     * Host event counters
+     */
+    m_core
+        .def("enableHostCounters", &HostCounters::enable)
+        .def("profileHostEvents", [](unsigned period,
+                                     const std::string &filename) {
+            HostCounters::profileEvents(period);
+            registerExitCallback([filename]() {
+                OutputStream *os = simout.create(filename);
+                HostCounters::dumpEventProfile(*os->stream());
+                simout.close(os);
+            });
+        })
+        ;
+
+    /*
+     * Configuration helpers
+     */
+    m_core
+        .def("writeBinaryConfig", &CxxBinaryConfigFile::convertIni)
+        ;
+
+    /*
+     * Instantiation helpers, calling a method on a list of objects in a
+     * single call from Python
+     */
+    m_core
+        .def("initAll", &SimObject::initAll)
+        .def("initStateAll", &SimObject::initStateAll)
+        .def("loadStateAll", [](const std::vector<SimObject *> &objs,
+                                CheckpointIn *cp) {
+            for (auto *obj : objs)
+                obj->loadState(*cp);
+        })
+        .def("regProbePointsAll", [](const std::vector<SimObject *> &objs) {
+            for (auto *obj : objs)
+                obj->regProbePoints();
+        })
+        .def("regProbeListenersAll",
+             [](const std::vector<SimObject *> &objs) {
+            for (auto *obj : objs)
+                obj->regProbeListeners();
+        })
+        .def("startupAll", [](const std::vector<SimObject *> &objs) {
+            for (auto *obj : objs)
+                obj->startup();
+        })
+        ;
+
 
     init_drain(m_native);
     init_serialize(m_native);
@@ -45,10 +45,14 @@
 #include <map>
 #include <vector>
 
+#include "base/binary_logger.hh"
 #include "base/compiler.hh"
 #include "base/debug.hh"
+#include "base/flight_recorder.hh"
+#include "base/logging.hh"
 #include "base/output.hh"
 #include "base/trace.hh"
+#include "sim/core.hh"
 #include "sim/debug.hh"
 
 namespace py = pybind11;
@@ -73,6 +77,30 @@ output(const char *filename)
     Trace::setDebugLogger(new Trace::OstreamLogger(*file_stream->stream()));
 }
 
+static void
+binaryOutput(const char *filename)
+{
+    // The decoder seeks in the trace, so it is never compressed
+    OutputStream *file_stream = simout.create(filename, true, true);
+
+    auto *logger = new Trace::BinaryLogger(*file_stream->stream());
+    Trace::setDebugLogger(logger);
+
+    registerExitCallback([logger]() { logger->close(); });
+}
+
+static void
+flightRecorder(const char *filename, size_t capacity)
+{
+    auto *recorder = new Trace::FlightRecorder(simout.resolve(filename),
+                                               capacity);
+    Trace::setDebugLogger(recorder);
+
+    Logger::addExitHook([recorder]() {
+        recorder->dumpFile("panic or fatal error");
+    });
+}
+
 static void
 ignore(const char *expr)
 {
@@ -127,6 +155,8 @@ pybind_init_debug(py::module_ &m_native)
     py::module_ m_trace = m_native.def_submodule("trace");
     m_trace
         .def("output", &output)
+        .def("binaryOutput", &binaryOutput)
+        .def("flightRecorder", &flightRecorder)
         .def("ignore", &ignore)
         .def("enable", &Trace::enable)
         .def("disable", &Trace::disable)
@@ -42,6 +42,7 @@
 #include "pybind11/stl.h"
 
 #include "base/statistics.hh"
+#include "base/stats/binary.hh"
 #include "base/stats/text.hh"
 #include "config/have_hdf5.hh"
 
@@ -115,8 +116,16 @@ pybind_init_stats(py::module_ &m_native)
 #if HAVE_HDF5
         .def("initHDF5", &statistics::initHDF5)
 #endif
+        .def("initBinary", &statistics::initBinary)
         .def("registerPythonStatsHandlers",
              &statistics::registerPythonStatsHandlers)
+        .def("registerNativeStatsHandlers",
+             &statistics::registerNativeStatsHandlers)
+        .def("enableNativeDump", &statistics::enableNativeDump)
+        .def("disableNativeDump", &statistics::disableNativeDump)
+        .def("nativeDumpEnabled", &statistics::nativeDumpEnabled)
+        .def("nativeDump", &statistics::nativeDump)
+        .def("markDump", &statistics::markDump)
         .def("schedStatEvent", &statistics::schedStatEvent)
         .def("periodicStatDump", &statistics::periodicStatDump)
         .def("updateEvents", &statistics::updateEvents)
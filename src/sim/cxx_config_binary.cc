@@ -0,0 +1,290 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/cxx_config_binary.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <utility>
+
+#include "base/inifile.hh"
+#include "base/str.hh"
+
+namespace gem5
+{
+
+namespace
+{
+
+const char magic[8] = { 'g', 'e', 'm', '5', 'C', 'F', 'G', '\0' };
+
+void
+putWord(std::string &out, uint32_t word)
+{
+    for (int i = 0; i < 4; i++)
+        out.push_back((char)(word >> (8 * i)));
+}
+
+/** Bounds checked reader of the contents of a binary file */
+class Reader
+{
+  private:
+    const std::string &data;
+    size_t pos;
+    bool ok;
+
+  public:
+    Reader(const std::string &_data, size_t _pos)
+        : data(_data), pos(_pos), ok(true)
+    {}
+
+    bool good() const { return ok; }
+
+    uint32_t
+    word()
+    {
+        if (!ok || data.size() - pos < 4) {
+            ok = false;
+            return 0;
+        }
+        uint32_t word = 0;
+        for (int i = 0; i < 4; i++)
+            word |= (uint32_t)(uint8_t)data[pos++] << (8 * i);
+        return word;
+    }
+
+    std::string
+    string(uint32_t size)
+    {
+        if (!ok || data.size() - pos < size) {
+            ok = false;
+            return "";
+        }
+        pos += size;
+        return data.substr(pos - size, size);
+    }
+};
+
+} // anonymous namespace
+
+const std::string *
+CxxBinaryConfigFile::find(const std::string &object_name,
+    const std::string &entry_name) const
+{
+    auto object = objects.find(object_name);
+    if (object == objects.end())
+        return nullptr;
+
+    auto entry = object->second.find(entry_name);
+    if (entry == object->second.end())
+        return nullptr;
+
+    return &strings[entry->second];
+}
+
+bool
+CxxBinaryConfigFile::getParam(const std::string &object_name,
+    const std::string &param_name,
+    std::string &value) const
+{
+    const std::string *found = find(object_name, param_name);
+    if (found)
+        value = *found;
+    return found != nullptr;
+}
+
+bool
+CxxBinaryConfigFile::getParamVector(const std::string &object_name,
+    const std::string &param_name,
+    std::vector<std::string> &values) const
+{
+    const std::string *found = find(object_name, param_name);
+    if (found)
+        tokenize(values, *found, ' ', true);
+    return found != nullptr;
+}
+
+bool
+CxxBinaryConfigFile::getPortPeers(const std::string &object_name,
+    const std::string &port_name,
+    std::vector<std::string> &peers) const
+{
+    return getParamVector(object_name, port_name, peers);
+}
+
+bool
+CxxBinaryConfigFile::objectExists(const std::string &object) const
+{
+    return objects.find(object) != objects.end();
+}
+
+void
+CxxBinaryConfigFile::getAllObjectNames(std::vector<std::string> &list) const
+{
+    list.insert(list.end(), objectNames.begin(), objectNames.end());
+}
+
+void
+CxxBinaryConfigFile::getObjectChildren(const std::string &object_name,
+    std::vector<std::string> &children, bool return_paths) const
+{
+    if (!getParamVector(object_name, "children", children))
+        return;
+
+    if (return_paths && object_name != "root") {
+        for (auto i = children.begin(); i != children.end(); ++i)
+            *i = object_name + "." + *i;
+    }
+}
+
+bool
+CxxBinaryConfigFile::load(const std::string &filename)
+{
+    std::ifstream file(filename, std::ios::binary);
+    if (!file)
+        return false;
+
+    const std::string data((std::istreambuf_iterator<char>(file)),
+        std::istreambuf_iterator<char>());
+
+    if (data.size() < sizeof(magic) ||
+        data.compare(0, sizeof(magic), magic, sizeof(magic)) != 0) {
+        return false;
+    }
+
+    Reader reader(data, sizeof(magic));
+    if (reader.word() != version)
+        return false;
+
+    std::vector<std::string> new_strings(reader.word());
+    for (auto &string : new_strings) {
+        string = reader.string(reader.word());
+        if (!reader.good())
+            return false;
+    }
+
+    std::unordered_map<std::string, Entries> new_objects;
+    std::vector<std::string> new_names;
+    for (uint32_t num_objects = reader.word(); reader.good() && num_objects;
+         num_objects--) {
+        const uint32_t name = reader.word();
+        uint32_t num_entries = reader.word();
+        if (!reader.good() || name >= new_strings.size())
+            return false;
+
+        Entries &entries = new_objects[new_strings[name]];
+        new_names.push_back(new_strings[name]);
+        for (; num_entries; num_entries--) {
+            const uint32_t key = reader.word();
+            const uint32_t value = reader.word();
+            if (!reader.good() || key >= new_strings.size() ||
+                value >= new_strings.size()) {
+                return false;
+            }
+            entries[new_strings[key]] = value;
+        }
+    }
+
+    if (!reader.good())
+        return false;
+
+    strings = std::move(new_strings);
+    objects = std::move(new_objects);
+    objectNames = std::move(new_names);
+
+    return true;
+}
+
+bool
+CxxBinaryConfigFile::isBinaryConfig(const std::string &filename)
+{
+    std::ifstream file(filename, std::ios::binary);
+    char header[sizeof(magic)];
+
+    return file.read(header, sizeof(header)) &&
+        std::memcmp(header, magic, sizeof(magic)) == 0;
+}
+
+bool
+CxxBinaryConfigFile::write(IniFile &ini, const std::string &filename)
+{
+    std::unordered_map<std::string, uint32_t> string_ids;
+    std::string strings_out;
+    auto intern = [&](const std::string &string) {
+        auto inserted = string_ids.emplace(string, string_ids.size());
+        if (inserted.second) {
+            putWord(strings_out, string.size());
+            strings_out += string;
+        }
+        return inserted.first->second;
+    };
+
+    // Sort the objects and their entries so that the same
+    // configuration always gives the same file
+    std::vector<std::string> sections;
+    ini.getSectionNames(sections);
+    std::sort(sections.begin(), sections.end());
+
+    std::string objects_out;
+    putWord(objects_out, sections.size());
+    for (const auto &section : sections) {
+        std::vector<std::pair<std::string, std::string>> entries;
+        ini.visitSection(section,
+            [&entries](const std::string &key, const std::string &value) {
+                entries.emplace_back(key, value);
+            });
+        std::sort(entries.begin(), entries.end());
+
+        putWord(objects_out, intern(section));
+        putWord(objects_out, entries.size());
+        for (const auto &entry : entries) {
+            putWord(objects_out, intern(entry.first));
+            putWord(objects_out, intern(entry.second));
+        }
+    }
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file)
+        return false;
+
+    std::string header(magic, sizeof(magic));
+    putWord(header, version);
+    putWord(header, string_ids.size());
+
+    file << header << strings_out << objects_out;
+    return (bool)file.flush();
+}
+
+bool
+CxxBinaryConfigFile::convertIni(const std::string &ini_filename,
+    const std::string &filename)
+{
+    IniFile ini;
+    return ini.load(ini_filename) && write(ini, filename);
+}
+
+} // namespace gem5
@@ -0,0 +1,128 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *
+ *  Binary configuration file reading and writing for use with
+ *  CxxConfigManager
+ */
+
+#ifndef __SIM_CXX_CONFIG_BINARY_HH__
+#define __SIM_CXX_CONFIG_BINARY_HH__
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "sim/cxx_config.hh"
+
+namespace gem5
+{
+
+class IniFile;
+
+/** CxxConfigManager interface for using binary configuration files.
+ *
+ *  A binary configuration holds the same objects, parameters and port
+ *  connections as the config.ini written from an elaborated Python
+ *  configuration, with all the strings stored once in a table. It is
+ *  loaded with a single read and no parsing, so that a C++ configured
+ *  gem5 can instantiate the same system many times, with only a few
+ *  parameters overridden through the CxxConfigManager, without running
+ *  the Python configuration scripts again.
+ *
+ *  The file is laid out as follows, with all the integers stored as
+ *  32 bit little endian values:
+ *
+ *  - The magic "gem5CFG\0" and the format version.
+ *  - The number of strings, followed by the length and characters of
+ *    each string.
+ *  - The number of objects, followed by the name of each object, its
+ *    number of entries, and the name and value of each entry, all
+ *    given as indices in the table of strings. */
+class CxxBinaryConfigFile : public CxxConfigFileBase
+{
+  public:
+    /** Version of the file format */
+    static const uint32_t version = 1;
+
+  protected:
+    /** All the strings of the configuration, each stored once */
+    std::vector<std::string> strings;
+
+    /** Entry name to index of its value in the table of strings */
+    typedef std::unordered_map<std::string, uint32_t> Entries;
+
+    /** Object name to its entries */
+    std::unordered_map<std::string, Entries> objects;
+
+    /** Names of the objects, in file order */
+    std::vector<std::string> objectNames;
+
+    /** Find the value of an entry, or return nullptr */
+    const std::string *find(const std::string &object_name,
+        const std::string &entry_name) const;
+
+  public:
+    CxxBinaryConfigFile() { }
+
+    bool getParam(const std::string &object_name,
+        const std::string &param_name,
+        std::string &value) const;
+
+    bool getParamVector(const std::string &object_name,
+        const std::string &param_name,
+        std::vector<std::string> &values) const;
+
+    bool getPortPeers(const std::string &object_name,
+        const std::string &port_name,
+        std::vector<std::string> &peers) const;
+
+    bool objectExists(const std::string &object_name) const;
+
+    void getAllObjectNames(std::vector<std::string> &list) const;
+
+    void getObjectChildren(const std::string &object_name,
+        std::vector<std::string> &children,
+        bool return_paths = false) const;
+
+    bool load(const std::string &filename);
+
+    /** Is the named file a binary configuration file? */
+    static bool isBinaryConfig(const std::string &filename);
+
+    /** Write the contents of a .ini file as a binary configuration */
+    static bool write(IniFile &ini, const std::string &filename);
+
+    /** Convert a .ini configuration file to a binary one */
+    static bool convertIni(const std::string &ini_filename,
+        const std::string &filename);
+};
+
+} // namespace gem5
+
+#endif // __SIM_CXX_CONFIG_BINARY_HH__
@@ -0,0 +1,142 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "base/inifile.hh"
+#include "sim/cxx_config_binary.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+const char *config = R"ini_file(
+[root]
+type=Root
+children=system
+eventq_index=0
+
+[system]
+type=System
+children=cpu membus
+boot_osflags=a  b c
+mem_ranges=0:536870911
+
+[system.cpu]
+type=AtomicSimpleCPU
+icache_port=system.membus.cpu_side_ports[0]
+dcache_port=system.membus.cpu_side_ports[1]
+
+[system.membus]
+type=SystemXBar
+cpu_side_ports=system.cpu.icache_port system.cpu.dcache_port
+)ini_file";
+
+class CxxBinaryConfigFileTest : public testing::Test
+{
+  protected:
+    std::string iniName = "cxx_config_binary_test.ini";
+    std::string binName = "cxx_config_binary_test.bin";
+
+    void
+    SetUp() override
+    {
+        std::ofstream(iniName) << config;
+    }
+
+    void
+    TearDown() override
+    {
+        std::remove(iniName.c_str());
+        std::remove(binName.c_str());
+    }
+};
+
+} // anonymous namespace
+
+TEST_F(CxxBinaryConfigFileTest, RoundTrip)
+{
+    ASSERT_TRUE(CxxBinaryConfigFile::convertIni(iniName, binName));
+    EXPECT_TRUE(CxxBinaryConfigFile::isBinaryConfig(binName));
+    EXPECT_FALSE(CxxBinaryConfigFile::isBinaryConfig(iniName));
+
+    CxxBinaryConfigFile conf;
+    ASSERT_TRUE(conf.load(binName));
+
+    std::vector<std::string> names;
+    conf.getAllObjectNames(names);
+    EXPECT_EQ(names, std::vector<std::string>(
+        {"root", "system", "system.cpu", "system.membus"}));
+
+    std::string value;
+    EXPECT_TRUE(conf.getParam("system.cpu", "type", value));
+    EXPECT_EQ(value, "AtomicSimpleCPU");
+    EXPECT_TRUE(conf.getParam("system", "boot_osflags", value));
+    EXPECT_EQ(value, "a  b c");
+    EXPECT_FALSE(conf.getParam("system", "missing", value));
+    EXPECT_FALSE(conf.getParam("missing", "type", value));
+
+    std::vector<std::string> peers;
+    EXPECT_TRUE(conf.getPortPeers("system.membus", "cpu_side_ports", peers));
+    EXPECT_EQ(peers, std::vector<std::string>(
+        {"system.cpu.icache_port", "system.cpu.dcache_port"}));
+
+    EXPECT_TRUE(conf.objectExists("system.membus"));
+    EXPECT_FALSE(conf.objectExists("system.l2"));
+
+    std::vector<std::string> children;
+    conf.getObjectChildren("system", children, true);
+    EXPECT_EQ(children, std::vector<std::string>(
+        {"system.cpu", "system.membus"}));
+}
+
+TEST_F(CxxBinaryConfigFileTest, RejectsOtherFiles)
+{
+    CxxBinaryConfigFile conf;
+    EXPECT_FALSE(conf.load(iniName));
+    EXPECT_FALSE(conf.load("cxx_config_binary_test.missing"));
+}
+
+TEST_F(CxxBinaryConfigFileTest, RejectsTruncatedFiles)
+{
+    ASSERT_TRUE(CxxBinaryConfigFile::convertIni(iniName, binName));
+
+    std::ifstream file(binName, std::ios::binary);
+    std::string data((std::istreambuf_iterator<char>(file)),
+        std::istreambuf_iterator<char>());
+    file.close();
+
+    std::ofstream(binName, std::ios::binary | std::ios::trunc)
+        << data.substr(0, data.size() - 1);
+
+    CxxBinaryConfigFile conf;
+    EXPECT_FALSE(conf.load(binName));
+}
@@ -41,6 +41,7 @@
 #include "base/trace.hh"
 #include "cpu/smt.hh"
 #include "debug/Checkpoint.hh"
+#include "sim/host_counters.hh"
 
 namespace gem5
 {
@@ -220,7 +221,10 @@ EventQueue::serviceOne()
         setCurTick(event->when());
         if (debug::Event)
             event->trace("executed");
-        event->process();
+        if (HostCounters::sampleEvent())
+            HostCounters::processProfiled(event);
+        else
+            event->process();
         if (event->isExitEvent()) {
             assert(!event->flags.isSet(Event::Managed) ||
                    !event->flags.isSet(Event::IsMainQueue)); // would be silly
@@ -0,0 +1,216 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/host_counters.hh"
+
+#include <algorithm>
+#include <cerrno>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "base/cprintf.hh"
+#include "base/logging.hh"
+#include "config/have_perf_event.hh"
+#include "sim/eventq.hh"
+
+#if HAVE_PERF_EVENT
+#include "base/perf_event.hh"
+#endif
+
+namespace gem5
+{
+
+__thread unsigned HostCounters::countdown = 0;
+
+namespace
+{
+
+const char *counterNames[HostCounters::NumCounters] = {
+    "cycles", "instructions", "cache misses", "branch misses"
+};
+
+#if HAVE_PERF_EVENT
+const uint64_t counterConfigs[HostCounters::NumCounters] = {
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_MISSES,
+    PERF_COUNT_HW_BRANCH_MISSES,
+};
+
+PerfCounter counters[HostCounters::NumCounters];
+#endif
+
+/** Host events counted while processing the samples of an event. */
+struct EventProfile
+{
+    uint64_t samples = 0;
+    uint64_t counts[HostCounters::NumCounters] = {};
+};
+
+/** Profiles of the simulation events, by name. */
+std::unordered_map<std::string, EventProfile> eventProfiles;
+
+/** Sampling period of the profiled simulation events. */
+unsigned profilePeriod = 0;
+
+/**
+ * Host events counted by reading the counters around no work at all,
+ * which are subtracted from the samples.
+ */
+uint64_t readOverhead[HostCounters::NumCounters] = {};
+
+void
+readAll(uint64_t (&values)[HostCounters::NumCounters])
+{
+    for (int c = 0; c < HostCounters::NumCounters; c++)
+        values[c] = HostCounters::read((HostCounters::Counter)c);
+}
+
+} // anonymous namespace
+
+bool
+HostCounters::enable()
+{
+#if HAVE_PERF_EVENT
+    if (enabled())
+        return true;
+
+    for (int c = 0; c < NumCounters; c++) {
+        PerfCounterConfig config(PERF_TYPE_HARDWARE, counterConfigs[c]);
+        config.exclude_kernel(true)
+            .exclude_hv(true);
+        if (!counters[c].tryAttach(config, 0)) {
+            warn("Failed to count host %s (%i). Check the value of "
+                 "/proc/sys/kernel/perf_event_paranoid.\n",
+                 counterNames[c], errno);
+        }
+    }
+
+    return enabled();
+#else
+    warn("Host events can't be counted on this host.\n");
+    return false;
+#endif
+}
+
+bool
+HostCounters::enabled()
+{
+#if HAVE_PERF_EVENT
+    return counters[Cycles].attached();
+#else
+    return false;
+#endif
+}
+
+uint64_t
+HostCounters::read(Counter counter)
+{
+#if HAVE_PERF_EVENT
+    if (counters[counter].attached())
+        return counters[counter].read();
+#endif
+    return 0;
+}
+
+void
+HostCounters::profileEvents(unsigned period)
+{
+    profilePeriod = enabled() ? period : 0;
+    countdown = profilePeriod;
+
+    // Estimate what reading the counters costs, so that it is not
+    // counted as part of the events
+    const int rounds = 64;
+    uint64_t total[NumCounters] = {};
+    for (int i = 0; profilePeriod && i < rounds; i++) {
+        uint64_t before[NumCounters], after[NumCounters];
+        readAll(before);
+        readAll(after);
+        for (int c = 0; c < NumCounters; c++)
+            total[c] += after[c] - before[c];
+    }
+    for (int c = 0; c < NumCounters; c++)
+        readOverhead[c] = total[c] / rounds;
+}
+
+void
+HostCounters::processProfiled(Event *event)
+{
+    countdown = profilePeriod;
+
+    // Generic events are named after their instance, so they are
+    // grouped by their description instead
+    std::string name = event->name();
+    if (name.compare(0, 6, "Event_") == 0)
+        name = event->description();
+
+    uint64_t before[NumCounters], after[NumCounters];
+    readAll(before);
+    event->process();
+    readAll(after);
+
+    EventProfile &profile = eventProfiles[name];
+    profile.samples++;
+    for (int c = 0; c < NumCounters; c++) {
+        const uint64_t count = after[c] - before[c];
+        profile.counts[c] += count - std::min(count, readOverhead[c]);
+    }
+}
+
+void
+HostCounters::dumpEventProfile(std::ostream &os)
+{
+    std::vector<std::pair<std::string, EventProfile>> profiles(
+        eventProfiles.begin(), eventProfiles.end());
+    std::sort(profiles.begin(), profiles.end(),
+        [](const auto &a, const auto &b) {
+            return a.second.counts[Cycles] > b.second.counts[Cycles];
+        });
+
+    uint64_t total_cycles = 0;
+    for (const auto &profile : profiles)
+        total_cycles += profile.second.counts[Cycles];
+
+    ccprintf(os, "# Host events of one out of %d simulation events, "
+             "per processed event\n", profilePeriod);
+    ccprintf(os, "%-48s %10s %7s %12s %12s %12s %13s\n", "event",
+             "samples", "cycles%", "cycles", "instructions",
+             "cache misses", "branch misses");
+    for (const auto &profile : profiles) {
+        const EventProfile &p = profile.second;
+        const double samples = p.samples;
+        ccprintf(os, "%-48s %10d %7.2f %12.1f %12.1f %12.2f %13.2f\n",
+                 profile.first, p.samples,
+                 total_cycles ? 100.0 * p.counts[Cycles] / total_cycles : 0,
+                 p.counts[Cycles] / samples, p.counts[Instructions] / samples,
+                 p.counts[CacheMisses] / samples,
+                 p.counts[BranchMisses] / samples);
+    }
+}
+
+} // namespace gem5
@@ -0,0 +1,138 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Counters of the host events of the simulator itself.
+ */
+
+#ifndef __SIM_HOST_COUNTERS_HH__
+#define __SIM_HOST_COUNTERS_HH__
+
+#include <cstdint>
+#include <ostream>
+
+#include "base/compiler.hh"
+
+namespace gem5
+{
+
+class Event;
+
+/**
+ * Counters of host events, e.g., cycles or cache misses, caused by the
+ * simulator itself. They are read using PerfEvent on Linux hosts, and
+ * are exposed as statistics of the root (hostCycles, ...) and of the
+ * CPUs (hostCyclesPerSimInst, ...), so that the performance of the
+ * simulator can be tracked over the phases of a simulation, and
+ * regressions of the simulator can be caught automatically.
+ *
+ * The events of the thread that enabled the counters, i.e., the main
+ * simulation thread, are counted.
+ *
+ * The processing of a sample of the simulation events can also be
+ * profiled, which attributes the host events to the names of the
+ * simulation events, e.g., system.cpu.tickEvent.
+ */
+class HostCounters
+{
+  public:
+    /** The host events that are counted. */
+    enum Counter
+    {
+        Cycles,
+        Instructions,
+        CacheMisses,
+        BranchMisses,
+        NumCounters
+    };
+
+    /**
+     * Start counting the host events of the calling thread.
+     *
+     * @return True if the events are counted, false if the host does
+     * not allow it, in which case all the counts stay at 0.
+     */
+    static bool enable();
+
+    /** @return True if the host events are counted. */
+    static bool enabled();
+
+    /**
+     * Get the number of host events since the counters were enabled.
+     *
+     * @param counter The host event to get the count of.
+     * @return The count, or 0 if the events are not counted.
+     */
+    static uint64_t read(Counter counter);
+
+    /**
+     * Profile the host events caused by the processing of one out of
+     * every period simulation events on the calling thread.
+     *
+     * @param period The sampling period, in simulation events, or 0 to
+     * stop profiling.
+     */
+    static void profileEvents(unsigned period);
+
+    /**
+     * Write the profile of the simulation events, sorted by decreasing
+     * number of host cycles.
+     *
+     * @param os The stream to write the profile to.
+     */
+    static void dumpEventProfile(std::ostream &os);
+
+    /**
+     * Check if the next simulation event processed by this thread is
+     * to be profiled, see processProfiled().
+     *
+     * @return True if the event is sampled.
+     */
+    static bool
+    sampleEvent()
+    {
+        return GEM5_UNLIKELY(countdown != 0) && --countdown == 0;
+    }
+
+    /**
+     * Process a simulation event, counting the host events it causes.
+     *
+     * @param event The event to process.
+     */
+    static void processProfiled(Event *event);
+
+  private:
+    /**
+     * Number of events to process before the next sample. This is
+     * read for every event, so it uses __thread like the current event
+     * queue, which avoids the wrapper function of thread_local.
+     */
+    static __thread unsigned countdown;
+};
+
+} // namespace gem5
+
+#endif // __SIM_HOST_COUNTERS_HH__
@@ -76,9 +76,21 @@ Root::RootStats::RootStats()
              "The number of ticks simulated per host second (ticks/s)"),
     ADD_STAT(hostMemory, statistics::units::Byte::get(),
              "Number of bytes of host memory used"),
+    ADD_STAT(hostCycles, statistics::units::Cycle::get(),
+             "Number of host cycles spent simulating"),
+    ADD_STAT(hostInstructions, statistics::units::Count::get(),
+             "Number of host instructions executed to simulate"),
+    ADD_STAT(hostCacheMisses, statistics::units::Count::get(),
+             "Number of host cache misses while simulating"),
+    ADD_STAT(hostBranchMisses, statistics::units::Count::get(),
+             "Number of host branch mispredictions while simulating"),
+    ADD_STAT(hostIPC, statistics::units::Rate<
+                statistics::units::Count, statistics::units::Cycle>::get(),
+             "Host instructions per host cycle while simulating"),
 
     statTime(true),
-    startTick(0)
+    startTick(0),
+    hostEventsStart{}
 {
     simFreq.scalar(sim_clock::Frequency);
     simTicks.functor([this]() { return curTick() - startTick; });
@@ -100,8 +112,33 @@ Root::RootStats::RootStats()
 
     hostTickRate.precision(0);
 
+    // The host events are only counted if HostCounters were enabled
+    statistics::Value *host_events[] = {
+        &hostCycles, &hostInstructions, &hostCacheMisses, &hostBranchMisses
+    };
+    for (int c = 0; c < HostCounters::NumCounters; c++) {
+        const auto counter = (HostCounters::Counter)c;
+        host_events[c]
+            ->functor([this, counter]() { return hostEvents(counter); })
+            .precision(0)
+            .prereq(hostCycles)
+            ;
+    }
+
+    hostIPC
+        .precision(4)
+        .prereq(hostCycles)
+        ;
+
     simSeconds = simTicks / simFreq;
     hostTickRate = simTicks / hostSeconds;
+    hostIPC = hostInstructions / hostCycles;
+}
+
+uint64_t
+Root::RootStats::hostEvents(HostCounters::Counter counter) const
+{
+    return HostCounters::read(counter) - hostEventsStart[counter];
 }
 
 void
@@ -109,6 +146,8 @@ Root::RootStats::resetStats()
 {
     statTime.setTimer();
     startTick = curTick();
+    for (int c = 0; c < HostCounters::NumCounters; c++)
+        hostEventsStart[c] = HostCounters::read((HostCounters::Counter)c);
 
     statistics::Group::resetStats();
 }
@@ -56,6 +56,7 @@
 #include "base/types.hh"
 #include "params/Root.hh"
 #include "sim/eventq.hh"
+#include "sim/host_counters.hh"
 #include "sim/globals.hh"
 #include "sim/sim_object.hh"
 
@@ -110,6 +111,18 @@ class Root : public SimObject
         statistics::Formula hostTickRate;
         statistics::Value hostMemory;
 
+        statistics::Value hostCycles;
+        statistics::Value hostInstructions;
+        statistics::Value hostCacheMisses;
+        statistics::Value hostBranchMisses;
+        statistics::Formula hostIPC;
+
+        /**
+         * Get the number of host events counted since the statistics
+         * were reset, see HostCounters.
+         */
+        uint64_t hostEvents(HostCounters::Counter counter) const;
+
         static RootStats instance;
 
       private:
@@ -120,6 +133,7 @@ class Root : public SimObject
 
         Time statTime;
         Tick startTick;
+        uint64_t hostEventsStart[HostCounters::NumCounters];
     };
 
   public:
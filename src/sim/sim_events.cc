@@ -45,6 +45,7 @@
 #include <string>
 
 #include "base/callback.hh"
+#include "base/flight_recorder.hh"
 #include "sim/eventq.hh"
 #include "sim/sim_exit.hh"
 #include "sim/stats.hh"
@@ -79,6 +80,10 @@ GlobalSimLoopExitEvent::description() const
 void
 GlobalSimLoopExitEvent::process()
 {
+    // All the threads are stopped, so this is a consistent point to
+    // save the most recent debug messages
+    Trace::dumpFlightRecorder(cause);
+
     if (repeat) {
         schedule(curTick() + repeat);
     }
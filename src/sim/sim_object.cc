@@ -29,12 +29,17 @@
 
 #include "sim/sim_object.hh"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <thread>
 
 #include "base/logging.hh"
 #include "base/match.hh"
 #include "base/trace.hh"
 #include "debug/Checkpoint.hh"
+#include "sim/cur_tick.hh"
+#include "sim/eventq.hh"
 #include "sim/probe/probe.hh"
 
 namespace gem5
@@ -116,6 +121,74 @@ SimObject::regProbeListeners()
 {
 }
 
+namespace
+{
+
+/**
+ * Call an initialization method on a list of objects. The objects
+ * with an independent initialization are handed out to a pool of host
+ * threads, and the others are then initialized in order from the
+ * calling thread.
+ */
+void
+initObjects(const std::vector<SimObject *> &objs, unsigned threads,
+            void (SimObject::*method)(),
+            bool (SimObject::*is_independent)() const)
+{
+    std::vector<SimObject *> independent;
+    if (threads > 1) {
+        for (auto *obj : objs) {
+            if ((obj->*is_independent)())
+                independent.push_back(obj);
+        }
+    }
+
+    const bool parallel = independent.size() > 1;
+    if (parallel) {
+        // The workers see the same time and event queue as the caller
+        Tick *tick = Gem5Internal::_curTickPtr;
+        EventQueue *eventq = curEventQueue();
+        std::atomic<size_t> next(0);
+
+        auto worker = [&]() {
+            curEventQueue(eventq);
+            Gem5Internal::_curTickPtr = tick;
+            for (size_t i = next++; i < independent.size(); i = next++)
+                (independent[i]->*method)();
+        };
+
+        const size_t count = std::min<size_t>(threads, independent.size());
+        std::vector<std::thread> workers;
+        for (size_t t = 1; t < count; t++)
+            workers.emplace_back(worker);
+        worker();
+        for (auto &w : workers)
+            w.join();
+    }
+
+    for (auto *obj : objs) {
+        if (!parallel || !(obj->*is_independent)())
+            (obj->*method)();
+    }
+}
+
+} // anonymous namespace
+
+void
+SimObject::initAll(const std::vector<SimObject *> &objs, unsigned threads)
+{
+    initObjects(objs, threads, &SimObject::init,
+                &SimObject::independentInit);
+}
+
+void
+SimObject::initStateAll(const std::vector<SimObject *> &objs,
+                        unsigned threads)
+{
+    initObjects(objs, threads, &SimObject::initState,
+                &SimObject::independentInitState);
+}
+
 ProbeManager *
 SimObject::getProbeManager()
 {
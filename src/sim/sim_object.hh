@@ -193,6 +193,52 @@ class SimObject : public EventManager, public Serializable, public Drainable,
      */
     virtual void init();
 
+    /**
+     * Check whether init() only touches the state of this object, so
+     * that it may be called from another host thread concurrently with
+     * the initialization of other objects. Objects that register
+     * statistics, access other objects, or use any other global state
+     * while initializing must not override this.
+     *
+     * @return True if init() can be called concurrently.
+     *
+     * @ingroup api_simobject
+     */
+    virtual bool independentInit() const { return false; }
+
+    /**
+     * Check whether initState() can be called concurrently with the
+     * initialization of other objects, with the same restrictions as
+     * independentInit().
+     *
+     * @return True if initState() can be called concurrently.
+     *
+     * @ingroup api_simobject
+     */
+    virtual bool independentInitState() const { return false; }
+
+    /**
+     * Call init() on a list of objects. When more than one host thread
+     * is used, the objects that have an independent initialization are
+     * initialized first, concurrently, before the others are
+     * initialized in order from the calling thread.
+     *
+     * @param objs The objects to initialize, in configuration order.
+     * @param threads The number of host threads to use.
+     */
+    static void initAll(const std::vector<SimObject *> &objs,
+                        unsigned threads);
+
+    /**
+     * Call initState() on a list of objects, using host threads for
+     * independent objects in the same way as initAll().
+     *
+     * @param objs The objects to initialize, in configuration order.
+     * @param threads The number of host threads to use.
+     */
+    static void initStateAll(const std::vector<SimObject *> &objs,
+                             unsigned threads);
+
     /**
      * loadState() is called on each SimObject when restoring from a
      * checkpoint.  The default implementation simply calls
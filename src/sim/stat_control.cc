@@ -45,14 +45,19 @@
 
 #include "sim/stat_control.hh"
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <list>
+#include <utility>
 
 #include "base/callback.hh"
 #include "base/statistics.hh"
+#include "base/stats/dump_plan.hh"
+#include "base/str.hh"
 #include "base/time.hh"
 #include "sim/global_event.hh"
+#include "sim/root.hh"
 
 namespace gem5
 {
@@ -63,6 +68,43 @@ namespace statistics
 
 GlobalEvent *dumpEvent;
 
+namespace
+{
+
+/** Tick of the last dump. */
+Tick lastDump = 0;
+
+/** Outputs the statistics are dumped to from C++, if any. */
+std::vector<Output *> nativeOutputs;
+
+/** The flattened statistics tree used by the native dump. */
+DumpPlan nativePlan;
+
+/**
+ * Get the statistics that are not part of a group, in the order in
+ * which they are dumped from Python, i.e., sorted by the components of
+ * their names.
+ */
+std::vector<Info *>
+sortedLegacyStats()
+{
+    std::vector<std::pair<std::vector<std::string>, Info *>> named;
+    for (auto *info : statsList()) {
+        std::vector<std::string> components;
+        tokenize(components, info->name, '.', false);
+        named.emplace_back(std::move(components), info);
+    }
+    std::stable_sort(named.begin(), named.end(),
+        [](const auto &a, const auto &b) { return a.first < b.first; });
+
+    std::vector<Info *> sorted;
+    for (const auto &n : named)
+        sorted.push_back(n.second);
+    return sorted;
+}
+
+} // anonymous namespace
+
 void
 initSimStats()
 {
@@ -77,11 +119,14 @@ class StatEvent : public GlobalEvent
     bool dump;
     bool reset;
     Tick repeat;
+    std::function<void()> callback;
 
   public:
-    StatEvent(Tick _when, bool _dump, bool _reset, Tick _repeat)
+    StatEvent(Tick _when, bool _dump, bool _reset, Tick _repeat,
+              std::function<void()> _callback = nullptr)
         : GlobalEvent(_when, Stat_Event_Pri, 0),
-          dump(_dump), reset(_reset), repeat(_repeat)
+          dump(_dump), reset(_reset), repeat(_repeat),
+          callback(std::move(_callback))
     {
     }
 
@@ -94,6 +139,9 @@ class StatEvent : public GlobalEvent
         if (reset)
             statistics::reset();
 
+        if (callback)
+            callback();
+
         if (repeat) {
             statistics::schedStatEvent(dump, reset, curTick() + repeat,
                 repeat);
@@ -113,6 +161,13 @@ schedStatEvent(bool dump, bool reset, Tick when, Tick repeat)
     dumpEvent = new StatEvent(when + simQuantum, dump, reset, repeat);
 }
 
+void
+schedStatEventOnce(bool dump, bool reset, std::function<void()> callback)
+{
+    new StatEvent(curTick() + simQuantum, dump, reset, 0,
+                  std::move(callback));
+}
+
 void
 periodicStatDump(Tick period)
 {
@@ -143,6 +198,78 @@ periodicStatDump(Tick period)
     }
 }
 
+bool
+markDump()
+{
+    assert(lastDump <= curTick());
+    const bool new_dump = lastDump != curTick();
+    lastDump = curTick();
+    return new_dump;
+}
+
+void
+enableNativeDump(const std::vector<Output *> &outputs)
+{
+    nativeOutputs = outputs;
+    nativePlan.clear();
+}
+
+void
+disableNativeDump()
+{
+    nativeOutputs.clear();
+    nativePlan.clear();
+}
+
+bool
+nativeDumpEnabled()
+{
+    return !nativeOutputs.empty();
+}
+
+void
+nativeDump()
+{
+    // Don't allow multiple global stat dumps in the same tick
+    if (!markDump())
+        return;
+
+    Root *root = Root::root();
+    panic_if(!root, "Statistics dumped before the Root was created.");
+
+    processDumpQueue();
+    // Notify the stats groups that we are about to dump stats
+    root->preDumpStats();
+
+    if (nativePlan.empty())
+        nativePlan.build(*root, sortedLegacyStats());
+    nativePlan.prepare();
+
+    for (auto *output : nativeOutputs) {
+        if (output->valid()) {
+            output->begin();
+            nativePlan.visit(*output);
+            output->end();
+        }
+    }
+}
+
+void
+nativeReset()
+{
+    // Reset the statistics of all SimObjects
+    Root *root = Root::root();
+    if (root)
+        root->resetStats();
+
+    // Then the statistics that are not part of a group, and any other
+    // registered reset callbacks
+    for (auto *info : statsList())
+        info->reset();
+
+    processResetQueue();
+}
+
 void
 updateEvents()
 {
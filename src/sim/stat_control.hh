@@ -41,6 +41,9 @@
 #ifndef __SIM_STAT_CONTROL_HH__
 #define __SIM_STAT_CONTROL_HH__
 
+#include <functional>
+#include <vector>
+
 #include "base/compiler.hh"
 #include "base/types.hh"
 #include "sim/cur_tick.hh"
@@ -53,6 +56,8 @@ namespace statistics
 {
 
 
+struct Output;
+
 void initSimStats();
 
 /**
@@ -75,6 +80,19 @@ void updateEvents();
 void schedStatEvent(bool dump, bool reset, Tick when = curTick(),
                     Tick repeat = 0);
 
+/**
+ * Schedule a single dump and/or reset of the statistics at the next
+ * synchronization of the event queues. This may be requested from any
+ * event queue, e.g., when a thread has committed a given number of
+ * instructions. Unlike schedStatEvent(), it leaves the event of the
+ * periodic dumps alone.
+ * @param dump Set true to dump the statistics.
+ * @param reset Set true to reset the statistics.
+ * @param callback Called once the statistics were dumped and/or reset.
+ */
+void schedStatEventOnce(bool dump, bool reset,
+                        std::function<void()> callback = nullptr);
+
 /**
  * Schedule periodic statistics dumping. This allows you to dump and reset the
  * built-in statistics on a regular basis, thereby allowing the extraction of
@@ -82,6 +100,43 @@ void schedStatEvent(bool dump, bool reset, Tick when = curTick(),
  * @param period The period at which the dumping should occur.
  */
 void periodicStatDump(Tick period = 0);
+
+/**
+ * Record that the statistics are being dumped at the current tick.
+ * Several dumps of the whole hierarchy in the same tick are not allowed,
+ * and the statistics only need to be prepared for the first dump of a
+ * tick.
+ * @return True if this is the first dump in the current tick.
+ */
+bool markDump();
+
+/**
+ * Dump the statistics to a set of outputs from C++. The tree of
+ * statistics groups is flattened on the first dump, so that later dumps,
+ * and in particular periodic dumps, neither walk the tree again nor call
+ * into Python.
+ * @param outputs The outputs to dump to, which must outlive the dumps.
+ */
+void enableNativeDump(const std::vector<Output *> &outputs);
+
+/** Stop dumping the statistics from C++. */
+void disableNativeDump();
+
+/** @return True if the statistics are dumped from C++. */
+bool nativeDumpEnabled();
+
+/**
+ * Dump the whole statistics hierarchy to the outputs passed to
+ * enableNativeDump(), unless it was already dumped in this tick.
+ */
+void nativeDump();
+
+/**
+ * Reset the whole statistics hierarchy from C++, which is equivalent
+ * to a reset from Python without walking the tree of objects there.
+ */
+void nativeReset();
+
 } // namespace statistics
 } // namespace gem5
 
@@ -38,6 +38,7 @@
 #include "sim/stat_register.hh"
 
 #include "base/statistics.hh"
+#include "sim/stat_control.hh"
 
 namespace gem5
 {
@@ -54,5 +55,10 @@ void registerPythonStatsHandlers()
     registerHandlers(pythonReset, pythonDump);
 }
 
+void registerNativeStatsHandlers()
+{
+    registerHandlers(nativeReset, nativeDump);
+}
+
 } // namespace statistics
 } // namespace gem5
@@ -54,6 +54,12 @@ namespace statistics
 /** Register py_... functions as the statistics handlers */
 void registerPythonStatsHandlers();
 
+/**
+ * Register the C++ reset and dump functions, see nativeReset() and
+ * nativeDump(), as the statistics handlers.
+ */
+void registerNativeStatsHandlers();
+
 } // namespace statistics
 } // namespace gem5
 
@@ -0,0 +1,145 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+'''
+Run 'hello' on a NonCachingSimpleCPU, with the caches bypassed, and
+switch to a TimingSimpleCPU after a number of instructions.
+
+When the caches are warmed while bypassed, check that the accesses are
+logged and applied to the tags in batches, that warmed blocks are
+evicted, and that the warmed blocks are refilled when switching. When
+they are not, check that the memory backdoors are passed through the
+caches.
+'''
+
+import argparse
+import sys
+
+import m5
+from m5.objects import *
+
+m5.util.addToPath('../../../configs/')
+from common.Caches import *
+
+parser = argparse.ArgumentParser()
+parser.add_argument('--cmd', required=True,
+                    help='The binary to run')
+parser.add_argument('--warm', action='store_true',
+                    help='Keep the caches warm when bypassed')
+parser.add_argument('--batch-size', type=int, default=64,
+                    help='Number of accesses applied to the tags at once')
+parser.add_argument('--switch-insts', type=int, default=1000,
+                    help='Number of instructions before switching')
+args = parser.parse_args()
+
+def check(cond, msg):
+    if not cond:
+        print('Check failed: %s' % msg, file=sys.stderr)
+        sys.exit(1)
+
+def stat(obj, name):
+    return obj.getCCObject().resolveStat(name)
+
+system = System()
+system.clk_domain = SrcClockDomain(clock='1GHz',
+                                   voltage_domain=VoltageDomain())
+system.mem_mode = 'atomic_noncaching'
+system.mem_ranges = [AddrRange('512MB')]
+
+system.cpu = NonCachingSimpleCPU(max_insts_any_thread=args.switch_insts)
+system.switch_cpu = TimingSimpleCPU(switched_out=True, cpu_id=0)
+
+# Small L1s, so that warmed blocks are evicted
+cache_params = {'warm_when_bypassed' : args.warm,
+                'warming_batch_size' : args.batch_size}
+system.cpu.addTwoLevelCacheHierarchy(
+    L1_ICache(size='1kB', assoc=2, **cache_params),
+    L1_DCache(size='1kB', assoc=2, **cache_params),
+    L2Cache(size='16kB', assoc=4, **cache_params))
+
+system.membus = SystemXBar()
+system.system_port = system.membus.cpu_side_ports
+system.cpu.createInterruptController()
+system.cpu.connectAllPorts(system.membus)
+
+system.physmem = SimpleMemory(range=system.mem_ranges[0])
+system.physmem.port = system.membus.mem_side_ports
+
+system.workload = SEWorkload.init_compatible(args.cmd)
+process = Process(cmd=[args.cmd])
+system.cpu.workload = process
+system.cpu.createThreads()
+
+system.switch_cpu.workload = process
+system.switch_cpu.isa = system.cpu.isa
+
+root = Root(full_system=False, system=system)
+m5.instantiate()
+
+exit_event = m5.simulate()
+check(exit_event.getCause() ==
+      'a thread reached the max instruction count',
+      'unexpected exit: %s' % exit_event.getCause())
+
+caches = (system.cpu.icache, system.cpu.dcache, system.cpu.l2cache)
+l1_accesses = 0
+for cache in caches:
+    accesses = stat(cache, 'warmingAccesses').value
+    if not args.warm:
+        check(accesses == 0, '%s warmed' % cache)
+        continue
+
+    # The log is only applied once full, or when draining
+    check(accesses > 0, '%s not warmed' % cache)
+    check(accesses % args.batch_size == 0,
+          '%s applied a partial batch' % cache)
+    check(stat(cache, 'warmingMisses').value > 0,
+          '%s allocated no blocks' % cache)
+    if cache is not system.cpu.l2cache:
+        l1_accesses += accesses
+        check(stat(cache, 'replacements').value > 0,
+              '%s evicted no warmed blocks' % cache)
+
+mem_accesses = (stat(system.physmem, 'numReads').total +
+                stat(system.physmem, 'numWrites').total)
+if args.warm:
+    # Every access is forwarded, as no backdoor is handed out
+    check(mem_accesses >= l1_accesses, 'accesses bypassed the caches')
+else:
+    # Without a backdoor every instruction fetch reaches the memory
+    check(mem_accesses < args.switch_insts / 10,
+          'no memory backdoor passed through the caches')
+
+m5.switchCpus(system, [(system.cpu, system.switch_cpu)])
+
+if args.warm:
+    # The L1s refill their blocks from the L2, which refills its own
+    # blocks first
+    l2 = system.cpu.l2cache
+    l2_reqs = sum(stat(l2, '%s.%s' % (cmd, res)).total
+                  for cmd in ('ReadCleanReq', 'ReadSharedReq')
+                  for res in ('hits', 'misses'))
+    check(l2_reqs > 0, 'warmed blocks were not refilled')
+
+exit_event = m5.simulate()
+print('Exiting @ tick %i because %s' % (m5.curTick(), exit_event.getCause()))
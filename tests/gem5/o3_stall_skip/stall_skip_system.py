@@ -0,0 +1,112 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+'''
+Run 'hello' on two identical systems with an O3 CPU, one of which skips
+the cycles in which the pipeline is stalled, and check that all their
+stats match, but for the number of skipped cycles.
+'''
+
+import argparse
+import sys
+
+import m5
+from m5.objects import *
+
+m5.util.addToPath('../../../configs/')
+from common.Caches import *
+
+parser = argparse.ArgumentParser()
+parser.add_argument('--cmd', required=True,
+                    help='The binary to run')
+args = parser.parse_args()
+
+def build_system(skip_stall_cycles):
+    system = System()
+    system.clk_domain = SrcClockDomain(clock='2GHz',
+                                       voltage_domain=VoltageDomain())
+    system.mem_mode = 'timing'
+    system.mem_ranges = [AddrRange('512MB')]
+
+    # A small ROB fills up quickly behind a miss, stalling the pipeline
+    system.cpu = DerivO3CPU(numROBEntries=32,
+                            skip_stall_cycles=skip_stall_cycles)
+    system.cpu.addTwoLevelCacheHierarchy(L1_ICache(size='32kB'),
+                                         L1_DCache(size='32kB'),
+                                         L2Cache(size='256kB'))
+
+    system.membus = SystemXBar()
+    system.system_port = system.membus.cpu_side_ports
+    system.cpu.createInterruptController()
+    system.cpu.connectAllPorts(system.membus)
+
+    system.mem_ctrl = MemCtrl(dram=DDR3_1600_8x8(range=system.mem_ranges[0]))
+    system.mem_ctrl.port = system.membus.mem_side_ports
+
+    system.workload = SEWorkload.init_compatible(args.cmd)
+    system.cpu.workload = Process(cmd=[args.cmd])
+    system.cpu.createThreads()
+
+    return system
+
+root = Root(full_system=False, system=build_system(False),
+            skip_system=build_system(True))
+m5.instantiate()
+
+exit_event = m5.simulate()
+print('Exiting @ tick %i because %s' % (m5.curTick(), exit_event.getCause()))
+
+def values(stat):
+    stat.prepare()
+    return tuple(getattr(stat, attr) for attr in
+                 ('value', 'values', 'sum', 'squares', 'underflow',
+                  'overflow', 'min_val', 'max_val')
+                 if hasattr(stat, attr))
+
+mismatches = []
+def compare(path, group, other):
+    for stat in group.getStats():
+        if stat.name == 'stallSkippedCycles':
+            continue
+        # Compare the representations, so that NaNs match
+        if repr(values(stat)) != repr(values(other.resolveStat(stat.name))):
+            mismatches.append('%s.%s' % (path, stat.name))
+
+    other_groups = other.getStatGroups()
+    for name, subgroup in group.getStatGroups().items():
+        compare('%s.%s' % (path, name), subgroup, other_groups[name])
+
+compare('system', root.system.getCCObject(),
+        root.skip_system.getCCObject())
+
+for name in mismatches:
+    print('Stat %s differs when skipping stalled cycles' % name,
+          file=sys.stderr)
+
+skipped = root.skip_system.cpu.getCCObject().resolveStat(
+    'stallSkippedCycles').value
+if skipped == 0:
+    print('No stalled cycles were skipped', file=sys.stderr)
+
+if mismatches or skipped == 0:
+    sys.exit(1)
@@ -0,0 +1,63 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+'''
+Test that skipping the cycles in which the O3 pipeline is stalled does
+not change any of the stats.
+'''
+
+from testlib import *
+
+progs = {
+    constants.gcn3_x86_tag : 'hello64-static',
+    constants.arm_tag : 'hello64-static',
+}
+
+base_path = joinpath(config.bin_path, 'hello')
+
+urlbase = config.resource_url + '/test-progs/hello/bin/'
+
+isa_urls = {
+    constants.gcn3_x86_tag : urlbase + 'x86/linux',
+    constants.arm_tag : urlbase + 'arm/linux',
+}
+
+verifiers = (
+    verifier.MatchStdoutNoPerf(joinpath(getcwd(), 'ref', 'simout')),
+)
+
+for isa, binary in progs.items():
+    path = joinpath(base_path, isa.lower())
+    hello_program = DownloadedProgram(isa_urls[isa] + '/' + binary, path,
+                                      binary)
+
+    gem5_verify_config(
+        name='o3-stall-skip-' + binary,
+        fixtures=(hello_program,),
+        verifiers=verifiers,
+        config=joinpath(getcwd(), 'stall_skip_system.py'),
+        config_args=['--cmd', joinpath(path, binary)],
+        valid_isas=(isa,),
+        valid_hosts=constants.supported_hosts,
+        length=constants.quick_tag,
+    )
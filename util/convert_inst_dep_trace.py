@@ -0,0 +1,183 @@
+#!/usr/bin/env python3
+
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script converts protobuf traces of the instruction dependency
+# graph, as written by the ElasticTrace probe, to the columnar binary
+# format described in src/cpu/trace/elastic_trace_file.hh. The TraceCPU
+# accepts either format and recognises columnar traces by their magic
+# number.
+#
+# Usage: convert_inst_dep_trace.py <protobuf input> <columnar output>
+
+import array
+import struct
+import sys
+
+import protolib
+
+# Import the packet proto definitions. If they are not found, attempt
+# to generate them automatically. This assumes that the script is
+# executed from the gem5 root.
+try:
+    import inst_dep_record_pb2
+except:
+    print("Did not find proto definition, attempting to generate")
+    from subprocess import call
+    error = call(['protoc', '--python_out=util', '--proto_path=src/proto',
+                  'src/proto/inst_dep_record.proto'])
+    if not error:
+        import inst_dep_record_pb2
+        print("Generated proto definitions for instruction dependency record")
+    else:
+        print("Failed to import proto definitions")
+        exit(-1)
+
+MAGIC = b'gem5ETC\0'
+VERSION = 1
+RECORDS_PER_BLOCK = 4096
+
+class Block(object):
+    """The columns of a block of records being converted."""
+
+    def __init__(self):
+        self.seq_num = array.array('Q')
+        self.comp_delay = array.array('Q')
+        self.p_addr = array.array('Q')
+        self.v_addr = array.array('Q')
+        self.pc = array.array('Q')
+        self.size = array.array('I')
+        self.flags = array.array('I')
+        self.weight = array.array('I')
+        self.dep_dist = array.array('I')
+        self.type = array.array('B')
+        self.num_rob_deps = array.array('B')
+        self.num_reg_deps = array.array('B')
+
+    def __len__(self):
+        return len(self.seq_num)
+
+    def add_deps(self, seq_num, deps, skip):
+        num_deps = 0
+        for dep in deps:
+            if dep in skip:
+                continue
+            if dep >= seq_num or seq_num - dep >= 2**32 or num_deps == 255:
+                print("Seq. num", seq_num, "has an unsupported dependency on",
+                      dep)
+                exit(-1)
+            self.dep_dist.append(seq_num - dep)
+            num_deps += 1
+        return num_deps
+
+    def add(self, packet):
+        self.seq_num.append(packet.seq_num)
+        self.comp_delay.append(packet.comp_delay)
+        self.p_addr.append(packet.p_addr)
+        self.v_addr.append(packet.v_addr)
+        self.pc.append(packet.pc)
+        self.size.append(packet.size)
+        self.flags.append(packet.flags)
+        self.weight.append(packet.weight)
+        self.type.append(packet.type)
+        self.num_rob_deps.append(
+            self.add_deps(packet.seq_num, packet.rob_dep, ()))
+        # Register dependencies that are also order dependencies are
+        # dropped, as the TraceCPU only honours them once
+        self.num_reg_deps.append(
+            self.add_deps(packet.seq_num, packet.reg_dep, packet.rob_dep))
+
+    def write(self, out):
+        out.write(struct.pack('<II', len(self), len(self.dep_dist)))
+        size = 8
+        for column in (self.seq_num, self.comp_delay, self.p_addr,
+                       self.v_addr, self.pc, self.size, self.flags,
+                       self.weight, self.dep_dist, self.type,
+                       self.num_rob_deps, self.num_reg_deps):
+            if sys.byteorder != 'little':
+                column.byteswap()
+            out.write(column.tobytes())
+            size += len(column) * column.itemsize
+        # Pad the block to keep the next one aligned
+        out.write(b'\0' * (-size % 8))
+
+def main():
+    if len(sys.argv) != 3:
+        print("Usage: ", sys.argv[0], " <protobuf input> <columnar output>")
+        exit(-1)
+
+    # Open the file on read mode
+    proto_in = protolib.openFileRd(sys.argv[1])
+
+    try:
+        columnar_out = open(sys.argv[2], 'wb')
+    except IOError:
+        print("Failed to open ", sys.argv[2], " for writing")
+        exit(-1)
+
+    # Read the magic number in 4-byte Little Endian
+    magic_number = proto_in.read(4).decode()
+
+    if magic_number != "gem5":
+        print("Unrecognized file")
+        exit(-1)
+
+    print("Parsing packet header")
+
+    header = inst_dep_record_pb2.InstDepRecordHeader()
+    protolib.decodeMessage(proto_in, header)
+
+    print("Object id:", header.obj_id)
+    print("Tick frequency:", header.tick_freq)
+    print("Window size:", header.window_size)
+
+    columnar_out.write(MAGIC)
+    columnar_out.write(struct.pack('<IIQQ', VERSION, header.window_size,
+                                   header.tick_freq, 0))
+
+    print("Converting packets")
+
+    num_packets = 0
+    block = Block()
+    packet = inst_dep_record_pb2.InstDepRecord()
+
+    # Decode the packet messages until we hit the end of the file
+    while protolib.decodeMessage(proto_in, packet):
+        num_packets += 1
+        block.add(packet)
+        if len(block) == RECORDS_PER_BLOCK:
+            block.write(columnar_out)
+            block = Block()
+
+    if len(block):
+        block.write(columnar_out)
+
+    print("Converted packets:", num_packets)
+
+    # We're done
+    columnar_out.close()
+    proto_in.close()
+
+if __name__ == "__main__":
+    main()
@@ -62,6 +62,7 @@
 #include "base/str.hh"
 #include "base/trace.hh"
 #include "cpu/base.hh"
+#include "sim/cxx_config_binary.hh"
 #include "sim/cxx_config_ini.hh"
 #include "sim/cxx_manager.hh"
 #include "sim/init_signals.hh"
@@ -78,7 +79,10 @@ void
 usage(const std::string &prog_name)
 {
     std::cerr << "Usage: " << prog_name << (
-        " <config-file.ini> [ <option> ]\n\n"
+        " <config-file> [ <option> ]\n\n"
+        "The config file is either a config.ini or a binary config"
+        " written with\n"
+        "--binary-config.\n\n"
         "OPTIONS:\n"
         "    -p <object> <param> <value>  -- set a parameter\n"
         "    -v <object> <param> <values> -- set a vector parameter from"
@@ -124,7 +128,11 @@ main(int argc, char **argv)
 
     const std::string config_file(argv[arg_ptr]);
 
-    CxxConfigFileBase *conf = new CxxIniFile();
+    CxxConfigFileBase *conf;
+    if (CxxBinaryConfigFile::isBinaryConfig(config_file))
+        conf = new CxxBinaryConfigFile();
+    else
+        conf = new CxxIniFile();
 
     if (!conf->load(config_file.c_str())) {
         std::cerr << "Can't open config file: " << config_file << '\n';
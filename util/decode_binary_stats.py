@@ -0,0 +1,295 @@
+#!/usr/bin/env python3
+
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script reads the binary statistics written by the "binary" stats
+# output, e.g., when running gem5 with --stats-file=binary://stats.bin.
+# The format is described in src/base/stats/binary.hh.
+#
+# It can be used as a module:
+#
+#   stats = BinaryStats("m5out/stats.bin")
+#   ticks = stats.ticks()
+#   data = stats.load(["system.cpu.numCycles", "system.cpu.ipc"])
+#
+# where each loaded stat is an array with one row per dump, or from the
+# command line to list the stats in a file or print some of them as CSV:
+#
+#   decode_binary_stats.py m5out/stats.bin
+#   decode_binary_stats.py m5out/stats.bin system.cpu.numCycles
+#
+# Only the stats that are asked for are kept in memory, and numpy arrays
+# are returned if numpy is available.
+
+import os
+import struct
+import sys
+
+MAGIC = b'gem5STB\0'
+VERSION = 2
+
+TAG_SCHEMA = 1
+TAG_DUMP = 2
+
+KINDS = ['scalar', 'vector', 'dist', 'vector_dist', 'vector_2d', 'formula']
+
+# The buckets of distributions are labelled by their index. The range of
+# bucket i starts at the bucket_min + i * bucket_size values of the same
+# dump, as the buckets of a histogram grow during the simulation.
+
+class Stat(object):
+    """Description of a stat from the schema of a file."""
+
+    def __init__(self, name, unit, desc, kind, rows, cols, row_labels,
+                 col_labels, offset):
+        self.name = name
+        self.unit = unit
+        self.desc = desc
+        self.kind = kind
+        self.rows = rows
+        self.cols = cols
+        self.row_labels = row_labels
+        self.col_labels = col_labels
+        # Index of the first value of the stat in a dump
+        self.offset = offset
+
+    @property
+    def size(self):
+        return self.rows * self.cols
+
+    @property
+    def shape(self):
+        """Shape of the values of one dump."""
+        if self.kind in ('vector_dist', 'vector_2d'):
+            return (self.rows, self.cols)
+        elif self.kind == 'scalar':
+            return ()
+        else:
+            return (self.cols, )
+
+class _Buffer(object):
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def varint(self):
+        result = 0
+        shift = 0
+        while True:
+            byte = self.data[self.pos]
+            self.pos += 1
+            result |= (byte & 0x7f) << shift
+            if byte < 0x80:
+                return result
+            shift += 7
+
+    def string(self):
+        length = self.varint()
+        value = self.data[self.pos:self.pos + length].decode()
+        self.pos += length
+        return value
+
+    def u8(self):
+        self.pos += 1
+        return self.data[self.pos - 1]
+
+    def u64(self):
+        self.pos += 8
+        return struct.unpack_from('<Q', self.data, self.pos - 8)[0]
+
+    def double(self):
+        self.pos += 8
+        return struct.unpack_from('<d', self.data, self.pos - 8)[0]
+
+class BinaryStats(object):
+    """A binary stats file. Opening the file only reads its schema and
+    locates its dumps, and the values of the stats are decoded when they
+    are loaded."""
+
+    def __init__(self, path):
+        self.path = path
+        self.stats = {}
+        self.names = []
+        self._num_values = 0
+        # Offset and length of the payload of each dump
+        self._dumps = []
+
+        size = os.path.getsize(path)
+        with open(path, 'rb') as f:
+            header = f.read(12)
+            if len(header) != 12 or header[:8] != MAGIC:
+                raise ValueError("%s is not a binary stats file" % path)
+            version = struct.unpack('<I', header[8:])[0]
+            if version != VERSION:
+                raise ValueError("%s has unsupported version %d" %
+                                 (path, version))
+
+            while True:
+                record = f.read(9)
+                if len(record) < 9:
+                    break
+                tag, length = struct.unpack('<BQ', record)
+                offset = f.tell()
+                if offset + length > size:
+                    # A truncated record is a dump that is being written
+                    break
+                if tag == TAG_SCHEMA:
+                    self._parse_schema(f.read(length))
+                    continue
+                if tag == TAG_DUMP:
+                    self._dumps.append((offset, length))
+                f.seek(offset + length)
+
+    def _parse_schema(self, payload):
+        buf = _Buffer(payload)
+        offset = 0
+        for i in range(buf.varint()):
+            name = buf.string()
+            unit = buf.string()
+            desc = buf.string()
+            kind = KINDS[buf.u8()]
+            rows = buf.varint()
+            cols = buf.varint()
+            row_labels = [ buf.string() for j in range(buf.varint()) ]
+            col_labels = [ buf.string() for j in range(buf.varint()) ]
+            stat = Stat(name, unit, desc, kind, rows, cols, row_labels,
+                        col_labels, offset)
+            self.stats[name] = stat
+            self.names.append(name)
+            offset += stat.size
+        self._num_values = offset
+
+    def __len__(self):
+        """Number of dumps in the file."""
+        return len(self._dumps)
+
+    def _read_dumps(self, last):
+        """Yield the index and the payload of the dumps up to last. As the
+        dumps only hold the values that changed, the dumps preceding the
+        ones of interest are needed to decode them."""
+        with open(self.path, 'rb') as f:
+            for index, (offset, length) in enumerate(self._dumps[:last]):
+                f.seek(offset)
+                yield index, f.read(length)
+
+    def ticks(self):
+        """Tick of each dump."""
+        result = []
+        with open(self.path, 'rb') as f:
+            for offset, length in self._dumps:
+                f.seek(offset)
+                result.append(struct.unpack('<Q', f.read(8))[0])
+        return _array(result)
+
+    def load(self, names, first=0, last=None):
+        """Load the values of some stats. The result maps the name of
+        each stat to an array with one entry per dump between first and
+        last, each entry having the shape of the stat."""
+
+        stats = [ self.stats[name] for name in names ]
+        if last is None:
+            last = len(self._dumps)
+        rows = { stat.name : [] for stat in stats }
+
+        values = [ 0.0 ] * self._num_values
+        for index, payload in self._read_dumps(last):
+            buf = _Buffer(payload)
+            buf.u64()
+            pos = 0
+            for i in range(buf.varint()):
+                code = buf.varint()
+                pos += code >> 1
+                if code & 1:
+                    values[pos] = buf.double()
+                else:
+                    delta = buf.varint()
+                    delta = (delta >> 1) ^ -(delta & 1)
+                    values[pos] = float(int(values[pos]) + delta)
+                pos += 1
+
+            if index < first:
+                continue
+            for stat in stats:
+                if stat.kind == 'scalar':
+                    rows[stat.name].append(values[stat.offset])
+                else:
+                    rows[stat.name].append(
+                        values[stat.offset:stat.offset + stat.size])
+
+        result = {}
+        for stat in stats:
+            data = _array(rows[stat.name])
+            if _numpy:
+                data = data.reshape((len(rows[stat.name]), ) + stat.shape)
+            result[stat.name] = data
+        return result
+
+try:
+    import numpy as _numpy
+except ImportError:
+    _numpy = None
+
+def _array(values):
+    if _numpy:
+        return _numpy.array(values, dtype=float)
+    return values
+
+def main():
+    if len(sys.argv) < 2:
+        print("Usage: ", sys.argv[0], " <binary stats> [stat names]")
+        exit(-1)
+
+    stats = BinaryStats(sys.argv[1])
+
+    if len(sys.argv) == 2:
+        print("Dumps:", len(stats))
+        for name in stats.names:
+            stat = stats.stats[name]
+            print("%s %s %dx%d %s" % (name, stat.kind, stat.rows, stat.cols,
+                                      stat.unit))
+        return
+
+    names = sys.argv[2:]
+    data = stats.load(names)
+    columns = []
+    for name in names:
+        stat = stats.stats[name]
+        if stat.kind == 'scalar':
+            columns.append(name)
+        else:
+            columns.extend("%s::%d" % (name, i) for i in range(stat.size))
+    print(",".join(["tick"] + columns))
+    for index, tick in enumerate(stats.ticks()):
+        row = [ "%d" % tick ]
+        for name in names:
+            values = data[name][index]
+            if _numpy:
+                values = _numpy.ravel(values)
+            elif not isinstance(values, list):
+                values = [ values ]
+            row.extend("%g" % v for v in values)
+        print(",".join(row))
+
+if __name__ == "__main__":
+    main()